@@ -738,6 +738,26 @@ bool CSG_String::asInt(int &Value) const
 	return( end > start );
 }
 
+//---------------------------------------------------------
+sLong CSG_String::asLongLong(void) const
+{
+	sLong	Value	= 0;
+
+	asLongLong(Value);
+
+	return( Value );
+}
+
+bool CSG_String::asLongLong(sLong &Value) const
+{
+	const wxChar	*start = m_pString->c_str();
+	wxChar			*end;
+
+	Value	= wxStrtoll(start, &end, 10);
+
+	return( end > start );
+}
+
 //---------------------------------------------------------
 double CSG_String::asDouble(void) const
 {
@@ -48,6 +48,8 @@
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
+#include <algorithm>
+
 #include "grid.h"
 #include "data_manager.h"
 
@@ -207,6 +209,7 @@ void CSG_Grid::_On_Construction(void)
 	m_Values		= NULL;
 
 	m_Cache_Stream	= NULL;
+	m_Cache_Blocks	= NULL;
 	m_Cache_Offset	= 0;
 	m_Cache_bSwap	= false;
 	m_Cache_bFlip	= false;
@@ -216,6 +219,9 @@ void CSG_Grid::_On_Construction(void)
 
 	m_Index			= NULL;
 
+	m_Stats_Blocks	= NULL;
+	m_Stats_Dirty	= NULL;
+
 	m_pOwner		= NULL;
 
 	Set_Update_Flag();
@@ -991,28 +997,89 @@ bool CSG_Grid::On_Update(void)
 		m_Statistics.Set_Count(m_Statistics.Get_Count() >= Get_Max_Samples() ? Get_NCells()	// any no-data cells ?
 			: (sLong)(Get_NCells() * (double)m_Statistics.Get_Count() / (double)Get_Max_Samples())
 		);
+
+		return( true );
 	}
-	else
+
+	//-----------------------------------------------------
+	// block statistics are only valid for the no-data and
+	// scaling settings they have been collected with...
+
+	double	Key[4]	= { Get_NoData_Value(), Get_NoData_Value(true), Get_Scaling(), Get_Offset() };
+
+	if( m_Stats_Blocks && memcmp(Key, m_Stats_Key, sizeof(Key)) )
+	{
+		_Stats_Destroy();
+	}
+
+	int	nBlocks	= _Stats_Get_Block_Count();
+
+	if( !m_Stats_Blocks )
 	{
-		for(int y=0; y<Get_NY() && SG_UI_Process_Set_Progress(y, Get_NY()); y++)
+		m_Stats_Blocks	= new CSG_Simple_Statistics[nBlocks];
+		m_Stats_Dirty	= (BYTE *)SG_Malloc(nBlocks * sizeof(BYTE));
+
+		memset(m_Stats_Dirty, 1, nBlocks * sizeof(BYTE));
+		memcpy(m_Stats_Key, Key, sizeof(Key));
+	}
+
+	//-----------------------------------------------------
+	#pragma omp parallel for schedule(dynamic)
+	for(int iBlock=0; iBlock<nBlocks; iBlock++)
+	{
+		if( m_Stats_Dirty[iBlock] )
 		{
-			for(int x=0; x<Get_NX(); x++)
-			{
-				double	Value	= asDouble(x, y, false);
+			m_Stats_Dirty[iBlock]	= 0;
 
-				if( !is_NoData_Value(Value) )
+			CSG_Simple_Statistics	&Statistics	= m_Stats_Blocks[iBlock];
+
+			Statistics.Create(false);
+
+			for(int y=iBlock<<5, yMax=M_GET_MIN(Get_NY(), y + 32); y<yMax; y++)
+			{
+				for(int x=0; x<Get_NX(); x++)
 				{
-					m_Statistics	+= Scaling ? Offset + Scaling * Value : Value;
+					double	Value	= asDouble(x, y, false);
+
+					if( !is_NoData_Value(Value) )
+					{
+						Statistics	+= Scaling ? Offset + Scaling * Value : Value;
+					}
 				}
 			}
 		}
+	}
 
-		SG_UI_Process_Set_Ready();
+	for(int iBlock=0; iBlock<nBlocks; iBlock++)
+	{
+		m_Statistics	+= m_Stats_Blocks[iBlock];
 	}
 
 	return( true );
 }
 
+//---------------------------------------------------------
+void CSG_Grid::_Stats_Set_Dirty(void)
+{
+	if( m_Stats_Dirty )
+	{
+		memset(m_Stats_Dirty, 1, _Stats_Get_Block_Count() * sizeof(BYTE));
+	}
+}
+
+//---------------------------------------------------------
+void CSG_Grid::_Stats_Destroy(void)
+{
+	if( m_Stats_Blocks )
+	{
+		delete[](m_Stats_Blocks);
+
+		m_Stats_Blocks	= NULL;
+	}
+
+	SG_FREE_SAFE(m_Stats_Dirty);
+}
+
 //---------------------------------------------------------
 double CSG_Grid::Get_Mean(void)
 {
@@ -1065,7 +1132,7 @@ double CSG_Grid::Get_Quantile(double Quantile, bool bFromHistogram)
 	{
 		return( Get_Histogram().Get_Quantile(Quantile) );
 	}
-	else
+	else if( m_Index && !Get_Update_Flag() )	// use an existing sort index
 	{
 		sLong	n	= (sLong)(Quantile * (Get_Data_Count() - 1));
 
@@ -1074,6 +1141,60 @@ double CSG_Grid::Get_Quantile(double Quantile, bool bFromHistogram)
 			return( asDouble(n) );
 		}
 	}
+	else	// select without sorting all values
+	{
+		CSG_Array	_Count(sizeof(sLong), Get_NY()); sLong *Count = (sLong *)_Count.Get_Array();
+
+		#pragma omp parallel for
+		for(int y=0; y<Get_NY(); y++)
+		{
+			sLong	n	= 0;
+
+			for(int x=0; x<Get_NX(); x++)
+			{
+				if( !is_NoData(x, y) )
+				{
+					n++;
+				}
+			}
+
+			Count[y]	= n;
+		}
+
+		sLong	nValues	= 0;
+
+		for(int y=0; y<Get_NY(); y++)
+		{
+			sLong	n	= Count[y]; Count[y] = nValues; nValues += n;
+		}
+
+		CSG_Vector	Values;
+
+		if( nValues > 0 && Values.Create((size_t)nValues) )
+		{
+			double	*v	= Values.Get_Data();
+
+			#pragma omp parallel for
+			for(int y=0; y<Get_NY(); y++)
+			{
+				sLong	i	= Count[y];
+
+				for(int x=0; x<Get_NX(); x++)
+				{
+					if( !is_NoData(x, y) )
+					{
+						v[i++]	= asDouble(x, y);
+					}
+				}
+			}
+
+			sLong	n	= (sLong)(Quantile * (nValues - 1));
+
+			std::nth_element(v, v + n, v + nValues);
+
+			return( v[n] );
+		}
+	}
 
 	return( Get_NoData_Value() );
 }
@@ -1261,164 +1382,272 @@ bool CSG_Grid::Get_Histogram(const CSG_Rect &rWorld, CSG_Histogram &Histogram, s
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-bool CSG_Grid::_Set_Index(void)
+// The index is created with a parallel LSD radix sort, which
+// works on sort keys that are copied out of the grid once.
+// Keys are unsigned integers of the grid's value size with the
+// same order as the (scaled) cell values, e.g. floating point
+// values are mapped with the usual sign bit flipping trick.
+// No-data cells are excluded from sorting and stored at the
+// end of the index in reverse order.
+//---------------------------------------------------------
+static inline DWORD	SG_Grid_Index_Key_Float	(float Value)
 {
-	//-----------------------------------------------------
-	if( m_Index == NULL && (m_Index = (sLong *)SG_Malloc((size_t)Get_NCells() * sizeof(sLong))) == NULL )
-	{
-		SG_UI_Msg_Add_Error(_TL("could not create index: insufficient memory"));
+	DWORD	Key;	memcpy(&Key, &Value, sizeof(Key));
 
-		return( false );
-	}
-
-	//-----------------------------------------------------
-	const sLong	M	= 7;
+	return( Key & 0x80000000 ? ~Key : Key | 0x80000000 );
+}
 
-	sLong	i, j, k, l, ir, n, *istack, jstack, nstack, indxt, itemp, nData;
-	double	a;
+//---------------------------------------------------------
+static inline uLong	SG_Grid_Index_Key_Double(double Value)
+{
+	uLong	Key;	memcpy(&Key, &Value, sizeof(Key));
 
-	//-----------------------------------------------------
-	SG_UI_Process_Set_Text(CSG_String::Format("%s: %s", _TL("Create index"), Get_Name()));
+	return( Key & 0x8000000000000000ULL ? ~Key : Key | 0x8000000000000000ULL );
+}
 
-	for(i=0, j=0, nData=Get_NCells(); i<Get_NCells(); i++)
+//---------------------------------------------------------
+template <typename TKey>
+static inline TKey	SG_Grid_Index_Key		(TSG_Data_Type Type, double Value)
+{
+	switch( Type )
 	{
-		if( is_NoData(i) )
-		{
-			m_Index[--nData]	= i;
-		}
-		else // if( !is_NoData(i) )
-		{
-			m_Index[j++]	= i;
-		}
+	case SG_DATATYPE_Bit   : return( (TKey)(Value != 0.0 ? 1 : 0) );
+	case SG_DATATYPE_Byte  : return( (TKey)(BYTE )Value );
+	case SG_DATATYPE_Char  : return( (TKey)(BYTE )((int  )Value + 0x80) );
+	case SG_DATATYPE_Word  : return( (TKey)(WORD )Value );
+	case SG_DATATYPE_Short : return( (TKey)(WORD )((int  )Value + 0x8000) );
+	case SG_DATATYPE_DWord : return( (TKey)(DWORD)Value );
+	case SG_DATATYPE_Int   : return( (TKey)(DWORD)((sLong)Value + 0x80000000LL) );
+	case SG_DATATYPE_Float : return( (TKey)SG_Grid_Index_Key_Float((float)Value) );
+	default                : return( (TKey)SG_Grid_Index_Key_Double(Value) );
 	}
+}
+
+//---------------------------------------------------------
+template <typename TKey, typename TIndex>
+static bool			SG_Grid_Index_Radix_Sort(TKey *Keys, TIndex *Index, sLong n)
+{
+	TKey	*tKeys	= (TKey   *)SG_Malloc((size_t)n * sizeof(TKey  ));
+	TIndex	*tIndex	= (TIndex *)SG_Malloc((size_t)n * sizeof(TIndex));
 
-	if( nData <= 0 )
+	if( !tKeys || !tIndex )
 	{
-	//	SG_FREE_SAFE(m_Index);
+		SG_FREE_SAFE(tKeys); SG_FREE_SAFE(tIndex);
 
-		return( false );	// nothing to do
+		return( false );
 	}
 
 	//-----------------------------------------------------
-	l		= 0;
-	n		= 0;
-	ir		= nData - 1;
+	int	nThreads	= n < 0x10000 ? 1 : SG_OMP_Get_Max_Num_Threads();
 
-	nstack	= 64;
-	istack	= (sLong *)SG_Malloc((size_t)nstack * sizeof(sLong));
-	jstack	= 0;
+	CSG_Array	Count(sizeof(sLong), 256 * nThreads);	sLong	*Counts	= (sLong *)Count.Get_Array();
 
-	for(;;)
+	TKey	*pKeys	= Keys , *pKeys_t	= tKeys ;
+	TIndex	*pIndex	= Index, *pIndex_t	= tIndex;
+
+	bool	bResult	= true;
+
+	for(int Pass=0, Shift=0; bResult && Pass<(int)sizeof(TKey); Pass++, Shift+=8)
 	{
-		if( ir - l < M )
-		{
-			if( !SG_UI_Process_Set_Progress((double)(n += M - 1), (double)nData) )
-			{
-				SG_FREE_SAFE(istack);
-				SG_FREE_SAFE(m_Index);
+		bResult	= SG_UI_Process_Set_Progress(Pass, sizeof(TKey));
 
-				SG_UI_Msg_Add_Error(_TL("index creation stopped by user"));
-				SG_UI_Process_Set_Ready();
+		memset(Counts, 0, 256 * nThreads * sizeof(sLong));
 
-				return( false );
-			}
+		#pragma omp parallel for num_threads(nThreads)
+		for(int iThread=0; iThread<nThreads; iThread++)
+		{
+			sLong	*c	= Counts + 256 * iThread;
 
-			for(j=l+1; j<=ir; j++)
+			for(sLong i=n*iThread/nThreads, j=n*(iThread+1)/nThreads; i<j; i++)
 			{
-				indxt	= m_Index[j];
-				a		= asDouble(indxt);
-
-				for(i=j-1; i>=0; i--)
-				{
-					if( asDouble(m_Index[i]) <= a )
-					{
-						break;
-					}
+				c[(pKeys[i] >> Shift) & 0xFF]++;
+			}
+		}
 
-					m_Index[i + 1]	= m_Index[i];
-				}
+		//-------------------------------------------------
+		bool	bSkip	= false;	sLong	Offset	= 0;
 
-				m_Index[i + 1]	= indxt;
-			}
+		for(int Digit=0; !bSkip && Digit<256; Digit++)
+		{
+			sLong	nDigit	= Offset;
 
-			if( jstack == 0 )
+			for(int iThread=0; iThread<nThreads; iThread++)
 			{
-				break;
+				sLong	c	= Counts[256 * iThread + Digit];	Counts[256 * iThread + Digit]	= Offset;	Offset	+= c;
 			}
 
-			ir		= istack[jstack--];
-			l		= istack[jstack--];
+			bSkip	= Offset - nDigit == n;	// all keys share this digit, nothing to do
 		}
 
-		//-------------------------------------------------
-		else
+		if( bSkip )
 		{
-			#define SORT_SWAP(a,b)	{itemp=(a);(a)=(b);(b)=itemp;}
+			continue;
+		}
 
-			k		= (l + ir) >> 1;
+		//-------------------------------------------------
+		#pragma omp parallel for num_threads(nThreads)
+		for(int iThread=0; iThread<nThreads; iThread++)
+		{
+			sLong	*c	= Counts + 256 * iThread;
 
-			SORT_SWAP(m_Index[k], m_Index[l + 1]);
+			for(sLong i=n*iThread/nThreads, j=n*(iThread+1)/nThreads; i<j; i++)
+			{
+				sLong	k	= c[(pKeys[i] >> Shift) & 0xFF]++;
 
-			if( asDouble( m_Index[l + 1]) > asDouble(m_Index[ir]) )
-				SORT_SWAP(m_Index[l + 1],            m_Index[ir]);
+				pKeys_t [k]	= pKeys [i];
+				pIndex_t[k]	= pIndex[i];
+			}
+		}
 
-			if( asDouble( m_Index[l    ]) > asDouble(m_Index[ir]) )
-				SORT_SWAP(m_Index[l    ],            m_Index[ir]);
+		TKey	*p	= pKeys ; pKeys  = pKeys_t ; pKeys_t  = p;
+		TIndex	*q	= pIndex; pIndex = pIndex_t; pIndex_t = q;
+	}
 
-			if( asDouble( m_Index[l + 1]) > asDouble(m_Index[l ]) )
-				SORT_SWAP(m_Index[l + 1],            m_Index[l ]);
+	//-----------------------------------------------------
+	if( bResult && pIndex != Index )
+	{
+		memcpy(Index, pIndex, (size_t)n * sizeof(TIndex));
+	}
 
-			i		= l + 1;
-			j		= ir;
-			indxt	= m_Index[l];
-			a		= asDouble(indxt);
+	SG_Free(tKeys);
+	SG_Free(tIndex);
 
-			for(;;)
-			{
-				do	i++;	while(asDouble(m_Index[i]) < a);
-				do	j--;	while(asDouble(m_Index[j]) > a);
+	return( bResult );
+}
 
-				if( j < i )
-				{
-					break;
-				}
+//---------------------------------------------------------
+template <typename TKey, typename TIndex>
+static bool			SG_Grid_Index_Create	(CSG_Grid *pGrid, TIndex *Index, sLong &nData)
+{
+	int	nx	= pGrid->Get_NX(), ny = pGrid->Get_NY();
 
-				SORT_SWAP(m_Index[i], m_Index[j]);
-			}
+	//-----------------------------------------------------
+	CSG_Array	Rows(sizeof(sLong), ny + 1);	sLong	*nRowData	= (sLong *)Rows.Get_Array();	// data cells before row y
 
-			#undef SORT_SWAP
+	nRowData[0]	= 0;
 
-			m_Index[l]	= m_Index[j];
-			m_Index[j]	= indxt;
-			jstack		+= 2;
+	#pragma omp parallel for
+	for(int y=0; y<ny; y++)
+	{
+		sLong	n	= 0;
 
-			if( jstack >= nstack )
+		for(int x=0; x<nx; x++)
+		{
+			if( !pGrid->is_NoData(x, y) )
 			{
-				nstack	+= 64;
-				istack	= (sLong *)SG_Realloc(istack, (size_t)nstack * sizeof(int));
+				n++;
 			}
+		}
+
+		nRowData[y + 1]	= n;
+	}
+
+	for(int y=0; y<ny; y++)
+	{
+		nRowData[y + 1]	+= nRowData[y];
+	}
+
+	if( (nData = nRowData[ny]) <= 0 )
+	{
+		return( true );	// nothing to do
+	}
+
+	//-----------------------------------------------------
+	TKey	*Keys	= (TKey *)SG_Malloc((size_t)nData * sizeof(TKey));
+
+	if( !Keys )
+	{
+		return( false );
+	}
+
+	TSG_Data_Type	Type	= pGrid->Get_Type();	bool	bInvert	= pGrid->Get_Scaling() < 0.0;
+
+	sLong	nCells	= pGrid->Get_NCells();
+
+	#pragma omp parallel for
+	for(int y=0; y<ny; y++)
+	{
+		sLong	i	= (sLong)y * nx, iData = nRowData[y], iNoData = nCells - 1 - (i - iData);
+
+		for(int x=0; x<nx; x++, i++)
+		{
+			double	Value	= pGrid->asDouble(x, y, false);
 
-			if( ir - i + 1 >= j - l )
+			if( pGrid->is_NoData_Value(Value) )
 			{
-				istack[jstack]		= ir;
-				istack[jstack - 1]	= i;
-				ir					= j - 1;
+				Index[iNoData--]	= (TIndex)i;
 			}
 			else
 			{
-				istack[jstack]		= j - 1;
-				istack[jstack - 1]	= l;
-				l					= i;
+				TKey	Key	= SG_Grid_Index_Key<TKey>(Type, Value);
+
+				Keys [iData]	= bInvert ? (TKey)~Key : Key;
+				Index[iData++]	= (TIndex)i;
 			}
 		}
 	}
 
 	//-----------------------------------------------------
-	SG_Free(istack);
+	bool	bResult	= SG_Grid_Index_Radix_Sort(Keys, Index, nData);
+
+	SG_Free(Keys);
+
+	return( bResult );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid::_Set_Index(void)
+{
+	//-----------------------------------------------------
+	if( m_Index == NULL && (m_Index = SG_Malloc((size_t)Get_NCells() * (_is_Index32() ? sizeof(DWORD) : sizeof(sLong)))) == NULL )
+	{
+		SG_UI_Msg_Add_Error(_TL("could not create index: insufficient memory"));
+
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	SG_UI_Process_Set_Text(CSG_String::Format("%s: %s", _TL("Create index"), Get_Name()));
+
+	bool	bResult;	sLong	nData	= 0;
+
+	switch( Get_nValueBytes() )
+	{
+	case  0:	// bit
+	case  1: bResult = _is_Index32()
+		? SG_Grid_Index_Create<BYTE , DWORD>(this, (DWORD *)m_Index, nData)
+		: SG_Grid_Index_Create<BYTE , sLong>(this, (sLong *)m_Index, nData);
+		break;
+
+	case  2: bResult = _is_Index32()
+		? SG_Grid_Index_Create<WORD , DWORD>(this, (DWORD *)m_Index, nData)
+		: SG_Grid_Index_Create<WORD , sLong>(this, (sLong *)m_Index, nData);
+		break;
+
+	case  4: bResult = _is_Index32()
+		? SG_Grid_Index_Create<DWORD, DWORD>(this, (DWORD *)m_Index, nData)
+		: SG_Grid_Index_Create<DWORD, sLong>(this, (sLong *)m_Index, nData);
+		break;
+
+	default: bResult = _is_Index32()
+		? SG_Grid_Index_Create<uLong, DWORD>(this, (DWORD *)m_Index, nData)
+		: SG_Grid_Index_Create<uLong, sLong>(this, (sLong *)m_Index, nData);
+		break;
+	}
 
 	SG_UI_Process_Set_Ready();
 
-	return( true );
+	//-----------------------------------------------------
+	if( !bResult )
+	{
+		SG_FREE_SAFE(m_Index);
+
+		SG_UI_Msg_Add_Error(_TL("index creation failed"));
+
+		return( false );
+	}
+
+	return( nData > 0 );
 }
 
 
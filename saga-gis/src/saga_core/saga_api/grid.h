@@ -115,6 +115,8 @@ typedef enum ESG_Grid_File_Key
 	GRID_FILE_KEY_Z_OFFSET,
 	GRID_FILE_KEY_NODATA_VALUE,
 	GRID_FILE_KEY_TOPTOBOTTOM,
+	GRID_FILE_KEY_TILE_SIZE,
+	GRID_FILE_KEY_TILE_LEVELS,
 	GRID_FILE_KEY_Count
 }
 TSG_Grid_File_Key;
@@ -137,7 +139,9 @@ const SG_Char	gSG_Grid_File_Key_Names[GRID_FILE_KEY_Count][32]	=
 	SG_T("Z_FACTOR"),
 	SG_T("Z_OFFSET"),
 	SG_T("NODATA_VALUE"),
-	SG_T("TOPTOBOTTOM")
+	SG_T("TOPTOBOTTOM"),
+	SG_T("TILE_SIZE"),
+	SG_T("TILE_LEVELS")
 };
 
 //---------------------------------------------------------
@@ -436,6 +440,8 @@ public:		///////////////////////////////////////////////
 	//-----------------------------------------------------
 	bool						m_bFlip, m_bSwapBytes;
 
+	int							m_Tile_Size, m_Tile_Levels;
+
 	sLong						m_Offset;
 
 	double						m_zScale, m_zOffset, m_NoData[2];
@@ -482,6 +488,7 @@ public:		///////////////////////////////////////////////
 
 									CSG_Grid		(const CSG_String &FileName   , TSG_Data_Type Type = SG_DATATYPE_Undefined, bool bCached = false, bool bLoadData = true);
 	bool							Create			(const CSG_String &FileName   , TSG_Data_Type Type = SG_DATATYPE_Undefined, bool bCached = false, bool bLoadData = true);
+	bool							Create			(const CSG_String &FileName   , const CSG_Rect &Extent, int Level = 0, bool bCached = false);
 
 									CSG_Grid		(CSG_Grid *pGrid              , TSG_Data_Type Type = SG_DATATYPE_Undefined, bool bCached = false);
 	bool							Create			(CSG_Grid *pGrid              , TSG_Data_Type Type = SG_DATATYPE_Undefined, bool bCached = false);
@@ -659,7 +666,7 @@ public:		///////////////////////////////////////////////
 	{
 		if( Position >= 0 && Position < Get_NCells() && _Get_Index() )
 		{
-			Position	= m_Index[bDown ? Get_NCells() - Position - 1 : Position];
+			Position	= _Get_Index_Cell(bDown ? Get_NCells() - Position - 1 : Position);
 
 			if( !bCheckNoData || !is_NoData(Position) )
 			{
@@ -845,6 +852,8 @@ public:		///////////////////////////////////////////////
 				return;
 		}
 
+		_Stats_Set_Dirty(y);
+
 		Set_Modified();
 	}
 
@@ -852,6 +861,10 @@ public:		///////////////////////////////////////////////
 	CSG_Vector					Get_Row					(int y)	const;
 	bool						Set_Row					(int y, const CSG_Vector &Values);
 
+	// Copy a row's values in the grid's own data type and memory layout (Get_nLineBytes()), without scaling. Safe to be called in parallel for different rows.
+	bool						Get_Line				(int y,       void *Values)	const;
+	bool						Set_Line				(int y, const void *Values);
+
 
 //---------------------------------------------------------
 protected:	///////////////////////////////////////////////
@@ -870,17 +883,23 @@ private:	///////////////////////////////////////////////
 
 	size_t						m_nBytes_Value, m_nBytes_Line;
 
-	sLong						*m_Index, m_Cache_Offset;
+	sLong						m_Cache_Offset;
 
 	double						m_zOffset, m_zScale;
 
 	FILE						*m_Cache_Stream;
 
+	void						*m_Cache_Blocks, *m_Index;
+
 	TSG_Data_Type				m_Type;
 
 	CSG_String					m_Unit, m_Cache_File;
 
-	CSG_Simple_Statistics		m_Statistics;
+	CSG_Simple_Statistics		m_Statistics, *m_Stats_Blocks;
+
+	BYTE						*m_Stats_Dirty;
+
+	double						m_Stats_Key[4];
 
 	CSG_Histogram				m_Histogram;
 
@@ -896,6 +915,25 @@ private:	///////////////////////////////////////////////
 
 	void						_Set_Properties			(TSG_Data_Type Type, int NX, int NY, double Cellsize, double xMin, double yMin);
 
+	//-----------------------------------------------------
+	// Statistics are kept for blocks of 32 rows. Writing a
+	// value flags its block, so that an update only needs to
+	// re-scan the flagged blocks.
+
+	int							_Stats_Get_Block_Count	(void)	const	{	return( (Get_NY() + 31) >> 5 );	}
+
+	void						_Stats_Set_Dirty		(int y)
+	{
+		if( m_Stats_Dirty )
+		{
+			m_Stats_Dirty[y >> 5]	= 1;
+		}
+	}
+
+	void						_Stats_Set_Dirty		(void);
+	void						_Stats_Destroy			(void);
+
+	//-----------------------------------------------------
 	bool						_Set_Index				(void);
 	bool						_Get_Index				(void)
 	{
@@ -907,6 +945,16 @@ private:	///////////////////////////////////////////////
 		return( m_Index || _Set_Index() );
 	}
 
+	//-----------------------------------------------------
+	// The index uses 32bit integers if the number of cells allows it.
+
+	bool						_is_Index32				(void)	const	{	return( Get_NCells() <= 0xFFFFFFFFLL );	}
+
+	sLong						_Get_Index_Cell			(sLong i)	const
+	{
+		return( _is_Index32() ? (sLong)((DWORD *)m_Index)[i] : ((sLong *)m_Index)[i] );
+	}
+
 
 	//-----------------------------------------------------
 	// Memory handling...
@@ -924,6 +972,13 @@ private:	///////////////////////////////////////////////
 	void						_Cache_Set_Value		(int x, int y, double Value);
 	double						_Cache_Get_Value		(int x, int y)	const;
 
+	bool						_Cache_Blocks_Create	(void);
+	void						_Cache_Blocks_Destroy	(void);
+	bool						_Cache_Blocks_Flush		(void)			const;
+	bool						_Cache_Block_Load		(int iBlock)	const;
+	bool						_Cache_Block_Save		(int iBlock)	const;
+	char *						_Cache_Get_Line			(int y, bool bModify)	const;
+
 
 	//-----------------------------------------------------
 	// File access...
@@ -938,6 +993,8 @@ private:	///////////////////////////////////////////////
 
 	bool						_Load_Compressed		(const CSG_String &FileName, bool bCached, bool bLoadData);
 	bool						_Save_Compressed		(const CSG_String &FileName);
+	bool						_Load_Tiles				(const CSG_String &Archive, const CSG_String &FileName, const CSG_Grid_File_Info &Info, int Level, int xOffset, int yOffset);
+	bool						_Save_Tiles				(CSG_File_Zip &Stream, const CSG_String &FileName, int Tile_Size, int nLevels);
 
 	bool						_Load_Binary			(CSG_File &Stream, TSG_Data_Type File_Type, bool bFlip, bool bSwapBytes);
 	bool						_Save_Binary			(CSG_File &Stream, TSG_Data_Type File_Type, bool bFlip, bool bSwapBytes);
@@ -1013,7 +1070,10 @@ SAGA_API_DLL_EXPORT void			SG_Grid_Cache_Set_Directory		(const SG_Char *Director
 SAGA_API_DLL_EXPORT void			SG_Grid_Cache_Set_Mode			(int Mode);
 SAGA_API_DLL_EXPORT int				SG_Grid_Cache_Get_Mode			(void);
 
-SAGA_API_DLL_EXPORT void			SG_Grid_Cache_Set_Threshold		(int nBytes);
+/** Grids exceeding the threshold size will be cached (if caching mode is on).
+  * For cached grids the threshold also defines the amount of memory that is
+  * used to hold recently accessed row blocks resident. */
+SAGA_API_DLL_EXPORT void			SG_Grid_Cache_Set_Threshold		(sLong nBytes);
 SAGA_API_DLL_EXPORT void			SG_Grid_Cache_Set_Threshold_MB	(double nMegabytes);
 SAGA_API_DLL_EXPORT sLong			SG_Grid_Cache_Get_Threshold		(void);
 SAGA_API_DLL_EXPORT double			SG_Grid_Cache_Get_Threshold_MB	(void);
@@ -1023,6 +1083,12 @@ SAGA_API_DLL_EXPORT bool					SG_Grid_Set_File_Format_Default		(int Format);
 SAGA_API_DLL_EXPORT TSG_Grid_File_Format	SG_Grid_Get_File_Format_Default		(void);
 SAGA_API_DLL_EXPORT CSG_String				SG_Grid_Get_File_Extension_Default	(void);
 
+/** Edge length of the tiles used by the compressed native grid
+  * format (sg-grd-z). A tile size of zero writes the untiled layout
+  * that can be read by older SAGA versions. */
+SAGA_API_DLL_EXPORT bool					SG_Grid_Set_File_Tile_Size			(int Size);
+SAGA_API_DLL_EXPORT int						SG_Grid_Get_File_Tile_Size			(void);
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -1123,21 +1189,20 @@ public:
 	double						Get_Direction		(void)						const	{	return( m_Direction );	}
 	double						Get_Tolerance		(void)						const	{	return( m_Tolerance );	}
 
-	int							Get_Count			(void)						const	{	return( m_Kernel.Get_Count() );	}
-	int							Get_X				(int Index, int Offset = 0)	const	{	return( Index >= 0 && Index < m_Kernel.Get_Count() ? m_Kernel[Index].asInt   (0) + Offset : Offset );	}
-	int							Get_Y				(int Index, int Offset = 0)	const	{	return( Index >= 0 && Index < m_Kernel.Get_Count() ? m_Kernel[Index].asInt   (1) + Offset : Offset );	}
-	double						Get_Distance		(int Index                )	const	{	return( Index >= 0 && Index < m_Kernel.Get_Count() ? m_Kernel[Index].asDouble(2)          : -1.    );	}
-	double						Get_Weight			(int Index                )	const	{	return( Index >= 0 && Index < m_Kernel.Get_Count() ? m_Kernel[Index].asDouble(3)          :  0.    );	}
+	int							Get_Count			(void)						const	{	return( m_nCells );	}
+	int							Get_Size			(void)						const	{	return( m_Size   );	}
+	int							Get_X				(int Index, int Offset = 0)	const	{	return( Index >= 0 && Index < m_nCells ? m_X.Get_Array()[Index] + Offset : Offset );	}
+	int							Get_Y				(int Index, int Offset = 0)	const	{	return( Index >= 0 && Index < m_nCells ? m_Y.Get_Array()[Index] + Offset : Offset );	}
+	double						Get_Distance		(int Index                )	const	{	return( Index >= 0 && Index < m_nCells ? m_Distance.Get_Data()[Index]        : -1.    );	}
+	double						Get_Weight			(int Index                )	const	{	return( Index >= 0 && Index < m_nCells ? m_Weight  .Get_Data()[Index]        :  0.    );	}
 	bool						Get_Values			(int Index, int &x, int &y, double &Distance, double &Weight, bool bOffset = false)	const
 	{
-		if( Index >= 0 && Index < m_Kernel.Get_Count() )
+		if( Index >= 0 && Index < m_nCells )
 		{
-			CSG_Table_Record	&Cell	= m_Kernel[Index];
-
-			x			= bOffset ? x + Cell.asInt(0) : Cell.asInt(0);
-			y			= bOffset ? y + Cell.asInt(1) : Cell.asInt(1);
-			Distance	= Cell.asDouble(2);
-			Weight		= Cell.asDouble(3);
+			x			= bOffset ? x + m_X.Get_Array()[Index] : m_X.Get_Array()[Index];
+			y			= bOffset ? y + m_Y.Get_Array()[Index] : m_Y.Get_Array()[Index];
+			Distance	= m_Distance.Get_Data()[Index];
+			Weight		= m_Weight  .Get_Data()[Index];
 
 			return( true );
 		}
@@ -1145,16 +1210,28 @@ public:
 		return( false );
 	}
 
+	const int *					Get_X				(void)						const	{	return( m_X.Get_Array() );	}
+	const int *					Get_Y				(void)						const	{	return( m_Y.Get_Array() );	}
+	const double *				Get_Distance		(void)						const	{	return( m_Distance.Get_Data() );	}
+	const double *				Get_Weight			(void)						const	{	return( m_Weight  .Get_Data() );	}
+
+	bool						is_Separable		(void)						const;
+	bool						Get_Separable		(CSG_Vector &Weights)		const;
+
+	bool						Get_Sliding			(CSG_Array_Int &Out, CSG_Array_Int &In)	const;
+
 
 private:
 
-	int							m_Type;
+	int							m_Type, m_nCells, m_Size;
 
 	double						m_Radius, m_Radius_0, m_Direction, m_Tolerance;
 
 	CSG_Distance_Weighting		m_Weighting;
 
-	CSG_Table					m_Kernel;
+	CSG_Array_Int				m_X, m_Y;
+
+	CSG_Vector					m_Distance, m_Weight;
 
 
 	bool						_Set_Kernel			(int Type, double Radius, double Radius_Inner, double Direction, double Tolerance);
@@ -1162,6 +1239,184 @@ private:
 };
 
 
+///////////////////////////////////////////////////////////
+//														 //
+//					Grid Focal Tiles					 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+* CSG_Grid_Focal_Tile holds a rectangular part of a grid
+* together with a halo of Get_Halo() cells on each side as
+* plain double values, so that focal operations read all the
+* kernel cells of the tile's cells without range and no-data
+* checks. No-data cells and cells outside the grid are NaN.
+* Optionally the tile keeps for each cell the rank of its
+* value among the distinct values of the tile (-1 for no-data),
+* which allows exact sliding window histograms also for
+* floating point values (see CSG_Grid_Focal_Histogram).
+* Tiles are loaded with CSG_Grid_Focal_Tiles::Get_Tile().
+*/
+//---------------------------------------------------------
+class SAGA_API_DLL_EXPORT CSG_Grid_Focal_Tile
+{
+	friend class CSG_Grid_Focal_Tiles;
+
+public:
+	CSG_Grid_Focal_Tile(void);
+
+	int							Get_Halo			(void)	const	{	return( m_Halo );	}
+	int							Get_xMin			(void)	const	{	return( m_xMin );	}
+	int							Get_yMin			(void)	const	{	return( m_yMin );	}
+	int							Get_xMax			(void)	const	{	return( m_xMin + m_NX - 1 );	}
+	int							Get_yMax			(void)	const	{	return( m_yMin + m_NY - 1 );	}
+	int							Get_NX				(void)	const	{	return( m_NX );		}
+	int							Get_NY				(void)	const	{	return( m_NY );		}
+
+	static bool					is_NoData			(double Value)	{	return( SG_is_NaN(Value) );	}
+
+	/// Returns row y (grid coordinates) of the tile, which has to be indexed with grid column coordinates from Get_xMin() - Get_Halo() to Get_xMax() + Get_Halo().
+	const double *				Get_Row				(int y)			const	{	return( m_Values.Get_Data() + (sLong)(y - m_yMin + m_Halo) * m_Stride + m_Halo - m_xMin );	}
+	double						Get_Value			(int x, int y)	const	{	return( Get_Row(y)[x] );	}
+
+	int							Get_Rank_Count		(void)			const	{	return( (int)m_Rank_Values.Get_N() );	}
+	double						Get_Rank_Value		(int Rank)		const	{	return( m_Rank_Values.Get_Data()[Rank] );	}
+	const int *					Get_Rank_Row		(int y)			const	{	return( m_Ranks.Get_Array() + (sLong)(y - m_yMin + m_Halo) * m_Stride + m_Halo - m_xMin );	}
+
+
+private:
+
+	int							m_xMin, m_yMin, m_NX, m_NY, m_Halo, m_Stride;
+
+	CSG_Array_Int				m_Ranks;
+
+	CSG_Vector					m_Values, m_Rank_Values;
+
+};
+
+//---------------------------------------------------------
+/**
+* CSG_Grid_Focal_Tiles splits a grid into square tiles for
+* focal operations with kernels of up to Halo cells radius.
+* The tile size defaults to twice the halo, but at least 128
+* cells, which keeps the halo overhead and the memory needed
+* per tile bounded. Tiles can be processed in parallel, each
+* thread loading them into its own CSG_Grid_Focal_Tile.
+*/
+//---------------------------------------------------------
+class SAGA_API_DLL_EXPORT CSG_Grid_Focal_Tiles
+{
+public:
+	CSG_Grid_Focal_Tiles(void);
+	CSG_Grid_Focal_Tiles(const CSG_Grid *pGrid, int Halo, int Size = 0);
+	bool						Create				(const CSG_Grid *pGrid, int Halo, int Size = 0);
+
+	int							Get_Count			(void)	const	{	return( m_nx * m_ny );	}
+	int							Get_Halo			(void)	const	{	return( m_Halo );	}
+	int							Get_Size			(void)	const	{	return( m_Size );	}
+
+	bool						Get_Tile			(int iTile, CSG_Grid_Focal_Tile &Tile, bool bRanks = false)	const;
+
+
+private:
+
+	int							m_Halo, m_Size, m_nx, m_ny;
+
+	const CSG_Grid				*m_pGrid;
+
+};
+
+//---------------------------------------------------------
+/**
+* Histogram of value ranks (see CSG_Grid_Focal_Tile) for
+* sliding window operations. Adding and removing a value
+* costs O(log n) for n ranks, the k-th smallest rank is found
+* in O(log n) and the highest class count in O(1). Negative
+* ranks (no-data) are ignored.
+*/
+//---------------------------------------------------------
+class SAGA_API_DLL_EXPORT CSG_Grid_Focal_Histogram
+{
+public:
+	CSG_Grid_Focal_Histogram(void);
+
+	bool						Create				(int nRanks);
+
+	void						Add					(int Rank);
+	void						Del					(int Rank);
+
+	int							Get_Count			(void)		const	{	return( m_nTotal );	}
+	int							Get_Count			(int Rank)	const	{	return( m_Count.Get_Array()[Rank] );	}
+	int							Get_Count_Max		(void)		const	{	return( m_nMax );	}
+	int							Get_Count_Min		(void)		const;
+
+	int							Get_Rank			(int k)		const;
+
+
+private:
+
+	int							m_nRanks, m_nTotal, m_nMax, m_Step;
+
+	CSG_Array_Int				m_Count, m_Tree, m_nCounts;
+
+};
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//				Grid Polygon Coverage					 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+* CSG_Grid_Polygon_Coverage is a scanline rasteriser that
+* calculates the exact fraction of each grid cell covered by
+* a polygon. The polygon's edges are assigned to the rows
+* they cross once, so that Get_Row() only needs to walk the
+* few edges crossing a row, whatever the polygon's vertex
+* count is. Alternatively Get_Row() tells which cells have
+* their centers inside the polygon. Rows can be requested
+* in any order and from several threads.
+*/
+//---------------------------------------------------------
+class SAGA_API_DLL_EXPORT CSG_Grid_Polygon_Coverage
+{
+public:
+	CSG_Grid_Polygon_Coverage(void);
+	CSG_Grid_Polygon_Coverage(const CSG_Grid_System &System, class CSG_Shape_Polygon *pPolygon);
+	bool						Create				(const CSG_Grid_System &System, class CSG_Shape_Polygon *pPolygon);
+
+	bool						Destroy				(void);
+
+	bool						is_Valid			(void)	const	{	return( m_xMin <= m_xMax && m_yMin <= m_yMax );	}
+
+	int							Get_xMin			(void)	const	{	return( m_xMin );	}
+	int							Get_xMax			(void)	const	{	return( m_xMax );	}
+	int							Get_yMin			(void)	const	{	return( m_yMin );	}
+	int							Get_yMax			(void)	const	{	return( m_yMax );	}
+	int							Get_NX				(void)	const	{	return( m_xMax - m_xMin + 1 );	}
+
+	bool						Get_Row				(int y, double *Coverage, bool bCenters = false)	const;
+
+
+private:
+
+	typedef struct
+	{
+		double					ax, ay, bx, by, Sign;
+	}
+	TEdge;
+
+	int							m_xMin, m_xMax, m_yMin, m_yMax;
+
+	CSG_Array					m_Edges;
+
+	CSG_Array_Int				m_Row_First, m_Row_Edges;
+
+};
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
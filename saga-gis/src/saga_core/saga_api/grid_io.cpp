@@ -125,6 +125,28 @@ TSG_Grid_File_Format	SG_Grid_Get_File_Format_Default	(void)
 	return( gSG_Grid_File_Format_Default );
 }
 
+//---------------------------------------------------------
+static int				gSG_Grid_File_Tile_Size			= 0;	// no tiles, readable by all versions
+
+//---------------------------------------------------------
+bool					SG_Grid_Set_File_Tile_Size		(int Size)
+{
+	if( Size == 0 || (Size >= 16 && Size <= 4096) )
+	{
+		gSG_Grid_File_Tile_Size	= Size;
+
+		return( true );
+	}
+
+	return( false );
+}
+
+//---------------------------------------------------------
+int						SG_Grid_Get_File_Tile_Size		(void)
+{
+	return( gSG_Grid_File_Tile_Size );
+}
+
 //---------------------------------------------------------
 CSG_String				SG_Grid_Get_File_Extension_Default	(void)
 {
@@ -493,45 +515,147 @@ bool CSG_Grid::_Save_Native(const CSG_String &_FileName, TSG_Grid_File_Format Fo
 
 ///////////////////////////////////////////////////////////
 //														 //
+//														 //
 //						Compressed						 //
 //														 //
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-bool CSG_Grid::_Load_Compressed(const CSG_String &_FileName, bool bCached, bool bLoadData)
+// The compressed native format stores the grid header and
+// its data as entries of a zip archive. If a tile size has
+// been set with SG_Grid_Set_File_Tile_Size() the data is not
+// stored as one single entry but split into square tiles,
+// each being a separately compressed archive entry. Tiled
+// archives cannot be read by SAGA versions that do not know
+// about tiles, so the default tile size is zero (no tiles). The archive's central directory serves as
+// tile index, which allows random access to the tiles of a
+// given window and parallel decompression. Tiles are stored
+// for the original resolution (level 0) and for a pyramid of
+// overviews, each level halving the resolution of the
+// previous one until it fits into a single tile.
+//---------------------------------------------------------
+static bool SG_Grid_Zip_Get_Header(CSG_File_Zip &Stream, const CSG_String &Archive, CSG_String &FileName)
 {
-	Set_File_Name(_FileName, true);
+	FileName	= SG_File_Get_Name(Archive, false) + ".";
 
-	CSG_File_Zip	Stream(_FileName, SG_FILE_R);
+	if( Stream.Get_File(FileName + "sgrd"  )
+	||  Stream.Get_File(FileName + "sg-grd") )
+	{
+		return( true );
+	}
 
-	if( !Stream.is_Reading() )
+	for(size_t i=0; i<Stream.Get_File_Count(); i++)
+	{
+		if( SG_File_Cmp_Extension(Stream.Get_File_Name(i), "sgrd"  )
+		||  SG_File_Cmp_Extension(Stream.Get_File_Name(i), "sg-grd") )
+		{
+			FileName	= SG_File_Get_Name(Stream.Get_File_Name(i), false) + ".";
+
+			return( Stream.Get_File(i) );
+		}
+	}
+
+	FileName.Clear();
+
+	return( false );
+}
+
+//---------------------------------------------------------
+static int SG_Grid_Tiles_Get_Levels(const CSG_Grid_System &System, int Tile_Size)
+{
+	int	nLevels	= 0;
+
+	for(int NX=System.Get_NX(), NY=System.Get_NY(); nLevels<16 && (NX > Tile_Size || NY > Tile_Size); nLevels++)
+	{
+		NX	= 1 + (NX - 1) / 2;
+		NY	= 1 + (NY - 1) / 2;
+	}
+
+	return( nLevels );
+}
+
+//---------------------------------------------------------
+static CSG_Grid_System SG_Grid_Tiles_Get_System(const CSG_Grid_System &System, int Level)
+{
+	if( Level < 1 )
+	{
+		return( System );
+	}
+
+	int		Scale		= 1 << Level;
+
+	double	Cellsize	= Scale * System.Get_Cellsize(), Shift = 0.5 * (Cellsize - System.Get_Cellsize());
+
+	return( CSG_Grid_System(Cellsize, System.Get_XMin() + Shift, System.Get_YMin() + Shift,
+		1 + (System.Get_NX() - 1) / Scale,
+		1 + (System.Get_NY() - 1) / Scale
+	));
+}
+
+//---------------------------------------------------------
+static CSG_String SG_Grid_Tiles_Get_Name(const CSG_String &FileName, int Level, int yTile, int xTile)
+{
+	return( FileName + CSG_String::Format("tile_%d_%d_%d", Level, yTile, xTile) );
+}
+
+//---------------------------------------------------------
+/** Maps each tile of the given level to the index of its archive
+  * entry, so that tiles can be opened without searching the
+  * archive's entries by name. Missing tiles are marked with -1.
+*/
+static bool SG_Grid_Tiles_Get_Index(CSG_File_Zip &Stream, const CSG_String &FileName, int Level, int nx, int ny, CSG_Array_Int &Index)
+{
+	if( !Index.Create((size_t)nx * ny) )
 	{
 		return( false );
 	}
 
-	//-----------------------------------------------------
-	CSG_String	FileName(SG_File_Get_Name(_FileName, false) + ".");
+	for(size_t i=0; i<Index.Get_Size(); i++)
+	{
+		Index[i]	= -1;
+	}
 
-	if( !Stream.Get_File(FileName + "sgrd"  )
-	&&  !Stream.Get_File(FileName + "sg-grd") )
+	CSG_String	Prefix(FileName + CSG_String::Format("tile_%d_", Level));
+
+	for(size_t i=0; i<Stream.Get_File_Count(); i++)
 	{
-		FileName.Clear();
+		CSG_String	Name(Stream.Get_File_Name(i));
 
-		for(size_t i=0; i<Stream.Get_File_Count(); i++)
+		if( Name.Find(Prefix) == 0 )
 		{
-			if( SG_File_Cmp_Extension(Stream.Get_File_Name(i), "sgrd"  )
-			||  SG_File_Cmp_Extension(Stream.Get_File_Name(i), "sg-grd") )
+			Name	= Name.Right(Name.Length() - Prefix.Length());
+
+			int	y	= Name.BeforeFirst('_').asInt();
+			int	x	= Name.AfterFirst ('_').asInt();
+
+			if( x >= 0 && x < nx && y >= 0 && y < ny )
 			{
-				FileName	= SG_File_Get_Name(Stream.Get_File_Name(i), false) + ".";
-				Stream.Get_File(Stream.Get_File_Name(i));
-				break;
+				Index[(size_t)y * nx + x]	= (int)i;
 			}
 		}
+	}
 
-		if( FileName.is_Empty() )
-		{
-			return( false );
-		}
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid::_Load_Compressed(const CSG_String &_FileName, bool bCached, bool bLoadData)
+{
+	Set_File_Name(_FileName, true);
+
+	CSG_File_Zip	Stream(_FileName, SG_FILE_R);
+
+	if( !Stream.is_Reading() )
+	{
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	CSG_String	FileName;
+
+	if( !SG_Grid_Zip_Get_Header(Stream, _FileName, FileName) )
+	{
+		return( false );
 	}
 
 	//-----------------------------------------------------
@@ -577,6 +701,11 @@ bool CSG_Grid::_Load_Compressed(const CSG_String &_FileName, bool bCached, bool
 		bCached	= true;
 	}
 
+	if( Info.m_Tile_Size > 0 )
+	{
+		return( _Memory_Create(bCached) && _Load_Tiles(_FileName, FileName, Info, 0, 0, 0) );
+	}
+
 	return( Stream.Get_File(FileName + "sdat") && _Memory_Create(bCached)
 		&& _Load_Binary(Stream, m_Type, Info.m_bFlip, Info.m_bSwapBytes)
 	);
@@ -599,20 +728,351 @@ bool CSG_Grid::_Save_Compressed(const CSG_String &_FileName)
 
 		CSG_Grid_File_Info	Info(*this);
 
-		if( Stream.Add_File(FileName + "sgrd") && Info.Save(Stream, true)
-		&&  Stream.Add_File(FileName + "sdat") && _Save_Binary(Stream, m_Type, false, bBigEndian) )
+		if( gSG_Grid_File_Tile_Size > 0 && m_Type != SG_DATATYPE_Bit )
 		{
-			Stream.Add_File(FileName + "mgrd"        ); Save_MetaData(Stream);
-			Stream.Add_File(FileName + "prj"         ); Get_Projection().Save(Stream, SG_PROJ_FMT_WKT);
-			Stream.Add_File(FileName + "sdat.aux.xml"); Info.Save_AUX_XML(Stream);
+			Info.m_Tile_Size	= gSG_Grid_File_Tile_Size;
+			Info.m_Tile_Levels	= SG_Grid_Tiles_Get_Levels(Get_System(), Info.m_Tile_Size);
 
-			return( true );
+			if( !Stream.Add_File(FileName + "sgrd") || !Info.Save(Stream, true)
+			||  !_Save_Tiles(Stream, FileName, Info.m_Tile_Size, Info.m_Tile_Levels) )
+			{
+				return( false );
+			}
 		}
+		else if( !Stream.Add_File(FileName + "sgrd") || !Info.Save(Stream, true)
+			 ||  !Stream.Add_File(FileName + "sdat") || !_Save_Binary(Stream, m_Type, false, bBigEndian) )
+		{
+			return( false );
+		}
+
+		Stream.Add_File(FileName + "mgrd"        ); Save_MetaData(Stream);
+		Stream.Add_File(FileName + "prj"         ); Get_Projection().Save(Stream, SG_PROJ_FMT_WKT);
+		Stream.Add_File(FileName + "sdat.aux.xml"); Info.Save_AUX_XML(Stream);
+
+		return( true );
 	}
 
 	return( false );
 }
 
+//---------------------------------------------------------
+/** Reads the tiles of the given pyramid level that intersect
+  * with this grid, whose lower left cell is located at the
+  * level's cell position given by xOffset and yOffset. Each
+  * thread decompresses its own tiles through its own archive
+  * handle. Tiles are written directly into the row buffers
+  * of in-memory grids, cached grids are filled sequentially.
+*/
+//---------------------------------------------------------
+bool CSG_Grid::_Load_Tiles(const CSG_String &Archive, const CSG_String &FileName, const CSG_Grid_File_Info &Info, int Level, int xOffset, int yOffset)
+{
+	CSG_Grid_System	System(SG_Grid_Tiles_Get_System(Info.m_System, Level));
+
+	int	Size	= Info.m_Tile_Size;
+	int	nx		= 1 + (System.Get_NX() - 1) / Size;
+	int	ny		= 1 + (System.Get_NY() - 1) / Size;
+
+	CSG_Array_Int	Index;
+
+	{
+		CSG_File_Zip	Stream(Archive, SG_FILE_R);
+
+		if( !Stream.is_Reading() || !SG_Grid_Tiles_Get_Index(Stream, FileName, Level, nx, ny, Index) )
+		{
+			return( false );
+		}
+	}
+
+	//-----------------------------------------------------
+	int	ax	= xOffset / Size, bx = M_GET_MIN(nx - 1, (xOffset + Get_NX() - 1) / Size);
+	int	ay	= yOffset / Size, by = M_GET_MIN(ny - 1, (yOffset + Get_NY() - 1) / Size);
+
+	if( xOffset < 0 || yOffset < 0 || ax > bx || ay > by )
+	{
+		return( false );
+	}
+
+	int	nTiles	= (bx - ax + 1) * (by - ay + 1);
+
+	Set_File_Type(GRID_FILE_FORMAT_Compressed);
+
+	int	nErrors	= 0;
+
+	//-----------------------------------------------------
+	#pragma omp parallel if(!is_Cached())
+	{
+		CSG_File_Zip	Stream(Archive, SG_FILE_R);
+
+		CSG_Array	Tile(m_nBytes_Value, (sLong)Size * Size), Line(1, is_Cached() ? m_nBytes_Line : 0);
+
+		#pragma omp for schedule(dynamic) reduction(+:nErrors)
+		for(int i=0; i<nTiles; i++)
+		{
+			int	xTile	= ax + i % (bx - ax + 1);
+			int	yTile	= ay + i / (bx - ax + 1);
+			int	iEntry	= Index[(size_t)yTile * nx + xTile];
+
+			if( iEntry < 0 || !Stream.Get_File((size_t)iEntry) )
+			{
+				nErrors++;
+
+				continue;
+			}
+
+			int	x0	= xTile * Size, w = M_GET_MIN(Size, System.Get_NX() - x0);
+			int	y0	= yTile * Size, h = M_GET_MIN(Size, System.Get_NY() - y0);
+
+			char	*pTile	= (char *)Tile.Get_Array();
+
+			if( Stream.Read(pTile, m_nBytes_Value, (size_t)w * h) != (size_t)w * h )
+			{
+				nErrors++;
+
+				continue;
+			}
+
+			if( Info.m_bSwapBytes && m_nBytes_Value > 1 )
+			{
+				for(sLong j=0; j<(sLong)w * h; j++)
+				{
+					_Swap_Bytes(pTile + j * m_nBytes_Value, m_nBytes_Value);
+				}
+			}
+
+			//---------------------------------------------
+			int	xa	= M_GET_MAX(x0    , xOffset), xb = M_GET_MIN(x0 + w, xOffset + Get_NX());
+			int	ya	= M_GET_MAX(y0    , yOffset), yb = M_GET_MIN(y0 + h, yOffset + Get_NY());
+
+			size_t	nBytes	= (size_t)(xb - xa) * m_nBytes_Value;
+			size_t	xBytes	= (size_t)(xa - xOffset) * m_nBytes_Value;
+
+			for(int y=ya; y<yb; y++)
+			{
+				char	*pValues	= pTile + ((size_t)(y - y0) * w + (xa - x0)) * m_nBytes_Value;
+
+				if( !is_Cached() )
+				{
+					memcpy((char *)m_Values[y - yOffset] + xBytes, pValues, nBytes);
+				}
+				else if( Get_Line(y - yOffset, Line.Get_Array()) )
+				{
+					memcpy((char *)Line.Get_Array() + xBytes, pValues, nBytes);
+
+					Set_Line(y - yOffset, Line.Get_Array());
+				}
+			}
+		}
+	}
+
+	return( nErrors == 0 );
+}
+
+//---------------------------------------------------------
+/** Writes the tiles of the original resolution followed by the
+  * tiles of each overview level. An overview cell is the mean of
+  * the valid cells of the corresponding 2x2 cells of the previous
+  * level, so only the previous level needs to be kept in memory.
+*/
+//---------------------------------------------------------
+bool CSG_Grid::_Save_Tiles(CSG_File_Zip &Stream, const CSG_String &FileName, int Size, int nLevels)
+{
+	const CSG_Grid	*pGrid	= this;
+
+	CSG_Grid	Overview[2];
+
+	for(int Level=0; Level<=nLevels; Level++)
+	{
+		if( Level > 0 )
+		{
+			CSG_Grid	&Grid	= Overview[Level % 2];
+
+			if( !Grid.Create(SG_Grid_Tiles_Get_System(Get_System(), Level), m_Type) )
+			{
+				return( false );
+			}
+
+			Grid.Set_NoData_Value_Range(Get_NoData_Value(), Get_NoData_Value(true));
+
+			#pragma omp parallel for
+			for(int y=0; y<Grid.Get_NY(); y++)
+			{
+				for(int x=0; x<Grid.Get_NX(); x++)
+				{
+					int	n = 0; double s = 0.0;
+
+					for(int iy=2*y; iy<=2*y+1 && iy<pGrid->Get_NY(); iy++)
+					{
+						for(int ix=2*x; ix<=2*x+1 && ix<pGrid->Get_NX(); ix++)
+						{
+							if( !pGrid->is_NoData(ix, iy) )
+							{
+								n++; s += pGrid->asDouble(ix, iy, false);
+							}
+						}
+					}
+
+					if( n > 0 )
+					{
+						Grid.Set_Value(x, y, s / n, false);
+					}
+					else
+					{
+						Grid.Set_NoData(x, y);
+					}
+				}
+			}
+
+			pGrid	= &Grid;
+		}
+
+		//-------------------------------------------------
+		int	nx	= 1 + (pGrid->Get_NX() - 1) / Size;
+		int	ny	= 1 + (pGrid->Get_NY() - 1) / Size;
+
+		CSG_Array	Band(pGrid->m_nBytes_Line, Size);
+
+		for(int yTile=0; yTile<ny; yTile++)
+		{
+			if( !SG_UI_Process_Set_Progress(yTile, ny) )
+			{
+				return( false );	// cancelled, the archive is incomplete
+			}
+
+			int	y0	= yTile * Size, h = M_GET_MIN(Size, pGrid->Get_NY() - y0);
+
+			for(int y=0; y<h; y++)
+			{
+				pGrid->Get_Line(y0 + y, (char *)Band.Get_Array() + (size_t)y * pGrid->m_nBytes_Line);
+			}
+
+			for(int xTile=0; xTile<nx; xTile++)
+			{
+				int	x0	= xTile * Size, w = M_GET_MIN(Size, pGrid->Get_NX() - x0);
+
+				if( !Stream.Add_File(SG_Grid_Tiles_Get_Name(FileName, Level, yTile, xTile)) )
+				{
+					return( false );
+				}
+
+				for(int y=0; y<h; y++)
+				{
+					Stream.Write((char *)Band.Get_Array() + (size_t)y * pGrid->m_nBytes_Line + (size_t)x0 * m_nBytes_Value, m_nBytes_Value, w);
+				}
+			}
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+/** Loads the cells of a grid file that are located inside the
+  * given extent. For tiled compressed grid files (sg-grd-z) only
+  * the tiles intersecting the extent are decompressed. A level
+  * greater than zero selects the overview with the resolution
+  * reduced by the factor 2^Level. For all other file types the
+  * complete grid is loaded and resampled to the target window.
+*/
+//---------------------------------------------------------
+bool CSG_Grid::Create(const CSG_String &_FileName, const CSG_Rect &Extent, int Level, bool bCached)
+{
+	Destroy();
+
+	CSG_Grid_File_Info	Info;	CSG_String	FileName;
+
+	if( SG_File_Cmp_Extension(_FileName, "sg-grd-z") )
+	{
+		CSG_File_Zip	Stream(_FileName, SG_FILE_R);
+
+		if( !Stream.is_Reading() || !SG_Grid_Zip_Get_Header(Stream, _FileName, FileName) || !Info.Create(Stream) )
+		{
+			return( false );
+		}
+
+		if( Info.m_Tile_Size > 0 && Stream.Get_File(FileName + "prj") )
+		{
+			Get_Projection().Load(Stream, SG_PROJ_FMT_WKT);
+		}
+	}
+
+	//-----------------------------------------------------
+	if( Info.m_Tile_Size < 1 )	// not tiled, load everything and resample
+	{
+		CSG_Grid	Grid;
+
+		if( !Grid.Create(_FileName) )
+		{
+			return( false );
+		}
+
+		Level	= M_GET_MAX(0, Level);
+
+		CSG_Grid_System	System(SG_Grid_Tiles_Get_System(Grid.Get_System(), Level));
+
+		double	Cellsize	= System.Get_Cellsize();
+
+		int	ax	= M_GET_MAX(0                 , (int)ceil ((Extent.Get_XMin() - System.Get_XMin()) / Cellsize));
+		int	bx	= M_GET_MIN(System.Get_NX() - 1, (int)floor((Extent.Get_XMax() - System.Get_XMin()) / Cellsize));
+		int	ay	= M_GET_MAX(0                 , (int)ceil ((Extent.Get_YMin() - System.Get_YMin()) / Cellsize));
+		int	by	= M_GET_MIN(System.Get_NY() - 1, (int)floor((Extent.Get_YMax() - System.Get_YMin()) / Cellsize));
+
+		if( ax > bx || ay > by || !Create(Grid.Get_Type(), bx - ax + 1, by - ay + 1, Cellsize,
+			System.Get_XMin() + ax * Cellsize, System.Get_YMin() + ay * Cellsize, bCached) )
+		{
+			return( false );
+		}
+
+		Set_Name        (Grid.Get_Name       ());
+		Set_Description (Grid.Get_Description());
+		Set_Unit        (Grid.Get_Unit       ());
+		Set_Scaling     (Grid.Get_Scaling(), Grid.Get_Offset());
+		Set_NoData_Value_Range(Grid.Get_NoData_Value(), Grid.Get_NoData_Value(true));
+
+		Get_Projection().Create(Grid.Get_Projection());
+
+		return( Assign(&Grid, Level > 0 ? GRID_RESAMPLING_Mean_Cells : GRID_RESAMPLING_NearestNeighbour) );
+	}
+
+	//-----------------------------------------------------
+	Level	= M_GET_MAX(0, M_GET_MIN(Level, Info.m_Tile_Levels));
+
+	CSG_Grid_System	System(SG_Grid_Tiles_Get_System(Info.m_System, Level));
+
+	double	Cellsize	= System.Get_Cellsize();
+
+	int	ax	= M_GET_MAX(0                 , (int)ceil ((Extent.Get_XMin() - System.Get_XMin()) / Cellsize));
+	int	bx	= M_GET_MIN(System.Get_NX() - 1, (int)floor((Extent.Get_XMax() - System.Get_XMin()) / Cellsize));
+	int	ay	= M_GET_MAX(0                 , (int)ceil ((Extent.Get_YMin() - System.Get_YMin()) / Cellsize));
+	int	by	= M_GET_MIN(System.Get_NY() - 1, (int)floor((Extent.Get_YMax() - System.Get_YMin()) / Cellsize));
+
+	CSG_Projection	Projection(Get_Projection());
+
+	if( ax > bx || ay > by || !Create(Info.m_Type, bx - ax + 1, by - ay + 1, Cellsize,
+		System.Get_XMin() + ax * Cellsize, System.Get_YMin() + ay * Cellsize, bCached) )
+	{
+		return( false );
+	}
+
+	Set_Name        (Info.m_Name);
+	Set_Description (Info.m_Description);
+	Set_Unit        (Info.m_Unit);
+	Set_Scaling     (Info.m_zScale, Info.m_zOffset);
+	Set_NoData_Value_Range(Info.m_NoData[0], Info.m_NoData[1]);
+
+	Get_Projection().Create(Projection);
+
+	if( !_Load_Tiles(_FileName, FileName, Info, Level, ax, ay) )
+	{
+		Destroy();
+
+		return( false );
+	}
+
+	Set_Modified(false);
+
+	return( true );
+}
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -1040,6 +1500,8 @@ void CSG_Grid_File_Info::_On_Construction(void)
 	m_Data_File		.Clear();
 	m_bFlip			= false;
 	m_bSwapBytes	= false;
+	m_Tile_Size		= 0;
+	m_Tile_Levels	= 0;
 	m_Offset		= 0;
 	m_Projection	.Destroy();
 }
@@ -1064,6 +1526,8 @@ bool CSG_Grid_File_Info::Create(const CSG_Grid_File_Info &Info)
 	m_Data_File		= Info.m_Data_File;
 	m_bFlip			= Info.m_bFlip;
 	m_bSwapBytes	= Info.m_bSwapBytes;
+	m_Tile_Size		= Info.m_Tile_Size;
+	m_Tile_Levels	= Info.m_Tile_Levels;
 	m_Offset		= Info.m_Offset;
 	m_Projection	= Info.m_Projection;
 
@@ -1090,6 +1554,8 @@ bool CSG_Grid_File_Info::Create(const CSG_Grid &Grid)
 	m_Data_File		.Clear();
 	m_bFlip			= false;
 	m_bSwapBytes	= false;
+	m_Tile_Size		= 0;
+	m_Tile_Levels	= 0;
 	m_Offset		= 0;
 	m_Projection	= Grid.Get_Projection();
 
@@ -1190,6 +1656,9 @@ bool CSG_Grid_File_Info::Create(CSG_File &Stream)
 		case GRID_FILE_KEY_BYTEORDER_BIG  :	m_bSwapBytes  = Value.Find(GRID_FILE_KEY_TRUE) >= 0;	break;
 		case GRID_FILE_KEY_TOPTOBOTTOM    :	m_bFlip       = Value.Find(GRID_FILE_KEY_TRUE) >= 0;	break;
 
+		case GRID_FILE_KEY_TILE_SIZE      :	m_Tile_Size   = Value.asInt   ();	break;
+		case GRID_FILE_KEY_TILE_LEVELS    :	m_Tile_Levels = Value.asInt   ();	break;
+
 		case GRID_FILE_KEY_DATAFILE_NAME:
 			if( SG_File_Get_Path(Value).Length() > 0 )
 			{
@@ -1290,6 +1759,12 @@ bool CSG_Grid_File_Info::Save(const CSG_File &Stream, bool bBinary)
 	GRID_FILE_PRINT(GRID_FILE_KEY_Z_OFFSET       , CSG_String::Format("%f"   , m_zOffset               ));
 	GRID_FILE_PRINT(GRID_FILE_KEY_NODATA_VALUE   , CSG_String::Format("%f;%f", m_NoData[0], m_NoData[1]));
 
+	if( m_Tile_Size > 0 )
+	{
+		GRID_FILE_PRINT(GRID_FILE_KEY_TILE_SIZE  , CSG_String::Format("%d"   , m_Tile_Size             ));
+		GRID_FILE_PRINT(GRID_FILE_KEY_TILE_LEVELS, CSG_String::Format("%d"   , m_Tile_Levels           ));
+	}
+
 	return( true );
 }
 
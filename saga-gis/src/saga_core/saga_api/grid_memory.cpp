@@ -63,6 +63,7 @@
 
 //---------------------------------------------------------
 #include <memory.h>
+#include <omp.h>
 
 #include "grid.h"
 #include "parameters.h"
@@ -121,7 +122,7 @@ int					SG_Grid_Cache_Get_Mode(void)
 static sLong		gSG_Grid_Cache_Threshold	= 0;
 
 //---------------------------------------------------------
-void				SG_Grid_Cache_Set_Threshold(int nBytes)
+void				SG_Grid_Cache_Set_Threshold(sLong nBytes)
 {
 	if( nBytes >= 0 )
 	{
@@ -132,7 +133,7 @@ void				SG_Grid_Cache_Set_Threshold(int nBytes)
 //---------------------------------------------------------
 void				SG_Grid_Cache_Set_Threshold_MB(double nMegabytes)
 {
-	SG_Grid_Cache_Set_Threshold((int)(nMegabytes * N_MEGABYTE_BYTES));
+	SG_Grid_Cache_Set_Threshold((sLong)(nMegabytes * N_MEGABYTE_BYTES));
 }
 
 //---------------------------------------------------------
@@ -177,6 +178,8 @@ void CSG_Grid::_Memory_Destroy(void)
 {
 	SG_FREE_SAFE(m_Index);
 
+	_Stats_Destroy();
+
 	if( is_Cached() )
 	{
 		_Cache_Destroy(false);
@@ -244,15 +247,49 @@ void CSG_Grid::_Array_Destroy(void)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-#define CACHE_FILE_POS(x, y)	(m_Cache_Offset + (m_Cache_bFlip ? Get_NY() - 1 - y : y) * m_nBytes_Line + x * m_nBytes_Value)
+// The cache file is accessed through row blocks of about
+// CACHE_BLOCK_SIZE bytes. Recently used blocks are kept in
+// memory up to the cache threshold (see SG_Grid_Cache_Set_Threshold)
+// and modified blocks are written back when they are dropped.
+// Each block has its own lock, so that threads working on
+// different blocks do not wait for each other. The cache lock
+// only guards the list of resident blocks (most recently used
+// first) and the file stream, i.e. it is set for loading and
+// dropping blocks, but not for accessing resident blocks.
+
+#define CACHE_BLOCK_SIZE		N_MEGABYTE_BYTES
 
 //---------------------------------------------------------
 #if defined(_SAGA_LINUX)
-#define CACHE_FILE_SEEK	fseek
+#define CACHE_FILE_SEEK	fseeko
 #else
 #define CACHE_FILE_SEEK	_fseeki64
 #endif
 
+//---------------------------------------------------------
+typedef struct SSG_Grid_Cache_Block
+{
+	bool					bModified;
+
+	int						iPrev, iNext;	// resident blocks list
+
+	omp_lock_t				Lock;
+
+	char					*Values;
+}
+TSG_Grid_Cache_Block;
+
+//---------------------------------------------------------
+typedef struct SSG_Grid_Cache
+{
+	int						nRows, nBlocks, nResident, maxResident, iFirst, iLast;
+
+	omp_lock_t				Lock;
+
+	TSG_Grid_Cache_Block	*Blocks;
+}
+TSG_Grid_Cache;
+
 //---------------------------------------------------------
 bool CSG_Grid::Set_Cache(bool bOn)
 {
@@ -328,7 +365,7 @@ bool CSG_Grid::_Cache_Create(const CSG_String &File, TSG_Data_Type Data_Type, sL
 
 	_Array_Destroy();
 
-	return( true );
+	return( _Cache_Blocks_Create() );
 }
 
 //---------------------------------------------------------
@@ -363,7 +400,7 @@ bool CSG_Grid::_Cache_Create(void)	// create temporary cache file
 
 	_Array_Destroy();
 
-	return( true );
+	return( _Cache_Blocks_Create() );
 }
 
 //---------------------------------------------------------
@@ -371,6 +408,13 @@ bool CSG_Grid::_Cache_Destroy(bool bMemory_Restore)
 {
 	if( is_Cached() )
 	{
+		if( bMemory_Restore || !m_Cache_bTemp )
+		{
+			_Cache_Blocks_Flush();	// write back modified blocks
+		}
+
+		_Cache_Blocks_Destroy();
+
 		if( bMemory_Restore && _Array_Create() && !CACHE_FILE_SEEK(m_Cache_Stream, m_Cache_Offset, SEEK_SET) )
 		{
 			for(int y=0; y<Get_NY() && SG_UI_Process_Set_Progress(y, Get_NY()); y++)
@@ -413,70 +457,508 @@ bool CSG_Grid::_Cache_Destroy(bool bMemory_Restore)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-void CSG_Grid::_Cache_Set_Value(int x, int y, double Value)
+bool CSG_Grid::_Cache_Blocks_Create(void)
 {
-	char	Buffer[8];
+	_Cache_Blocks_Destroy();
+
+	TSG_Grid_Cache	*pCache	= new TSG_Grid_Cache;
 
-	switch( m_Type )
+	pCache->nRows		= (int)(CACHE_BLOCK_SIZE / Get_nLineBytes());
+
+	if( pCache->nRows < 1 )
+	{
+		pCache->nRows	= 1;
+	}
+	else if( pCache->nRows > Get_NY() )
 	{
-	case SG_DATATYPE_Float : (*(float  *)Buffer) = (float          )(Value); break;
-	case SG_DATATYPE_Double: (*(double *)Buffer) = (double         )(Value); break;
-	case SG_DATATYPE_Byte  : (*(BYTE   *)Buffer) = SG_ROUND_TO_BYTE (Value); break;
-	case SG_DATATYPE_Char  : (*(char   *)Buffer) = SG_ROUND_TO_CHAR (Value); break;
-	case SG_DATATYPE_Word  : (*(WORD   *)Buffer) = SG_ROUND_TO_WORD (Value); break;
-	case SG_DATATYPE_Short : (*(short  *)Buffer) = SG_ROUND_TO_SHORT(Value); break;
-	case SG_DATATYPE_DWord : (*(DWORD  *)Buffer) = SG_ROUND_TO_DWORD(Value); break;
-	case SG_DATATYPE_Int   : (*(int    *)Buffer) = SG_ROUND_TO_INT  (Value); break;
-	case SG_DATATYPE_Long  : (*(sLong  *)Buffer) = SG_ROUND_TO_SLONG(Value); break;
+		pCache->nRows	= Get_NY();
+	}
 
-	default:
-		return;
+	pCache->nBlocks		= 1 + (Get_NY() - 1) / pCache->nRows;
+	pCache->nResident	= 0;
+	pCache->iFirst		= -1;
+	pCache->iLast		= -1;
+
+	//-----------------------------------------------------
+	// at least a few blocks per thread, so that neighbourhood
+	// operations in parallel loops do not start thrashing...
+
+	sLong	maxResident	= SG_Grid_Cache_Get_Threshold() / ((sLong)pCache->nRows * Get_nLineBytes());
+
+	if( maxResident < 4 * SG_OMP_Get_Max_Num_Threads() )
+	{
+		maxResident	= 4 * SG_OMP_Get_Max_Num_Threads();
+	}
+
+	pCache->maxResident	= (int)M_GET_MIN(maxResident, (sLong)pCache->nBlocks);
+
+	//-----------------------------------------------------
+	if( (pCache->Blocks = (TSG_Grid_Cache_Block *)SG_Calloc(pCache->nBlocks, sizeof(TSG_Grid_Cache_Block))) == NULL )
+	{
+		delete(pCache);
+
+		return( false );
 	}
 
-	if( m_Cache_bSwap )
+	omp_init_lock(&pCache->Lock);
+
+	for(int i=0; i<pCache->nBlocks; i++)
 	{
-		_Swap_Bytes(Buffer, Get_nValueBytes());
+		omp_init_lock(&pCache->Blocks[i].Lock);
 	}
 
-	if( !CACHE_FILE_SEEK(m_Cache_Stream, CACHE_FILE_POS(x, y), SEEK_SET) )
+	m_Cache_Blocks	= pCache;
+
+	return( true );
+}
+
+//---------------------------------------------------------
+void CSG_Grid::_Cache_Blocks_Destroy(void)
+{
+	if( m_Cache_Blocks )
 	{
-		fwrite(Buffer, 1, Get_nValueBytes(), m_Cache_Stream);
+		TSG_Grid_Cache	*pCache	= (TSG_Grid_Cache *)m_Cache_Blocks;
+
+		for(int i=0; i<pCache->nBlocks; i++)
+		{
+			SG_FREE_SAFE(pCache->Blocks[i].Values);
+
+			omp_destroy_lock(&pCache->Blocks[i].Lock);
+		}
+
+		SG_Free(pCache->Blocks);
+
+		omp_destroy_lock(&pCache->Lock);
+
+		delete(pCache);
+
+		m_Cache_Blocks	= NULL;
 	}
 }
 
 //---------------------------------------------------------
-double CSG_Grid::_Cache_Get_Value(int x, int y) const
+bool CSG_Grid::_Cache_Blocks_Flush(void)	const
 {
-	if( !CACHE_FILE_SEEK(m_Cache_Stream, CACHE_FILE_POS(x, y), SEEK_SET) )
+	bool	bResult	= true;
+
+	if( m_Cache_Blocks )
 	{
-		char	Buffer[8];
+		TSG_Grid_Cache	*pCache	= (TSG_Grid_Cache *)m_Cache_Blocks;
 
-		if( fread(Buffer, 1, Get_nValueBytes(), m_Cache_Stream) == (size_t)Get_nValueBytes() )
+		for(int i=0; i<pCache->nBlocks; i++)
+		{
+			if( pCache->Blocks[i].Values && pCache->Blocks[i].bModified && !_Cache_Block_Save(i) )
+			{
+				bResult	= false;
+			}
+		}
+
+		fflush(m_Cache_Stream);
+	}
+
+	return( bResult );
+}
+
+//---------------------------------------------------------
+// Block rows are held in grid order (bottom up) and in the
+// native byte order, so flipping and byte swapping are done
+// once per block when it is read or written.
+//---------------------------------------------------------
+bool CSG_Grid::_Cache_Block_Load(int iBlock)	const
+{
+	TSG_Grid_Cache			*pCache	= (TSG_Grid_Cache *)m_Cache_Blocks;
+	TSG_Grid_Cache_Block	&Block	= pCache->Blocks[iBlock];
+
+	int	yStart	= iBlock * pCache->nRows, nRows = M_GET_MIN(pCache->nRows, Get_NY() - yStart);
+
+	if( !Block.Values && (Block.Values = (char *)SG_Malloc((size_t)pCache->nRows * Get_nLineBytes())) == NULL )
+	{
+		return( false );
+	}
+
+	Block.bModified	= false;
+
+	//-----------------------------------------------------
+	sLong	Position	= m_Cache_Offset + (sLong)(m_Cache_bFlip ? Get_NY() - (yStart + nRows) : yStart) * Get_nLineBytes();
+
+	if( CACHE_FILE_SEEK(m_Cache_Stream, Position, SEEK_SET)
+	||  fread(Block.Values, Get_nLineBytes(), nRows, m_Cache_Stream) != (size_t)nRows )
+	{
+		SG_UI_Msg_Add_Error(CSG_String::Format("%s [%s, %s %d-%d]", _TL("failed to read grid cache"), Get_Name(), _TL("rows"), yStart + 1, yStart + nRows));
+
+		//-------------------------------------------------
+		// the block stays usable, but reads back as no-data
+
+		memset(Block.Values, 0, (size_t)nRows * Get_nLineBytes());
+
+		double	NoData	= Get_NoData_Value();
+
+		for(int x=0; x<Get_NX(); x++)
 		{
 			switch( m_Type )
 			{
-			case SG_DATATYPE_Byte  : return( (double)(*(BYTE   *)Buffer) );
-			case SG_DATATYPE_Char  : return( (double)(*(char   *)Buffer) );
-			case SG_DATATYPE_Word  : return( (double)(*(WORD   *)Buffer) );
-			case SG_DATATYPE_Short : return( (double)(*(short  *)Buffer) );
-			case SG_DATATYPE_DWord : return( (double)(*(DWORD  *)Buffer) );
-			case SG_DATATYPE_Int   : return( (double)(*(int    *)Buffer) );
-			case SG_DATATYPE_Long  : return( (double)(*(sLong  *)Buffer) );
-			case SG_DATATYPE_Float : return( (double)(*(float  *)Buffer) );
-			case SG_DATATYPE_Double: return( (double)(*(double *)Buffer) );
-
-			default:
+			case SG_DATATYPE_Float : ((float  *)Block.Values)[x] = (float          )(NoData); break;
+			case SG_DATATYPE_Double: ((double *)Block.Values)[x] = (double         )(NoData); break;
+			case SG_DATATYPE_Byte  : ((BYTE   *)Block.Values)[x] = SG_ROUND_TO_BYTE (NoData); break;
+			case SG_DATATYPE_Char  : ((char   *)Block.Values)[x] = SG_ROUND_TO_CHAR (NoData); break;
+			case SG_DATATYPE_Word  : ((WORD   *)Block.Values)[x] = SG_ROUND_TO_WORD (NoData); break;
+			case SG_DATATYPE_Short : ((short  *)Block.Values)[x] = SG_ROUND_TO_SHORT(NoData); break;
+			case SG_DATATYPE_DWord : ((DWORD  *)Block.Values)[x] = SG_ROUND_TO_DWORD(NoData); break;
+			case SG_DATATYPE_Int   : ((int    *)Block.Values)[x] = SG_ROUND_TO_INT  (NoData); break;
+			case SG_DATATYPE_Long  : ((sLong  *)Block.Values)[x] = SG_ROUND_TO_SLONG(NoData); break;
+			case SG_DATATYPE_ULong : ((uLong  *)Block.Values)[x] = SG_ROUND_TO_ULONG(NoData); break;
+			default:	// bits have no no-data value
 				break;
 			}
+		}
+
+		for(int y=1; y<nRows; y++)
+		{
+			memcpy(Block.Values + (size_t)y * Get_nLineBytes(), Block.Values, Get_nLineBytes());
+		}
+
+		return( true );
+	}
+
+	//-----------------------------------------------------
+	if( m_Cache_bFlip && nRows > 1 )
+	{
+		CSG_Array	Line(1, Get_nLineBytes());
+
+		for(int a=0, b=nRows-1; a<b; a++, b--)
+		{
+			char	*pA	= Block.Values + (size_t)a * Get_nLineBytes();
+			char	*pB	= Block.Values + (size_t)b * Get_nLineBytes();
+
+			memcpy(Line.Get_Array(), pA, Get_nLineBytes());
+			memcpy(pA, pB, Get_nLineBytes());
+			memcpy(pB, Line.Get_Array(), Get_nLineBytes());
+		}
+	}
 
-			if( m_Cache_bSwap )
+	if( m_Cache_bSwap && Get_nValueBytes() > 1 )
+	{
+		char	*pValue	= Block.Values;
+
+		for(sLong i=(sLong)nRows*Get_NX(); i>0; i--, pValue+=Get_nValueBytes())
+		{
+			_Swap_Bytes(pValue, Get_nValueBytes());
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid::_Cache_Block_Save(int iBlock)	const
+{
+	TSG_Grid_Cache			*pCache	= (TSG_Grid_Cache *)m_Cache_Blocks;
+	TSG_Grid_Cache_Block	&Block	= pCache->Blocks[iBlock];
+
+	int	yStart	= iBlock * pCache->nRows, nRows = M_GET_MIN(pCache->nRows, Get_NY() - yStart);
+
+	Block.bModified	= false;
+
+	//-----------------------------------------------------
+	sLong	Position	= m_Cache_Offset + (sLong)(m_Cache_bFlip ? Get_NY() - (yStart + nRows) : yStart) * Get_nLineBytes();
+
+	if( CACHE_FILE_SEEK(m_Cache_Stream, Position, SEEK_SET) )
+	{
+		return( false );
+	}
+
+	if( !m_Cache_bFlip && !m_Cache_bSwap )
+	{
+		return( fwrite(Block.Values, Get_nLineBytes(), nRows, m_Cache_Stream) == (size_t)nRows );
+	}
+
+	//-----------------------------------------------------
+	CSG_Array	Line(1, Get_nLineBytes());
+
+	for(int i=0; i<nRows; i++)
+	{
+		memcpy(Line.Get_Array(), Block.Values + (size_t)(m_Cache_bFlip ? nRows - 1 - i : i) * Get_nLineBytes(), Get_nLineBytes());
+
+		if( m_Cache_bSwap && Get_nValueBytes() > 1 )
+		{
+			char	*pValue	= (char *)Line.Get_Array();
+
+			for(int x=0; x<Get_NX(); x++, pValue+=Get_nValueBytes())
 			{
-				_Swap_Bytes(Buffer, Get_nValueBytes());
+				_Swap_Bytes(pValue, Get_nValueBytes());
 			}
 		}
+
+		if( fwrite(Line.Get_Array(), Get_nLineBytes(), 1, m_Cache_Stream) != 1 )
+		{
+			return( false );
+		}
 	}
 
-	return( 0.0 );
+	return( true );
+}
+
+//---------------------------------------------------------
+static inline void	SG_Grid_Cache_Unlink	(TSG_Grid_Cache *pCache, int i)
+{
+	TSG_Grid_Cache_Block	&Block	= pCache->Blocks[i];
+
+	if( Block.iPrev >= 0 ) { pCache->Blocks[Block.iPrev].iNext = Block.iNext; } else { pCache->iFirst = Block.iNext; }
+	if( Block.iNext >= 0 ) { pCache->Blocks[Block.iNext].iPrev = Block.iPrev; } else { pCache->iLast  = Block.iPrev; }
+}
+
+//---------------------------------------------------------
+static inline void	SG_Grid_Cache_Push		(TSG_Grid_Cache *pCache, int i)
+{
+	TSG_Grid_Cache_Block	&Block	= pCache->Blocks[i];
+
+	Block.iPrev	= -1;
+	Block.iNext	= pCache->iFirst;
+
+	if( pCache->iFirst >= 0 ) { pCache->Blocks[pCache->iFirst].iPrev = i; } else { pCache->iLast = i; }
+
+	pCache->iFirst	= i;
+}
+
+//---------------------------------------------------------
+// Returns a pointer to the memory of row y. Has to be called
+// with the lock of the row's block set. Hits do not wait for
+// the cache lock, if it is busy the block just keeps its list
+// position. Blocks locked by other threads are not dropped,
+// block locks are only tested here, so no thread waits for a
+// block lock while holding the cache lock.
+//---------------------------------------------------------
+char * CSG_Grid::_Cache_Get_Line(int y, bool bModify)	const
+{
+	TSG_Grid_Cache	*pCache	= (TSG_Grid_Cache *)m_Cache_Blocks;
+
+	int	iBlock	= y / pCache->nRows;
+
+	TSG_Grid_Cache_Block	&Block	= pCache->Blocks[iBlock];
+
+	if( Block.Values )	// resident
+	{
+		if( omp_test_lock(&pCache->Lock) )
+		{
+			if( pCache->iFirst != iBlock )
+			{
+				SG_Grid_Cache_Unlink(pCache, iBlock);
+				SG_Grid_Cache_Push  (pCache, iBlock);
+			}
+
+			omp_unset_lock(&pCache->Lock);
+		}
+	}
+	else
+	{
+		omp_set_lock(&pCache->Lock);
+
+		if( pCache->nResident >= pCache->maxResident )	// drop least recently used block
+		{
+			for(int iDrop=pCache->iLast; iDrop>=0; iDrop=pCache->Blocks[iDrop].iPrev)
+			{
+				TSG_Grid_Cache_Block	&Drop	= pCache->Blocks[iDrop];
+
+				if( omp_test_lock(&Drop.Lock) )
+				{
+					if( Drop.bModified )
+					{
+						_Cache_Block_Save(iDrop);
+					}
+
+					SG_Grid_Cache_Unlink(pCache, iDrop);
+
+					Block.Values	= Drop.Values;	// reuse the memory
+
+					Drop .Values	= NULL;
+					pCache->nResident--;
+
+					omp_unset_lock(&Drop.Lock);
+
+					break;
+				}
+			}
+		}
+
+		bool	bLoaded	= _Cache_Block_Load(iBlock);
+
+		if( bLoaded )
+		{
+			SG_Grid_Cache_Push(pCache, iBlock);
+
+			pCache->nResident++;
+		}
+
+		omp_unset_lock(&pCache->Lock);
+
+		if( !bLoaded )
+		{
+			return( NULL );
+		}
+	}
+
+	if( bModify )
+	{
+		Block.bModified	= true;
+	}
+
+	return( Block.Values + (size_t)(y - iBlock * pCache->nRows) * Get_nLineBytes() );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+void CSG_Grid::_Cache_Set_Value(int x, int y, double Value)
+{
+	TSG_Grid_Cache	*pCache	= (TSG_Grid_Cache *)m_Cache_Blocks;
+
+	omp_lock_t		*pLock	= &pCache->Blocks[y / pCache->nRows].Lock;
+
+	omp_set_lock(pLock);
+
+	char	*pLine	= _Cache_Get_Line(y, true);
+
+	if( pLine ) switch( m_Type )
+	{
+	case SG_DATATYPE_Float : ((float  *)pLine)[x] = (float          )(Value); break;
+	case SG_DATATYPE_Double: ((double *)pLine)[x] = (double         )(Value); break;
+	case SG_DATATYPE_Byte  : ((BYTE   *)pLine)[x] = SG_ROUND_TO_BYTE (Value); break;
+	case SG_DATATYPE_Char  : ((char   *)pLine)[x] = SG_ROUND_TO_CHAR (Value); break;
+	case SG_DATATYPE_Word  : ((WORD   *)pLine)[x] = SG_ROUND_TO_WORD (Value); break;
+	case SG_DATATYPE_Short : ((short  *)pLine)[x] = SG_ROUND_TO_SHORT(Value); break;
+	case SG_DATATYPE_DWord : ((DWORD  *)pLine)[x] = SG_ROUND_TO_DWORD(Value); break;
+	case SG_DATATYPE_Int   : ((int    *)pLine)[x] = SG_ROUND_TO_INT  (Value); break;
+	case SG_DATATYPE_Long  : ((sLong  *)pLine)[x] = SG_ROUND_TO_SLONG(Value); break;
+	case SG_DATATYPE_ULong : ((uLong  *)pLine)[x] = SG_ROUND_TO_ULONG(Value); break;
+	case SG_DATATYPE_Bit   : ((BYTE   *)pLine)[x / 8] = Value != 0.0
+			? ((BYTE  *)pLine)[x / 8] |   m_Bitmask[x % 8]
+			: ((BYTE  *)pLine)[x / 8] & (~m_Bitmask[x % 8]);
+		break;
+
+	default:
+		break;
+	}
+
+	omp_unset_lock(pLock);
+}
+
+//---------------------------------------------------------
+double CSG_Grid::_Cache_Get_Value(int x, int y) const
+{
+	TSG_Grid_Cache	*pCache	= (TSG_Grid_Cache *)m_Cache_Blocks;
+
+	omp_lock_t		*pLock	= &pCache->Blocks[y / pCache->nRows].Lock;
+
+	double	Value	= 0.0;
+
+	omp_set_lock(pLock);
+
+	char	*pLine	= _Cache_Get_Line(y, false);
+
+	if( pLine ) switch( m_Type )
+	{
+	case SG_DATATYPE_Byte  : Value = (double)((BYTE   *)pLine)[x]; break;
+	case SG_DATATYPE_Char  : Value = (double)((char   *)pLine)[x]; break;
+	case SG_DATATYPE_Word  : Value = (double)((WORD   *)pLine)[x]; break;
+	case SG_DATATYPE_Short : Value = (double)((short  *)pLine)[x]; break;
+	case SG_DATATYPE_DWord : Value = (double)((DWORD  *)pLine)[x]; break;
+	case SG_DATATYPE_Int   : Value = (double)((int    *)pLine)[x]; break;
+	case SG_DATATYPE_Long  : Value = (double)((sLong  *)pLine)[x]; break;
+	case SG_DATATYPE_ULong : Value = (double)((uLong  *)pLine)[x]; break;
+	case SG_DATATYPE_Float : Value = (double)((float  *)pLine)[x]; break;
+	case SG_DATATYPE_Double: Value = (double)((double *)pLine)[x]; break;
+	case SG_DATATYPE_Bit   : Value = (((BYTE *)pLine)[x / 8] & m_Bitmask[x % 8]) == 0 ? 0.0 : 1.0; break;
+
+	default:
+		break;
+	}
+
+	omp_unset_lock(pLock);
+
+	return( Value );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Grid::Get_Line(int y, void *Values)	const
+{
+	if( y < 0 || y >= Get_NY() || !Values )
+	{
+		return( false );
+	}
+
+	if( !is_Cached() )
+	{
+		memcpy(Values, m_Values[y], m_nBytes_Line);
+
+		return( true );
+	}
+
+	TSG_Grid_Cache	*pCache	= (TSG_Grid_Cache *)m_Cache_Blocks;
+
+	omp_lock_t		*pLock	= &pCache->Blocks[y / pCache->nRows].Lock;
+
+	omp_set_lock(pLock);
+
+	char	*pLine	= _Cache_Get_Line(y, false);
+
+	if( pLine )
+	{
+		memcpy(Values, pLine, m_nBytes_Line);
+	}
+
+	omp_unset_lock(pLock);
+
+	return( pLine != NULL );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid::Set_Line(int y, const void *Values)
+{
+	if( y < 0 || y >= Get_NY() || !Values )
+	{
+		return( false );
+	}
+
+	if( !is_Cached() )
+	{
+		memcpy(m_Values[y], Values, m_nBytes_Line);
+	}
+	else
+	{
+		TSG_Grid_Cache	*pCache	= (TSG_Grid_Cache *)m_Cache_Blocks;
+
+		omp_lock_t		*pLock	= &pCache->Blocks[y / pCache->nRows].Lock;
+
+		omp_set_lock(pLock);
+
+		char	*pLine	= _Cache_Get_Line(y, true);
+
+		if( pLine )
+		{
+			memcpy(pLine, Values, m_nBytes_Line);
+		}
+
+		omp_unset_lock(pLock);
+
+		if( !pLine )
+		{
+			return( false );
+		}
+	}
+
+	_Stats_Set_Dirty(y);
+
+	Set_Modified();
+
+	return( true );
 }
 
 
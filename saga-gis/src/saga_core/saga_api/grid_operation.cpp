@@ -88,6 +88,8 @@ bool CSG_Grid::Assign(double Value)
 		{
 			memset(m_Values[y], 0, Get_nLineBytes());
 		}
+
+		_Stats_Set_Dirty();
 	}
 	else
 	{
@@ -104,9 +106,7 @@ bool CSG_Grid::Assign(double Value)
 	//-----------------------------------------------------
 	Get_History().Destroy();
 
-	m_Statistics.Invalidate();
-
-	Set_Update_Flag(false);
+	Set_Update_Flag();
 
 	return( true );
 }
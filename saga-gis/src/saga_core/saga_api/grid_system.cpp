@@ -48,6 +48,10 @@
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
+#include <algorithm>
+#include <limits>
+#include <vector>
+
 #include "grid.h"
 #include "shapes.h"
 #include "parameters.h"
@@ -325,16 +329,26 @@ bool CSG_Grid_System::is_Equal(double Cellsize, const TSG_Rect &Extent) const
 //---------------------------------------------------------
 CSG_Grid_Cell_Addressor::CSG_Grid_Cell_Addressor(void)
 {
-	m_Kernel.Add_Field("X", SG_DATATYPE_Int   );
-	m_Kernel.Add_Field("Y", SG_DATATYPE_Int   );
-	m_Kernel.Add_Field("D", SG_DATATYPE_Double);
-	m_Kernel.Add_Field("W", SG_DATATYPE_Double);
+	m_Type		= 0;
+	m_nCells	= 0;
+	m_Size		= 0;
+
+	m_Radius	= 1.;
+	m_Radius_0	= 0.;
+	m_Direction	= 0.;
+	m_Tolerance	= 0.;
 }
 
 //---------------------------------------------------------
 bool CSG_Grid_Cell_Addressor::Destroy(void)
 {
-	m_Kernel.Del_Records();
+	m_X       .Destroy();
+	m_Y       .Destroy();
+	m_Distance.Destroy();
+	m_Weight  .Destroy();
+
+	m_nCells	= 0;
+	m_Size		= 0;
 
 	m_Radius	= 1.;
 	m_Radius_0	= 0.;
@@ -492,6 +506,20 @@ bool CSG_Grid_Cell_Addressor::Enable_Parameters(CSG_Parameters &Parameters)
 //														 //
 ///////////////////////////////////////////////////////////
 
+//---------------------------------------------------------
+class CSG_Grid_Cell_Addressor_Compare
+{
+public:
+	CSG_Grid_Cell_Addressor_Compare(const double *Distance) : m_Distance(Distance)	{}
+
+	bool			operator ()		(int a, int b)	const	{	return( m_Distance[a] < m_Distance[b] );	}
+
+private:
+
+	const double	*m_Distance;
+
+};
+
 //---------------------------------------------------------
 bool CSG_Grid_Cell_Addressor::_Set_Kernel(int Type, double Radius, double Radius_Inner, double Direction, double Tolerance)
 {
@@ -517,18 +545,16 @@ bool CSG_Grid_Cell_Addressor::_Set_Kernel(int Type, double Radius, double Radius
 	}
 
 	//-----------------------------------------------------
-	#define	ADD_CELL(x, y, Distance)	{\
-		CSG_Table_Record	&Cell	= *Kernel.Add_Record();\
-		Cell.Set_Value(0, x);\
-		Cell.Set_Value(1, y);\
-		Cell.Set_Value(2, Distance);\
-		Cell.Set_Value(3, m_Weighting.Get_Weight(d));\
-	}
-
-	CSG_Table	Kernel(&m_Kernel);
+	// the kernel is kept as flat coordinate, distance and
+	// weight arrays, cells are collected in row order and
+	// then stable sorted by distance...
 
 	int	Size	= (int)ceil(m_Radius);
 
+	int	n	= 0, nMax	= (1 + 2 * Size) * (1 + 2 * Size);
+
+	CSG_Array_Int	X(nMax), Y(nMax);	CSG_Vector	D(nMax);
+
 	//-----------------------------------------------------
 	for(int y=-Size; y<=Size; y++)
 	{
@@ -542,47 +568,101 @@ bool CSG_Grid_Cell_Addressor::_Set_Kernel(int Type, double Radius, double Radius
 
 			double	d	= SG_Get_Length(x, y);
 
+			bool	bAdd;
+
 			switch( m_Type )
 			{
 			default:	// square
-				ADD_CELL(x, y, d);
+				bAdd	= true;
 				break;
 
 			case  1:	// circle
-				if( d <= m_Radius )
-				{
-					ADD_CELL(x, y, d);
-				}
+				bAdd	= d <= m_Radius;
 				break;
 
 			case  2:	// annulus
-				if( d <= m_Radius && d >= m_Radius_0 )
-				{
-					ADD_CELL(x, y, d);
-				}
+				bAdd	= d <= m_Radius && d >= m_Radius_0;
 				break;
 
 			case  3:	// sector
-				if( d <= m_Radius && d >= m_Radius_0 && ((x == 0 && y == 0) || SG_is_Angle_Between(SG_Get_Angle_Of_Direction(x, y), Sector[0], Sector[1], false)) )
-				{
-					ADD_CELL(x, y, d);
-				}
+				bAdd	= d <= m_Radius && d >= m_Radius_0 && ((x == 0 && y == 0) || SG_is_Angle_Between(SG_Get_Angle_Of_Direction(x, y), Sector[0], Sector[1], false));
 				break;
 			}
+
+			if( bAdd )
+			{
+				X[n] = x; Y[n] = y; D[n] = d; n++;
+			}
 		}
 	}
 
 	//-----------------------------------------------------
-	if( Kernel.Get_Count() < 1 )
+	if( n < 1 )
 	{
 		return( false );
 	}
 
-	Kernel.Set_Index(2, TABLE_INDEX_Ascending);
+	m_nCells	= n;
+
+	CSG_Array_Int	Index(m_nCells);
+
+	for(int i=0; i<m_nCells; i++)
+	{
+		Index[i]	= i;
+	}
+
+	CSG_Grid_Cell_Addressor_Compare	Compare(D.Get_Data());
+
+	std::stable_sort(Index.Get_Array(), Index.Get_Array() + m_nCells, Compare);
+
+	m_X       .Create(m_nCells);
+	m_Y       .Create(m_nCells);
+	m_Distance.Create(m_nCells);
+	m_Weight  .Create(m_nCells);
+
+	for(int i=0; i<m_nCells; i++)
+	{
+		int	j	= Index[i];
+
+		m_X       [i]	= X[j];
+		m_Y       [i]	= Y[j];
+		m_Distance[i]	= D[j];
+		m_Weight  [i]	= m_Weighting.Get_Weight(D[j]);
+
+		if( m_Size < abs(X[j]) ) { m_Size = abs(X[j]); }
+		if( m_Size < abs(Y[j]) ) { m_Size = abs(Y[j]); }
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+/**
+* A square kernel with no or Gaussian distance weighting can
+* be applied as two one-dimensional passes, because its
+* weights are the product of the weights of their x and y
+* components. Get_Separable() returns these one-dimensional
+* weights for the offsets -Get_Size() to +Get_Size().
+*/
+//---------------------------------------------------------
+bool CSG_Grid_Cell_Addressor::is_Separable(void)	const
+{
+	return( m_nCells > 0 && is_Square() && m_Radius_0 <= 0.
+		&& (m_Weighting.Get_Weighting() == SG_DISTWGHT_None || m_Weighting.Get_Weighting() == SG_DISTWGHT_GAUSS)
+	);
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_Cell_Addressor::Get_Separable(CSG_Vector &Weights)	const
+{
+	if( !is_Separable() || !Weights.Create(1 + 2 * m_Size) )
+	{
+		return( false );
+	}
 
-	for(int i=0; i<Kernel.Get_Count(); i++)
+	for(int i=-m_Size; i<=m_Size; i++)
 	{
-		m_Kernel.Add_Record(Kernel.Get_Record_byIndex(i));
+		Weights[m_Size + i]	= m_Weighting.Get_Weight(abs(i));
 	}
 
 	return( true );
@@ -626,3 +706,603 @@ bool CSG_Grid_Cell_Addressor::Set_Sector(double Radius, double Direction, double
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
+
+
+//---------------------------------------------------------
+/**
+* Returns the cells to remove from (Out) and to add to (In) a
+* sliding window, when the kernel moves one column to the
+* right. Out lists the indices of those kernel cells, which
+* have no kernel cell to their left, In those, which have no
+* kernel cell to their right. Offsets of Out cells refer to the
+* old, offsets of In cells to the new kernel center.
+*/
+//---------------------------------------------------------
+bool CSG_Grid_Cell_Addressor::Get_Sliding(CSG_Array_Int &Out, CSG_Array_Int &In)	const
+{
+	Out.Create(0); In.Create(0);
+
+	if( m_nCells < 1 )
+	{
+		return( false );
+	}
+
+	int	n	= 2 * m_Size + 3;	// with one cell margin on each side
+
+	CSG_Array_Int	Mask(n * n); Mask.Assign(0);
+
+	#define MASK_CELL(x, y)	Mask[(m_Size + 1 + (y)) * n + m_Size + 1 + (x)]
+
+	for(int i=0; i<m_nCells; i++)
+	{
+		MASK_CELL(Get_X(i), Get_Y(i))	= 1;
+	}
+
+	for(int i=0; i<m_nCells; i++)
+	{
+		if( !MASK_CELL(Get_X(i) - 1, Get_Y(i)) )
+		{
+			Out.Add(i);
+		}
+
+		if( !MASK_CELL(Get_X(i) + 1, Get_Y(i)) )
+		{
+			In.Add(i);
+		}
+	}
+
+	#undef MASK_CELL
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//					Grid Focal Tiles					 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_Grid_Focal_Tile::CSG_Grid_Focal_Tile(void)
+{
+	m_xMin	= m_yMin	= m_NX	= m_NY	= m_Halo	= m_Stride	= 0;
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_Grid_Focal_Tiles::CSG_Grid_Focal_Tiles(void)
+{
+	m_pGrid	= NULL;	m_Halo	= m_Size	= m_nx	= m_ny	= 0;
+}
+
+//---------------------------------------------------------
+CSG_Grid_Focal_Tiles::CSG_Grid_Focal_Tiles(const CSG_Grid *pGrid, int Halo, int Size)
+{
+	Create(pGrid, Halo, Size);
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_Focal_Tiles::Create(const CSG_Grid *pGrid, int Halo, int Size)
+{
+	m_pGrid	= NULL;	m_Halo	= m_Size	= m_nx	= m_ny	= 0;
+
+	if( !pGrid || !pGrid->is_Valid() )
+	{
+		return( false );
+	}
+
+	m_pGrid	= pGrid;
+	m_Halo	= Halo > 0 ? Halo : 0;
+	m_Size	= Size > 0 ? Size : M_GET_MAX(128, 2 * m_Halo);
+	m_nx	= 1 + (pGrid->Get_NX() - 1) / m_Size;
+	m_ny	= 1 + (pGrid->Get_NY() - 1) / m_Size;
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_Focal_Tiles::Get_Tile(int iTile, CSG_Grid_Focal_Tile &Tile, bool bRanks)	const
+{
+	if( !m_pGrid || iTile < 0 || iTile >= Get_Count() )
+	{
+		return( false );
+	}
+
+	Tile.m_Halo		= m_Halo;
+	Tile.m_xMin		= (iTile % m_nx) * m_Size;
+	Tile.m_yMin		= (iTile / m_nx) * m_Size;
+	Tile.m_NX		= M_GET_MIN(m_Size, m_pGrid->Get_NX() - Tile.m_xMin);
+	Tile.m_NY		= M_GET_MIN(m_Size, m_pGrid->Get_NY() - Tile.m_yMin);
+	Tile.m_Stride	= Tile.m_NX + 2 * m_Halo;
+
+	int	nRows	= Tile.m_NY + 2 * m_Halo;
+
+	if( (sLong)Tile.m_Values.Get_N() != (sLong)Tile.m_Stride * nRows && !Tile.m_Values.Create((size_t)Tile.m_Stride * nRows) )
+	{
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	const double	NoData	= std::numeric_limits<double>::quiet_NaN();
+
+	for(int iy=0, y=Tile.m_yMin-m_Halo; iy<nRows; iy++, y++)
+	{
+		double	*Values	= Tile.m_Values.Get_Data() + (sLong)iy * Tile.m_Stride;
+
+		for(int ix=0, x=Tile.m_xMin-m_Halo; ix<Tile.m_Stride; ix++, x++)
+		{
+			Values[ix]	= m_pGrid->is_InGrid(x, y) ? m_pGrid->asDouble(x, y) : NoData;
+		}
+	}
+
+	if( !bRanks )
+	{
+		return( true );
+	}
+
+	//-----------------------------------------------------
+	// ranks index the sorted distinct values of the tile
+
+	std::vector<double>	Values;	Values.reserve(Tile.m_Values.Get_N());
+
+	for(int i=0; i<Tile.m_Values.Get_N(); i++)
+	{
+		double	Value	= Tile.m_Values.Get_Data()[i];
+
+		if( !SG_is_NaN(Value) )
+		{
+			Values.push_back(Value);
+		}
+	}
+
+	std::sort(Values.begin(), Values.end());
+
+	Values.erase(std::unique(Values.begin(), Values.end()), Values.end());
+
+	Tile.m_Rank_Values.Create(Values.size());
+
+	if( Values.size() > 0 )
+	{
+		std::copy(Values.begin(), Values.end(), Tile.m_Rank_Values.Get_Data());
+	}
+
+	Tile.m_Ranks.Create(Tile.m_Values.Get_N());
+
+	for(int i=0; i<Tile.m_Values.Get_N(); i++)
+	{
+		double	Value	= Tile.m_Values.Get_Data()[i];
+
+		Tile.m_Ranks[i]	= SG_is_NaN(Value) ? -1 : (int)(std::lower_bound(Values.begin(), Values.end(), Value) - Values.begin());
+	}
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_Grid_Focal_Histogram::CSG_Grid_Focal_Histogram(void)
+{
+	m_nRanks	= m_nTotal	= m_nMax	= m_Step	= 0;
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_Focal_Histogram::Create(int nRanks)
+{
+	m_nRanks	= nRanks > 0 ? nRanks : 0;
+	m_nTotal	= m_nMax	= 0;
+
+	m_Count  .Create(m_nRanks    ); m_Count  .Assign(0);
+	m_Tree   .Create(m_nRanks + 1); m_Tree   .Assign(0);
+	m_nCounts.Create(64          ); m_nCounts.Assign(0);
+
+	for(m_Step=1; 2 * m_Step<=m_nRanks; m_Step*=2) {}
+
+	return( m_nRanks > 0 );
+}
+
+//---------------------------------------------------------
+void CSG_Grid_Focal_Histogram::Add(int Rank)
+{
+	if( Rank < 0 || Rank >= m_nRanks )
+	{
+		return;
+	}
+
+	int	Count	= ++m_Count[Rank];
+
+	if( Count >= (int)m_nCounts.Get_Size() )
+	{
+		size_t	n	= m_nCounts.Get_Size();
+
+		m_nCounts.Set_Array(2 * Count);
+
+		for(size_t i=n; i<m_nCounts.Get_Size(); i++)
+		{
+			m_nCounts[i]	= 0;
+		}
+	}
+
+	m_nCounts[Count - 1]--;	// count of zero is not used
+	m_nCounts[Count    ]++;
+
+	if( m_nMax < Count )
+	{
+		m_nMax	= Count;
+	}
+
+	for(int i=Rank+1; i<=m_nRanks; i+=i&(-i))
+	{
+		m_Tree[i]++;
+	}
+
+	m_nTotal++;
+}
+
+//---------------------------------------------------------
+void CSG_Grid_Focal_Histogram::Del(int Rank)
+{
+	if( Rank < 0 || Rank >= m_nRanks || m_Count[Rank] < 1 )
+	{
+		return;
+	}
+
+	int	Count	= m_Count[Rank]--;
+
+	m_nCounts[Count    ]--;
+	m_nCounts[Count - 1]++;
+
+	if( m_nMax == Count && m_nCounts[Count] == 0 )
+	{
+		m_nMax	= Count - 1;
+	}
+
+	for(int i=Rank+1; i<=m_nRanks; i+=i&(-i))
+	{
+		m_Tree[i]--;
+	}
+
+	m_nTotal--;
+}
+
+//---------------------------------------------------------
+/**
+* Returns the lowest count of the ranks present in the window.
+*/
+int CSG_Grid_Focal_Histogram::Get_Count_Min(void)	const
+{
+	const int	*nCounts	= m_nCounts.Get_Array();
+
+	for(int Count=1; Count<=m_nMax; Count++)
+	{
+		if( nCounts[Count] > 0 )
+		{
+			return( Count );
+		}
+	}
+
+	return( 0 );
+}
+
+//---------------------------------------------------------
+/**
+* Returns the k-th smallest rank (zero based) of the window
+* or -1, if k is out of range.
+*/
+int CSG_Grid_Focal_Histogram::Get_Rank(int k)	const
+{
+	if( k < 0 || k >= m_nTotal )
+	{
+		return( -1 );
+	}
+
+	const int	*Tree	= m_Tree.Get_Array();
+
+	int	Rank	= 0, Rest	= k + 1;
+
+	for(int Step=m_Step; Step>0; Step/=2)
+	{
+		if( Rank + Step <= m_nRanks && Tree[Rank + Step] < Rest )
+		{
+			Rank	+= Step;
+			Rest	-= Tree[Rank];
+		}
+	}
+
+	return( Rank );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//				Grid Polygon Coverage					 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_Grid_Polygon_Coverage::CSG_Grid_Polygon_Coverage(void)
+{
+	Destroy();
+}
+
+//---------------------------------------------------------
+CSG_Grid_Polygon_Coverage::CSG_Grid_Polygon_Coverage(const CSG_Grid_System &System, CSG_Shape_Polygon *pPolygon)
+{
+	Create(System, pPolygon);
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_Polygon_Coverage::Destroy(void)
+{
+	m_xMin	= m_yMin	= 0;
+	m_xMax	= m_yMax	= -1;
+
+	m_Edges    .Destroy();
+	m_Row_First.Destroy();
+	m_Row_Edges.Destroy();
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid_Polygon_Coverage::Create(const CSG_Grid_System &System, CSG_Shape_Polygon *pPolygon)
+{
+	Destroy();
+
+	if( !System.is_Valid() || !pPolygon || !pPolygon->is_Valid() )
+	{
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	// all calculations are done in grid coordinates, cell
+	// (x, y) covers the square from x - 0.5 to x + 0.5 and
+	// y - 0.5 to y + 0.5
+
+	#define GET_XGRID(x)	((x - System.Get_XMin()) / System.Get_Cellsize())
+	#define GET_YGRID(y)	((y - System.Get_YMin()) / System.Get_Cellsize())
+
+	const CSG_Rect	&Extent	= pPolygon->Get_Extent();
+
+	m_xMin	= (int)floor(GET_XGRID(Extent.Get_XMin()) + 0.5); if( m_xMin < 0 ) m_xMin = 0;
+	m_xMax	= (int)floor(GET_XGRID(Extent.Get_XMax()) + 0.5); if( m_xMax >= System.Get_NX() ) m_xMax = System.Get_NX() - 1;
+	m_yMin	= (int)floor(GET_YGRID(Extent.Get_YMin()) + 0.5); if( m_yMin < 0 ) m_yMin = 0;
+	m_yMax	= (int)floor(GET_YGRID(Extent.Get_YMax()) + 0.5); if( m_yMax >= System.Get_NY() ) m_yMax = System.Get_NY() - 1;
+
+	if( !is_Valid() )
+	{
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	// outer rings are counted counter-clockwise and lakes
+	// clockwise, whatever the orientation of their vertices
+
+	int	nEdges	= 0;
+
+	for(int iPart=0; iPart<pPolygon->Get_Part_Count(); iPart++)
+	{
+		nEdges	+= pPolygon->Get_Point_Count(iPart);
+	}
+
+	TEdge	*Edges	= (TEdge *)m_Edges.Create(sizeof(TEdge), nEdges);
+
+	int	*nRow	= m_Row_First.Create(2 + m_yMax - m_yMin);	m_Row_First.Assign(0);
+
+	nEdges	= 0;
+
+	for(int iPart=0; iPart<pPolygon->Get_Part_Count(); iPart++)
+	{
+		double	Sign	= pPolygon->is_Lake(iPart) == pPolygon->is_Clockwise(iPart) ? 1. : -1.;
+
+		TSG_Point	B	= pPolygon->Get_Point(pPolygon->Get_Point_Count(iPart) - 1, iPart);
+
+		for(int iPoint=0; iPoint<pPolygon->Get_Point_Count(iPart); iPoint++)
+		{
+			TSG_Point	A	= B;	B	= pPolygon->Get_Point(iPoint, iPart);
+
+			if( A.y == B.y )	// horizontal edges neither add area nor cross cell centers
+			{
+				continue;
+			}
+
+			TEdge	&Edge	= Edges[nEdges];
+
+			Edge.ax		= GET_XGRID(A.x);
+			Edge.ay		= GET_YGRID(A.y);
+			Edge.bx		= GET_XGRID(B.x);
+			Edge.by		= GET_YGRID(B.y);
+			Edge.Sign	= Sign;
+
+			int	y0	= (int)floor(M_GET_MIN(Edge.ay, Edge.by) + 0.5); if( y0 < m_yMin ) y0 = m_yMin;
+			int	y1	= (int)floor(M_GET_MAX(Edge.ay, Edge.by) + 0.5); if( y1 > m_yMax ) y1 = m_yMax;
+
+			if( y0 <= y1 )
+			{
+				for(int y=y0; y<=y1; y++)
+				{
+					nRow[1 + y - m_yMin]++;
+				}
+
+				nEdges++;
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	// bucket the edges by the rows they cross
+
+	for(int y=m_yMin; y<=m_yMax; y++)
+	{
+		nRow[1 + y - m_yMin]	+= nRow[y - m_yMin];
+	}
+
+	int	*Row_Edges	= m_Row_Edges.Create(nRow[1 + m_yMax - m_yMin]);
+
+	CSG_Array_Int	Next(m_Row_First);
+
+	for(int i=0; i<nEdges; i++)
+	{
+		int	y0	= (int)floor(M_GET_MIN(Edges[i].ay, Edges[i].by) + 0.5); if( y0 < m_yMin ) y0 = m_yMin;
+		int	y1	= (int)floor(M_GET_MAX(Edges[i].ay, Edges[i].by) + 0.5); if( y1 > m_yMax ) y1 = m_yMax;
+
+		for(int y=y0; y<=y1; y++)
+		{
+			Row_Edges[Next[y - m_yMin]++]	= i;
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+/**
+* Fills Coverage with the values of the cells Get_xMin() to
+* Get_xMax() of row y. These are the cells' fractions covered
+* by the polygon (0 to 1) or, if bCenters is true, 1 for all
+* cells with their center inside the polygon, else 0.
+* The covered area is the integral of the clamped x position
+* along the polygon's boundary (Green's theorem). Each edge
+* piece inside a cell adds its exact share to this cell and
+* the full piece length to all cells left of it, which is
+* accumulated with a running sum.
+*/
+//---------------------------------------------------------
+bool CSG_Grid_Polygon_Coverage::Get_Row(int y, double *Coverage, bool bCenters)	const
+{
+	if( y < m_yMin || y > m_yMax || !Coverage )
+	{
+		return( false );
+	}
+
+	int	nx	= Get_NX();
+
+	const TEdge	*Edges	= (const TEdge *)m_Edges.Get_Array();
+
+	const int	*Row	= m_Row_Edges.Get_Array() + m_Row_First[y - m_yMin];
+	int			nRow	= m_Row_First[1 + y - m_yMin] - m_Row_First[y - m_yMin];
+
+	//-----------------------------------------------------
+	if( bCenters )
+	{
+		std::vector<double>	Crossings;
+
+		for(int i=0; i<nRow; i++)
+		{
+			const TEdge	&e	= Edges[Row[i]];
+
+			if( (e.ay <= y && y < e.by) || (e.ay > y && y >= e.by) )
+			{
+				Crossings.push_back(e.ax + (y - e.ay) * (e.bx - e.ax) / (e.by - e.ay));
+			}
+		}
+
+		std::sort(Crossings.begin(), Crossings.end());
+
+		memset(Coverage, 0, nx * sizeof(double));
+
+		for(size_t i=1; i<Crossings.size(); i+=2)
+		{
+			int	x0	= (int)ceil(Crossings[i - 1]    ); if( x0 < m_xMin ) x0 = m_xMin;
+			int	x1	= (int)ceil(Crossings[i    ] - 1); if( x1 > m_xMax ) x1 = m_xMax;
+
+			for(int x=x0; x<=x1; x++)
+			{
+				Coverage[x - m_xMin]	= 1.;
+			}
+		}
+
+		return( true );
+	}
+
+	//-----------------------------------------------------
+	std::vector<double>	Full(nx + 1, 0.);
+
+	memset(Coverage, 0, nx * sizeof(double));
+
+	double	xLeft	= m_xMin - 0.5, xRight	= m_xMax + 0.5;
+
+	for(int i=0; i<nRow; i++)
+	{
+		const TEdge	&e	= Edges[Row[i]];
+
+		double	y0	= M_GET_MAX(M_GET_MIN(e.ay, e.by), y - 0.5);
+		double	y1	= M_GET_MIN(M_GET_MAX(e.ay, e.by), y + 0.5);
+
+		if( y1 <= y0 )
+		{
+			continue;
+		}
+
+		double	k	= (e.bx - e.ax) / (e.by - e.ay);
+		double	xa	= e.ax + k * (y0 - e.ay);
+		double	xb	= e.ax + k * (y1 - e.ay);
+		double	dy	= (y1 - y0) * (e.by > e.ay ? e.Sign : -e.Sign);
+
+		double	u0	= M_GET_MIN(xa, xb);
+		double	u1	= M_GET_MAX(xa, xb);
+
+		//-------------------------------------------------
+		if( u0 == u1 )	// vertical
+		{
+			int	x	= (int)floor(u0 + 0.5);
+
+			if( x > m_xMax )
+			{
+				Full[0]	+= dy;
+			}
+			else if( x >= m_xMin )
+			{
+				Coverage[x - m_xMin]	+= (u0 - (x - 0.5)) * dy;	Full[0]	+= dy;	Full[x - m_xMin]	-= dy;
+			}
+
+			continue;
+		}
+
+		//-------------------------------------------------
+		double	Rate	= dy / (u1 - u0);
+
+		if( u1 > xRight )	// right of the window, full contribution to all cells
+		{
+			Full[0]	+= Rate * (u1 - M_GET_MAX(u0, xRight));
+
+			u1	= xRight;
+		}
+
+		if( u0 < xLeft )	// left of the window, no contribution
+		{
+			u0	= xLeft;
+		}
+
+		for(int x=(int)floor(u0 + 0.5); u0<u1; x++)
+		{
+			double	v	= M_GET_MIN(u1, x + 0.5), d = Rate * (v - u0);
+
+			Coverage[x - m_xMin]	+= (0.5 * (u0 + v) - (x - 0.5)) * d;	Full[0]	+= d;	Full[x - m_xMin]	-= d;
+
+			u0	= v;
+		}
+	}
+
+	//-----------------------------------------------------
+	double	Sum	= 0.;
+
+	for(int x=0; x<nx; x++)
+	{
+		Sum	+= Full[x];
+
+		double	f	= Coverage[x] + Sum;
+
+		Coverage[x]	= f < 0. ? 0. : f > 1. ? 1. : f;
+	}
+
+	return( true );
+}
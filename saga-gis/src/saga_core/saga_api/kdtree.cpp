@@ -484,6 +484,13 @@ bool CSG_KDTree_2D::Destroy(void)
 //														 //
 ///////////////////////////////////////////////////////////
 
+//---------------------------------------------------------
+/**
+* Stores the search results internally, accessible through
+* Get_Match_Count(), Get_Match_Index() and Get_Match_Distance().
+* Not re-entrant! For concurrent queries use one of the const
+* variants, which write their results into caller owned buffers.
+*/
 //---------------------------------------------------------
 size_t CSG_KDTree_2D::Get_Nearest_Points(double Coordinate[2], size_t Count, double Radius)
 {
@@ -491,7 +498,7 @@ size_t CSG_KDTree_2D::Get_Nearest_Points(double Coordinate[2], size_t Count, dou
 }
 
 //---------------------------------------------------------
-size_t CSG_KDTree_2D::Get_Nearest_Points(double Coordinate[2], size_t Count, double Radius, CSG_Array_Int &Indices, CSG_Vector &Distances)
+size_t CSG_KDTree_2D::Get_Nearest_Points(const double Coordinate[2], size_t Count, double Radius, CSG_Array_Int &Indices, CSG_Vector &Distances) const
 {
 	if( Radius > 0. )
 	{
@@ -544,7 +551,7 @@ size_t CSG_KDTree_2D::Get_Nearest_Points(double Coordinate[2], size_t Count, dou
 }
 
 //---------------------------------------------------------
-size_t CSG_KDTree_2D::Get_Nearest_Points(double Coordinate[2], size_t Count, size_t *Indices, double *Distances)
+size_t CSG_KDTree_2D::Get_Nearest_Points(const double Coordinate[2], size_t Count, size_t *Indices, double *Distances) const
 {
 	Count	= ((CSG_KDTree_Adaptor::kd_tree_2d *)m_pKDTree)->knnSearch(Coordinate, Count, Indices, Distances);
 		
@@ -557,13 +564,13 @@ size_t CSG_KDTree_2D::Get_Nearest_Points(double Coordinate[2], size_t Count, siz
 }
 
 //---------------------------------------------------------
-bool CSG_KDTree_2D::Get_Nearest_Point(double Coordinate[2], size_t &Index, double &Distance)
+bool CSG_KDTree_2D::Get_Nearest_Point(const double Coordinate[2], size_t &Index, double &Distance) const
 {
 	return( Get_Nearest_Points(Coordinate, 1, &Index, &Distance) == 1 );
 }
 
 //---------------------------------------------------------
-bool CSG_KDTree_2D::Get_Nearest_Point(double Coordinate[2], size_t &Index)
+bool CSG_KDTree_2D::Get_Nearest_Point(const double Coordinate[2], size_t &Index) const
 {
 	double	Distance;
 
@@ -571,7 +578,7 @@ bool CSG_KDTree_2D::Get_Nearest_Point(double Coordinate[2], size_t &Index)
 }
 
 //---------------------------------------------------------
-CSG_Shape * CSG_KDTree_2D::Get_Nearest_Shape(double Coordinate[2])
+CSG_Shape * CSG_KDTree_2D::Get_Nearest_Shape(const double Coordinate[2]) const
 {
 	size_t	Index;
 
@@ -580,6 +587,57 @@ CSG_Shape * CSG_KDTree_2D::Get_Nearest_Shape(double Coordinate[2])
 	return( pShapes && Get_Nearest_Point(Coordinate, Index) ? pShapes->Get_Shape((int)Index) : NULL );
 }
 
+//---------------------------------------------------------
+/**
+* Batched k-nearest neighbour search. Each row of 'Coordinates'
+* is taken as query point. 'Indices' and 'Distances' have to
+* provide room for 'Count' results per query point, the results
+* for the i-th query point start at position 'i * Count'.
+* Queries are processed in parallel. Returns the number of
+* neighbours found per query point, which is less than 'Count'
+* only if the tree holds less points.
+*/
+//---------------------------------------------------------
+size_t CSG_KDTree_2D::Get_Nearest_Points(const CSG_Matrix &Coordinates, size_t Count, size_t *Indices, double *Distances) const
+{
+	if( !is_Okay() || Coordinates.Get_NCols() < 2 || Count < 1 || !Indices || !Distances )
+	{
+		return( 0 );
+	}
+
+	#pragma omp parallel for
+	for(int i=0; i<Coordinates.Get_NRows(); i++)
+	{
+		Get_Nearest_Points(Coordinates[i], Count, Indices + i * Count, Distances + i * Count);
+	}
+
+	return( M_GET_MIN(Count, m_pAdaptor->kdtree_get_point_count()) );
+}
+
+//---------------------------------------------------------
+/**
+* Batched search, each row of 'Coordinates' is taken as query
+* point. 'Indices' and 'Distances' have to be arrays with one
+* entry per query point, which receive the results as described
+* for the single point query. Queries are processed in parallel.
+*/
+//---------------------------------------------------------
+bool CSG_KDTree_2D::Get_Nearest_Points(const CSG_Matrix &Coordinates, size_t Count, double Radius, CSG_Array_Int *Indices, CSG_Vector *Distances) const
+{
+	if( !is_Okay() || Coordinates.Get_NCols() < 2 || !Indices || !Distances )
+	{
+		return( false );
+	}
+
+	#pragma omp parallel for
+	for(int i=0; i<Coordinates.Get_NRows(); i++)
+	{
+		Get_Nearest_Points(Coordinates[i], Count, Radius, Indices[i], Distances[i]);
+	}
+
+	return( true );
+}
+
 //---------------------------------------------------------
 size_t      CSG_KDTree_2D::Get_Nearest_Points(double x, double y, size_t Count, double Radius)
 {
@@ -588,35 +646,35 @@ size_t      CSG_KDTree_2D::Get_Nearest_Points(double x, double y, size_t Count,
 	return( Get_Nearest_Points(c, Count, Radius) );
 }
 
-size_t      CSG_KDTree_2D::Get_Nearest_Points(double x, double y, size_t Count, double Radius, CSG_Array_Int &Indices, CSG_Vector &Distances)
+size_t      CSG_KDTree_2D::Get_Nearest_Points(double x, double y, size_t Count, double Radius, CSG_Array_Int &Indices, CSG_Vector &Distances) const
 {
 	double	c[2]; c[0] = x; c[1] = y;
 
 	return( Get_Nearest_Points(c, Count, Radius, Indices, Distances) );
 }
 
-size_t      CSG_KDTree_2D::Get_Nearest_Points(double x, double y, size_t Count, size_t *Indices, double *Distances)
+size_t      CSG_KDTree_2D::Get_Nearest_Points(double x, double y, size_t Count, size_t *Indices, double *Distances) const
 {
 	double	c[2]; c[0] = x; c[1] = y;
 
 	return( Get_Nearest_Points(c, Count, Indices, Distances) );
 }
 
-bool        CSG_KDTree_2D::Get_Nearest_Point(double x, double y, size_t &Index, double &Distance)
+bool        CSG_KDTree_2D::Get_Nearest_Point(double x, double y, size_t &Index, double &Distance) const
 {
 	double	c[2]; c[0] = x; c[1] = y;
 
 	return( Get_Nearest_Point(c, Index, Distance) );
 }
 
-bool        CSG_KDTree_2D::Get_Nearest_Point(double x, double y, size_t &Index)
+bool        CSG_KDTree_2D::Get_Nearest_Point(double x, double y, size_t &Index) const
 {
 	double	c[2]; c[0] = x; c[1] = y;
 
 	return( Get_Nearest_Point(c, Index) );
 }
 
-CSG_Shape * CSG_KDTree_2D::Get_Nearest_Shape(double x, double y)
+CSG_Shape * CSG_KDTree_2D::Get_Nearest_Shape(double x, double y) const
 {
 	double	c[2]; c[0] = x; c[1] = y;
 
@@ -812,6 +870,13 @@ bool CSG_KDTree_3D::Destroy(void)
 //														 //
 ///////////////////////////////////////////////////////////
 
+//---------------------------------------------------------
+/**
+* Stores the search results internally, accessible through
+* Get_Match_Count(), Get_Match_Index() and Get_Match_Distance().
+* Not re-entrant! For concurrent queries use one of the const
+* variants, which write their results into caller owned buffers.
+*/
 //---------------------------------------------------------
 size_t CSG_KDTree_3D::Get_Nearest_Points(double Coordinate[3], size_t Count, double Radius)
 {
@@ -819,7 +884,7 @@ size_t CSG_KDTree_3D::Get_Nearest_Points(double Coordinate[3], size_t Count, dou
 }
 
 //---------------------------------------------------------
-size_t CSG_KDTree_3D::Get_Nearest_Points(double Coordinate[3], size_t Count, double Radius, CSG_Array_Int &Indices, CSG_Vector &Distances)
+size_t CSG_KDTree_3D::Get_Nearest_Points(const double Coordinate[3], size_t Count, double Radius, CSG_Array_Int &Indices, CSG_Vector &Distances) const
 {
 	if( Radius > 0. )
 	{
@@ -872,7 +937,7 @@ size_t CSG_KDTree_3D::Get_Nearest_Points(double Coordinate[3], size_t Count, dou
 }
 
 //---------------------------------------------------------
-size_t CSG_KDTree_3D::Get_Nearest_Points(double Coordinate[3], size_t Count, size_t *Indices, double *Distances)
+size_t CSG_KDTree_3D::Get_Nearest_Points(const double Coordinate[3], size_t Count, size_t *Indices, double *Distances) const
 {
 	Count	= ((CSG_KDTree_Adaptor::kd_tree_3d *)m_pKDTree)->knnSearch(Coordinate, Count, Indices, Distances);
 
@@ -885,13 +950,13 @@ size_t CSG_KDTree_3D::Get_Nearest_Points(double Coordinate[3], size_t Count, siz
 }
 
 //---------------------------------------------------------
-bool CSG_KDTree_3D::Get_Nearest_Point(double Coordinate[3], size_t &Index, double &Distance)
+bool CSG_KDTree_3D::Get_Nearest_Point(const double Coordinate[3], size_t &Index, double &Distance) const
 {
 	return( Get_Nearest_Points(Coordinate, 1, &Index, &Distance) == 1 );
 }
 
 //---------------------------------------------------------
-bool CSG_KDTree_3D::Get_Nearest_Point(double Coordinate[3], size_t &Index)
+bool CSG_KDTree_3D::Get_Nearest_Point(const double Coordinate[3], size_t &Index) const
 {
 	double	Distance;
 
@@ -899,7 +964,7 @@ bool CSG_KDTree_3D::Get_Nearest_Point(double Coordinate[3], size_t &Index)
 }
 
 //---------------------------------------------------------
-CSG_Shape * CSG_KDTree_3D::Get_Nearest_Shape(double Coordinate[3])
+CSG_Shape * CSG_KDTree_3D::Get_Nearest_Shape(const double Coordinate[3]) const
 {
 	size_t	Index;
 
@@ -908,6 +973,57 @@ CSG_Shape * CSG_KDTree_3D::Get_Nearest_Shape(double Coordinate[3])
 	return( pShapes && Get_Nearest_Point(Coordinate, Index) ? pShapes->Get_Shape((int)Index) : NULL );
 }
 
+//---------------------------------------------------------
+/**
+* Batched k-nearest neighbour search. Each row of 'Coordinates'
+* is taken as query point. 'Indices' and 'Distances' have to
+* provide room for 'Count' results per query point, the results
+* for the i-th query point start at position 'i * Count'.
+* Queries are processed in parallel. Returns the number of
+* neighbours found per query point, which is less than 'Count'
+* only if the tree holds less points.
+*/
+//---------------------------------------------------------
+size_t CSG_KDTree_3D::Get_Nearest_Points(const CSG_Matrix &Coordinates, size_t Count, size_t *Indices, double *Distances) const
+{
+	if( !is_Okay() || Coordinates.Get_NCols() < 3 || Count < 1 || !Indices || !Distances )
+	{
+		return( 0 );
+	}
+
+	#pragma omp parallel for
+	for(int i=0; i<Coordinates.Get_NRows(); i++)
+	{
+		Get_Nearest_Points(Coordinates[i], Count, Indices + i * Count, Distances + i * Count);
+	}
+
+	return( M_GET_MIN(Count, m_pAdaptor->kdtree_get_point_count()) );
+}
+
+//---------------------------------------------------------
+/**
+* Batched search, each row of 'Coordinates' is taken as query
+* point. 'Indices' and 'Distances' have to be arrays with one
+* entry per query point, which receive the results as described
+* for the single point query. Queries are processed in parallel.
+*/
+//---------------------------------------------------------
+bool CSG_KDTree_3D::Get_Nearest_Points(const CSG_Matrix &Coordinates, size_t Count, double Radius, CSG_Array_Int *Indices, CSG_Vector *Distances) const
+{
+	if( !is_Okay() || Coordinates.Get_NCols() < 3 || !Indices || !Distances )
+	{
+		return( false );
+	}
+
+	#pragma omp parallel for
+	for(int i=0; i<Coordinates.Get_NRows(); i++)
+	{
+		Get_Nearest_Points(Coordinates[i], Count, Radius, Indices[i], Distances[i]);
+	}
+
+	return( true );
+}
+
 //---------------------------------------------------------
 size_t      CSG_KDTree_3D::Get_Nearest_Points(double x, double y, double z, size_t Count, double Radius)
 {
@@ -916,35 +1032,35 @@ size_t      CSG_KDTree_3D::Get_Nearest_Points(double x, double y, double z, size
 	return( Get_Nearest_Points(c, Count, Radius) );
 }
 
-size_t      CSG_KDTree_3D::Get_Nearest_Points(double x, double y, double z, size_t Count, double Radius, CSG_Array_Int &Indices, CSG_Vector &Distances)
+size_t      CSG_KDTree_3D::Get_Nearest_Points(double x, double y, double z, size_t Count, double Radius, CSG_Array_Int &Indices, CSG_Vector &Distances) const
 {
 	double	c[3]; c[0] = x; c[1] = y; c[2] = z;
 
 	return( Get_Nearest_Points(c, Count, Radius, Indices, Distances) );
 }
 
-size_t      CSG_KDTree_3D::Get_Nearest_Points(double x, double y, double z, size_t Count, size_t *Indices, double *Distances)
+size_t      CSG_KDTree_3D::Get_Nearest_Points(double x, double y, double z, size_t Count, size_t *Indices, double *Distances) const
 {
 	double	c[3]; c[0] = x; c[1] = y; c[2] = z;
 
 	return( Get_Nearest_Points(c, Count, Indices, Distances) );
 }
 
-bool        CSG_KDTree_3D::Get_Nearest_Point(double x, double y, double z, size_t &Index, double &Distance)
+bool        CSG_KDTree_3D::Get_Nearest_Point(double x, double y, double z, size_t &Index, double &Distance) const
 {
 	double	c[3]; c[0] = x; c[1] = y; c[2] = z;
 
 	return( Get_Nearest_Point(c, Index, Distance) );
 }
 
-bool        CSG_KDTree_3D::Get_Nearest_Point(double x, double y, double z, size_t &Index)
+bool        CSG_KDTree_3D::Get_Nearest_Point(double x, double y, double z, size_t &Index) const
 {
 	double	c[3]; c[0] = x; c[1] = y; c[2] = z;
 
 	return( Get_Nearest_Point(c, Index) );
 }
 
-CSG_Shape * CSG_KDTree_3D::Get_Nearest_Shape(double x, double y, double z)
+CSG_Shape * CSG_KDTree_3D::Get_Nearest_Shape(double x, double y, double z) const
 {
 	double	c[3]; c[0] = x; c[1] = y; c[2] = z;
 
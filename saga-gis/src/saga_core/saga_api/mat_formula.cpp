@@ -68,6 +68,7 @@
 #include <stdarg.h>
 #include <errno.h>
 #include <ctype.h>
+#include <float.h>
 
 #include "mat_tools.h"
 #include "grid.h"
@@ -88,6 +89,8 @@
 //---------------------------------------------------------
 #define GET_VALUE_BUFSIZE	500
 
+#define GET_VALUES_BLOCK	256
+
 //---------------------------------------------------------
 #define EPSILON				1e-9
 
@@ -653,6 +656,196 @@ double CSG_Formula::_Get_Value(const double *Parameters, TSG_Formula func) const
 } 
 
 
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+  * Evaluates the formula for nValues rows at once. Columns
+  * supplies one array of nValues input values for each of the
+  * first nColumns variables ('a', 'b', ...), remaining variables
+  * are taken from the values given by Set_Variable(). Columns
+  * may contain NULL pointers for unused variables. The code is
+  * interpreted once per block of rows and each operation runs
+  * as a simple loop over the block. If NoData is not NULL it
+  * is expected to have nValues elements, which flag rows with
+  * invalid input on entry. On return rows with a non-finite
+  * result are flagged too. Rows that are flagged on entry are
+  * evaluated anyway, so their input should be any valid number.
+*/
+//---------------------------------------------------------
+bool CSG_Formula::Get_Values(const double **Columns, int nColumns, double *Result, sLong nValues, BYTE *NoData) const
+{
+	if( !m_Formula.code || !Result || nValues < 1 )
+	{
+		return( false );
+	}
+
+	CSG_Array	Stack(sizeof(double), (size_t)_Get_Stack_Size() * GET_VALUES_BLOCK);
+
+	for(sLong Offset=0; Offset<nValues; Offset+=GET_VALUES_BLOCK)
+	{
+		int	n	= (int)(nValues - Offset < GET_VALUES_BLOCK ? nValues - Offset : GET_VALUES_BLOCK);
+
+		double	*r	= (double *)Stack.Get_Array();
+
+		if( !_Get_Values(r, Columns, nColumns, Offset, n) )
+		{
+			return( false );
+		}
+
+		memcpy(Result + Offset, r, n * sizeof(double));
+
+		if( NoData )
+		{
+			BYTE	*m	= NoData + Offset;
+
+			for(int i=0; i<n; i++)
+			{
+				m[i]	= m[i] || !(fabs(r[i]) <= DBL_MAX) ? 1 : 0;	// not finite
+			}
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+int CSG_Formula::_Get_Stack_Size(void) const
+{
+	int	n	= 0, nMax = 1;
+
+	for(const char *function=m_Formula.code; *function; )
+	{
+		switch( *function++ )
+		{
+		case 'D': case 'V':	n++; function++; break;
+		case 'M':	break;
+		case 'F':	n	+= 1 - m_Functions[*function++].nParameters; break;
+		default :	n--; break;
+		}
+
+		if( nMax < n )
+		{
+			nMax	= n;
+		}
+	}
+
+	return( nMax );
+}
+
+//---------------------------------------------------------
+#define VALUES_UNARY(op)		{ double *x = bufp - GET_VALUES_BLOCK;                                 for(int i=0; i<n; i++) { x[i] = op; } }
+#define VALUES_BINARY(op)		{ double *y = bufp - GET_VALUES_BLOCK, *x = y - GET_VALUES_BLOCK;      for(int i=0; i<n; i++) { x[i] = op; } bufp = y; }
+#define VALUES_TERNARY(op)		{ double *z = bufp - GET_VALUES_BLOCK, *y = z - GET_VALUES_BLOCK, *x = y - GET_VALUES_BLOCK; for(int i=0; i<n; i++) { x[i] = op; } bufp = y; }
+
+//---------------------------------------------------------
+bool CSG_Formula::_Get_Values(double *Stack, const double **Columns, int nColumns, sLong Offset, int n) const
+{
+	double	*bufp	= Stack;	// points to the first free block in the stack
+	char	*function	= m_Formula.code;
+
+	for( ; ; )
+	{
+		switch( *function++ )
+		{
+		case '\0':
+			return( true );
+
+		case 'D': {
+			double	c	= m_Formula.ctable[*function++];
+
+			for(int i=0; i<n; i++) { bufp[i] = c; }
+
+			bufp	+= GET_VALUES_BLOCK;
+			break; }
+
+		case 'V': {
+			int	iVar	= (*function++) - 'a';
+
+			if( iVar < nColumns && Columns[iVar] )
+			{
+				memcpy(bufp, Columns[iVar] + Offset, n * sizeof(double));
+			}
+			else
+			{
+				double	c	= m_Parameters[iVar];
+
+				for(int i=0; i<n; i++) { bufp[i] = c; }
+			}
+
+			bufp	+= GET_VALUES_BLOCK;
+			break; }
+
+		case 'M': VALUES_UNARY (-x[i]                          ); break;
+		case '+': VALUES_BINARY(x[i] + y[i]                    ); break;
+		case '-': VALUES_BINARY(x[i] - y[i]                    ); break;
+		case '*': VALUES_BINARY(x[i] * y[i]                    ); break;
+		case '/': VALUES_BINARY(x[i] / y[i]                    ); break;
+		case '^': VALUES_BINARY(pow(x[i], y[i])                ); break;
+		case '=': VALUES_BINARY(x[i] == y[i] ? 1.0 : 0.0       ); break;
+		case '>': VALUES_BINARY(x[i] >  y[i] ? 1.0 : 0.0       ); break;
+		case '<': VALUES_BINARY(x[i] <  y[i] ? 1.0 : 0.0       ); break;
+		case '&': VALUES_BINARY(x[i] && y[i] ? 1.0 : 0.0       ); break;
+		case '|': VALUES_BINARY(x[i] || y[i] ? 1.0 : 0.0       ); break;
+
+		//-------------------------------------------------
+		case 'F': {
+			const TSG_Function	&F	= m_Functions[*function++];
+
+			switch( F.nParameters )
+			{
+			case 0:
+				if( F.bVarying )
+				{
+					for(int i=0; i<n; i++) { bufp[i] = ((TSG_Formula_Function_0)F.Function)(); }
+				}
+				else
+				{
+					double	c	= ((TSG_Formula_Function_0)F.Function)();
+
+					for(int i=0; i<n; i++) { bufp[i] = c; }
+				}
+
+				bufp	+= GET_VALUES_BLOCK;
+				break;
+
+			case 1:	// built-in functions get their own loops
+				if     ( F.Function == (TSG_Formula_Function_1)fabs  ) VALUES_UNARY(fabs(x[i])           )
+				else if( F.Function == (TSG_Formula_Function_1)sqrt  ) VALUES_UNARY(sqrt(x[i])           )
+				else if( F.Function == (TSG_Formula_Function_1)f_sqr ) VALUES_UNARY(x[i] * x[i]          )
+				else if( F.Function == (TSG_Formula_Function_1)f_int ) VALUES_UNARY((double)(int)x[i]    )
+				else VALUES_UNARY(((TSG_Formula_Function_1)F.Function)(x[i]))
+				break;
+
+			case 2:
+				if     ( F.Function == (TSG_Formula_Function_1)f_min ) VALUES_BINARY(x[i] < y[i] ? x[i] : y[i])
+				else if( F.Function == (TSG_Formula_Function_1)f_max ) VALUES_BINARY(x[i] > y[i] ? x[i] : y[i])
+				else if( F.Function == (TSG_Formula_Function_1)f_gt  ) VALUES_BINARY(x[i] > y[i] ? 1.0 : 0.0)
+				else if( F.Function == (TSG_Formula_Function_1)f_lt  ) VALUES_BINARY(x[i] < y[i] ? 1.0 : 0.0)
+				else if( F.Function == (TSG_Formula_Function_1)f_and ) VALUES_BINARY(x[i] != 0.0 && y[i] != 0.0 ? 1.0 : 0.0)
+				else if( F.Function == (TSG_Formula_Function_1)f_or  ) VALUES_BINARY(x[i] != 0.0 || y[i] != 0.0 ? 1.0 : 0.0)
+				else VALUES_BINARY(((TSG_Formula_Function_2)F.Function)(x[i], y[i]))
+				break;
+
+			case 3:
+				if     ( F.Function == (TSG_Formula_Function_1)f_ifelse ) VALUES_TERNARY(x[i] ? y[i] : z[i])
+				else VALUES_TERNARY(((TSG_Formula_Function_3)F.Function)(x[i], y[i], z[i]))
+				break;
+
+			default:
+				return( false );	// _Set_Error(_TL("I2: too many parameters"));
+			}
+			break; }
+
+		default:
+			return( false );	// _Set_Error(_TL("I1: unrecognizable operator"));
+		}
+	}
+}
+
+
 ///////////////////////////////////////////////////////////
 //                                                       //
 //                                                       //
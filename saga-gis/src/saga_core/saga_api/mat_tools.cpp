@@ -1633,11 +1633,30 @@ bool CSG_Histogram::Create(size_t nClasses, double Minimum, double Maximum, CSG_
 	}
 
 	//-----------------------------------------------------
-	for(sLong i=0; i<pGrid->Get_NCells(); i++)
+	#pragma omp parallel
 	{
-		if( !pGrid->is_NoData(i) )
+		CSG_Histogram	Histogram;	Histogram._Create(m_nClasses, m_Minimum, m_Maximum);
+
+		#pragma omp for
+		for(int y=0; y<pGrid->Get_NY(); y++)
+		{
+			for(int x=0; x<pGrid->Get_NX(); x++)
+			{
+				if( !pGrid->is_NoData(x, y) )
+				{
+					Histogram.Add_Value(pGrid->asDouble(x, y));
+				}
+			}
+		}
+
+		#pragma omp critical
 		{
-			Add_Value(pGrid->asDouble(i));
+			m_Statistics	+= Histogram.m_Statistics;
+
+			for(size_t i=0; i<m_nClasses; i++)
+			{
+				m_Elements[i]	+= Histogram.m_Elements[i];
+			}
 		}
 	}
 
@@ -1980,6 +1999,7 @@ bool CSG_Natural_Breaks::_Calculate(int nClasses)
 //---------------------------------------------------------
 CSG_Cluster_Analysis::CSG_Cluster_Analysis(void)
 {
+	m_bFloat	= false;
 	m_nFeatures	= 0;
 	m_Iteration	= 0;
 }
@@ -2005,7 +2025,14 @@ bool CSG_Cluster_Analysis::Destroy(void)
 }
 
 //---------------------------------------------------------
-bool CSG_Cluster_Analysis::Create(int nFeatures)
+/**
+* Features are stored with double precision by default. Use
+* SG_DATATYPE_Float as data type to halve the memory needed
+* for large numbers of elements. Centroids and variances are
+* always calculated with double precision.
+*/
+//---------------------------------------------------------
+bool CSG_Cluster_Analysis::Create(int nFeatures, TSG_Data_Type Data_Type)
 {
 	Destroy();
 
@@ -2013,7 +2040,9 @@ bool CSG_Cluster_Analysis::Create(int nFeatures)
 	{
 		m_nFeatures	= nFeatures;
 
-		m_Features.Create(m_nFeatures * sizeof(double), 0, SG_ARRAY_GROWTH_3);
+		m_bFloat	= Data_Type == SG_DATATYPE_Float;
+
+		m_Features.Create(m_nFeatures * (m_bFloat ? sizeof(float) : sizeof(double)), 0, SG_ARRAY_GROWTH_3);
 
 		return( true );
 	}
@@ -2032,7 +2061,14 @@ bool CSG_Cluster_Analysis::Set_Feature(int iElement, int iFeature, double Value)
 {
 	if( iElement >= 0 && iElement < Get_nElements() && iFeature >= 0 && iFeature < m_nFeatures )
 	{
-		((double *)m_Features.Get_Entry(iElement))[iFeature]	= Value;
+		if( m_bFloat )
+		{
+			((float  *)m_Features.Get_Entry(iElement))[iFeature]	= (float)Value;
+		}
+		else
+		{
+			((double *)m_Features.Get_Entry(iElement))[iFeature]	= Value;
+		}
 
 		return( true );
 	}
@@ -2044,14 +2080,17 @@ bool CSG_Cluster_Analysis::Set_Feature(int iElement, int iFeature, double Value)
 /**
 * Performs the cluster analysis using the features added prior
 * to this step. Method is minimum distance (= default), hill
-* climbing (= 1), or both methods in combination. If nMaxIterations
-* is set to zero, the analysis is iterated until it converges.
+* climbing (= 1), both methods in combination (= 2), or mini-batch
+* k-means (= 3). If nMaxIterations is set to zero, the analysis
+* is iterated until it converges. Mini-batch k-means counts each
+* batch as one iteration and takes Batch_Size randomly drawn
+* elements per batch (default is 1024).
 * Initilization is done randomely (= default), periodically (= 1),
-* or skipped (= 2). The latter case allows starting the clustering
-* with user supplied start partitions.
+* skipped (= 2), or with k-means++ seeding (= 3). Skipping allows
+* starting the clustering with user supplied start partitions.
 */
 //---------------------------------------------------------
-bool CSG_Cluster_Analysis::Execute(int Method, int nClusters, int nMaxIterations, int Initialization)
+bool CSG_Cluster_Analysis::Execute(int Method, int nClusters, int nMaxIterations, int Initialization, int Batch_Size)
 {
 	if( Get_nElements() < 2 || nClusters < 2 )
 	{
@@ -2089,9 +2128,20 @@ bool CSG_Cluster_Analysis::Execute(int Method, int nClusters, int nMaxIterations
 				m_Clusters[iElement]	= iElement % nClusters;
 			}
 			break;
+
+		case  3:	// k-means++, nearest seed
+			{
+				m_Clusters[iElement]	= 0;
+			}
+			break;
 		}
 	}
 
+	if( Initialization == 3 && !_Set_Seeds() )
+	{
+		return( false );
+	}
+
 	//-----------------------------------------------------
 	bool	bResult;
 
@@ -2103,6 +2153,7 @@ bool CSG_Cluster_Analysis::Execute(int Method, int nClusters, int nMaxIterations
 	case  1: bResult = _Hill_Climbing   (true , nMaxIterations);	break;
 	case  2: bResult = _Minimum_Distance(true , nMaxIterations)
 				&&     _Hill_Climbing   (false, nMaxIterations);	break;
+	case  3: bResult = _Mini_Batch      (nMaxIterations, Batch_Size);	break;
 	}
 
 	//-----------------------------------------------------
@@ -2117,99 +2168,405 @@ bool CSG_Cluster_Analysis::Execute(int Method, int nClusters, int nMaxIterations
 	return( bResult );
 }
 
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
 //---------------------------------------------------------
-bool CSG_Cluster_Analysis::_Minimum_Distance(bool bInitialize, int nMaxIterations)
+double CSG_Cluster_Analysis::_Get_Distance(int iElement, const double *Centroid)	const
 {
-	int		iElement, iCluster, nClusters	= m_Variance.Get_N();
+	double	Distance	= 0.;
 
-	double	SP_Last	= -1.;
+	if( m_bFloat )
+	{
+		const float	*Feature	= (const float  *)m_Features.Get_Entry(iElement);
+
+		for(int iFeature=0; iFeature<m_nFeatures; iFeature++)
+		{
+			Distance	+= SG_Get_Square(Centroid[iFeature] - Feature[iFeature]);
+		}
+	}
+	else
+	{
+		const double	*Feature	= (const double *)m_Features.Get_Entry(iElement);
+
+		for(int iFeature=0; iFeature<m_nFeatures; iFeature++)
+		{
+			Distance	+= SG_Get_Square(Centroid[iFeature] - Feature[iFeature]);
+		}
+	}
+
+	return( Distance );
+}
+
+//---------------------------------------------------------
+/**
+* Returns the nearest centroid and the squared distances to
+* the nearest and to the second nearest centroid.
+*/
+//---------------------------------------------------------
+int CSG_Cluster_Analysis::_Get_Nearest(int iElement, double &Distance, double &Second)	const
+{
+	int	minCluster	= -1;
+
+	Distance	= Second	= -1.;
+
+	for(int iCluster=0; iCluster<Get_nClusters(); iCluster++)
+	{
+		double	d	= _Get_Distance(iElement, m_Centroid[iCluster]);
+
+		if( minCluster < 0 || d < Distance )
+		{
+			Second		= Distance;
+			Distance	= d;
+			minCluster	= iCluster;
+		}
+		else if( Second < 0. || d < Second )
+		{
+			Second		= d;
+		}
+	}
+
+	return( minCluster );
+}
+
+//---------------------------------------------------------
+/**
+* Calculates the centroids and number of members from the
+* current partition. Each thread sums up its own copy of
+* the centroids, these are merged afterwards.
+*/
+//---------------------------------------------------------
+void CSG_Cluster_Analysis::_Set_Centroids(void)
+{
+	int	nClusters = Get_nClusters(), nThreads = SG_OMP_Get_Max_Num_Threads(), *Clusters = m_Clusters.Get_Array();
+
+	CSG_Vector	Sum((size_t)nThreads * nClusters * m_nFeatures), Count((size_t)nThreads * nClusters);
+
+	double	*pSum = Sum.Get_Data(), *pCount = Count.Get_Data();
+
+	#pragma omp parallel for
+	for(int iElement=0; iElement<Get_nElements(); iElement++)
+	{
+		int	iCluster	= nClusters * SG_OMP_Get_Thread_Num() + Clusters[iElement];
+
+		double	*Centroid	= pSum + (size_t)iCluster * m_nFeatures;
+
+		for(int iFeature=0; iFeature<m_nFeatures; iFeature++)
+		{
+			Centroid[iFeature]	+= _Get_Feature(iElement, iFeature);
+		}
+
+		pCount[iCluster]++;
+	}
 
 	//-----------------------------------------------------
-	for(m_Iteration=1; SG_UI_Process_Get_Okay(); m_Iteration++)
+	for(int iCluster=0; iCluster<nClusters; iCluster++)
+	{
+		double	n	= 0.;
+
+		for(int iThread=0; iThread<nThreads; iThread++)
+		{
+			n	+= pCount[nClusters * iThread + iCluster];
+		}
+
+		m_nMembers[iCluster]	= (int)n;
+
+		for(int iFeature=0; iFeature<m_nFeatures; iFeature++)
+		{
+			double	s	= 0.;
+
+			for(int iThread=0; iThread<nThreads; iThread++)
+			{
+				s	+= pSum[(size_t)(nClusters * iThread + iCluster) * m_nFeatures + iFeature];
+			}
+
+			m_Centroid[iCluster][iFeature]	= n > 0. ? s / n : 0.;
+		}
+	}
+}
+
+//---------------------------------------------------------
+void CSG_Cluster_Analysis::_Set_Variance(void)
+{
+	int	nClusters = Get_nClusters(), nThreads = SG_OMP_Get_Max_Num_Threads(), *Clusters = m_Clusters.Get_Array();
+
+	CSG_Vector	Variance((size_t)nThreads * nClusters);
+
+	double	*pVariance	= Variance.Get_Data();
+
+	#pragma omp parallel for
+	for(int iElement=0; iElement<Get_nElements(); iElement++)
+	{
+		pVariance[nClusters * SG_OMP_Get_Thread_Num() + Clusters[iElement]]	+= _Get_Distance(iElement, m_Centroid[Clusters[iElement]]);
+	}
+
+	m_SP		= 0.;
+	m_Variance	= 0.;
+
+	for(int iCluster=0; iCluster<nClusters; iCluster++)
+	{
+		for(int iThread=0; iThread<nThreads; iThread++)
+		{
+			m_Variance[iCluster]	+= pVariance[nClusters * iThread + iCluster];
+		}
+
+		m_SP	+= m_Variance[iCluster];
+	}
+
+	m_SP	/= Get_nElements();
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+* k-means++ seeding (Arthur & Vassilvitskii 2007). Each seed
+* is drawn with a probability proportional to the squared
+* distance to the nearest seed chosen so far. The elements
+* are assigned to their nearest seed.
+*/
+//---------------------------------------------------------
+bool CSG_Cluster_Analysis::_Set_Seeds(void)
+{
+	int	nClusters = Get_nClusters(), nElements = Get_nElements(), *Clusters = m_Clusters.Get_Array();
+
+	CSG_Array	Distance(sizeof(float), nElements);
+
+	float	*pDistance	= (float *)Distance.Get_Array();
+
+	if( !pDistance )
 	{
-		m_Variance	= 0.;
-		m_Centroid	= 0.;
-		m_nMembers	= 0;
+		return( false );
+	}
+
+	const int	nChunks	= 256;	// partial sums for a faster weighted drawing
+
+	CSG_Vector	Chunks(nChunks);
+
+	double	*pChunks	= Chunks.Get_Data();
+
+	//-----------------------------------------------------
+	int	iSeed	= (int)CSG_Random::Get_Uniform(0, nElements); if( iSeed >= nElements ) { iSeed = nElements - 1; }
+
+	for(int iCluster=0; iCluster<nClusters && SG_UI_Process_Get_Okay(); iCluster++)
+	{
+		double	*Centroid	= m_Centroid[iCluster];
+
+		for(int iFeature=0; iFeature<m_nFeatures; iFeature++)
+		{
+			Centroid[iFeature]	= _Get_Feature(iSeed, iFeature);
+		}
+
+		#pragma omp parallel for
+		for(int iChunk=0; iChunk<nChunks; iChunk++)
+		{
+			int	iEnd	= (int)(((sLong)nElements * (iChunk + 1)) / nChunks);
+
+			pChunks[iChunk]	= 0.;
+
+			for(int iElement=(int)(((sLong)nElements * iChunk) / nChunks); iElement<iEnd; iElement++)
+			{
+				double	d	= _Get_Distance(iElement, Centroid);
+
+				if( iCluster == 0 || d < pDistance[iElement] )
+				{
+					pDistance[iElement]	= (float)d;
+					Clusters [iElement]	= iCluster;
+				}
+
+				pChunks[iChunk]	+= pDistance[iElement];
+			}
+		}
 
 		//-------------------------------------------------
-		for(iElement=0; iElement<Get_nElements(); iElement++)
+		if( iCluster < nClusters - 1 )
 		{
-			m_nMembers[iCluster = m_Clusters[iElement]]++;
+			double	Sum	= 0.;
 
-			double	*Feature	= (double *)m_Features.Get_Entry(iElement);
+			for(int iChunk=0; iChunk<nChunks; iChunk++)
+			{
+				Sum	+= pChunks[iChunk];
+			}
 
-			for(int iFeature=0; iFeature<m_nFeatures; iFeature++)
+			double	r	= CSG_Random::Get_Uniform(0, Sum);
+
+			int	iChunk	= 0;
+
+			while( iChunk < nChunks - 1 && r >= pChunks[iChunk] )
 			{
-				m_Centroid[iCluster][iFeature]	+= Feature[iFeature];
+				r	-= pChunks[iChunk++];
+			}
+
+			int	iEnd	= (int)(((sLong)nElements * (iChunk + 1)) / nChunks);
+
+			for(iSeed=(int)(((sLong)nElements * iChunk) / nChunks); iSeed<iEnd - 1; iSeed++)
+			{
+				if( (r -= pDistance[iSeed]) < 0. )
+				{
+					break;
+				}
 			}
 		}
+	}
+
+	return( SG_UI_Process_Get_Okay() );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+* Iterative minimum distance with Hamerly's (2010) bounds.
+* For each element an upper bound of the distance to its
+* centroid and a lower bound of the distance to any other
+* centroid are kept and updated with the centroid shifts.
+* The distances to all centroids are only calculated if
+* the bounds cannot exclude a change of the assignment.
+* Bounds are stored with single precision, rounded towards
+* the safe side.
+*/
+//---------------------------------------------------------
+bool CSG_Cluster_Analysis::_Minimum_Distance(bool bInitialize, int nMaxIterations)
+{
+	int	nClusters = Get_nClusters(), *Clusters = m_Clusters.Get_Array();
+
+	CSG_Array	Upper(sizeof(float), Get_nElements()), Lower(sizeof(float), Get_nElements());
+
+	float	*pUpper = (float *)Upper.Get_Array(), *pLower = (float *)Lower.Get_Array();
+
+	if( !pUpper || !pLower )
+	{
+		return( false );
+	}
+
+	CSG_Matrix	Centroid;
+	CSG_Vector	Shift(nClusters), Half(nClusters);
+
+	//-----------------------------------------------------
+	for(m_Iteration=1; SG_UI_Process_Get_Okay(); m_Iteration++)
+	{
+		Centroid	= m_Centroid;
+
+		_Set_Centroids();
 
 		//-------------------------------------------------
-		for(iCluster=0; iCluster<nClusters; iCluster++)
+		int		maxCluster	= -1;
+		double	maxShift[2]	= { 0., 0. };	// largest and second largest centroid shift
+
+		for(int iCluster=0; iCluster<nClusters; iCluster++)
 		{
-			double	d	= m_nMembers[iCluster] > 0 ? 1. / m_nMembers[iCluster] : 0.;
+			double	d	= 0.;
 
 			for(int iFeature=0; iFeature<m_nFeatures; iFeature++)
 			{
-				m_Centroid[iCluster][iFeature]	*= d;
+				d	+= SG_Get_Square(m_Centroid[iCluster][iFeature] - Centroid[iCluster][iFeature]);
+			}
+
+			if( (Shift[iCluster] = sqrt(d)) > maxShift[0] )
+			{
+				maxShift[1]	= maxShift[0];
+				maxShift[0]	= Shift[iCluster];
+				maxCluster	= iCluster;
+			}
+			else if( Shift[iCluster] > maxShift[1] )
+			{
+				maxShift[1]	= Shift[iCluster];
+			}
+
+			//---------------------------------------------
+			double	dMin	= -1.;
+
+			for(int jCluster=0; jCluster<nClusters; jCluster++)
+			{
+				if( jCluster != iCluster )
+				{
+					d	= 0.;
+
+					for(int iFeature=0; iFeature<m_nFeatures; iFeature++)
+					{
+						d	+= SG_Get_Square(m_Centroid[iCluster][iFeature] - m_Centroid[jCluster][iFeature]);
+					}
+
+					if( dMin < 0. || d < dMin )
+					{
+						dMin	= d;
+					}
+				}
 			}
+
+			Half[iCluster]	= sqrt(dMin) / 2.;	// half distance to the nearest other centroid
 		}
 
 		//-------------------------------------------------
 		int	nShifts	= 0;
 
-		m_SP	= 0.;
-
-		for(iElement=0; iElement<Get_nElements(); iElement++)
+		#pragma omp parallel for reduction(+:nShifts)
+		for(int iElement=0; iElement<Get_nElements(); iElement++)
 		{
-			double	*Feature	= (double *)m_Features.Get_Entry(iElement);
+			int		iCluster	= Clusters[iElement];
 
-			double	minVariance	= -1.;
-			int		minCluster	= -1;
+			bool	bScan	= true;
 
-			for(iCluster=0; iCluster<nClusters; iCluster++)
+			double	u, l;
+
+			if( m_Iteration > 1 )
 			{
-				double	Variance	= 0.;
+				u	= pUpper[iElement] + Shift[iCluster];
+				l	= pLower[iElement] - maxShift[iCluster == maxCluster ? 1 : 0];
 
-				for(int iFeature=0; iFeature<m_nFeatures; iFeature++)
-				{
-					Variance	+= SG_Get_Square(m_Centroid[iCluster][iFeature] - Feature[iFeature]);
-				}
+				double	m	= Half[iCluster] > l ? Half[iCluster] : l;
 
-				if( minVariance < 0. || Variance < minVariance )
+				if( u > m )	// tighten the upper bound
 				{
-					minVariance	= Variance;
-					minCluster	= iCluster;
+					u	= sqrt(_Get_Distance(iElement, m_Centroid[iCluster]));
 				}
+
+				bScan	= u > m;
 			}
 
-			if( m_Clusters[iElement] != minCluster )
+			if( bScan )
 			{
-				m_Clusters[iElement]	= minCluster;
+				double	d1, d2;	int	jCluster	= _Get_Nearest(iElement, d1, d2);
+
+				u	= sqrt(d1);
+				l	= sqrt(d2);
 
-				nShifts++;
+				if( jCluster != iCluster )
+				{
+					Clusters[iElement]	= jCluster;
+
+					nShifts++;
+				}
 			}
 
-			m_SP					+= minVariance;
-			m_Variance[minCluster]	+= minVariance;
+			pUpper[iElement]	= (float)(u * (1. + 1e-6));
+			pLower[iElement]	= (float)(l * (1. - 1e-6));
 		}
 
 		//-------------------------------------------------
-		m_SP	/= Get_nElements();
-
-		SG_UI_Process_Set_Text(CSG_String::Format("%s: %d >> %s %f",
-			_TL("pass"  ), m_Iteration,
-			_TL("change"), m_Iteration < 2 ? m_SP : SP_Last - m_SP
+		SG_UI_Process_Set_Text(CSG_String::Format("%s: %d >> %s %d",
+			_TL("pass"   ), m_Iteration,
+			_TL("changes"), nShifts
 		));
 
-		SP_Last	 = m_SP;
-
 		if( nShifts == 0 || (nMaxIterations > 0 && nMaxIterations <= m_Iteration) )
 		{
-			return( true );
+			break;
 		}
 	}
 
+	//-----------------------------------------------------
+	_Set_Centroids();
+	_Set_Variance ();
+
 	return( true );
 }
 
@@ -2227,11 +2584,9 @@ bool CSG_Cluster_Analysis::_Hill_Climbing(bool bInitialize, int nMaxIterations)
 	{
 		m_nMembers[iCluster = m_Clusters[iElement]]++;
 
-		double	*Feature	= (double *)m_Features.Get_Entry(iElement);
-
 		for(int iFeature=0; iFeature<m_nFeatures; iFeature++)
 		{
-			double	d	 = Feature[iFeature];
+			double	d	 = _Get_Feature(iElement, iFeature);
 
 			m_Centroid[iCluster][iFeature]	+= d;
 			m_Variance[iCluster]          	+= d*d;
@@ -2263,14 +2618,7 @@ bool CSG_Cluster_Analysis::_Hill_Climbing(bool bInitialize, int nMaxIterations)
 
 			if( noShift++ < Get_nElements() && m_nMembers[iCluster] > 1 )
 			{
-				int	iFeature; double *Feature	= (double *)m_Features.Get_Entry(iElement);
-
-				double	V1, V2, Variance	= 0.;
-
-				for(iFeature=0; iFeature<m_nFeatures; iFeature++)
-				{
-					Variance	+= SG_Get_Square(m_Centroid[iCluster][iFeature] - Feature[iFeature]);
-				}
+				double	V1, V2, Variance	= _Get_Distance(iElement, m_Centroid[iCluster]);
 
 				V1		= Variance * m_nMembers[iCluster] / (m_nMembers[iCluster] - 1.);
 
@@ -2282,12 +2630,7 @@ bool CSG_Cluster_Analysis::_Hill_Climbing(bool bInitialize, int nMaxIterations)
 				{
 					if( jCluster != iCluster )
 					{
-						Variance	= 0.; 
-
-						for(iFeature=0; iFeature<m_nFeatures; iFeature++)
-						{
-							Variance	+= SG_Get_Square(m_Centroid[jCluster][iFeature] - Feature[iFeature]);
-						}
+						Variance	= _Get_Distance(iElement, m_Centroid[jCluster]);
 
 						V2	= Variance * m_nMembers[jCluster] / (m_nMembers[jCluster] + 1.);
 
@@ -2308,9 +2651,9 @@ bool CSG_Cluster_Analysis::_Hill_Climbing(bool bInitialize, int nMaxIterations)
 					V1						 = 1. / (m_nMembers[iCluster] - 1.);
 					V2						 = 1. / (m_nMembers[kCluster] + 1.);
 
-					for(iFeature=0; iFeature<m_nFeatures; iFeature++)
+					for(int iFeature=0; iFeature<m_nFeatures; iFeature++)
 					{
-						double	d	= Feature[iFeature];
+						double	d	= _Get_Feature(iElement, iFeature);
 
 						m_Centroid[iCluster][iFeature]	= (m_nMembers[iCluster] * m_Centroid[iCluster][iFeature] - d) * V1;
 						m_Centroid[kCluster][iFeature]	= (m_nMembers[kCluster] * m_Centroid[kCluster][iFeature] + d) * V2;
@@ -2349,6 +2692,106 @@ bool CSG_Cluster_Analysis::_Hill_Climbing(bool bInitialize, int nMaxIterations)
 }
 
 
+
+//---------------------------------------------------------
+/**
+* Mini-batch k-means (Sculley 2010). Centroids are moved
+* towards the elements of small random samples with a per
+* centroid learning rate. Iterations stop when the smoothed
+* batch variance did not improve for ten batches or when
+* the maximum number of iterations (batches) is reached.
+* Finally all elements are assigned to their nearest centroid.
+*/
+//---------------------------------------------------------
+bool CSG_Cluster_Analysis::_Mini_Batch(int nMaxIterations, int Batch_Size)
+{
+	int	nClusters = Get_nClusters(), nElements = Get_nElements(), *Clusters = m_Clusters.Get_Array();
+
+	if( Batch_Size < 1         ) { Batch_Size = 1024;      }
+	if( Batch_Size > nElements ) { Batch_Size = nElements; }
+
+	_Set_Centroids();	// start partition
+
+	CSG_Array_Int	Batch(Batch_Size), Nearest(Batch_Size);
+
+	int	*pBatch = Batch.Get_Array(), *pNearest = Nearest.Get_Array();
+
+	CSG_Vector	Count(nClusters);
+
+	double	SP_Smooth = 0., SP_Best = 0.;	int	nStable = 0;
+
+	//-----------------------------------------------------
+	for(m_Iteration=1; SG_UI_Process_Get_Okay(); m_Iteration++)
+	{
+		for(int i=0; i<Batch_Size; i++)
+		{
+			if( (pBatch[i] = (int)CSG_Random::Get_Uniform(0, nElements)) >= nElements )
+			{
+				pBatch[i]	= nElements - 1;
+			}
+		}
+
+		double	SP	= 0.;
+
+		#pragma omp parallel for reduction(+:SP)
+		for(int i=0; i<Batch_Size; i++)
+		{
+			double	d1, d2;	pNearest[i]	= _Get_Nearest(pBatch[i], d1, d2);
+
+			SP	+= d1;
+		}
+
+		for(int i=0; i<Batch_Size; i++)
+		{
+			int		iCluster	= pNearest[i];
+
+			double	*Centroid	= m_Centroid[iCluster], Rate = 1. / (Count[iCluster] += 1.);
+
+			for(int iFeature=0; iFeature<m_nFeatures; iFeature++)
+			{
+				Centroid[iFeature]	+= Rate * (_Get_Feature(pBatch[i], iFeature) - Centroid[iFeature]);
+			}
+		}
+
+		//-------------------------------------------------
+		SP	/= Batch_Size;
+
+		SP_Smooth	= m_Iteration == 1 ? SP : SP_Smooth + 0.1 * (SP - SP_Smooth);
+
+		if( m_Iteration == 1 || SP_Smooth < SP_Best )
+		{
+			SP_Best	= SP_Smooth;	nStable	= 0;
+		}
+		else
+		{
+			nStable++;
+		}
+
+		SG_UI_Process_Set_Text(CSG_String::Format("%s: %d >> %s %f",
+			_TL("batch"   ), m_Iteration,
+			_TL("variance"), SP_Smooth
+		));
+
+		if( nStable >= 10 || (nMaxIterations > 0 && nMaxIterations <= m_Iteration) )
+		{
+			break;
+		}
+	}
+
+	//-----------------------------------------------------
+	#pragma omp parallel for
+	for(int iElement=0; iElement<nElements; iElement++)
+	{
+		double	d1, d2;	Clusters[iElement]	= _Get_Nearest(iElement, d1, d2);
+	}
+
+	_Set_Centroids();
+	_Set_Variance ();
+
+	return( true );
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
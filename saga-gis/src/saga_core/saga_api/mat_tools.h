@@ -1127,7 +1127,7 @@ public:
 	CSG_Cluster_Analysis(void);
 	virtual ~CSG_Cluster_Analysis(void);
 
-	bool					Create				(int nFeatures);
+	bool					Create				(int nFeatures, TSG_Data_Type Data_Type = SG_DATATYPE_Double);
 	bool					Destroy				(void);
 
 	bool					Add_Element			(void);
@@ -1135,7 +1135,7 @@ public:
 
 	int						Get_Cluster			(int iElement)	const	{	return( iElement >= 0 && iElement < Get_nElements() ? m_Clusters[iElement] : -1 );	}
 
-	bool					Execute				(int Method, int nClusters, int nMaxIterations = 0, int Initialization = 0);
+	bool					Execute				(int Method, int nClusters, int nMaxIterations = 0, int Initialization = 0, int Batch_Size = 0);
 
 	int						Get_nElements		(void)	const	{	return( (int)m_Features.Get_Size() );	}
 	int						Get_nFeatures		(void)	const	{	return(      m_nFeatures           );	}
@@ -1152,6 +1152,8 @@ public:
 
 private:
 
+	bool					m_bFloat;
+
 	int						m_Iteration, m_nFeatures;
 
 	double					m_SP;
@@ -1165,10 +1167,25 @@ private:
 	CSG_Matrix				m_Centroid;
 
 
+	double					_Get_Feature		(int iElement, int iFeature)	const
+	{
+		return( m_bFloat ? ((float *)m_Features.Get_Entry(iElement))[iFeature] : ((double *)m_Features.Get_Entry(iElement))[iFeature] );
+	}
+
+	double					_Get_Distance		(int iElement, const double *Centroid)	const;
+	int						_Get_Nearest		(int iElement, double &Distance, double &Second)	const;
+
+	void					_Set_Centroids		(void);
+	void					_Set_Variance		(void);
+
+	bool					_Set_Seeds			(void);
+
 	bool					_Minimum_Distance	(bool bInitialize, int nMaxIterations);
 
 	bool					_Hill_Climbing		(bool bInitialize, int nMaxIterations);
 
+	bool					_Mini_Batch			(int nMaxIterations, int Batch_Size);
+
 };
 
 
@@ -1862,6 +1879,8 @@ public:
 	double						Get_Value			(double *Values, int nValues)	const;
 	double						Get_Value			(const char *Arguments, ... )	const;
 
+	bool						Get_Values			(const double **Columns, int nColumns, double *Result, sLong nValues, BYTE *NoData = NULL)	const;
+
 	const char *				Get_Used_Variables	(void);
 
 
@@ -1914,6 +1933,9 @@ private:
 
 	double						_Get_Value			(const double *Parameters, TSG_Formula Function)	const;
 
+	int							_Get_Stack_Size		(void)	const;
+	bool						_Get_Values			(double *Stack, const double **Columns, int nColumns, sLong Offset, int nValues)	const;
+
 	int							_is_Operand			(char c);
 	int							_is_Operand_Code	(char c);
 	int							_is_Number			(char c);
@@ -190,6 +190,7 @@ void CSG_PointCloud::_On_Construction(void)
 	m_Points		= NULL;
 	m_nRecords		= 0;
 	m_nPointBytes	= 0;
+	m_nPointBuffer	= 0;
 
 	m_Cursor		= NULL;
 	m_bXYZPrecDbl	= true;
@@ -201,8 +202,6 @@ void CSG_PointCloud::_On_Construction(void)
 	m_Shapes.Create(SHAPE_TYPE_Point, NULL, NULL, SG_VERTEX_TYPE_XYZ);
 	m_Shapes.Add_Shape();
 	m_Shapes_Index	= -1;
-
-	m_Array_Points.Create(sizeof(char *), 0, SG_ARRAY_GROWTH_3);
 }
 
 //---------------------------------------------------------
@@ -503,15 +502,60 @@ bool CSG_PointCloud::_Load(CSG_File &Stream)
 		}
 	}
 
+	if( nPointBytes != m_nPointBytes - 1 )
+	{
+		return( false );
+	}
+
 	//-----------------------------------------------------
-	sLong	fLength	= Stream.Length();
+	// the point records are read in chunks, the file length
+	// (if known) is used to allocate the point buffer once
+
+	sLong	fLength	= Stream.Length(), nPoints = (fLength - Stream.Tell()) / nPointBytes;
 
-	while( _Inc_Array() && Stream.Read(m_Cursor + 1, nPointBytes) && SG_UI_Process_Set_Progress((double)Stream.Tell(), (double)fLength) )
+	if( nPoints > PC_MAX_POINTS )
 	{
-		// nop
+		SG_UI_Msg_Add_Error(CSG_String::Format("%s (%lld > %d)", _TL("too many points"), nPoints, PC_MAX_POINTS));
+
+		return( false );
 	}
 
-	_Dec_Array();
+	if( nPoints > 0 && !_Set_Point_Buffer(nPoints) )
+	{
+		return( false );
+	}
+
+	CSG_Array	Buffer(nPointBytes, 0x10000);	// read 64k points at once
+
+	char	*pBuffer	= (char *)Buffer.Get_Array();
+
+	size_t	nRead;
+
+	while( (nRead = Stream.Read(pBuffer, nPointBytes, Buffer.Get_Size())) > 0 && SG_UI_Process_Set_Progress((double)Stream.Tell(), (double)fLength) )
+	{
+		if( m_nRecords + (sLong)nRead > PC_MAX_POINTS )
+		{
+			SG_UI_Msg_Add_Error(CSG_String::Format("%s (> %d)", _TL("too many points"), PC_MAX_POINTS));
+
+			return( false );
+		}
+
+		if( m_nRecords + (sLong)nRead > m_nPointBuffer && !_Set_Point_Buffer(m_nRecords + M_GET_MAX((sLong)nRead, m_nPointBuffer / 2)) )
+		{
+			return( false );
+		}
+
+		char	*pPoint	= m_Points + (sLong)m_nRecords * m_nPointBytes, *pRead = pBuffer;
+
+		for(size_t i=0; i<nRead; i++, pPoint+=m_nPointBytes, pRead+=nPointBytes)
+		{
+			pPoint[0]	= 0;	// record flags
+
+			memcpy(pPoint + 1, pRead, nPointBytes);
+		}
+
+		m_nRecords	+= (int)nRead;
+	}
 
 	return( true );
 }
@@ -542,9 +586,20 @@ bool CSG_PointCloud::_Save(CSG_File &Stream)
 
 	_Set_Shape(m_Shapes_Index);
 
-	for(i=0; i<Get_Count() && SG_UI_Process_Set_Progress(i, Get_Count()); i++)
+	CSG_Array	Buffer(nPointBytes, 0x10000);	// write 64k points at once
+
+	char	*pBuffer	= (char *)Buffer.Get_Array();
+
+	for(i=0; i<Get_Count() && SG_UI_Process_Set_Progress(i, Get_Count()); )
 	{
-		Stream.Write(m_Points[i] + 1, nPointBytes);
+		int		n	= 0;
+
+		for(char *pWrite=pBuffer; i<Get_Count() && n<(int)Buffer.Get_Size(); i++, n++, pWrite+=nPointBytes)
+		{
+			memcpy(pWrite, _Get_Point(i) + 1, nPointBytes);
+		}
+
+		Stream.Write(pBuffer, nPointBytes, n);
 	}
 
 	return( true );
@@ -611,11 +666,15 @@ bool CSG_PointCloud::Assign(CSG_Data_Object *pObject)
 			_Add_Field(pPointCloud->m_Field_Name[iField]->c_str(), pPointCloud->m_Field_Type[iField]);
 		}
 
-		for(int iPoint=0; iPoint<pPointCloud->Get_Count(); iPoint++)
+		if( pPointCloud->Get_Count() > 0 && _Set_Point_Buffer(pPointCloud->Get_Count()) )
 		{
-			if( _Inc_Array() )
+			memcpy(m_Points, pPointCloud->m_Points, (sLong)pPointCloud->Get_Count() * m_nPointBytes);
+
+			m_nRecords	= pPointCloud->Get_Count();
+
+			for(int iPoint=0; iPoint<m_nRecords; iPoint++)	// don't copy record flags
 			{
-				memcpy(m_Points[iPoint] + 1, pPointCloud->m_Points[iPoint] + 1, m_nPointBytes - 1);
+				_Get_Point(iPoint)[0]	= 0;
 			}
 		}
 
@@ -697,6 +756,22 @@ bool CSG_PointCloud::_Add_Field(const SG_Char *Name, TSG_Data_Type Type, int iFi
 		m_nPointBytes	= 1;
 	}
 
+	int	nPointBytes	= m_nPointBytes;	// previous record size
+
+	sLong	iCursor	= m_Cursor ? (m_Cursor - m_Points) / nPointBytes : -1;
+
+	if( m_nPointBuffer > 0 )
+	{
+		char	*Points	= (char *)SG_Realloc(m_Points, m_nPointBuffer * (nPointBytes + nFieldBytes));
+
+		if( !Points )
+		{
+			return( false );
+		}
+
+		m_Points	= Points;
+	}
+
 	m_nPointBytes	+= nFieldBytes;
 	m_nFields		++;
 
@@ -723,21 +798,26 @@ bool CSG_PointCloud::_Add_Field(const SG_Char *Name, TSG_Data_Type Type, int iFi
 	}
 
 	//-----------------------------------------------------
+	// widen the records in place, starting with the last one,
+	// so that no record is overwritten before it has been moved
+
 	int	Offset = m_Field_Offset[iField], nMoveBytes = iField < m_nFields - 1 ? m_nPointBytes - m_Field_Offset[iField + 1] : 0;
 
-	#pragma omp parallel for
-	for(int i=0; i<Get_Count(); i++)
+	for(sLong i=m_nRecords-1; i>=0; i--)
 	{
-		m_Points[i]	= (char *)SG_Realloc(m_Points[i], m_nPointBytes * sizeof(char));
+		char	*pSource	= m_Points + i * nPointBytes, *pTarget = m_Points + i * m_nPointBytes;
 
 		if( nMoveBytes > 0 )
 		{
-			memmove(m_Points[i] + Offset + nFieldBytes, m_Points[i] + Offset, nMoveBytes);
+			memmove(pTarget + Offset + nFieldBytes, pSource + Offset, nMoveBytes);
 		}
 
-		memset(m_Points[i] + Offset, 0, nFieldBytes);
+		memmove(pTarget, pSource, Offset);
+		memset (pTarget + Offset, 0, nFieldBytes);
 	}
 
+	m_Cursor	= iCursor >= 0 ? m_Points + iCursor * m_nPointBytes : NULL;
+
 	//-----------------------------------------------------
 	m_Shapes.Add_Field(Name, Type, iField);
 
@@ -760,23 +840,40 @@ bool CSG_PointCloud::Del_Field(int iField)
 	//-----------------------------------------------------
 	int	nFieldBytes	= PC_GET_NBYTES(m_Field_Type[iField]);
 
+	sLong	iCursor	= m_Cursor ? (m_Cursor - m_Points) / m_nPointBytes : -1;
+
 	m_nFields		--;
 	m_nPointBytes	-= nFieldBytes;
 
 	//-----------------------------------------------------
+	// narrow the records in place, starting with the first one
+
 	int	Offset = m_Field_Offset[iField], nMoveBytes = iField < m_nFields ? (m_nPointBytes + nFieldBytes) - m_Field_Offset[iField + 1] : 0;
 
-	#pragma omp parallel for
-	for(int i=0; i<m_nRecords; i++)
+	for(sLong i=0; i<m_nRecords; i++)
 	{
+		char	*pSource	= m_Points + i * (m_nPointBytes + nFieldBytes), *pTarget = m_Points + i * m_nPointBytes;
+
+		memmove(pTarget, pSource, Offset);
+
 		if( nMoveBytes > 0 )
 		{
-			memmove(m_Points[i] + Offset, m_Points[i] + Offset + nFieldBytes, nMoveBytes);
+			memmove(pTarget + Offset, pSource + Offset + nFieldBytes, nMoveBytes);
 		}
+	}
+
+	if( m_nPointBuffer > 0 )
+	{
+		char	*Points	= (char *)SG_Realloc(m_Points, m_nPointBuffer * m_nPointBytes);
 
-		m_Points[i]	= (char *)SG_Realloc(m_Points[i], m_nPointBytes * sizeof(char));
+		if( Points )
+		{
+			m_Points	= Points;
+		}
 	}
 
+	m_Cursor	= iCursor >= 0 ? m_Points + iCursor * m_nPointBytes : NULL;
+
 	//-----------------------------------------------------
 	delete(m_Field_Name [iField]);
 	delete(m_Field_Stats[iField]);
@@ -840,7 +937,9 @@ bool CSG_PointCloud::Mov_Field(int iField, int Position)
 	#pragma omp parallel for
 	for(int i=0; i<m_nRecords; i++)
 	{
-		memcpy(m_Points[i] + m_Field_Offset[Position], m_Points[i] + m_Field_Offset[iField], Size);
+		char	*pPoint	= _Get_Point(i);
+
+		memcpy(pPoint + m_Field_Offset[Position], pPoint + m_Field_Offset[iField], Size);
 	}
 
 	if( !Del_Field(iField) )
@@ -1047,10 +1146,10 @@ TSG_Point_Z CSG_PointCloud::Get_Point(int iPoint)	const
 {
 	TSG_Point_Z	p;
 
-	if( iPoint >= 0 && iPoint < Get_Count() )
-	{
-		char	*pPoint	= m_Points[iPoint];
+	char	*pPoint	= _Get_Point(iPoint);
 
+	if( pPoint )
+	{
 		p.x	= _Get_Field_Value(pPoint, 0);
 		p.y	= _Get_Field_Value(pPoint, 1);
 		p.z	= _Get_Field_Value(pPoint, 2);
@@ -1075,11 +1174,13 @@ bool CSG_PointCloud::Set_Point(const TSG_Point_Z &Point)
 //---------------------------------------------------------
 bool CSG_PointCloud::Set_Point(int iPoint, const TSG_Point_Z &Point)
 {
-	if( iPoint >= 0 && iPoint < m_nRecords )
+	char	*pPoint	= _Get_Point(iPoint);
+
+	if( pPoint )
 	{
-		return( _Set_Field_Value(m_Points[iPoint], 0, Point.x)
-			&&  _Set_Field_Value(m_Points[iPoint], 1, Point.y)
-			&&  _Set_Field_Value(m_Points[iPoint], 2, Point.z)
+		return( _Set_Field_Value(pPoint, 0, Point.x)
+			&&  _Set_Field_Value(pPoint, 1, Point.y)
+			&&  _Set_Field_Value(pPoint, 2, Point.z)
 		);
 	}
 
@@ -1122,17 +1223,11 @@ bool CSG_PointCloud::Del_Point(int iPoint)
 			Select(iPoint, true);
 		}
 
-		m_Cursor	= m_Points[iPoint];
-
-		for(int i=iPoint, j=iPoint+1; j<Get_Count(); i++, j++)
+		if( iPoint < Get_Count() - 1 )
 		{
-			m_Points[i]	= m_Points[j];
+			memmove(_Get_Point(iPoint), _Get_Point(iPoint + 1), (sLong)(Get_Count() - 1 - iPoint) * m_nPointBytes);
 		}
 
-		m_Points[Get_Count() - 1]	= m_Cursor;
-
-		m_Cursor	= NULL;
-
 		_Dec_Array();
 
 		Set_Modified();
@@ -1148,17 +1243,11 @@ bool CSG_PointCloud::Del_Point(int iPoint)
 //---------------------------------------------------------
 bool CSG_PointCloud::Del_Points(void)
 {
-	for(int iPoint=0; iPoint<m_nRecords; iPoint++)
-	{
-		SG_Free(m_Points[iPoint]);
-	}
-
-	m_Array_Points.Destroy();
-
 	m_nRecords	= 0;
-	m_Points	= NULL;
 	m_Cursor	= NULL;
 
+	_Set_Point_Buffer(0);
+
 	m_Selection.Set_Array(0);
 
 	Set_Modified();
@@ -1176,16 +1265,67 @@ bool CSG_PointCloud::Del_Points(void)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-bool CSG_PointCloud::_Inc_Array(void)
+/**
+* All point records are stored in one contiguous memory block,
+* each record with a size of m_nPointBytes. This resizes the
+* block to hold nPoints records, keeping the cursor valid.
+*/
+//---------------------------------------------------------
+bool CSG_PointCloud::_Set_Point_Buffer(sLong nPoints)
 {
-	if( m_nFields > 0 && m_Array_Points.Set_Array(m_nRecords + 1, (void **)&m_Points) )
+	if( nPoints < m_nRecords )
 	{
-		m_Points[m_nRecords++]	= m_Cursor	= (char *)SG_Calloc(m_nPointBytes, sizeof(char));
+		return( false );
+	}
 
+	if( nPoints == m_nPointBuffer )
+	{
 		return( true );
 	}
 
-	return( false );
+	if( nPoints < 1 )
+	{
+		SG_FREE_SAFE(m_Points);
+
+		m_nPointBuffer	= 0;
+
+		return( true );
+	}
+
+	sLong	iCursor	= m_Cursor ? (m_Cursor - m_Points) / m_nPointBytes : -1;
+
+	char	*Points	= (char *)SG_Realloc(m_Points, nPoints * m_nPointBytes);
+
+	if( !Points )
+	{
+		return( false );
+	}
+
+	m_Points		= Points;
+	m_nPointBuffer	= nPoints;
+	m_Cursor		= iCursor >= 0 ? m_Points + iCursor * m_nPointBytes : NULL;
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_PointCloud::_Inc_Array(void)
+{
+	if( m_nFields < 1 || m_nRecords >= PC_MAX_POINTS )
+	{
+		return( false );
+	}
+
+	if( m_nRecords >= m_nPointBuffer && !_Set_Point_Buffer(m_nPointBuffer < 1024 ? 1024 : M_GET_MIN(m_nPointBuffer + m_nPointBuffer / 2, (sLong)PC_MAX_POINTS)) )
+	{
+		return( false );
+	}
+
+	m_Cursor	= m_Points + (sLong)m_nRecords++ * m_nPointBytes;
+
+	memset(m_Cursor, 0, m_nPointBytes);
+
+	return( true );
 }
 
 //---------------------------------------------------------
@@ -1197,9 +1337,10 @@ bool CSG_PointCloud::_Dec_Array(void)
 
 		m_Cursor	= NULL;
 
-		SG_Free(m_Points[m_nRecords]);
-
-		m_Array_Points.Set_Array(m_nRecords, (void **)&m_Points);
+		if( m_nRecords < m_nPointBuffer / 4 )	// release memory, if less than a quarter is in use
+		{
+			_Set_Point_Buffer(m_nPointBuffer / 2);
+		}
 	}
 
 	return( true );
@@ -1275,11 +1416,11 @@ bool CSG_PointCloud::_Stats_Update(int iField) const
 	}
 	else
 	{
-		char	**pPoint	= m_Points;
+		char	*pPoint	= m_Points;
 
-		for(int i=0; i<Get_Count(); i++, pPoint++)
+		for(int i=0; i<Get_Count(); i++, pPoint+=m_nPointBytes)
 		{
-			double	Value	= _Get_Field_Value(*pPoint, iField);
+			double	Value	= _Get_Field_Value(pPoint, iField);
 
 			if( iField < 3 || is_NoData_Value(Value) == false )
 			{
@@ -1326,7 +1467,7 @@ CSG_Shape * CSG_PointCloud::_Set_Shape(int iPoint)
 
 	if( pShape->is_Modified() && m_Shapes_Index >= 0 && m_Shapes_Index < Get_Count() )
 	{
-		m_Cursor	= m_Points[m_Shapes_Index];
+		m_Cursor	= _Get_Point(m_Shapes_Index);
 
 		for(int i=0; i<Get_Field_Count(); i++)
 		{
@@ -1347,7 +1488,7 @@ CSG_Shape * CSG_PointCloud::_Set_Shape(int iPoint)
 	{
 		if(1|| iPoint != m_Shapes_Index )
 		{
-			m_Cursor	= m_Points[iPoint];
+			m_Cursor	= _Get_Point(iPoint);
 
 			pShape->Set_Point(Get_X(), Get_Y(), 0, 0);
 			pShape->Set_Z    (Get_Z()         , 0, 0);
@@ -1484,7 +1625,7 @@ bool CSG_PointCloud::Select(int iRecord, bool bInvert)
 	{
 		for(size_t i=0; i<Get_Selection_Count(); i++)
 		{
-			m_Points[Get_Selection_Index(i)][0]	&= ~SG_TABLE_REC_FLAG_Selected;
+			_Get_Point(Get_Selection_Index(i))[0]	&= ~SG_TABLE_REC_FLAG_Selected;
 		}
 
 		m_Selection.Destroy();
@@ -1562,7 +1703,7 @@ bool CSG_PointCloud::Select(TSG_Point Point, bool bInvert)
 //---------------------------------------------------------
 bool CSG_PointCloud::is_Selected(int iRecord)	const
 {
-	return( iRecord >= 0 && iRecord < Get_Count() && (m_Points[iRecord][0] & SG_TABLE_REC_FLAG_Selected) != 0 );
+	return( iRecord >= 0 && iRecord < Get_Count() && (_Get_Point(iRecord)[0] & SG_TABLE_REC_FLAG_Selected) != 0 );
 }
 
 
@@ -1623,22 +1764,18 @@ int CSG_PointCloud::Del_Selection(void)
 
 		for(int i=0; i<m_nRecords; i++)
 		{
-			if( (m_Points[i][0] & SG_TABLE_REC_FLAG_Selected) != 0 )
-			{
-				SG_Free(m_Points[i]);
-			}
-			else
+			if( (_Get_Point(i)[0] & SG_TABLE_REC_FLAG_Selected) == 0 )
 			{
 				if( n < i )
 				{
-					m_Points[n]	= m_Points[i];
+					memcpy(_Get_Point(n), _Get_Point(i), m_nPointBytes);
 				}
 
 				n++;
 			}
 		}
 
-		m_Array_Points.Set_Array(m_nRecords = n, (void **)&m_Points);
+		_Set_Point_Buffer(m_nRecords = n);
 
 		Set_Modified();
 		Set_Update_Flag();
@@ -1653,17 +1790,17 @@ int CSG_PointCloud::Inv_Selection(void)
 {
 	if( m_Selection.Set_Array((size_t)m_nRecords - Get_Selection_Count()) )
 	{
-		char	**pPoint	= m_Points;
+		char	*pPoint	= m_Points;
 
-		for(size_t i=0, n=0; i<(size_t)m_nRecords && n<Get_Selection_Count(); i++, pPoint++)
+		for(size_t i=0, n=0; i<(size_t)m_nRecords && n<Get_Selection_Count(); i++, pPoint+=m_nPointBytes)
 		{
-			if( ((*pPoint)[0] & SG_TABLE_REC_FLAG_Selected) != 0 )
+			if( (pPoint[0] & SG_TABLE_REC_FLAG_Selected) != 0 )
 			{
-				(*pPoint)[0]	&= ~SG_TABLE_REC_FLAG_Selected;
+				pPoint[0]	&= ~SG_TABLE_REC_FLAG_Selected;
 			}
 			else
 			{
-				(*pPoint)[0]	|= SG_TABLE_REC_FLAG_Selected;
+				pPoint[0]	|= SG_TABLE_REC_FLAG_Selected;
 
 				_Set_Selection(i, n++);
 			}
@@ -84,6 +84,9 @@
 //														 //
 ///////////////////////////////////////////////////////////
 
+//---------------------------------------------------------
+#define PC_MAX_POINTS	0x7FFFFFFF	// point counts and indices are int, see CSG_Table
+
 //---------------------------------------------------------
 typedef enum ESG_PointCloud_FileType
 {
@@ -154,10 +157,11 @@ public:
 	bool							Del_Point			(int iPoint);
 	bool							Del_Points			(void);
 
+	/// The point storage is addressed with 64 bit offsets, but the point count and the point indices are still limited to PC_MAX_POINTS by the int based record API of CSG_Table.
 	int								Get_Point_Count		(void)			const	{	return( m_nRecords );	}
 
 	//-----------------------------------------------------
-	bool							Set_Cursor			(int iPoint)							{	return( (m_Cursor = iPoint >= 0 && iPoint < m_nRecords ? m_Points[iPoint] : NULL) != NULL );	}
+	bool							Set_Cursor			(int iPoint)							{	return( (m_Cursor = _Get_Point(iPoint)) != NULL );	}
 	virtual bool					Set_Value			(            int iField, double Value)	{	return( _Set_Field_Value(m_Cursor, iField, Value) );	}
 	virtual double					Get_Value			(            int iField)	const		{	return( _Get_Field_Value(m_Cursor, iField) );			}
 	double							Get_X				(void)						const		{	return( _Get_Field_Value(m_Cursor, 0) );				}
@@ -168,11 +172,11 @@ public:
 	bool							Set_NoData			(            int iField)				{	return( Set_Value(iField, Get_NoData_Value()) );	}
 	bool							is_NoData			(            int iField)	const		{	return( is_NoData_Value(Get_Value(iField)) );		}
 
-	virtual bool					Set_Value			(int iPoint, int iField, double Value)	{	return( _Set_Field_Value(iPoint >= 0 && iPoint < m_nRecords ? m_Points[iPoint] : NULL, iField, Value) );	}
-	virtual double					Get_Value			(int iPoint, int iField)	const		{	return( _Get_Field_Value(iPoint >= 0 && iPoint < m_nRecords ? m_Points[iPoint] : NULL, iField) );		}
-	double							Get_X				(int iPoint)				const		{	return( _Get_Field_Value(iPoint >= 0 && iPoint < m_nRecords ? m_Points[iPoint] : NULL, 0) );				}
-	double							Get_Y				(int iPoint)				const		{	return( _Get_Field_Value(iPoint >= 0 && iPoint < m_nRecords ? m_Points[iPoint] : NULL, 1) );				}
-	double							Get_Z				(int iPoint)				const		{	return( _Get_Field_Value(iPoint >= 0 && iPoint < m_nRecords ? m_Points[iPoint] : NULL, 2) );				}
+	virtual bool					Set_Value			(int iPoint, int iField, double Value)	{	return( _Set_Field_Value(_Get_Point(iPoint), iField, Value) );	}
+	virtual double					Get_Value			(int iPoint, int iField)	const		{	return( _Get_Field_Value(_Get_Point(iPoint), iField) );		}
+	double							Get_X				(int iPoint)				const		{	return( _Get_Field_Value(_Get_Point(iPoint), 0) );				}
+	double							Get_Y				(int iPoint)				const		{	return( _Get_Field_Value(_Get_Point(iPoint), 1) );				}
+	double							Get_Z				(int iPoint)				const		{	return( _Get_Field_Value(_Get_Point(iPoint), 2) );				}
 	bool							Set_Attribute		(int iPoint, int iField, double Value)	{	return( Set_Value(iPoint, iField + 3, Value) );				}
 	double							Get_Attribute		(int iPoint, int iField)	const		{	return( Get_Value(iPoint, iField + 3) );					}
 	bool							Set_NoData			(int iPoint, int iField)				{	return( Set_Value(iPoint, iField, Get_NoData_Value()) );}
@@ -180,8 +184,8 @@ public:
 
 	virtual bool					Set_Value			(            int iField, const SG_Char *Value)			{	return( _Set_Field_Value(m_Cursor, iField, Value) );	}
 	virtual bool					Get_Value			(            int iField, CSG_String    &Value)	const	{	return( _Get_Field_Value(m_Cursor, iField, Value) );	}
-	virtual bool					Set_Value			(int iPoint, int iField, const SG_Char *Value)			{	return( _Set_Field_Value(iPoint >= 0 && iPoint < m_nRecords ? m_Points[iPoint] : NULL, iField, Value) );	}
-	virtual bool					Get_Value			(int iPoint, int iField, CSG_String    &Value)	const	{	return( _Get_Field_Value(iPoint >= 0 && iPoint < m_nRecords ? m_Points[iPoint] : NULL, iField, Value) );	}
+	virtual bool					Set_Value			(int iPoint, int iField, const SG_Char *Value)			{	return( _Set_Field_Value(_Get_Point(iPoint), iField, Value) );	}
+	virtual bool					Get_Value			(int iPoint, int iField, CSG_String    &Value)	const	{	return( _Get_Field_Value(_Get_Point(iPoint), iField, Value) );	}
 	virtual bool					Set_Attribute		(            int iField, const SG_Char *Value)			{	return( Set_Value(iField + 3, Value) );			}
 	virtual bool					Get_Attribute		(            int iField, CSG_String    &Value)	const	{	return( Get_Value(iField + 3, Value) );			}
 	virtual bool					Set_Attribute		(int iPoint, int iField, const SG_Char *Value)			{	return( Set_Value(iPoint, iField + 3, Value) );	}
@@ -240,11 +244,11 @@ private:
 
 	bool							m_bXYZPrecDbl;
 
-	char							**m_Points, *m_Cursor;
+	char							*m_Points, *m_Cursor;
 
 	int								m_nPointBytes, *m_Field_Offset, m_Shapes_Index;
 
-	CSG_Array						m_Array_Points;
+	sLong							m_nPointBuffer;
 
 	CSG_Shapes						m_Shapes;
 
@@ -261,6 +265,9 @@ private:
 	bool							_Get_Field_Value	(char *pPoint, int iField, CSG_String    &Value)	const;
 	int								_Get_Field_Bytes	(TSG_Data_Type Type);
 
+	char *							_Get_Point			(sLong iPoint)	const	{	return( iPoint >= 0 && iPoint < m_nRecords ? m_Points + iPoint * m_nPointBytes : NULL );	}
+
+	bool							_Set_Point_Buffer	(sLong nPoints);
 	bool							_Inc_Array			(void);
 	bool							_Dec_Array			(void);
 
@@ -1267,18 +1267,21 @@ public:
 	virtual double				Get_Point_Value		(int i)	const	{	return( m_Points[i][2] );	}
 
 	virtual size_t				Get_Nearest_Points	(double Coordinate[2], size_t Count, double Radius);
-	virtual size_t				Get_Nearest_Points	(double Coordinate[2], size_t Count, double Radius, CSG_Array_Int &Indices, CSG_Vector &Distances);
-	virtual size_t				Get_Nearest_Points	(double Coordinate[2], size_t Count, size_t *Indices, double *Distances);
-	virtual bool				Get_Nearest_Point	(double Coordinate[2], size_t &Index, double &Distance);
-	virtual bool				Get_Nearest_Point	(double Coordinate[2], size_t &Index);
-	virtual CSG_Shape *			Get_Nearest_Shape	(double Coordinate[2]);
+	virtual size_t				Get_Nearest_Points	(const double Coordinate[2], size_t Count, double Radius, CSG_Array_Int &Indices, CSG_Vector &Distances)	const;
+	virtual size_t				Get_Nearest_Points	(const double Coordinate[2], size_t Count, size_t *Indices, double *Distances)	const;
+	virtual bool				Get_Nearest_Point	(const double Coordinate[2], size_t &Index, double &Distance)	const;
+	virtual bool				Get_Nearest_Point	(const double Coordinate[2], size_t &Index)	const;
+	virtual CSG_Shape *			Get_Nearest_Shape	(const double Coordinate[2])	const;
+
+	virtual size_t				Get_Nearest_Points	(const CSG_Matrix &Coordinates, size_t Count, size_t *Indices, double *Distances)	const;
+	virtual bool				Get_Nearest_Points	(const CSG_Matrix &Coordinates, size_t Count, double Radius, CSG_Array_Int *Indices, CSG_Vector *Distances)	const;
 
 	virtual size_t				Get_Nearest_Points	(double x, double y, size_t Count, double Radius);
-	virtual size_t				Get_Nearest_Points	(double x, double y, size_t Count, double Radius, CSG_Array_Int &Indices, CSG_Vector &Distances);
-	virtual size_t				Get_Nearest_Points	(double x, double y, size_t Count, size_t *Indices, double *Distances);
-	virtual bool				Get_Nearest_Point	(double x, double y, size_t &Index, double &Distance);
-	virtual bool				Get_Nearest_Point	(double x, double y, size_t &Index);
-	virtual CSG_Shape *			Get_Nearest_Shape	(double x, double y);
+	virtual size_t				Get_Nearest_Points	(double x, double y, size_t Count, double Radius, CSG_Array_Int &Indices, CSG_Vector &Distances)	const;
+	virtual size_t				Get_Nearest_Points	(double x, double y, size_t Count, size_t *Indices, double *Distances)	const;
+	virtual bool				Get_Nearest_Point	(double x, double y, size_t &Index, double &Distance)	const;
+	virtual bool				Get_Nearest_Point	(double x, double y, size_t &Index)	const;
+	virtual CSG_Shape *			Get_Nearest_Shape	(double x, double y)	const;
 
 };
 
@@ -1312,18 +1315,21 @@ public:
 
 	virtual size_t				Get_Nearest_Points	(double Coordinate[3], size_t Count, double Radius);
 
-	virtual size_t				Get_Nearest_Points	(double Coordinate[3], size_t Count, size_t *Indices, double *Distances);
-	virtual size_t				Get_Nearest_Points	(double Coordinate[3], size_t Count, double Radius, CSG_Array_Int &Indices, CSG_Vector &Distances);
-	virtual bool				Get_Nearest_Point	(double Coordinate[3], size_t &Index, double &Distance);
-	virtual bool				Get_Nearest_Point	(double Coordinate[3], size_t &Index);
-	virtual CSG_Shape *			Get_Nearest_Shape	(double Coordinate[3]);
+	virtual size_t				Get_Nearest_Points	(const double Coordinate[3], size_t Count, size_t *Indices, double *Distances)	const;
+	virtual size_t				Get_Nearest_Points	(const double Coordinate[3], size_t Count, double Radius, CSG_Array_Int &Indices, CSG_Vector &Distances)	const;
+	virtual bool				Get_Nearest_Point	(const double Coordinate[3], size_t &Index, double &Distance)	const;
+	virtual bool				Get_Nearest_Point	(const double Coordinate[3], size_t &Index)	const;
+	virtual CSG_Shape *			Get_Nearest_Shape	(const double Coordinate[3])	const;
+
+	virtual size_t				Get_Nearest_Points	(const CSG_Matrix &Coordinates, size_t Count, size_t *Indices, double *Distances)	const;
+	virtual bool				Get_Nearest_Points	(const CSG_Matrix &Coordinates, size_t Count, double Radius, CSG_Array_Int *Indices, CSG_Vector *Distances)	const;
 
 	virtual size_t				Get_Nearest_Points	(double x, double y, double z, size_t Count, double Radius);
-	virtual size_t				Get_Nearest_Points	(double x, double y, double z, size_t Count, double Radius, CSG_Array_Int &Indices, CSG_Vector &Distances);
-	virtual size_t				Get_Nearest_Points	(double x, double y, double z, size_t Count, size_t *Indices, double *Distances);
-	virtual bool				Get_Nearest_Point	(double x, double y, double z, size_t &Index, double &Distance);
-	virtual bool				Get_Nearest_Point	(double x, double y, double z, size_t &Index);
-	virtual CSG_Shape *			Get_Nearest_Shape	(double x, double y, double z);
+	virtual size_t				Get_Nearest_Points	(double x, double y, double z, size_t Count, double Radius, CSG_Array_Int &Indices, CSG_Vector &Distances)	const;
+	virtual size_t				Get_Nearest_Points	(double x, double y, double z, size_t Count, size_t *Indices, double *Distances)	const;
+	virtual bool				Get_Nearest_Point	(double x, double y, double z, size_t &Index, double &Distance)	const;
+	virtual bool				Get_Nearest_Point	(double x, double y, double z, size_t &Index)	const;
+	virtual CSG_Shape *			Get_Nearest_Shape	(double x, double y, double z)	const;
 
 };
 
@@ -1468,6 +1474,60 @@ protected:
 };
 
 
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+* CSG_Shapes_RTree is a packed R-tree over the extents of a
+* shapes layer's shapes, bulk loaded with Sort-Tile-Recursive
+* packing (Leutenegger et al. 1997). The shapes' extents are
+* copied with construction, so queries neither access the
+* shapes nor modify the index and can run in parallel.
+* Get_Index() enumerates the shapes in packing order, which
+* keeps spatial neighbours together in groups of Node_Size.
+*/
+//---------------------------------------------------------
+class SAGA_API_DLL_EXPORT CSG_Shapes_RTree
+{
+public:
+	CSG_Shapes_RTree(void);
+	CSG_Shapes_RTree(CSG_Shapes *pShapes, int Node_Size = 16);
+
+	virtual ~CSG_Shapes_RTree(void);
+
+	bool						Create				(CSG_Shapes *pShapes, int Node_Size = 16);
+	void						Destroy				(void);
+
+	bool						is_Valid			(void)	const	{	return( m_Nodes.Get_Size() > 0 );	}
+
+	int							Get_Count			(void)	const	{	return( (int)m_Index.Get_Size() );	}
+	int							Get_Node_Size		(void)	const	{	return( m_Node_Size );	}
+	int							Get_Index			(int i)	const	{	return( m_Index[i] );	}
+
+	int							Get_Shapes			(const CSG_Rect &Extent, CSG_Array_Int &Shapes)	const;
+
+
+private:
+
+	typedef struct
+	{
+		double					xMin, yMin, xMax, yMax;
+
+		int						First, Count, Level;
+	}
+	TNode;
+
+	int							m_Node_Size;
+
+	CSG_Array					m_Nodes, m_Extents;
+
+	CSG_Array_Int				m_Index;
+
+};
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //					Polygon Tools						 //
@@ -1480,6 +1540,7 @@ SAGA_API_DLL_EXPORT bool		SG_Polygon_Difference	(CSG_Shape *pPolygon, CSG_Shape
 SAGA_API_DLL_EXPORT bool		SG_Polygon_ExclusiveOr	(CSG_Shape *pPolygon, CSG_Shape *pClip, CSG_Shape *pResult = NULL);
 SAGA_API_DLL_EXPORT bool		SG_Polygon_Union		(CSG_Shape *pPolygon, CSG_Shape *pClip, CSG_Shape *pResult = NULL);
 SAGA_API_DLL_EXPORT bool		SG_Polygon_Dissolve		(CSG_Shape *pPolygon, CSG_Shape *pResult = NULL);
+SAGA_API_DLL_EXPORT bool		SG_Polygon_Dissolve		(CSG_Shapes *pPolygons, CSG_Shape *pResult);
 SAGA_API_DLL_EXPORT bool		SG_Polygon_Simplify		(CSG_Shape *pPolygon, CSG_Shape *pResult = NULL);
 SAGA_API_DLL_EXPORT bool		SG_Polygon_Offset		(CSG_Shape *pPolygon, double dSize, double dArc, CSG_Shape *pResult = NULL);
 
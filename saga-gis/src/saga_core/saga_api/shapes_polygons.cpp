@@ -49,6 +49,8 @@
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
+#include <vector>
+
 #include "shapes.h"
 
 #include "clipper.hpp"
@@ -440,6 +442,101 @@ bool	SG_Polygon_Dissolve		(CSG_Shape *pPolygon, CSG_Shape *pResult)
 	return( false );
 }
 
+//---------------------------------------------------------
+#define CASCADED_UNION_NODE_SIZE	8
+
+//---------------------------------------------------------
+/**
+* Dissolves all polygons of pPolygons into pResult with a
+* cascaded union: the polygons are grouped by their location
+* (the packing order of a CSG_Shapes_RTree) and each group
+* is merged separately, then the groups' results are merged
+* group-wise again and so on up to the root. Each
+* union operates on neighbouring and thus mostly overlapping
+* polygons only and the merges of one tree level run in
+* parallel, which is much faster than adding polygon after
+* polygon to an ever growing result.
+*/
+//---------------------------------------------------------
+bool	SG_Polygon_Dissolve		(CSG_Shapes *pPolygons, CSG_Shape *pResult)
+{
+	if( !pPolygons || pPolygons->Get_Type() != SHAPE_TYPE_Polygon || !pResult )
+	{
+		return( false );
+	}
+
+	if( pPolygons->Get_Count() < 1 )	// nothing to dissolve, empty result
+	{
+		pResult->Del_Parts();
+
+		return( true );
+	}
+
+	CSG_Converter_WorldToInt	Converter;
+
+	if( !Converter.Create(pPolygons->Get_Extent()) )
+	{
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	CSG_Shapes_RTree	Index;
+
+	if( !Index.Create(pPolygons, CASCADED_UNION_NODE_SIZE) )
+	{
+		return( false );
+	}
+
+	int	n	= Index.Get_Count();
+
+	//-----------------------------------------------------
+	// outer rings are converted counter-clockwise and lakes
+	// clockwise, as Clipper returns them, so non-zero filling
+	// gives the union of overlapping polygons at every level
+
+	std::vector<ClipperLib::Paths>	Level(n);
+
+	for(int i=0; i<n; i++)
+	{
+		Converter.Convert(pPolygons->Get_Shape(Index.Get_Index(i)), Level[i]);
+	}
+
+	while( Level.size() > 1 )
+	{
+		std::vector<ClipperLib::Paths>	Next((Level.size() + CASCADED_UNION_NODE_SIZE - 1) / CASCADED_UNION_NODE_SIZE);
+
+		#pragma omp parallel for schedule(dynamic)
+		for(int i=0; i<(int)Next.size(); i++)
+		{
+			ClipperLib::Clipper	Clipper;
+
+			for(size_t j=i*CASCADED_UNION_NODE_SIZE; j<Level.size() && j<(size_t)(i+1)*CASCADED_UNION_NODE_SIZE; j++)
+			{
+				Clipper.AddPaths(Level[j], ClipperLib::ptSubject, true);
+
+				ClipperLib::Paths().swap(Level[j]);	// free memory as early as possible
+			}
+
+			Clipper.Execute(ClipperLib::ctUnion, Next[i], ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+		}
+
+		Level.swap(Next);
+	}
+
+	//-----------------------------------------------------
+	if( n == 1 )	// make sure a single polygon is dissolved, too
+	{
+		ClipperLib::Clipper	Clipper;	ClipperLib::Paths	Result;
+
+		Clipper.AddPaths(Level[0], ClipperLib::ptSubject, true);
+		Clipper.Execute(ClipperLib::ctUnion, Result, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+
+		Level[0].swap(Result);
+	}
+
+	return( Converter.Convert(Level[0], pResult) );
+}
+
 //---------------------------------------------------------
 bool	SG_Polygon_Simplify		(CSG_Shape *pPolygon, CSG_Shape *pResult)
 {
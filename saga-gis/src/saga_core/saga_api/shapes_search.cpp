@@ -64,6 +64,8 @@
 //---------------------------------------------------------
 #include "shapes.h"
 
+#include <algorithm>
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -609,6 +611,245 @@ int CSG_Shapes_Search::Select_Quadrants(double x, double y, double Radius, int M
 }
 
 
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_Shapes_RTree::CSG_Shapes_RTree(void)
+{
+	m_Node_Size	= 16;
+}
+
+//---------------------------------------------------------
+CSG_Shapes_RTree::CSG_Shapes_RTree(CSG_Shapes *pShapes, int Node_Size)
+{
+	m_Node_Size	= 16;
+
+	Create(pShapes, Node_Size);
+}
+
+//---------------------------------------------------------
+CSG_Shapes_RTree::~CSG_Shapes_RTree(void)
+{
+	Destroy();
+}
+
+//---------------------------------------------------------
+void CSG_Shapes_RTree::Destroy(void)
+{
+	m_Nodes  .Destroy();
+	m_Extents.Destroy();
+	m_Index  .Destroy();
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+class CSG_Shapes_RTree_Compare
+{
+public:
+	CSG_Shapes_RTree_Compare(const TSG_Rect *Extents, bool bX) : m_Extents(Extents), m_bX(bX)	{}
+
+	bool				operator ()	(int a, int b)	const
+	{
+		return( m_bX
+			? m_Extents[a].xMin + m_Extents[a].xMax < m_Extents[b].xMin + m_Extents[b].xMax
+			: m_Extents[a].yMin + m_Extents[a].yMax < m_Extents[b].yMin + m_Extents[b].yMax
+		);
+	}
+
+private:
+
+	const TSG_Rect		*m_Extents;
+
+	bool				m_bX;
+
+};
+
+//---------------------------------------------------------
+// The shapes are sorted by the x-coordinate of their extents'
+// centers, cut into vertical slices of sqrt(leaves) leaves,
+// and each slice is sorted by y. Runs of Node_Size shapes
+// then form the leaves, runs of Node_Size nodes the branches
+// of the next level, up to the root, which is the last node.
+//---------------------------------------------------------
+bool CSG_Shapes_RTree::Create(CSG_Shapes *pShapes, int Node_Size)
+{
+	Destroy();
+
+	if( !pShapes || Node_Size < 2 )
+	{
+		return( false );
+	}
+
+	m_Node_Size	= Node_Size;
+
+	int	n	= pShapes->Get_Count();
+
+	if( n < 1 )
+	{
+		return( true );	// valid, but empty
+	}
+
+	//-----------------------------------------------------
+	CSG_Array	Extents(sizeof(TSG_Rect), n);	TSG_Rect *E = (TSG_Rect *)Extents.Get_Array();
+
+	int	*Index	= m_Index.Create(n);
+
+	if( !E || !Index || !m_Extents.Create(sizeof(TSG_Rect), n) )
+	{
+		Destroy();
+
+		return( false );
+	}
+
+	for(int i=0; i<n; i++)
+	{
+		Index[i]	= i;
+		E    [i]	= pShapes->Get_Shape(i)->Get_Extent();
+	}
+
+	int	nLeaves	= (n + m_Node_Size - 1) / m_Node_Size;
+	int	nSlice	= m_Node_Size * (int)ceil(sqrt((double)nLeaves));
+
+	std::sort(Index, Index + n, CSG_Shapes_RTree_Compare(E, true));
+
+	for(int i=0; i<n; i+=nSlice)
+	{
+		std::sort(Index + i, Index + M_GET_MIN(n, i + nSlice), CSG_Shapes_RTree_Compare(E, false));
+	}
+
+	TSG_Rect	*Packed	= (TSG_Rect *)m_Extents.Get_Array();	// extents in packing order
+
+	for(int i=0; i<n; i++)
+	{
+		Packed[i]	= E[Index[i]];
+	}
+
+	//-----------------------------------------------------
+	int	nNodes	= 0;
+
+	for(int nLevel=nLeaves; ; nLevel=(nLevel + m_Node_Size - 1) / m_Node_Size)
+	{
+		nNodes	+= nLevel;	if( nLevel <= 1 ) break;
+	}
+
+	TNode	*Nodes	= (TNode *)m_Nodes.Create(sizeof(TNode), nNodes);
+
+	if( !Nodes )
+	{
+		Destroy();
+
+		return( false );
+	}
+
+	for(int i=0, iNode=0; i<n; i+=m_Node_Size, iNode++)	// leaves
+	{
+		TNode	&Node	= Nodes[iNode];
+
+		Node.First	= i;
+		Node.Count	= M_GET_MIN(m_Node_Size, n - i);
+		Node.Level	= 0;
+
+		for(int j=0; j<Node.Count; j++)
+		{
+			const TSG_Rect	&r	= Packed[i + j];
+
+			if( j == 0 || Node.xMin > r.xMin ) Node.xMin = r.xMin;
+			if( j == 0 || Node.yMin > r.yMin ) Node.yMin = r.yMin;
+			if( j == 0 || Node.xMax < r.xMax ) Node.xMax = r.xMax;
+			if( j == 0 || Node.yMax < r.yMax ) Node.yMax = r.yMax;
+		}
+	}
+
+	for(int First=0, nLevel=nLeaves, iNode=nLeaves, Level=1; nLevel>1; Level++)	// branches
+	{
+		int	nNext	= 0;
+
+		for(int i=First; i<First+nLevel; i+=m_Node_Size, iNode++, nNext++)
+		{
+			TNode	&Node	= Nodes[iNode];
+
+			Node.First	= i;
+			Node.Count	= M_GET_MIN(m_Node_Size, First + nLevel - i);
+			Node.Level	= Level;
+
+			for(int j=0; j<Node.Count; j++)
+			{
+				const TNode	&r	= Nodes[i + j];
+
+				if( j == 0 || Node.xMin > r.xMin ) Node.xMin = r.xMin;
+				if( j == 0 || Node.yMin > r.yMin ) Node.yMin = r.yMin;
+				if( j == 0 || Node.xMax < r.xMax ) Node.xMax = r.xMax;
+				if( j == 0 || Node.yMax < r.yMax ) Node.yMax = r.yMax;
+			}
+		}
+
+		First	+= nLevel;	nLevel	= nNext;
+	}
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Collects the indices of all shapes with an extent that
+// touches the given one, in ascending order.
+//---------------------------------------------------------
+int CSG_Shapes_RTree::Get_Shapes(const CSG_Rect &Extent, CSG_Array_Int &Shapes)	const
+{
+	Shapes.Destroy();
+
+	if( !is_Valid() )
+	{
+		return( 0 );
+	}
+
+	const TNode		*Nodes	= (const TNode    *)m_Nodes  .Get_Array();
+	const TSG_Rect	*Packed	= (const TSG_Rect *)m_Extents.Get_Array();
+
+	CSG_Array_Int	Stack;	Stack.Add((int)m_Nodes.Get_Size() - 1);	// root
+
+	while( Stack.Get_Size() > 0 )
+	{
+		const TNode	&Node	= Nodes[Stack[Stack.Get_Size() - 1]];	Stack.Set_Array(Stack.Get_Size() - 1, false);
+
+		if( Node.xMax < Extent.Get_XMin() || Node.xMin > Extent.Get_XMax()
+		||  Node.yMax < Extent.Get_YMin() || Node.yMin > Extent.Get_YMax() )
+		{
+			continue;
+		}
+
+		for(int i=Node.First; i<Node.First+Node.Count; i++)
+		{
+			if( Node.Level > 0 )
+			{
+				Stack.Add(i);
+			}
+			else if( Packed[i].xMax >= Extent.Get_XMin() && Packed[i].xMin <= Extent.Get_XMax()
+				 &&  Packed[i].yMax >= Extent.Get_YMin() && Packed[i].yMin <= Extent.Get_YMax() )
+			{
+				Shapes.Add(m_Index[i]);
+			}
+		}
+	}
+
+	std::sort(Shapes.Get_Array(), Shapes.Get_Array() + Shapes.Get_Size());
+
+	return( (int)Shapes.Get_Size() );
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
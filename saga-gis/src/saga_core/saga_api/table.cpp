@@ -299,6 +299,9 @@ void CSG_Table::_On_Construction(void)
 	m_Field_Type	= NULL;
 	m_Field_Stats	= NULL;
 
+	m_Storage		= SG_TABLE_STORAGE_Records;
+	m_Columns		= NULL;
+
 	m_Records		= NULL;
 	m_nRecords		= 0;
 	m_nBuffer		= 0;
@@ -334,6 +337,11 @@ bool CSG_Table::Destroy(void)
 		{
 			delete(m_Field_Name [i]);
 			delete(m_Field_Stats[i]);
+
+			if( m_Columns )
+			{
+				delete(m_Columns[i]);
+			}
 		}
 
 		m_nFields		= 0;
@@ -341,6 +349,7 @@ bool CSG_Table::Destroy(void)
 		SG_Free(m_Field_Name);
 		SG_Free(m_Field_Type);
 		SG_Free(m_Field_Stats);
+		SG_FREE_SAFE(m_Columns);
 
 		m_Field_Name	= NULL;
 		m_Field_Type	= NULL;
@@ -425,6 +434,93 @@ bool CSG_Table::Assign_Values(const SG_Char *FileName)
 }
 
 
+///////////////////////////////////////////////////////////
+//														 //
+//						Storage							 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Table::Set_Storage(TSG_Table_Storage Storage)
+{
+	if( Storage == m_Storage )
+	{
+		return( true );
+	}
+
+	if( Get_ObjectType() == SG_DATAOBJECT_TYPE_PointCloud )	// point clouds come with their own storage
+	{
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	if( Storage == SG_TABLE_STORAGE_Columns )
+	{
+		m_Columns	= m_nFields > 0 ? (CSG_Table_Column **)SG_Malloc(m_nFields * sizeof(CSG_Table_Column *)) : NULL;
+
+		for(int iField=0; iField<m_nFields; iField++)
+		{
+			m_Columns[iField]	= new CSG_Table_Column(m_Field_Type[iField], m_nRecords);
+
+			for(int i=0; i<m_nRecords; i++)
+			{
+				CSG_Table_Value_Column(m_Columns[iField], i)	= *m_Records[i]->m_Values[iField];
+			}
+		}
+
+		for(int i=0; i<m_nRecords; i++)
+		{
+			CSG_Table_Record	*pRecord	= m_Records[i];
+
+			for(int iField=0; iField<m_nFields; iField++)
+			{
+				delete(pRecord->m_Values[iField]);
+			}
+
+			SG_FREE_SAFE(pRecord->m_Values);
+		}
+	}
+
+	//-----------------------------------------------------
+	else
+	{
+		for(int i=0; i<m_nRecords; i++)
+		{
+			CSG_Table_Record	*pRecord	= m_Records[i];
+
+			CSG_Table_Value	**Values	= m_nFields > 0 ? (CSG_Table_Value **)SG_Malloc(m_nFields * sizeof(CSG_Table_Value *)) : NULL;
+
+			for(int iField=0; iField<m_nFields; iField++)
+			{
+				Values[iField]	= CSG_Table_Record::_Create_Value(m_Field_Type[iField]);
+
+				*Values[iField]	= CSG_Table_Value_Column(m_Columns[iField], i);
+
+				if( pRecord->m_Values && pRecord->m_Values[iField] )
+				{
+					delete(pRecord->m_Values[iField]);
+				}
+			}
+
+			SG_FREE_SAFE(pRecord->m_Values);
+
+			pRecord->m_Values	= Values;
+		}
+
+		for(int iField=0; iField<m_nFields; iField++)
+		{
+			delete(m_Columns[iField]);
+		}
+
+		SG_FREE_SAFE(m_Columns);
+	}
+
+	m_Storage	= Storage;
+
+	return( true );
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //						Checks							 //
@@ -497,12 +593,22 @@ bool CSG_Table::Add_Field(const CSG_String &Name, TSG_Data_Type Type, int Positi
 	m_Field_Type	= (TSG_Data_Type          *)SG_Realloc(m_Field_Type , m_nFields * sizeof(TSG_Data_Type          ));
 	m_Field_Stats	= (CSG_Simple_Statistics **)SG_Realloc(m_Field_Stats, m_nFields * sizeof(CSG_Simple_Statistics *));
 
+	if( m_Storage == SG_TABLE_STORAGE_Columns )
+	{
+		m_Columns	= (CSG_Table_Column      **)SG_Realloc(m_Columns    , m_nFields * sizeof(CSG_Table_Column      *));
+	}
+
 	//-----------------------------------------------------
 	for(int i=m_nFields-1; i>Position; i--)
 	{
 		m_Field_Name [i]	= m_Field_Name [i - 1];
 		m_Field_Type [i]	= m_Field_Type [i - 1];
 		m_Field_Stats[i]	= m_Field_Stats[i - 1];
+
+		if( m_Columns )
+		{
+			m_Columns[i]	= m_Columns[i - 1];
+		}
 	}
 
 	//-----------------------------------------------------
@@ -510,6 +616,11 @@ bool CSG_Table::Add_Field(const CSG_String &Name, TSG_Data_Type Type, int Positi
 	m_Field_Type [Position]	= Type;
 	m_Field_Stats[Position]	= new CSG_Simple_Statistics();
 
+	if( m_Columns )
+	{
+		m_Columns[Position]	= new CSG_Table_Column(Type, m_nRecords);
+	}
+
 	//-----------------------------------------------------
 	for(int i=0; i<m_nRecords; i++)
 	{
@@ -533,6 +644,11 @@ bool CSG_Table::Del_Field(int del_Field)
 	delete(m_Field_Name [del_Field]);
 	delete(m_Field_Stats[del_Field]);
 
+	if( m_Columns )
+	{
+		delete(m_Columns[del_Field]);
+	}
+
 	//-------------------------------------------------
 	m_nFields--;
 
@@ -541,6 +657,11 @@ bool CSG_Table::Del_Field(int del_Field)
 		m_Field_Name [i]	= m_Field_Name [i + 1];
 		m_Field_Type [i]	= m_Field_Type [i + 1];
 		m_Field_Stats[i]	= m_Field_Stats[i + 1];
+
+		if( m_Columns )
+		{
+			m_Columns[i]	= m_Columns[i + 1];
+		}
 	}
 
 	//-------------------------------------------------
@@ -548,6 +669,11 @@ bool CSG_Table::Del_Field(int del_Field)
 	m_Field_Type	= (TSG_Data_Type          *)SG_Realloc(m_Field_Type , m_nFields * sizeof(TSG_Data_Type          ));
 	m_Field_Stats	= (CSG_Simple_Statistics **)SG_Realloc(m_Field_Stats, m_nFields * sizeof(CSG_Simple_Statistics *));
 
+	if( m_Columns && m_nFields < 1 )
+	{
+		SG_FREE_SAFE(m_Columns);
+	}
+
 	//-------------------------------------------------
 	for(int i=0; i<m_nRecords; i++)
 	{
@@ -592,10 +718,10 @@ bool CSG_Table::Mov_Field(int iField, int Position)
 		iField++;
 	}
 
-	#pragma omp parallel for
+	#pragma omp parallel for if( !m_Columns )	// writing strings to a column is not thread safe
 	for(int i=0; i<m_nRecords; i++)
 	{
-		*m_Records[i]->Get_Value(Position) = *m_Records[i]->Get_Value(iField);
+		m_Records[i]->_Assign_Value(Position, m_Records[i], iField);
 	}
 
 	if( !Del_Field(iField) )
@@ -642,6 +768,24 @@ bool CSG_Table::Set_Field_Type(int iField, TSG_Data_Type Type)
 
 	m_Field_Type[iField]	= Type;
 
+	if( m_Columns )
+	{
+		CSG_Table_Column	*pColumn	= new CSG_Table_Column(Type, m_nRecords);
+
+		for(int i=0; i<m_nRecords; i++)
+		{
+			CSG_Table_Value_Column(pColumn, i)	= CSG_Table_Value_Column(m_Columns[iField], i);
+
+			m_Records[i]->Set_Modified();
+		}
+
+		delete(m_Columns[iField]);
+
+		m_Columns[iField]	= pColumn;
+
+		return( true );
+	}
+
 	for(int i=0; i<m_nRecords; i++)
 	{
 		CSG_Table_Record	*pRecord	= m_Records[i];
@@ -760,6 +904,36 @@ bool CSG_Table::_Dec_Array(void)
 	return( true );
 }
 
+//---------------------------------------------------------
+bool CSG_Table::_Ins_Columns(int iRecord)
+{
+	for(int iField=0; m_Columns && iField<m_nFields; iField++)
+	{
+		if( !m_Columns[iField]->Ins_Value(iRecord) )
+		{
+			while( --iField >= 0 )
+			{
+				m_Columns[iField]->Del_Value(iRecord);
+			}
+
+			return( false );
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Table::_Del_Columns(int iRecord)
+{
+	for(int iField=0; m_Columns && iField<m_nFields; iField++)
+	{
+		m_Columns[iField]->Del_Value(iRecord);
+	}
+
+	return( true );
+}
+
 //---------------------------------------------------------
 CSG_Table_Record * CSG_Table::_Get_New_Record(int Index)
 {
@@ -777,23 +951,10 @@ CSG_Table_Record * CSG_Table::Ins_Record(int iRecord, CSG_Table_Record *pCopy)
 {
 	if( iRecord < 0 ) { iRecord = 0; } else if( iRecord > m_nRecords ) { iRecord = m_nRecords; }
 
-	CSG_Table_Record	*pRecord	= _Inc_Array() ? _Get_New_Record(m_nRecords) : NULL;
+	CSG_Table_Record	*pRecord	= _Inc_Array() && _Ins_Columns(iRecord) ? _Get_New_Record(m_nRecords) : NULL;
 
 	if( pRecord )
 	{
-		if( pCopy )
-		{
-			if( Get_ObjectType() == SG_DATAOBJECT_TYPE_Shapes && pCopy->Get_Table()->Get_ObjectType() == SG_DATAOBJECT_TYPE_Shapes )
-			{
-				((CSG_Shape *)pRecord)->Assign((CSG_Shape *)pCopy, true);
-			}
-			else
-			{
-				pRecord->Assign(pCopy);
-			}
-		}
-
-		//-------------------------------------------------
 		if( iRecord < m_nRecords )
 		{
 			if( Get_Selection_Count() > 0 )	// update selection index
@@ -820,6 +981,19 @@ CSG_Table_Record * CSG_Table::Ins_Record(int iRecord, CSG_Table_Record *pCopy)
 		m_Records[iRecord]	= pRecord;
 		m_nRecords++;
 
+		//-------------------------------------------------
+		if( pCopy )	// copy not before the record indices have been updated, the source might be a record of this table
+		{
+			if( Get_ObjectType() == SG_DATAOBJECT_TYPE_Shapes && pCopy->Get_Table()->Get_ObjectType() == SG_DATAOBJECT_TYPE_Shapes )
+			{
+				((CSG_Shape *)pRecord)->Assign((CSG_Shape *)pCopy, true);
+			}
+			else
+			{
+				pRecord->Assign(pCopy);
+			}
+		}
+
 		//-------------------------------------------------
 		if( m_Index.is_Okay() )
 		{
@@ -859,6 +1033,8 @@ bool CSG_Table::Del_Record(int iRecord)
 
 		delete(m_Records[iRecord]);
 
+		_Del_Columns(iRecord);
+
 		m_nRecords--;
 
 		for(int i=iRecord; i<m_nRecords; i++)
@@ -901,6 +1077,11 @@ bool CSG_Table::Del_Records(void)
 	m_nRecords	= 0;
 	m_nBuffer	= 0;
 
+	for(int iField=0; m_Columns && iField<m_nFields; iField++)
+	{
+		m_Columns[iField]->Set_Count(0);
+	}
+
 	return( true );
 }
 
@@ -1241,6 +1422,30 @@ bool CSG_Table::_Stats_Update(int iField) const
 			: (sLong)(Get_Count() * (double)Statistics.Get_Count() / (double)Get_Max_Samples())
 		);
 	}
+	else if( Get_Column(iField) && Get_Column(iField)->Get_Type() == SG_TABLE_VALUE_TYPE_Double )	// stream the column's values
+	{
+		const double	*Values	= Get_Column(iField)->Get_Doubles();
+
+		for(int i=0; i<Get_Count(); i++)
+		{
+			if( !is_NoData_Value(Values[i]) )
+			{
+				Statistics	+= Values[i];
+			}
+		}
+	}
+	else if( Get_Column(iField) && Get_Column(iField)->Get_Type() == SG_TABLE_VALUE_TYPE_Int )
+	{
+		const int		*Values	= Get_Column(iField)->Get_Ints();
+
+		for(int i=0; i<Get_Count(); i++)
+		{
+			if( !is_NoData_Value(Values[i]) )
+			{
+				Statistics	+= Values[i];
+			}
+		}
+	}
 	else
 	{
 		for(int i=0; i<Get_Count(); i++)
@@ -107,6 +107,19 @@ typedef enum ESG_Table_Index_Order
 }
 TSG_Table_Index_Order;
 
+//---------------------------------------------------------
+// Column storage has to be requested explicitly (see
+// CSG_Table::Set_Storage()). Writing strings may move the
+// column's string memory, which invalidates the pointers
+// returned by asString() before, and string fields must not
+// be written by more than one thread at the same time.
+typedef enum ESG_Table_Storage
+{
+	SG_TABLE_STORAGE_Records	= 0,	// one value object per cell (default)
+	SG_TABLE_STORAGE_Columns			// one typed value array per field
+}
+TSG_Table_Storage;
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -168,8 +181,8 @@ public:
 	double						asDouble		(int              iField)	const;
 	double						asDouble		(const CSG_String &Field)	const;
 
-	CSG_Table_Value *			Get_Value		(int              iField)			{	return(  m_Values[iField] );	}
-	CSG_Table_Value &			operator []		(int              iField)	const	{	return( *m_Values[iField] );	}
+	CSG_Table_Value *			Get_Value		(int              iField);
+	CSG_Table_Value &			operator []		(int              iField)	const;
 
 	virtual bool				Assign			(CSG_Table_Record *pRecord);
 
@@ -201,6 +214,8 @@ protected:
 	bool						_Add_Field		(int add_Field);
 	bool						_Del_Field		(int del_Field);
 
+	bool						_Assign_Value	(int iField, CSG_Table_Record *pSource, int jField);
+
 	int							_Get_Field	 	(const CSG_String &Field)	const;
 
 };
@@ -262,6 +277,12 @@ public:
 
 	bool							Serialize			(CSG_File &Stream, bool bSave);
 
+	//-----------------------------------------------------
+	bool							Set_Storage			(TSG_Table_Storage Storage);	// records stay valid when switching the storage, value pointers obtained with CSG_Table_Record::Get_Value() do not.
+	TSG_Table_Storage				Get_Storage			(void)	const	{	return( m_Storage );	}
+
+	CSG_Table_Column *				Get_Column			(int iField)	const	{	return( m_Columns && iField >= 0 && iField < m_nFields ? m_Columns[iField] : NULL );	}
+
 	//-----------------------------------------------------
 	virtual bool					is_Valid			(void)	const			{	return( m_nFields > 0 );	}
 
@@ -379,6 +400,10 @@ protected:
 
 	CSG_Simple_Statistics			**m_Field_Stats;
 
+	TSG_Table_Storage				m_Storage;
+
+	CSG_Table_Column				**m_Columns;
+
 	CSG_Array						m_Selection;
 
 	CSG_Rect						m_Extent;
@@ -417,6 +442,9 @@ private:
 	bool							_Inc_Array			(void);
 	bool							_Dec_Array			(void);
 
+	bool							_Ins_Columns		(int iRecord);
+	bool							_Del_Columns		(int iRecord);
+
 	size_t							_Load_Text_Trim		(      CSG_String &Text, const SG_Char Separator);
 	size_t							_Load_Text_EndQuote	(const CSG_String &Text, const SG_Char Separator);
 
@@ -0,0 +1,611 @@
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//           Application Programming Interface           //
+//                                                       //
+//                  Library: SAGA_API                    //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                   table_column.cpp                    //
+//                                                       //
+//          Copyright (C) 2026 by Olaf Conrad            //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'.                              //
+//                                                       //
+// This library is free software; you can redistribute   //
+// it and/or modify it under the terms of the GNU Lesser //
+// General Public License as published by the Free       //
+// Software Foundation, either version 2.1 of the        //
+// License, or (at your option) any later version.       //
+//                                                       //
+// This library is distributed in the hope that it will  //
+// be useful, but WITHOUT ANY WARRANTY; without even the //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU Lesser General Public //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU Lesser     //
+// General Public License along with this program; if    //
+// not, see <http://www.gnu.org/licenses/>.              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    contact:    Olaf Conrad                            //
+//                Institute of Geography                 //
+//                University of Goettingen               //
+//                Goldschmidtstr. 5                      //
+//                37077 Goettingen                       //
+//                Germany                                //
+//                                                       //
+//    e-mail:     oconrad@saga-gis.org                   //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include "table_value.h"
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#define STRINGS_GARBAGE_MIN	65536
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_Table_Column::CSG_Table_Column(TSG_Data_Type Type, sLong nValues)
+{
+	m_Data_Type	= Type;
+	m_Type		= Get_Value_Type(Type);
+
+	m_nValues	= 0;
+	m_Garbage	= 0;
+
+	switch( m_Type )
+	{
+	case SG_TABLE_VALUE_TYPE_Binary: m_Values.Create(sizeof(CSG_Bytes *), 0, SG_ARRAY_GROWTH_3); break;
+	case SG_TABLE_VALUE_TYPE_String: m_Values.Create(sizeof(sLong      ), 0, SG_ARRAY_GROWTH_3); break;
+	case SG_TABLE_VALUE_TYPE_Int   : m_Values.Create(sizeof(int        ), 0, SG_ARRAY_GROWTH_3); break;
+	case SG_TABLE_VALUE_TYPE_Long  : m_Values.Create(sizeof(sLong      ), 0, SG_ARRAY_GROWTH_3); break;
+	case SG_TABLE_VALUE_TYPE_Date  :
+	case SG_TABLE_VALUE_TYPE_Double: m_Values.Create(sizeof(double     ), 0, SG_ARRAY_GROWTH_3); break;
+	}
+
+	m_Strings.Create(sizeof(SG_Char), 0, SG_ARRAY_GROWTH_3);
+
+	Set_Count(nValues);
+}
+
+//---------------------------------------------------------
+CSG_Table_Column::~CSG_Table_Column(void)
+{
+	Set_Count(0);
+}
+
+//---------------------------------------------------------
+TSG_Table_Value_Type CSG_Table_Column::Get_Value_Type(TSG_Data_Type Type)
+{
+	switch( Type )
+	{
+	default:
+	case SG_DATATYPE_String: return( SG_TABLE_VALUE_TYPE_String );
+
+	case SG_DATATYPE_Date  : return( SG_TABLE_VALUE_TYPE_Date   );
+
+	case SG_DATATYPE_Color :
+	case SG_DATATYPE_Byte  :
+	case SG_DATATYPE_Char  :
+	case SG_DATATYPE_Word  :
+	case SG_DATATYPE_Short :
+	case SG_DATATYPE_DWord :
+	case SG_DATATYPE_Int   : return( SG_TABLE_VALUE_TYPE_Int    );
+
+	case SG_DATATYPE_ULong :
+	case SG_DATATYPE_Long  : return( SG_TABLE_VALUE_TYPE_Long   );
+
+	case SG_DATATYPE_Float :
+	case SG_DATATYPE_Double: return( SG_TABLE_VALUE_TYPE_Double );
+
+	case SG_DATATYPE_Binary: return( SG_TABLE_VALUE_TYPE_Binary );
+	}
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Table_Column::Set_Count(sLong nValues)
+{
+	if( nValues < 0 )
+	{
+		return( false );
+	}
+
+	for(sLong i=nValues; i<m_nValues; i++)
+	{
+		_Destroy_Value(i);
+	}
+
+	if( !m_Values.Set_Array((size_t)nValues) )
+	{
+		return( false );
+	}
+
+	if( nValues > m_nValues )	// all bits zero is a valid 'zero' for numbers and binaries
+	{
+		memset((char *)m_Values.Get_Array() + m_nValues * m_Values.Get_Value_Size(), 0, (nValues - m_nValues) * m_Values.Get_Value_Size());
+
+		if( m_Type == SG_TABLE_VALUE_TYPE_String )
+		{
+			for(sLong i=m_nValues; i<nValues; i++)
+			{
+				((sLong *)m_Values.Get_Array())[i]	= -1;
+			}
+		}
+	}
+
+	m_nValues	= nValues;
+
+	if( m_nValues == 0 )
+	{
+		m_Strings.Set_Array(0);
+
+		m_Garbage	= 0;
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Table_Column::Ins_Value(sLong Index)
+{
+	if( Index < 0 || Index > m_nValues || !m_Values.Set_Array((size_t)(m_nValues + 1)) )
+	{
+		return( false );
+	}
+
+	size_t	Size	= m_Values.Get_Value_Size();
+	char	*Value	= (char *)m_Values.Get_Array() + Index * Size;
+
+	memmove(Value + Size, Value, (m_nValues - Index) * Size);
+	memset (Value, 0, Size);
+
+	if( m_Type == SG_TABLE_VALUE_TYPE_String )
+	{
+		*((sLong *)Value)	= -1;
+	}
+
+	m_nValues++;
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Table_Column::Del_Value(sLong Index)
+{
+	if( Index < 0 || Index >= m_nValues )
+	{
+		return( false );
+	}
+
+	_Destroy_Value(Index);
+
+	size_t	Size	= m_Values.Get_Value_Size();
+	char	*Value	= (char *)m_Values.Get_Array() + Index * Size;
+
+	memmove(Value, Value + Size, (m_nValues - Index - 1) * Size);
+
+	m_Values.Set_Array((size_t)--m_nValues);
+
+	if( m_nValues == 0 )
+	{
+		m_Strings.Set_Array(0);
+
+		m_Garbage	= 0;
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+void CSG_Table_Column::_Destroy_Value(sLong Index)
+{
+	switch( m_Type )
+	{
+	case SG_TABLE_VALUE_TYPE_Binary:
+		{
+			CSG_Bytes	**pBytes	= (CSG_Bytes **)m_Values.Get_Array() + Index;
+
+			if( *pBytes )
+			{
+				delete(*pBytes);
+
+				*pBytes	= NULL;
+			}
+		}
+		break;
+
+	case SG_TABLE_VALUE_TYPE_String:
+		{
+			sLong	*Offset	= (sLong *)m_Values.Get_Array() + Index;
+
+			if( *Offset >= 0 )
+			{
+				m_Garbage	+= SG_STR_LEN(_Get_String(Index)) + 1;
+
+				*Offset	= -1;
+			}
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+const SG_Char * CSG_Table_Column::_Get_String(sLong Index) const
+{
+	sLong	Offset	= ((sLong *)m_Values.Get_Array())[Index];
+
+	return( Offset < 0 ? SG_T("") : (SG_Char *)m_Strings.Get_Array() + Offset );
+}
+
+//---------------------------------------------------------
+bool CSG_Table_Column::_Set_String(sLong Index, const SG_Char *Value)
+{
+	const SG_Char	*Current	= _Get_String(Index);
+
+	if( !Value || !SG_STR_CMP(Current, Value) )
+	{
+		return( false );
+	}
+
+	sLong	*Offset	= (sLong *)m_Values.Get_Array() + Index;
+	size_t	nOld	= SG_STR_LEN(Current), nNew = SG_STR_LEN(Value);
+
+	if( nNew == 0 )
+	{
+		_Destroy_Value(Index);
+	}
+	else if( *Offset >= 0 && nNew <= nOld )	// re-use the old string's space
+	{
+		memmove((SG_Char *)m_Strings.Get_Array() + *Offset, Value, (nNew + 1) * sizeof(SG_Char));
+
+		m_Garbage	+= nOld - nNew;
+	}
+	else
+	{
+		CSG_String	Copy;	// the source might be located in the string buffer, which is going to be reallocated
+
+		if( Value >= (SG_Char *)m_Strings.Get_Array() && Value < (SG_Char *)m_Strings.Get_Array() + m_Strings.Get_Size() )
+		{
+			Copy	= Value;	Value	= Copy.c_str();
+		}
+
+		size_t	n	= m_Strings.Get_Size();
+
+		if( !m_Strings.Set_Array(n + nNew + 1) )
+		{
+			return( false );
+		}
+
+		memcpy((SG_Char *)m_Strings.Get_Array() + n, Value, (nNew + 1) * sizeof(SG_Char));
+
+		_Destroy_Value(Index);
+
+		*Offset	= (sLong)n;
+	}
+
+	if( m_Garbage > STRINGS_GARBAGE_MIN && m_Garbage > (sLong)m_Strings.Get_Size() / 2 )
+	{
+		_Compact();
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Table_Column::_Compact(void)
+{
+	size_t	Size	= m_Strings.Get_Size() - (size_t)m_Garbage;
+
+	SG_Char	*Strings	= (SG_Char *)SG_Malloc(Size * sizeof(SG_Char));
+
+	if( !Strings )
+	{
+		return( false );
+	}
+
+	sLong	*Offsets	= (sLong *)m_Values.Get_Array();
+
+	for(sLong i=0, n=0; i<m_nValues; i++)
+	{
+		if( Offsets[i] >= 0 )
+		{
+			const SG_Char	*s	= (SG_Char *)m_Strings.Get_Array() + Offsets[i];
+
+			size_t	Length	= SG_STR_LEN(s) + 1;
+
+			memcpy(Strings + n, s, Length * sizeof(SG_Char));
+
+			Offsets[i]	= n;	n	+= Length;
+		}
+	}
+
+	m_Strings.Set_Array(Size);
+
+	memcpy(m_Strings.Get_Array(), Strings, Size * sizeof(SG_Char));
+
+	SG_Free(Strings);
+
+	m_Garbage	= 0;
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#define CHECK_INDEX(Index)	if( Index < 0 || Index >= m_nValues ) { return( false ); }
+
+#define SET_VALUE(Type, Value)	{ Type *pValue = (Type *)m_Values.Get_Array() + Index; if( *pValue != Value ) { *pValue = Value; return( true ); } return( false ); }
+
+//---------------------------------------------------------
+bool CSG_Table_Column::Set_Value(sLong Index, const CSG_Bytes &Value)
+{
+	CHECK_INDEX(Index);
+
+	if( m_Type == SG_TABLE_VALUE_TYPE_Binary )
+	{
+		CSG_Bytes	**pBytes	= (CSG_Bytes **)m_Values.Get_Array() + Index;
+
+		if( !*pBytes )
+		{
+			*pBytes	= new CSG_Bytes;
+		}
+
+		return( (*pBytes)->Create(Value) );
+	}
+
+	return( Set_Value(Index, (const SG_Char *)Value.Get_Bytes()) );
+}
+
+//---------------------------------------------------------
+bool CSG_Table_Column::Set_Value(sLong Index, const SG_Char *Value)
+{
+	CHECK_INDEX(Index);
+
+	switch( m_Type )
+	{
+	case SG_TABLE_VALUE_TYPE_Binary:
+		return( Set_Value(Index, CSG_Bytes((BYTE *)Value, (int)((Value && *Value ? SG_STR_LEN(Value) : 0 * sizeof(SG_Char))))) );
+
+	case SG_TABLE_VALUE_TYPE_String:
+		return( _Set_String(Index, Value) );
+
+	case SG_TABLE_VALUE_TYPE_Date  :
+		return( Set_Value(Index, SG_Date_To_JulianDayNumber(Value)) );
+
+	case SG_TABLE_VALUE_TYPE_Int   :
+		{
+			int   i; CSG_String s(Value); return( s.asInt     (i) ? Set_Value(Index, i) : false );
+		}
+
+	case SG_TABLE_VALUE_TYPE_Long  :
+		{
+			sLong i; CSG_String s(Value); return( s.asLongLong(i) ? Set_Value(Index, i) : false );
+		}
+
+	case SG_TABLE_VALUE_TYPE_Double:
+		{
+			double d; CSG_String s(Value); return( s.asDouble(d) ? Set_Value(Index, d) : false );
+		}
+	}
+
+	return( false );
+}
+
+//---------------------------------------------------------
+bool CSG_Table_Column::Set_Value(sLong Index, int Value)
+{
+	CHECK_INDEX(Index);
+
+	switch( m_Type )
+	{
+	case SG_TABLE_VALUE_TYPE_Binary: return( Set_Value(Index, CSG_Bytes((BYTE *)&Value, sizeof(Value))) );
+	case SG_TABLE_VALUE_TYPE_String: return( _Set_String(Index, CSG_String::Format("%d", Value).c_str()) );
+	case SG_TABLE_VALUE_TYPE_Int   : SET_VALUE(int, Value);
+	case SG_TABLE_VALUE_TYPE_Long  : return( Set_Value(Index, (sLong )Value) );
+	case SG_TABLE_VALUE_TYPE_Date  :
+	case SG_TABLE_VALUE_TYPE_Double: return( Set_Value(Index, (double)Value) );
+	}
+
+	return( false );
+}
+
+//---------------------------------------------------------
+bool CSG_Table_Column::Set_Value(sLong Index, sLong Value)
+{
+	CHECK_INDEX(Index);
+
+	switch( m_Type )
+	{
+	case SG_TABLE_VALUE_TYPE_Binary: return( Set_Value(Index, CSG_Bytes((BYTE *)&Value, sizeof(Value))) );
+	case SG_TABLE_VALUE_TYPE_String: return( _Set_String(Index, CSG_String::Format("%lld", (long long)Value).c_str()) );
+	case SG_TABLE_VALUE_TYPE_Int   : return( Set_Value(Index, (int   )Value) );
+	case SG_TABLE_VALUE_TYPE_Long  : SET_VALUE(sLong, Value);
+	case SG_TABLE_VALUE_TYPE_Date  :
+	case SG_TABLE_VALUE_TYPE_Double: return( Set_Value(Index, (double)Value) );
+	}
+
+	return( false );
+}
+
+//---------------------------------------------------------
+bool CSG_Table_Column::Set_Value(sLong Index, double Value)
+{
+	CHECK_INDEX(Index);
+
+	switch( m_Type )
+	{
+	case SG_TABLE_VALUE_TYPE_Binary: return( Set_Value(Index, CSG_Bytes((BYTE *)&Value, sizeof(Value))) );
+	case SG_TABLE_VALUE_TYPE_String: return( _Set_String(Index, CSG_String::Format("%f", Value).c_str()) );
+	case SG_TABLE_VALUE_TYPE_Int   : return( Set_Value(Index, (int   )Value) );
+	case SG_TABLE_VALUE_TYPE_Long  : return( Set_Value(Index, (sLong )Value) );
+	case SG_TABLE_VALUE_TYPE_Date  :
+	case SG_TABLE_VALUE_TYPE_Double: SET_VALUE(double, Value);
+	}
+
+	return( false );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_Bytes CSG_Table_Column::asBinary(sLong Index) const
+{
+	if( m_Type == SG_TABLE_VALUE_TYPE_Binary )
+	{
+		CSG_Bytes	*pBytes	= Index >= 0 && Index < m_nValues ? ((CSG_Bytes **)m_Values.Get_Array())[Index] : NULL;
+
+		return( pBytes ? *pBytes : CSG_Bytes() );
+	}
+
+	const SG_Char	*s	= asString(Index);
+
+	return( CSG_Bytes((BYTE *)s, (int)(s && *s ? SG_STR_LEN(s) : 0) * sizeof(SG_Char)) );
+}
+
+//---------------------------------------------------------
+const SG_Char * CSG_Table_Column::asString(sLong Index, int Decimals) const
+{
+	if( Index < 0 || Index >= m_nValues )
+	{
+		return( NULL );
+	}
+
+	static CSG_String	s;
+
+	switch( m_Type )
+	{
+	case SG_TABLE_VALUE_TYPE_Binary:
+		{
+			CSG_Bytes	*pBytes	= ((CSG_Bytes **)m_Values.Get_Array())[Index];
+
+			return( pBytes ? (const SG_Char *)pBytes->Get_Bytes() : NULL );
+		}
+
+	case SG_TABLE_VALUE_TYPE_String:
+		return( _Get_String(Index) );
+
+	case SG_TABLE_VALUE_TYPE_Date  :	// a Julian Day Number of zero is used for dates that have not been set
+		{
+			double	JDN	= ((double *)m_Values.Get_Array())[Index];
+
+			s	= JDN != 0. ? SG_JulianDayNumber_To_Date(JDN) : CSG_String("");
+		}
+		break;
+
+	case SG_TABLE_VALUE_TYPE_Int   :
+		s.Printf("%d" , ((int   *)m_Values.Get_Array())[Index]);
+		break;
+
+	case SG_TABLE_VALUE_TYPE_Long  :
+		s.Printf("%lld", (long long)((sLong *)m_Values.Get_Array())[Index]);
+		break;
+
+	case SG_TABLE_VALUE_TYPE_Double:
+		s	= SG_Get_String(((double *)m_Values.Get_Array())[Index], Decimals);
+		break;
+	}
+
+	return( s.c_str() );
+}
+
+//---------------------------------------------------------
+int CSG_Table_Column::asInt(sLong Index) const
+{
+	if( Index >= 0 && Index < m_nValues ) switch( m_Type )
+	{
+	case SG_TABLE_VALUE_TYPE_Binary: { CSG_Bytes *pBytes = ((CSG_Bytes **)m_Values.Get_Array())[Index]; return( pBytes ? pBytes->Get_Count() : 0 ); }
+	case SG_TABLE_VALUE_TYPE_String: return( CSG_String(_Get_String(Index)).asInt() );
+	case SG_TABLE_VALUE_TYPE_Int   : return(       ((int    *)m_Values.Get_Array())[Index] );
+	case SG_TABLE_VALUE_TYPE_Long  : return( (int )((sLong  *)m_Values.Get_Array())[Index] );
+	case SG_TABLE_VALUE_TYPE_Date  :
+	case SG_TABLE_VALUE_TYPE_Double: return( (int )((double *)m_Values.Get_Array())[Index] );
+	}
+
+	return( 0 );
+}
+
+//---------------------------------------------------------
+sLong CSG_Table_Column::asLong(sLong Index) const
+{
+	if( Index >= 0 && Index < m_nValues ) switch( m_Type )
+	{
+	case SG_TABLE_VALUE_TYPE_Binary: { CSG_Bytes *pBytes = ((CSG_Bytes **)m_Values.Get_Array())[Index]; return( pBytes ? pBytes->Get_Count() : 0 ); }
+	case SG_TABLE_VALUE_TYPE_String: return( CSG_String(_Get_String(Index)).asLongLong() );
+	case SG_TABLE_VALUE_TYPE_Int   : return(         ((int    *)m_Values.Get_Array())[Index] );
+	case SG_TABLE_VALUE_TYPE_Long  : return(         ((sLong  *)m_Values.Get_Array())[Index] );
+	case SG_TABLE_VALUE_TYPE_Date  :
+	case SG_TABLE_VALUE_TYPE_Double: return( (sLong )((double *)m_Values.Get_Array())[Index] );
+	}
+
+	return( 0 );
+}
+
+//---------------------------------------------------------
+double CSG_Table_Column::asDouble(sLong Index) const
+{
+	if( Index >= 0 && Index < m_nValues ) switch( m_Type )
+	{
+	case SG_TABLE_VALUE_TYPE_Binary: return( 0. );
+	case SG_TABLE_VALUE_TYPE_String: return( CSG_String(_Get_String(Index)).asDouble() );
+	case SG_TABLE_VALUE_TYPE_Int   : return(          ((int    *)m_Values.Get_Array())[Index] );
+	case SG_TABLE_VALUE_TYPE_Long  : return( (double )((sLong  *)m_Values.Get_Array())[Index] );
+	case SG_TABLE_VALUE_TYPE_Date  :
+	case SG_TABLE_VALUE_TYPE_Double: return(          ((double *)m_Values.Get_Array())[Index] );
+	}
+
+	return( 0. );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
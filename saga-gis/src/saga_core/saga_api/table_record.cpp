@@ -54,6 +54,44 @@
 #include "table_value.h"
 
 
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// With columnar storage a record has no own values. Value
+// objects are only created on request (Get_Value(), []),
+// and refer to the table's column and the record's index.
+//---------------------------------------------------------
+class CSG_Table_Record_Value : public CSG_Table_Value_Column
+{
+public:
+	CSG_Table_Record_Value(CSG_Table_Record *pRecord, int iField) : CSG_Table_Value_Column(NULL, 0)
+	{
+		m_pRecord	= pRecord;
+		m_iField	= iField;
+	}
+
+	CSG_Table_Record_Value &		operator = (const CSG_Table_Record_Value &Value)	{	CSG_Table_Value_Column::operator = ((const CSG_Table_Value &)Value);	return( *this );	}
+
+	int								m_iField;
+
+
+protected:
+
+	virtual CSG_Table_Column *		_Get_Column		(void)	const	{	return( m_pRecord->Get_Table()->Get_Column(m_iField) );	}
+	virtual sLong					_Get_Index		(void)	const	{	return( m_pRecord->Get_Index() );	}
+
+
+private:
+
+	CSG_Table_Record				*m_pRecord;
+
+};
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
@@ -67,7 +105,7 @@ CSG_Table_Record::CSG_Table_Record(CSG_Table *pTable, int Index)
 	m_Index		= Index;
 	m_Flags		= 0;
 
-	if( m_pTable && m_pTable->Get_Field_Count() > 0 )
+	if( m_pTable && m_pTable->Get_Field_Count() > 0 && m_pTable->Get_Storage() == SG_TABLE_STORAGE_Records )
 	{
 		m_Values	= (CSG_Table_Value **)SG_Malloc(m_pTable->Get_Field_Count() * sizeof(CSG_Table_Value *));
 
@@ -90,11 +128,14 @@ CSG_Table_Record::~CSG_Table_Record(void)
 		m_pTable->Select(m_Index, true);
 	}
 
-	if( m_pTable->Get_Field_Count() > 0 )
+	if( m_Values )
 	{
 		for(int iField=0; iField<m_pTable->Get_Field_Count(); iField++)
 		{
-			delete(m_Values[iField]);
+			if( m_Values[iField] )
+			{
+				delete(m_Values[iField]);
+			}
 		}
 
 		SG_Free(m_Values);
@@ -151,6 +192,26 @@ bool CSG_Table_Record::_Add_Field(int add_Field)
 		add_Field	= m_pTable->Get_Field_Count() - 1;
 	}
 
+	if( m_pTable->Get_Storage() == SG_TABLE_STORAGE_Columns )
+	{
+		if( m_Values )
+		{
+			m_Values	= (CSG_Table_Value **)SG_Realloc(m_Values, m_pTable->Get_Field_Count() * sizeof(CSG_Table_Value *));
+
+			for(int iField=m_pTable->Get_Field_Count()-1; iField>add_Field; iField--)
+			{
+				if( (m_Values[iField] = m_Values[iField - 1]) != NULL )
+				{
+					((CSG_Table_Record_Value *)m_Values[iField])->m_iField	= iField;
+				}
+			}
+
+			m_Values[add_Field]	= NULL;
+		}
+
+		return( true );
+	}
+
 	m_Values	= (CSG_Table_Value **)SG_Realloc(m_Values, m_pTable->Get_Field_Count() * sizeof(CSG_Table_Value *));
 
 	for(int iField=m_pTable->Get_Field_Count()-1; iField>add_Field; iField--)
@@ -166,11 +227,24 @@ bool CSG_Table_Record::_Add_Field(int add_Field)
 //---------------------------------------------------------
 bool CSG_Table_Record::_Del_Field(int del_Field)
 {
-	delete(m_Values[del_Field]);
+	if( m_pTable->Get_Storage() == SG_TABLE_STORAGE_Columns && !m_Values )
+	{
+		return( true );
+	}
+
+	if( m_Values[del_Field] )
+	{
+		delete(m_Values[del_Field]);
+	}
 
 	for(int iField=del_Field; iField<m_pTable->Get_Field_Count(); iField++)
 	{
 		m_Values[iField]	= m_Values[iField + 1];
+
+		if( m_pTable->Get_Storage() == SG_TABLE_STORAGE_Columns && m_Values[iField] )
+		{
+			((CSG_Table_Record_Value *)m_Values[iField])->m_iField	= iField;
+		}
 	}
 
 	m_Values	= (CSG_Table_Value **)SG_Realloc(m_Values, m_pTable->Get_Field_Count() * sizeof(CSG_Table_Value *));
@@ -178,6 +252,25 @@ bool CSG_Table_Record::_Del_Field(int del_Field)
 	return( true );
 }
 
+//---------------------------------------------------------
+bool CSG_Table_Record::_Assign_Value(int iField, CSG_Table_Record *pSource, int jField)
+{
+	CSG_Table_Column	*pTarget	= m_pTable->Get_Column(iField), *pColumn = pSource->m_pTable->Get_Column(jField);
+
+	if( !pTarget && !pColumn )
+	{
+		*(m_Values[iField])	= *(pSource->m_Values[jField]);
+	}
+	else
+	{
+		CSG_Table_Value_Column	Target(pTarget, m_Index), Source(pColumn, pSource->m_Index);
+
+		(pTarget ? (CSG_Table_Value &)Target : *m_Values[iField])	= (pColumn ? (CSG_Table_Value &)Source : *pSource->m_Values[jField]);
+	}
+
+	return( true );
+}
+
 //---------------------------------------------------------
 int CSG_Table_Record::_Get_Field(const CSG_String &Field) const
 {
@@ -247,7 +340,9 @@ bool CSG_Table_Record::Set_Value		(int           iField, const CSG_Bytes &Value)
 {
 	if( iField >= 0 && iField < m_pTable->Get_Field_Count() )
 	{
-		if( m_Values[iField]->Set_Value(Value) )
+		CSG_Table_Column	*pColumn	= m_pTable->Get_Column(iField);
+
+		if( pColumn ? pColumn->Set_Value(m_Index, Value) : m_Values[iField]->Set_Value(Value) )
 		{
 			Set_Modified(true);
 
@@ -271,7 +366,9 @@ bool CSG_Table_Record::Set_Value(int iField, const CSG_String &Value)
 {
 	if( iField >= 0 && iField < m_pTable->Get_Field_Count() )
 	{
-		if( m_Values[iField]->Set_Value(Value) )
+		CSG_Table_Column	*pColumn	= m_pTable->Get_Column(iField);
+
+		if( pColumn ? pColumn->Set_Value(m_Index, Value.c_str()) : m_Values[iField]->Set_Value(Value) )
 		{
 			Set_Modified(true);
 
@@ -295,7 +392,9 @@ bool CSG_Table_Record::Set_Value(int iField, double Value)
 {
 	if( iField >= 0 && iField < m_pTable->Get_Field_Count() )
 	{
-		if( m_Values[iField]->Set_Value(Value) )
+		CSG_Table_Column	*pColumn	= m_pTable->Get_Column(iField);
+
+		if( pColumn ? pColumn->Set_Value(m_Index, Value) : m_Values[iField]->Set_Value(Value) )
 		{
 			Set_Modified(true);
 
@@ -356,11 +455,13 @@ bool CSG_Table_Record::Set_NoData(int iField)
 {
 	if( iField >= 0 && iField < m_pTable->Get_Field_Count() )
 	{
+		CSG_Table_Column	*pColumn	= m_pTable->Get_Column(iField);
+
 		switch( m_pTable->Get_Field_Type(iField) )
 		{
 		default:
 		case SG_DATATYPE_String:
-			if( !m_Values[iField]->Set_Value(SG_T("")) )
+			if( !(pColumn ? pColumn->Set_Value(m_Index, SG_T("")) : m_Values[iField]->Set_Value(SG_T(""))) )
 				return( false );
 			break;
 
@@ -376,12 +477,15 @@ bool CSG_Table_Record::Set_NoData(int iField)
 		case SG_DATATYPE_Long  :
 		case SG_DATATYPE_Float :
 		case SG_DATATYPE_Double:
-			if( !m_Values[iField]->Set_Value(m_pTable->Get_NoData_Value()) )
+			if( !(pColumn ? pColumn->Set_Value(m_Index, m_pTable->Get_NoData_Value()) : m_Values[iField]->Set_Value(m_pTable->Get_NoData_Value())) )
 				return( false );
 			break;
 
 		case SG_DATATYPE_Binary:
-			m_Values[iField]->asBinary().Destroy();
+			if( pColumn )
+				pColumn->Set_Value(m_Index, CSG_Bytes());
+			else
+				m_Values[iField]->asBinary().Destroy();
 			break;
 		}
 
@@ -410,7 +514,7 @@ bool CSG_Table_Record::is_NoData(int iField) const
 		{
 		default:
 		case SG_DATATYPE_String:
-			return( !m_Values[iField]->asString() || !*m_Values[iField]->asString() );
+			return( !asString(iField) || !*asString(iField) );
 
 		case SG_DATATYPE_Date  :
 		case SG_DATATYPE_Color :
@@ -422,14 +526,14 @@ bool CSG_Table_Record::is_NoData(int iField) const
 		case SG_DATATYPE_Int   :
 		case SG_DATATYPE_ULong :
 		case SG_DATATYPE_Long  :
-			return( m_pTable->is_NoData_Value(m_Values[iField]->asInt()) );
+			return( m_pTable->is_NoData_Value(asInt(iField)) );
 
 		case SG_DATATYPE_Float :
 		case SG_DATATYPE_Double:
-			return( m_pTable->is_NoData_Value(m_Values[iField]->asDouble()) );
+			return( m_pTable->is_NoData_Value(asDouble(iField)) );
 
 		case SG_DATATYPE_Binary:
-			return( m_Values[iField]->asBinary().Get_Count() == 0 );
+			return( m_pTable->Get_Column(iField) ? asInt(iField) == 0 : m_Values[iField]->asBinary().Get_Count() == 0 );
 		}
 	}
 
@@ -449,7 +553,14 @@ bool CSG_Table_Record::is_NoData(const CSG_String &Field) const
 //---------------------------------------------------------
 const SG_Char * CSG_Table_Record::asString(int iField, int Decimals) const
 {
-	return( iField >= 0 && iField < m_pTable->Get_Field_Count() ? m_Values[iField]->asString(Decimals) : NULL );
+	if( iField >= 0 && iField < m_pTable->Get_Field_Count() )
+	{
+		CSG_Table_Column	*pColumn	= m_pTable->Get_Column(iField);
+
+		return( pColumn ? pColumn->asString(m_Index, Decimals) : m_Values[iField]->asString(Decimals) );
+	}
+
+	return( NULL );
 }
 
 const SG_Char * CSG_Table_Record::asString(const CSG_String &Field, int Decimals) const
@@ -460,7 +571,14 @@ const SG_Char * CSG_Table_Record::asString(const CSG_String &Field, int Decimals
 //---------------------------------------------------------
 int CSG_Table_Record::asInt(int iField) const
 {
-	return( iField >= 0 && iField < m_pTable->Get_Field_Count() ? m_Values[iField]->asInt() : 0 );
+	if( iField >= 0 && iField < m_pTable->Get_Field_Count() )
+	{
+		CSG_Table_Column	*pColumn	= m_pTable->Get_Column(iField);
+
+		return( pColumn ? pColumn->asInt(m_Index) : m_Values[iField]->asInt() );
+	}
+
+	return( 0 );
 }
 
 int CSG_Table_Record::asInt(const CSG_String &Field) const
@@ -471,7 +589,14 @@ int CSG_Table_Record::asInt(const CSG_String &Field) const
 //---------------------------------------------------------
 sLong CSG_Table_Record::asLong(int iField) const
 {
-	return( iField >= 0 && iField < m_pTable->Get_Field_Count() ? m_Values[iField]->asLong() : 0 );
+	if( iField >= 0 && iField < m_pTable->Get_Field_Count() )
+	{
+		CSG_Table_Column	*pColumn	= m_pTable->Get_Column(iField);
+
+		return( pColumn ? pColumn->asLong(m_Index) : m_Values[iField]->asLong() );
+	}
+
+	return( 0 );
 }
 
 sLong CSG_Table_Record::asLong(const CSG_String &Field) const
@@ -482,7 +607,14 @@ sLong CSG_Table_Record::asLong(const CSG_String &Field) const
 //---------------------------------------------------------
 double CSG_Table_Record::asDouble(int iField) const
 {
-	return( iField >= 0 && iField < m_pTable->Get_Field_Count() ? m_Values[iField]->asDouble() : 0.0 );
+	if( iField >= 0 && iField < m_pTable->Get_Field_Count() )
+	{
+		CSG_Table_Column	*pColumn	= m_pTable->Get_Column(iField);
+
+		return( pColumn ? pColumn->asDouble(m_Index) : m_Values[iField]->asDouble() );
+	}
+
+	return( 0.0 );
 }
 
 double CSG_Table_Record::asDouble(const CSG_String &Field) const
@@ -491,6 +623,50 @@ double CSG_Table_Record::asDouble(const CSG_String &Field) const
 }
 
 
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_Table_Value * CSG_Table_Record::Get_Value(int iField)
+{
+	if( m_pTable->Get_Storage() == SG_TABLE_STORAGE_Columns )
+	{
+		if( iField < 0 || iField >= m_pTable->Get_Field_Count() )
+		{
+			return( NULL );
+		}
+
+		CSG_Table_Value	*pValue;	// proxies are created on demand, the record's own accessors (asDouble(), Set_Value()...) do without
+
+		#pragma omp critical(SG_Table_Record_Get_Value)
+		{
+			if( !m_Values )
+			{
+				m_Values	= (CSG_Table_Value **)SG_Calloc(m_pTable->Get_Field_Count(), sizeof(CSG_Table_Value *));
+			}
+
+			if( !m_Values[iField] )
+			{
+				m_Values[iField]	= new CSG_Table_Record_Value(this, iField);
+			}
+
+			pValue	= m_Values[iField];
+		}
+
+		return( pValue );
+	}
+
+	return( m_Values[iField] );
+}
+
+//---------------------------------------------------------
+CSG_Table_Value & CSG_Table_Record::operator [] (int iField) const
+{
+	return( *((CSG_Table_Record *)this)->Get_Value(iField) );
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 ///////////////////////////////////////////////////////////
@@ -505,7 +681,7 @@ bool CSG_Table_Record::Assign(CSG_Table_Record *pRecord)
 
 		for(int iField=0; iField<nFields; iField++)
 		{
-			*(m_Values[iField])	= *(pRecord->m_Values[iField]);
+			_Assign_Value(iField, pRecord, iField);
 		}
 
 		Set_Modified();
@@ -476,10 +476,10 @@ public:
 
 	virtual bool					Set_Value		(const SG_Char   *Value)
 	{
-		int			i;
+		sLong		i;
 		CSG_String	s(Value);
 
-		return( s.asInt(i) ? Set_Value(i) : false );
+		return( s.asLongLong(i) ? Set_Value(i) : false );
 	}
 
 	virtual bool					Set_Value		(int              Value)
@@ -509,7 +509,7 @@ public:
 	{
 		static CSG_String	s;
 
-		s.Printf("%ld", m_Value);
+		s.Printf("%lld", (long long)m_Value);
 
 		return( s.c_str() );
 	}
@@ -615,6 +615,173 @@ private:
 };
 
 
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+* CSG_Table_Column keeps all values of one table field in a
+* single typed array instead of one value object per cell.
+* Strings are collected in a shared character buffer, which
+* is compacted when too much of it became unused. Pointers
+* returned by asString() remain valid only until the next
+* modification of the column.
+* @see CSG_Table::Set_Storage
+*/
+//---------------------------------------------------------
+class SAGA_API_DLL_EXPORT CSG_Table_Column
+{
+public:
+	CSG_Table_Column(TSG_Data_Type Type, sLong nValues = 0);
+	virtual ~CSG_Table_Column(void);
+
+	static TSG_Table_Value_Type	Get_Value_Type	(TSG_Data_Type Type);
+
+	TSG_Data_Type				Get_Data_Type	(void)	const	{	return( m_Data_Type );	}
+	TSG_Table_Value_Type		Get_Type		(void)	const	{	return( m_Type      );	}
+	sLong						Get_Count		(void)	const	{	return( m_nValues   );	}
+
+	bool						Set_Count		(sLong nValues);
+	bool						Ins_Value		(sLong Index);
+	bool						Del_Value		(sLong Index);
+
+	//-----------------------------------------------------
+	bool						Set_Value		(sLong Index, const CSG_Bytes &Value);
+	bool						Set_Value		(sLong Index, const SG_Char   *Value);
+	bool						Set_Value		(sLong Index, int              Value);
+	bool						Set_Value		(sLong Index, sLong            Value);
+	bool						Set_Value		(sLong Index, double           Value);
+
+	CSG_Bytes					asBinary		(sLong Index)						const;
+	const SG_Char *				asString		(sLong Index, int Decimals = -99)	const;
+	int							asInt			(sLong Index)						const;
+	sLong						asLong			(sLong Index)						const;
+	double						asDouble		(sLong Index)						const;
+
+	//-----------------------------------------------------
+	/// Direct access to the typed value array, returns NULL if the column's value type differs.
+	const int *					Get_Ints		(void)	const	{	return( m_Type == SG_TABLE_VALUE_TYPE_Int    ? (const int    *)m_Values.Get_Array() : NULL );	}
+	const sLong *				Get_Longs		(void)	const	{	return( m_Type == SG_TABLE_VALUE_TYPE_Long   ? (const sLong  *)m_Values.Get_Array() : NULL );	}
+	const double *				Get_Doubles		(void)	const	{	return( m_Type == SG_TABLE_VALUE_TYPE_Double
+																		||  m_Type == SG_TABLE_VALUE_TYPE_Date   ? (const double *)m_Values.Get_Array() : NULL );	}
+
+
+private:
+
+	TSG_Data_Type				m_Data_Type;
+
+	TSG_Table_Value_Type		m_Type;
+
+	sLong						m_nValues, m_Garbage;
+
+	CSG_Array					m_Values, m_Strings;
+
+
+	void						_Destroy_Value	(sLong Index);
+
+	bool						_Set_String		(sLong Index, const SG_Char *Value);
+	const SG_Char *				_Get_String		(sLong Index)	const;
+	bool						_Compact		(void);
+
+};
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+* CSG_Table_Value_Column provides the CSG_Table_Value interface
+* for a single cell of a CSG_Table_Column, so that conversions
+* between value types follow the same rules for both storages.
+*/
+//---------------------------------------------------------
+class CSG_Table_Value_Column : public CSG_Table_Value
+{
+public:
+	CSG_Table_Value_Column(CSG_Table_Column *pColumn, sLong Index)	{	m_pColumn	= pColumn;	m_Index	= Index;	}
+	virtual ~CSG_Table_Value_Column(void) {}
+
+	virtual TSG_Table_Value_Type	Get_Type		(void)				const	{	return( _Get_Column()->Get_Type() );	}
+
+	//-----------------------------------------------------
+	virtual bool					Set_Value		(const CSG_Bytes &Value)	{	return( _Get_Column()->Set_Value(_Get_Index(), Value) );	}
+	virtual bool					Set_Value		(const SG_Char   *Value)	{	return( _Get_Column()->Set_Value(_Get_Index(), Value) );	}
+	virtual bool					Set_Value		(int              Value)	{	return( _Get_Column()->Set_Value(_Get_Index(), Value) );	}
+	virtual bool					Set_Value		(sLong            Value)	{	return( _Get_Column()->Set_Value(_Get_Index(), Value) );	}
+	virtual bool					Set_Value		(double           Value)	{	return( _Get_Column()->Set_Value(_Get_Index(), Value) );	}
+
+	//-----------------------------------------------------
+	virtual CSG_Bytes				asBinary		(void)				const	{	return( _Get_Column()->asBinary(_Get_Index()          ) );	}
+	virtual const SG_Char *			asString		(int Decimals =-99)	const	{	return( _Get_Column()->asString(_Get_Index(), Decimals) );	}
+	virtual int						asInt			(void)				const	{	return( _Get_Column()->asInt   (_Get_Index()          ) );	}
+	virtual sLong					asLong			(void)				const	{	return( _Get_Column()->asLong  (_Get_Index()          ) );	}
+	virtual double					asDouble		(void)				const	{	return( _Get_Column()->asDouble(_Get_Index()          ) );	}
+
+	//-----------------------------------------------------
+	virtual bool					is_Equal		(const CSG_Table_Value &Value)	const
+	{
+		switch( Get_Type() )
+		{
+		default:
+		case SG_TABLE_VALUE_TYPE_Binary:
+		case SG_TABLE_VALUE_TYPE_String:	return( !SG_STR_CMP(asString(), Value.asString()) );
+		case SG_TABLE_VALUE_TYPE_Int   :	return( asInt   () == Value.asInt   () );
+		case SG_TABLE_VALUE_TYPE_Long  :	return( asLong  () == Value.asLong  () );
+		case SG_TABLE_VALUE_TYPE_Date  :
+		case SG_TABLE_VALUE_TYPE_Double:	return( asDouble() == Value.asDouble() );
+		}
+	}
+
+	//-----------------------------------------------------
+	virtual CSG_Table_Value &		operator = (const CSG_Table_Value &Value)
+	{
+		switch( Get_Type() )
+		{
+		default:
+		case SG_TABLE_VALUE_TYPE_Binary:	Set_Value(Value.asBinary());	break;
+		case SG_TABLE_VALUE_TYPE_String:	Set_Value(Value.asString());	break;
+		case SG_TABLE_VALUE_TYPE_Int   :	Set_Value(Value.asInt   ());	break;
+		case SG_TABLE_VALUE_TYPE_Long  :	Set_Value(Value.asLong  ());	break;
+		case SG_TABLE_VALUE_TYPE_Double:	Set_Value(Value.asDouble());	break;
+
+		case SG_TABLE_VALUE_TYPE_Date  :
+			if( Value.Get_Type() == SG_TABLE_VALUE_TYPE_Binary || Value.Get_Type() == SG_TABLE_VALUE_TYPE_String )
+			{
+				Set_Value(Value.asString());
+			}
+			else
+			{
+				Set_Value(Value.asDouble());
+			}
+			break;
+		}
+
+		return( *this );
+	}
+
+	CSG_Table_Value_Column &		operator = (const CSG_Table_Value_Column &Value)	{	CSG_Table_Value_Column::operator = ((const CSG_Table_Value &)Value);	return( *this );	}
+
+
+protected:
+
+	virtual CSG_Table_Column *		_Get_Column		(void)				const	{	return( m_pColumn );	}
+	virtual sLong					_Get_Index		(void)				const	{	return( m_Index   );	}
+
+
+private:
+
+	sLong							m_Index;
+
+	CSG_Table_Column				*m_pColumn;
+
+};
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
@@ -133,6 +133,7 @@ bool	Config_Create	(wxConfigBase *pConfig)
 	Config_Write(pConfig,  "DATA", "GRID_CACHE_MODE"     , SG_Grid_Cache_Get_Mode        ());
 	Config_Write(pConfig,  "DATA", "GRID_CACHE_THRESHLOD", SG_Grid_Cache_Get_Threshold_MB());
 	Config_Write(pConfig,  "DATA", "GRID_COORD_PRECISION", CSG_Grid_System::Get_Precision());
+	Config_Write(pConfig,  "DATA", "GRID_FILE_TILE_SIZE" , SG_Grid_Get_File_Tile_Size    ());	// tiles of compressed grid files, zero for no tiles
 	Config_Write(pConfig,  "DATA", "HISTORY_DEPTH"       , SG_Get_History_Depth());
 	Config_Write(pConfig,  "DATA", "HISTORY_LISTS"       , SG_Get_History_Ignore_Lists() != 0);
 
@@ -187,6 +188,7 @@ bool	Config_Load		(wxConfigBase *pConfig)
 	if( Config_Read(pConfig,  "DATA", "GRID_CACHE_THRESHLOD", dValue) )	{	SG_Grid_Cache_Set_Threshold_MB(dValue);	}
 
 	if( Config_Read(pConfig,  "DATA", "GRID_COORD_PRECISION", iValue) )	{	CSG_Grid_System::Set_Precision(iValue);	}
+	if( Config_Read(pConfig,  "DATA", "GRID_FILE_TILE_SIZE" , iValue) )	{	SG_Grid_Set_File_Tile_Size    (iValue);	}
 
 	if( Config_Read(pConfig,  "DATA", "HISTORY_DEPTH"       , iValue) )	{	SG_Set_History_Depth       (iValue     );	}
 	if( Config_Read(pConfig,  "DATA", "HISTORY_LISTS"       , iValue) )	{	SG_Set_History_Ignore_Lists(iValue != 0);	}
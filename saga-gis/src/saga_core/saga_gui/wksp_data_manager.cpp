@@ -260,6 +260,12 @@ CWKSP_Data_Manager::CWKSP_Data_Manager(void)
 		), 2
 	);
 
+	m_Parameters.Add_Int("GRID_FMT_DEFAULT",
+		"GRID_FILE_TILE_SIZE"	, _TL("Compressed Grid Tiles"),
+		_TL("If greater than zero, compressed grid files (*.sg-grd-z) store their data in tiles of this size together with overviews, which allows fast loading of sub-windows and reduced resolutions. Tiled files cannot be read by older SAGA versions. Set to zero to store untiled files."),
+		0, 0, true, 4096, true
+	);
+
 	m_Parameters.Add_Int("NODE_GRID",
 		"GRID_COORD_PRECISION"	, _TL("Coordinate Precision"),
 		_TL("Precision used to store coordinates and cell sizes (i.e. number of decimals)."),
@@ -355,6 +361,8 @@ CWKSP_Data_Manager::CWKSP_Data_Manager(void)
 
 	CSG_Grid_System::Set_Precision   (m_Parameters("GRID_COORD_PRECISION")->asInt   ());
 
+	SG_Grid_Set_File_Tile_Size       (m_Parameters("GRID_FILE_TILE_SIZE" )->asInt   ());
+
 	SG_Set_History_Depth             (m_Parameters("HISTORY_DEPTH"       )->asInt   ());
 	SG_Set_History_Ignore_Lists      (m_Parameters("HISTORY_LISTS"       )->asInt   ());
 
@@ -754,6 +762,8 @@ void CWKSP_Data_Manager::Parameters_Changed(void)
 
 	CSG_Grid_System::Set_Precision   (m_Parameters("GRID_COORD_PRECISION")->asInt   ());
 
+	SG_Grid_Set_File_Tile_Size       (m_Parameters("GRID_FILE_TILE_SIZE" )->asInt   ());
+
 	SG_Set_History_Depth             (m_Parameters("HISTORY_DEPTH"       )->asInt   ());
 	SG_Set_History_Ignore_Lists      (m_Parameters("HISTORY_LISTS"       )->asInt   ());
 
@@ -336,39 +336,43 @@ void CWKSP_Map_DC::Draw_Polygon(CSG_Shape_Polygon *pPolygon)
 	}
 
 	//-----------------------------------------------------
-	else if( pPolygon->Get_Part_Count() == 1 && pPolygon->Get_Point_Count(0) > 2 )
-	{
-		wxPoint	*Points	= new wxPoint[pPolygon->Get_Point_Count()];
-
-		for(int iPoint=0; iPoint<pPolygon->Get_Point_Count(0); iPoint++)
-		{
-			Points[iPoint].x = (int)xWorld2DC(pPolygon->Get_Point(iPoint, 0).x);
-			Points[iPoint].y = (int)yWorld2DC(pPolygon->Get_Point(iPoint, 0).y);
-		}
-
-		dc.DrawPolygon(pPolygon->Get_Point_Count(), Points);
+	// vertices falling into the same pixel as their predecessor
+	// are skipped, so the number of points passed to the device
+	// context is limited by the polygon's size on screen
 
-		delete[](Points);
-	}
-
-	//-----------------------------------------------------
-	else if( pPolygon->Get_Part_Count() > 1 )
+	else
 	{
 		wxPoint  *Points = new wxPoint[pPolygon->Get_Point_Count()];
-		int     *nPoints = new int    [pPolygon->Get_Part_Count ()];
+		int     *nPoints = new int    [pPolygon->Get_Part_Count ()], nParts = 0;
 
 		for(int iPart=0, jPoint=0; iPart<pPolygon->Get_Part_Count(); iPart++)
 		{
-			nPoints[iPart]	= pPolygon->Get_Point_Count(iPart);
+			int	n	= 0;
+
+			for(int iPoint=0; iPoint<pPolygon->Get_Point_Count(iPart); iPoint++)
+			{
+				wxPoint	p((int)xWorld2DC(pPolygon->Get_Point(iPoint, iPart).x), (int)yWorld2DC(pPolygon->Get_Point(iPoint, iPart).y));
+
+				if( n == 0 || p != Points[jPoint + n - 1] )
+				{
+					Points[jPoint + n++]	= p;
+				}
+			}
 
-			for(int iPoint=0; iPoint<pPolygon->Get_Point_Count(iPart); iPoint++, jPoint++)
+			if( n > 2 )
 			{
-				Points[jPoint].x = (int)xWorld2DC(pPolygon->Get_Point(iPoint, iPart).x);
-				Points[jPoint].y = (int)yWorld2DC(pPolygon->Get_Point(iPoint, iPart).y);
+				nPoints[nParts++]	= n;	jPoint	+= n;
 			}
 		}
 
-		dc.DrawPolyPolygon(pPolygon->Get_Part_Count(), nPoints, Points, 0, 0, wxODDEVEN_RULE);
+		if( nParts == 1 )
+		{
+			dc.DrawPolygon(nPoints[0], Points);
+		}
+		else if( nParts > 1 )
+		{
+			dc.DrawPolyPolygon(nParts, nPoints, Points, 0, 0, wxODDEVEN_RULE);
+		}
 
 		delete[]( Points);
 		delete[](nPoints);
@@ -76,6 +76,12 @@
 CWKSP_PointCloud::CWKSP_PointCloud(CSG_PointCloud *pPointCloud)
 	: CWKSP_Layer(pPointCloud)
 {
+	m_LOD_nPoints	= 0;
+	m_LOD_nLevels	= 0;
+
+	m_Image_NX		= 0;
+	m_Image_NY		= 0;
+
 	m_pTable	= new CWKSP_Table(pPointCloud);
 
 	m_Edit_Attributes.Destroy();
@@ -267,6 +273,8 @@ bool CWKSP_PointCloud::On_Command(int Cmd_ID)
 		{
 			Get_PointCloud()->Del_Selection();
 
+			_LOD_Destroy();	// points removed
+
 			Update_Views();
 		}
 		break;
@@ -372,6 +380,12 @@ void CWKSP_PointCloud::On_Create_Parameters(void)
 		), 3
 	);
 
+	m_Parameters.Add_Int("NODE_DISPLAY",
+		"DISPLAY_TIME_LIMIT"	, _TL("Drawing Time Limit"),
+		_TL("Large point clouds are drawn from coarse to fine detail. Drawing stops refining after the given time [milliseconds]. Ignored if set to zero."),
+		1000, 0, true
+	);
+
 	//-----------------------------------------------------
 	m_Parameters.Add_Node("NODE_COLORS", "NODE_RGB", _TL("RGB"), _TL(""));
 
@@ -419,6 +433,8 @@ void CWKSP_PointCloud::On_DataObject_Changed(void)
 	m_Parameters.Set_Parameter("MAX_SAMPLES", 100. * m_pObject->Get_Max_Samples() / (double)Get_PointCloud()->Get_Count());
 
 	//-----------------------------------------------------
+	_LOD_Destroy();
+
 	CWKSP_Layer::On_DataObject_Changed();
 
 	m_pTable->DataObject_Changed();
@@ -947,6 +963,146 @@ bool CWKSP_PointCloud::Edit_Set_Attributes(void)
 }
 
 
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// The level of detail index is a quadtree of sample sets.
+// Level L divides the point cloud's extent into 2^L x 2^L
+// cells and holds one point per cell, namely the first one
+// that has not been taken by a coarser level. The finest
+// level takes all remaining points. Points are stored level
+// by level and cell by cell (counting sort), so that a cell's
+// points are found with the offset table. Because a cell can
+// only be occupied if all its ancestors are, a point's level
+// is found with a binary search along its cell path.
+//---------------------------------------------------------
+#define LOD_MIN_POINTS		262144
+#define LOD_MAX_LEVELS		12
+#define LOD_LEAF_SIZE		16
+
+//---------------------------------------------------------
+void CWKSP_PointCloud::_LOD_Destroy(void)
+{
+	m_LOD_nPoints	= 0;
+	m_LOD_nLevels	= 0;
+
+	m_LOD_Index .Destroy();
+	m_LOD_Offset.Destroy();
+}
+
+//---------------------------------------------------------
+bool CWKSP_PointCloud::_LOD_Update(void)
+{
+	CSG_PointCloud	*pPoints	= Get_PointCloud();
+
+	if( pPoints->Get_Count() < LOD_MIN_POINTS )
+	{
+		_LOD_Destroy();
+
+		return( false );
+	}
+
+	if( m_LOD_nPoints == pPoints->Get_Count() && m_LOD_Extent == pPoints->Get_Extent() && m_LOD_Offset.Get_Size() > 0 )
+	{
+		return( true );	// up-to-date
+	}
+
+	_LOD_Destroy();
+
+	//-----------------------------------------------------
+	int	n	= pPoints->Get_Count(), nLevels = 1;
+
+	while( nLevels < LOD_MAX_LEVELS && ((sLong)LOD_LEAF_SIZE << (2 * (nLevels - 1))) < n )
+	{
+		nLevels++;
+	}
+
+	int	Depth	= nLevels - 1, nCells = 1 << Depth, nKeys = 0;
+
+	for(int Level=0; Level<nLevels; Level++)
+	{
+		nKeys	+= 1 << (2 * Level);
+	}
+
+	CSG_Rect	Extent(pPoints->Get_Extent());
+
+	double	dx	= nCells / (Extent.Get_XRange() > 0. ? Extent.Get_XRange() : 1.);
+	double	dy	= nCells / (Extent.Get_YRange() > 0. ? Extent.Get_YRange() : 1.);
+
+	//-----------------------------------------------------
+	CSG_Array	Taken(sizeof(BYTE), nKeys - (nCells * nCells)), Keys(sizeof(int), n);
+
+	BYTE	*bTaken	= (BYTE *)Taken.Get_Array();
+	int		*Key	= (int  *)Keys .Get_Array();
+
+	if( !bTaken || !Key || !m_LOD_Index.Create(n) || !m_LOD_Offset.Create(nKeys + 1) )
+	{
+		_LOD_Destroy();
+
+		return( false );
+	}
+
+	memset(bTaken, 0, Taken.Get_Size());
+
+	int	*Offset	= m_LOD_Offset.Get_Array();	memset(Offset, 0, (nKeys + 1) * sizeof(int));
+
+	for(int i=0; i<n && SG_UI_Process_Set_Progress(i, n); i++)
+	{
+		int	x	= (int)((pPoints->Get_X(i) - Extent.Get_XMin()) * dx); if( x < 0 ) x = 0; else if( x >= nCells ) x = nCells - 1;
+		int	y	= (int)((pPoints->Get_Y(i) - Extent.Get_YMin()) * dy); if( y < 0 ) y = 0; else if( y >= nCells ) y = nCells - 1;
+
+		int	a	= 0, b = Depth;	// first level with a free cell
+
+		while( a < b )
+		{
+			int	Level	= (a + b) / 2, Shift = Depth - Level;
+
+			if( bTaken[((1 << (2 * Level)) - 1) / 3 + (y >> Shift) * (1 << Level) + (x >> Shift)] )
+			{
+				a	= Level + 1;
+			}
+			else
+			{
+				b	= Level;
+			}
+		}
+
+		Key[i]	= ((1 << (2 * a)) - 1) / 3 + (y >> (Depth - a)) * (1 << a) + (x >> (Depth - a));
+
+		if( a < Depth )
+		{
+			bTaken[Key[i]]	= 1;
+		}
+
+		Offset[Key[i] + 1]++;
+	}
+
+	SG_UI_Process_Set_Ready();
+
+	//-----------------------------------------------------
+	for(int i=0; i<nKeys; i++)
+	{
+		Offset[i + 1]	+= Offset[i];
+	}
+
+	CSG_Array_Int	_Next(m_LOD_Offset);	int	*Next = _Next.Get_Array(), *Index = m_LOD_Index.Get_Array();
+
+	for(int i=0; i<n; i++)
+	{
+		Index[Next[Key[i]]++]	= i;
+	}
+
+	//-----------------------------------------------------
+	m_LOD_nPoints	= n;
+	m_LOD_nLevels	= nLevels;
+	m_LOD_Extent	= Extent;
+
+	return( true );
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 ///////////////////////////////////////////////////////////
@@ -981,35 +1137,40 @@ inline void CWKSP_PointCloud::_Draw_Point(CWKSP_Map_DC &dc_Map, int x, int y, do
 	{
 		dc_Map.IMG_Set_Pixel(x, y, Color);
 	}
-	else if( m_Z.is_InGrid(x, y) )
+	else if( x >= 0 && x < m_Image_NX && y >= 0 && y < m_Image_NY )
 	{
+		sLong	i	= (sLong)y * m_Image_NX + x;
+
+		double	*Z	= (double *)m_Z.Get_Array();
+		int		*N	= m_N.Get_Array();
+
 		switch( m_Aggregation )
 		{
 		case 0:	// first value
-			if( m_N.asInt(x, y) == 0 )
+			if( N[i] == 0 )
 			{
 				dc_Map.IMG_Set_Pixel(x, y, Color);
 			}
 			break;
 
 		case 2:	// lowest z
-			if( m_N.asInt(x, y) == 0 || z < m_Z.asDouble(x, y) )
+			if( N[i] == 0 || z < Z[i] )
 			{
 				dc_Map.IMG_Set_Pixel(x, y, Color);
-				m_Z.Set_Value(x, y, z);
+				Z[i]	= z;
 			}
 			break;
 
 		case 3:	// highest z
-			if( m_N.asInt(x, y) == 0 || z > m_Z.asDouble(x, y) )
+			if( N[i] == 0 || z > Z[i] )
 			{
 				dc_Map.IMG_Set_Pixel(x, y, Color);
-				m_Z.Set_Value(x, y, z);
+				Z[i]	= z;
 			}
 			break;
 		}
 
-		m_N.Add_Value(x, y, 1);
+		N[i]++;
 	}
 }
 
@@ -1033,6 +1194,49 @@ void CWKSP_PointCloud::_Draw_Point(CWKSP_Map_DC &dc_Map, int x, int y, double z,
 	}
 }
 
+//---------------------------------------------------------
+void CWKSP_PointCloud::_Draw_Point(CWKSP_Map_DC &dc_Map, int iPoint, int Selection)
+{
+	CSG_PointCloud	*pPoints	= Get_PointCloud();
+
+	pPoints->Set_Cursor(iPoint);
+
+	if( !pPoints->is_NoData(m_fValue) )
+	{
+		TSG_Point_Z	Point	= pPoints->Get_Point();
+
+		if( dc_Map.m_rWorld.Contains(Point.x, Point.y) )
+		{
+			int		x	= (int)dc_Map.xWorld2DC(Point.x);
+			int		y	= (int)dc_Map.yWorld2DC(Point.y);
+
+			if( Selection >= 0 && pPoints->is_Selected(iPoint) )
+			{
+				int	Size	= Selection == iPoint ? 2 + m_PointSize : m_PointSize;
+
+				_Draw_Point(dc_Map, x, y, Point.z, SG_COLOR_YELLOW, Size    );
+				_Draw_Point(dc_Map, x, y, Point.z, SG_COLOR_RED   , Size + 2);
+			}
+			else
+			{
+				int		Color;
+
+				m_pClassify->Get_Class_Color_byValue(pPoints->Get_Value(m_fValue), Color);
+
+				_Draw_Point(dc_Map, x, y, Point.z, Color, m_PointSize);
+			}
+		}
+	}
+}
+
+//---------------------------------------------------------
+// With a level of detail index the points are drawn level
+// by level from coarse to fine, restricted to the cells
+// intersecting the map extent. Refinement stops when the
+// drawing time limit has been reached and, unless the lowest
+// or highest z is requested, when the cells become smaller
+// than a pixel. The time is checked while cells
+// are drawn, so a single level cannot exceed the limit much.
 //---------------------------------------------------------
 void CWKSP_PointCloud::_Draw_Points(CWKSP_Map_DC &dc_Map)
 {
@@ -1040,8 +1244,16 @@ void CWKSP_PointCloud::_Draw_Points(CWKSP_Map_DC &dc_Map)
 
 	if( m_Aggregation != 1 )
 	{
-		m_Z.Create(SG_DATATYPE_Double, dc_Map.m_rDC.GetWidth(), dc_Map.m_rDC.GetHeight());
-		m_N.Create(SG_DATATYPE_Int   , dc_Map.m_rDC.GetWidth(), dc_Map.m_rDC.GetHeight());
+		m_Image_NX	= dc_Map.m_rDC.GetWidth ();
+		m_Image_NY	= dc_Map.m_rDC.GetHeight();
+
+		m_Z.Create(sizeof(double), (size_t)m_Image_NX * m_Image_NY);
+		m_N.Create(                (size_t)m_Image_NX * m_Image_NY);
+
+		if( m_N.Get_Size() > 0 )
+		{
+			memset(m_N.Get_Array(), 0, m_N.Get_Size() * sizeof(int));
+		}
 	}
 
 	//-----------------------------------------------------
@@ -1049,36 +1261,66 @@ void CWKSP_PointCloud::_Draw_Points(CWKSP_Map_DC &dc_Map)
 
 	int	Selection	= pPoints->Get_Selection_Count() > 0 ? (int)pPoints->Get_Selection_Index(m_Edit_Index) : -1;
 
-	for(int i=0; i<pPoints->Get_Count(); i++)
+	if( !_LOD_Update() )
 	{
-		pPoints->Set_Cursor(i);
-
-		if( !pPoints->is_NoData(m_fValue) )
+		for(int i=0; i<pPoints->Get_Count(); i++)
 		{
-			TSG_Point_Z	Point	= pPoints->Get_Point();
+			_Draw_Point(dc_Map, i, Selection);
+		}
 
-			if( dc_Map.m_rWorld.Contains(Point.x, Point.y) )
-			{
-				int		x	= (int)dc_Map.xWorld2DC(Point.x);
-				int		y	= (int)dc_Map.yWorld2DC(Point.y);
+		return;
+	}
 
-				if( Selection >= 0 && pPoints->is_Selected(i) )
-				{
-					int	Size	= Selection == i ? 2 + m_PointSize : m_PointSize;
+	//-----------------------------------------------------
+	wxDateTime	Start	= wxDateTime::UNow();
 
-					_Draw_Point(dc_Map, x, y, Point.z, SG_COLOR_YELLOW, Size    );
-					_Draw_Point(dc_Map, x, y, Point.z, SG_COLOR_RED   , Size + 2);
-				}
-				else
-				{
-					int		Color;
+	int	Time_Limit	= m_Parameters("DISPLAY_TIME_LIMIT")->asInt();
+
+	const int	*Index	= m_LOD_Index.Get_Array(), *Offset = m_LOD_Offset.Get_Array();
 
-					m_pClassify->Get_Class_Color_byValue(pPoints->Get_Value(m_fValue), Color);
+	bool	bStop	= false;
 
-					_Draw_Point(dc_Map, x, y, Point.z, Color, m_PointSize);
+	for(int Level=0, First=0; !bStop && Level<m_LOD_nLevels; First+=1<<(2*Level), Level++)
+	{
+		int		nCells	= 1 << Level;
+
+		double	dx	= m_LOD_Extent.Get_XRange() / nCells;
+		double	dy	= m_LOD_Extent.Get_YRange() / nCells;
+
+		int		ax	= (int)floor((dc_Map.m_rWorld.Get_XMin() - m_LOD_Extent.Get_XMin()) / dx); if( ax < 0 ) ax = 0;
+		int		bx	= (int)floor((dc_Map.m_rWorld.Get_XMax() - m_LOD_Extent.Get_XMin()) / dx); if( bx >= nCells ) bx = nCells - 1;
+		int		ay	= (int)floor((dc_Map.m_rWorld.Get_YMin() - m_LOD_Extent.Get_YMin()) / dy); if( ay < 0 ) ay = 0;
+		int		by	= (int)floor((dc_Map.m_rWorld.Get_YMax() - m_LOD_Extent.Get_YMin()) / dy); if( by >= nCells ) by = nCells - 1;
+
+		for(int y=ay; !bStop && y<=by; y++)
+		{
+			for(int x=ax, iCell=First + y * nCells + ax; !bStop && x<=bx; x++, iCell++)
+			{
+				for(int i=Offset[iCell]; i<Offset[iCell + 1]; i++)
+				{
+					if( Selection < 0 || !pPoints->is_Selected(Index[i]) )
+					{
+						_Draw_Point(dc_Map, Index[i], -1);
+					}
+				}
+
+				if( Time_Limit > 0 && (iCell % 256) == 0 && (wxDateTime::UNow() - Start).GetMilliseconds() > Time_Limit )
+				{
+					bStop	= true;
 				}
 			}
 		}
+
+		if( m_Aggregation < 2 && dx <= dc_Map.m_DC2World && dy <= dc_Map.m_DC2World )
+		{
+			bStop	= true;	// one sample per pixel is enough, but not for the lowest or highest z
+		}
+	}
+
+	//-----------------------------------------------------
+	for(sLong i=0; Selection>=0 && i<pPoints->Get_Selection_Count(); i++)
+	{
+		_Draw_Point(dc_Map, (int)pPoints->Get_Selection_Index(i), Selection);
 	}
 }
 
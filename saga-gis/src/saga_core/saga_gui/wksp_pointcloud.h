@@ -131,11 +131,13 @@ protected:
 
 private:
 
-	int							m_fValue, m_PointSize, m_Aggregation;
+	int							m_fValue, m_PointSize, m_Aggregation, m_Image_NX, m_Image_NY;
 
 	wxColour					m_Color_Pen;
 
-	CSG_Grid					m_Z, m_N;
+	CSG_Array					m_Z;
+
+	CSG_Array_Int				m_N;
 
 	class CWKSP_Table			*m_pTable;
 
@@ -144,11 +146,26 @@ private:
 
 	void						_Draw_Point				(CWKSP_Map_DC &dc_Map, int x, int y, double z, int Color);
 	void						_Draw_Point				(CWKSP_Map_DC &dc_Map, int x, int y, double z, int Color, int Radius);
+	void						_Draw_Point				(CWKSP_Map_DC &dc_Map, int iPoint, int Selection);
 	void						_Draw_Points			(CWKSP_Map_DC &dc_Map);
 	void						_Draw_Thumbnail			(CWKSP_Map_DC &dc_Map);
 
 	void						_AttributeList_Set		(CSG_Parameter *pFields, bool bAddNoField);
 
+
+	//-----------------------------------------------------
+	// Level of detail...
+
+	int							m_LOD_nPoints, m_LOD_nLevels;
+
+	CSG_Rect					m_LOD_Extent;
+
+	CSG_Array_Int				m_LOD_Index, m_LOD_Offset;
+
+
+	void						_LOD_Destroy			(void);
+	bool						_LOD_Update				(void);
+
 };
 
 
@@ -95,6 +95,9 @@ CWKSP_Shapes::CWKSP_Shapes(CSG_Shapes *pShapes)
 	m_Sel_Color		= *wxRED;
 
 	m_bVertices		= 0;
+
+	m_Index_bVisible	= false;
+	m_Index_nShapes		= 0;
 }
 
 //---------------------------------------------------------
@@ -535,6 +538,8 @@ void CWKSP_Shapes::On_DataObject_Changed(void)
 
 	_Chart_Set_Options();
 
+	_Index_Destroy();
+
 	//-----------------------------------------------------
 	CWKSP_Layer::On_DataObject_Changed();
 
@@ -1140,6 +1145,89 @@ wxString CWKSP_Shapes::Get_Name_Attribute(void)
 }
 
 
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// The spatial index is a packed R-tree over the shapes'
+// extents (CSG_Shapes_RTree). It is built on demand with the
+// first drawing after the geometries have changed and lets
+// pan and zoom visit only those shapes whose extent comes
+// into view. Layers with only a few shapes are simply drawn
+// as a whole.
+//---------------------------------------------------------
+#define INDEX_MIN_SHAPES	1024
+
+//---------------------------------------------------------
+void CWKSP_Shapes::_Index_Destroy(void)
+{
+	m_Index_nShapes	= 0;
+
+	m_Index        .Destroy();
+	m_Index_Visible.Destroy();
+}
+
+//---------------------------------------------------------
+bool CWKSP_Shapes::_Index_Update(void)
+{
+	CSG_Shapes	*pShapes	= Get_Shapes();
+
+	if( pShapes->Get_Count() < INDEX_MIN_SHAPES )
+	{
+		_Index_Destroy();
+
+		return( false );
+	}
+
+	if( m_Index_nShapes == pShapes->Get_Count() && m_Index_Extent == pShapes->Get_Extent() && m_Index.is_Valid() )
+	{
+		return( true );	// up-to-date
+	}
+
+	_Index_Destroy();
+
+	if( !m_Index.Create(pShapes) || !m_Index.is_Valid() )
+	{
+		_Index_Destroy();
+
+		return( false );
+	}
+
+	m_Index_nShapes	= pShapes->Get_Count();
+	m_Index_Extent	= pShapes->Get_Extent();
+
+	return( true );
+}
+
+//---------------------------------------------------------
+// Collects the shapes whose extents intersect with the given
+// world rectangle, in their original order to preserve the
+// drawing sequence.
+//---------------------------------------------------------
+void CWKSP_Shapes::_Index_Set_Visible(const CSG_Rect &rWorld)
+{
+	m_Index_Visible.Destroy();
+
+	if( (m_Index_bVisible = _Index_Update()) == true )
+	{
+		m_Index.Get_Shapes(rWorld, m_Index_Visible);
+	}
+}
+
+//---------------------------------------------------------
+int CWKSP_Shapes::_Index_Get_Count(void)
+{
+	return( m_Index_bVisible ? (int)m_Index_Visible.Get_Size() : Get_Shapes()->Get_Count() );
+}
+
+//---------------------------------------------------------
+CSG_Shape * CWKSP_Shapes::_Index_Get_Shape(int i)
+{
+	return( Get_Shapes()->Get_Shape(m_Index_bVisible ? m_Index_Visible[i] : i) );
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 ///////////////////////////////////////////////////////////
@@ -1158,14 +1246,17 @@ void CWKSP_Shapes::On_Draw(CWKSP_Map_DC &dc_Map, int Flags)
 		return;
 	}
 
+	//-----------------------------------------------------
+	_Index_Set_Visible(dc_Map.m_rWorld);
+
 	//-----------------------------------------------------
 	if( (Flags & LAYER_DRAW_FLAG_THUMBNAIL) != 0 )
 	{
 		Draw_Initialize(dc_Map, Flags);
 
-		for(int iShape=0; iShape<Get_Shapes()->Get_Count(); iShape++)
+		for(int iShape=0; iShape<_Index_Get_Count(); iShape++)
 		{
-			_Draw_Shape(dc_Map, Get_Shapes()->Get_Shape(iShape));
+			_Draw_Shape(dc_Map, _Index_Get_Shape(iShape));
 		}
 
 		return;
@@ -1186,26 +1277,26 @@ void CWKSP_Shapes::On_Draw(CWKSP_Map_DC &dc_Map, int Flags)
 	//-----------------------------------------------------
 	if( (Flags & LAYER_DRAW_FLAG_NOEDITS) != 0 || !(m_Edit_pShape || Get_Shapes()->Get_Selection_Count()) )
 	{
-		for(int iShape=0; iShape<Get_Shapes()->Get_Count(); iShape++)
+		for(int iShape=0; iShape<_Index_Get_Count(); iShape++)
 		{
-			_Draw_Shape(dc, Get_Shapes()->Get_Shape(iShape));
+			_Draw_Shape(dc, _Index_Get_Shape(iShape));
 		}
 
 		if( _Chart_is_Valid() )
 		{
-			for(int iShape=0; iShape<Get_Shapes()->Get_Count(); iShape++)
+			for(int iShape=0; iShape<_Index_Get_Count(); iShape++)
 			{
-				_Draw_Chart(dc, Get_Shapes()->Get_Shape(iShape));
+				_Draw_Chart(dc, _Index_Get_Shape(iShape));
 			}
 		}
 	}
 	else	// selection and/or editing
 	{
-		for(int iShape=0; iShape<Get_Shapes()->Get_Count(); iShape++)
+		for(int iShape=0; iShape<_Index_Get_Count(); iShape++)
 		{
-			if( !Get_Shapes()->Get_Shape(iShape)->is_Selected() )
+			if( !_Index_Get_Shape(iShape)->is_Selected() )
 			{
-				_Draw_Shape(dc, Get_Shapes()->Get_Shape(iShape));
+				_Draw_Shape(dc, _Index_Get_Shape(iShape));
 			}
 		}
 
@@ -1262,13 +1353,13 @@ void CWKSP_Shapes::On_Draw(CWKSP_Map_DC &dc_Map, int Flags)
 
 		if( iSize >= 0 && iSize < Get_Shapes()->Get_Field_Count() )	// size by attribute
 		{
-			for(int iShape=0; iShape<Get_Shapes()->Get_Count(); iShape++)
+			for(int iShape=0; iShape<_Index_Get_Count(); iShape++)
 			{
-				int	Size	= (int)(0.5 + dSize * Get_Shapes()->Get_Shape(iShape)->asDouble(iSize));
+				int	Size	= (int)(0.5 + dSize * _Index_Get_Shape(iShape)->asDouble(iSize));
 
 				if( Size > 0 )
 				{
-					_Draw_Label(dc, Get_Shapes()->Get_Shape(iShape), Size);
+					_Draw_Label(dc, _Index_Get_Shape(iShape), Size);
 				}
 			}
 		}
@@ -1278,9 +1369,9 @@ void CWKSP_Shapes::On_Draw(CWKSP_Map_DC &dc_Map, int Flags)
 
 			if( Size > 0 )
 			{
-				for(int iShape=0; iShape<Get_Shapes()->Get_Count(); iShape++)
+				for(int iShape=0; iShape<_Index_Get_Count(); iShape++)
 				{
-					_Draw_Label(dc, Get_Shapes()->Get_Shape(iShape), Size);
+					_Draw_Label(dc, _Index_Get_Shape(iShape), Size);
 				}
 			}
 		}
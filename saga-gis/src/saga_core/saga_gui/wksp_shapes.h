@@ -190,6 +190,27 @@ private:
 	void						_Draw_Label				(CWKSP_Map_DC &dc_Map, CSG_Shape *pShape, int PointSize = 0);
 
 
+	//-----------------------------------------------------
+	// Spatial index...
+
+	bool						m_Index_bVisible;
+
+	int							m_Index_nShapes;
+
+	CSG_Rect					m_Index_Extent;
+
+	CSG_Shapes_RTree			m_Index;
+
+	CSG_Array_Int				m_Index_Visible;
+
+
+	void						_Index_Destroy			(void);
+	bool						_Index_Update			(void);
+	void						_Index_Set_Visible		(const CSG_Rect &rWorld);
+	int							_Index_Get_Count		(void);
+	CSG_Shape *					_Index_Get_Shape		(int i);
+
+
 	//-----------------------------------------------------
 	// Charts...
 
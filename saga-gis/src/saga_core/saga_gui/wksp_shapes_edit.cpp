@@ -537,6 +537,8 @@ bool CWKSP_Shapes::_Edit_Merge(void)
 	Get_Shapes()->Del_Selection();
 	Get_Shapes()->Select(pMerged, false);
 
+	_Index_Destroy();	// geometries changed
+
 	Update_Views(true);
 
 	return( true );
@@ -650,6 +652,8 @@ bool CWKSP_Shapes::_Edit_Split(void)
 						}
 
 						m_Edit_Shapes.Del_Shapes();
+
+						_Index_Destroy();	// geometries changed
 					}
 				}
 
@@ -828,6 +832,8 @@ bool CWKSP_Shapes::_Edit_Shape_Stop(bool bSave)
 			{
 				pShape->Assign(m_Edit_pShape, false);
 			}
+
+			_Index_Destroy();	// geometries changed
 		}
 
 		m_Edit_Shapes.Del_Shapes();
@@ -896,6 +902,8 @@ bool CWKSP_Shapes::_Edit_Shape_Del(void)
 				Get_Shapes()->Del_Selection();
 			}
 
+			_Index_Destroy();	// geometries changed
+
 			Edit_Set_Index(0);
 
 			Update_Views();
@@ -423,9 +423,12 @@ void CWKSP_Shapes_Line::_Draw_Shape(CWKSP_Map_DC &dc_Map, CSG_Shape *pShape, int
 
 			for(int iPoint=1; iPoint<pShape->Get_Point_Count(iPart); iPoint++)
 			{
-				TSG_Point_Int B = A; A = dc_Map.World2DC(pShape->Get_Point(iPoint, iPart)); A.x += xOffset; A.y += yOffset;
+				TSG_Point_Int B = dc_Map.World2DC(pShape->Get_Point(iPoint, iPart)); B.x += xOffset; B.y += yOffset;
 
-				dc_Map.dc.DrawLine(A.x, A.y, B.x, B.y);
+				if( B.x != A.x || B.y != A.y )	// skip sub-pixel segments
+				{
+					dc_Map.dc.DrawLine(A.x, A.y, B.x, B.y); A = B;
+				}
 			}
 		}
 	}
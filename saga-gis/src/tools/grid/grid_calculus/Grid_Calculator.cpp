@@ -319,9 +319,47 @@ TSG_Data_Type CGrid_Calculator_Base::Get_Result_Type(void)
 }
 
 //---------------------------------------------------------
-inline bool CGrid_Calculator_Base::Get_Result(const CSG_Vector &Values, double &Result)
+double ** CGrid_Calculator_Base::Get_Columns(CSG_Array &Values, int nValues)
 {
-	return( _finite(Result = m_Formula.Get_Value(Values)) != 0 );
+	double	**Columns	= (double **)SG_Malloc(m_nValues * sizeof(double *));
+
+	double	*pValues	= (double *)Values.Get_Array((size_t)m_nValues * nValues);
+
+	memset(pValues, 0, (size_t)m_nValues * nValues * sizeof(double));
+
+	for(int i=0; i<m_nValues; i++)
+	{
+		Columns[i]	= pValues + (size_t)i * nValues;
+	}
+
+	return( Columns );
+}
+
+//---------------------------------------------------------
+// Evaluates the formula for a complete row of values, which
+// is split into blocks that are processed in parallel.
+//---------------------------------------------------------
+bool CGrid_Calculator_Base::Get_Results(double **Columns, double *Results, BYTE *NoData, int nValues)
+{
+	const int	nBlock	= 1024;
+
+	#pragma omp parallel for
+	for(int i=0; i<nValues; i+=nBlock)
+	{
+		const double	*Block[32];
+
+		for(int j=0; j<m_nValues; j++)
+		{
+			Block[j]	= Columns[j] + i;
+		}
+
+		if( !m_Formula.Get_Values(Block, m_nValues, Results + i, M_GET_MIN(nBlock, nValues - i), NoData + i) )
+		{
+			memset(NoData + i, 1, M_GET_MIN(nBlock, nValues - i));
+		}
+	}
+
+	return( true );
 }
 
 
@@ -414,24 +452,39 @@ bool CGrid_Calculator::On_Execute(void)
 	m_NoData_Value	= pResult->Get_NoData_Value();
 
 	//-----------------------------------------------------
+	CSG_Array	Values(sizeof(double)), Results(sizeof(double), Get_NX()), NoData(sizeof(BYTE), Get_NX());
+
+	double	**Columns	= Get_Columns(Values, Get_NX());
+
+	double	*pResults	= (double *)Results.Get_Array();
+	BYTE	*pNoData	= (BYTE   *)NoData .Get_Array();
+
 	for(int y=0; y<Get_NY() && Set_Progress(y); y++)
 	{
 		#pragma omp parallel for
 		for(int x=0; x<Get_NX(); x++)
 		{
-			double	Result;	CSG_Vector	Values(m_nValues);
+			pNoData[x]	= Get_Values(x, y, Columns) ? 0 : 1;
+		}
+
+		Get_Results(Columns, pResults, pNoData, Get_NX());
 
-			if( Get_Values(x, y, Values) && Get_Result(Values, Result) )
+		#pragma omp parallel for
+		for(int x=0; x<Get_NX(); x++)
+		{
+			if( pNoData[x] )
 			{
-				pResult->Set_Value(x, y, Result);
+				pResult->Set_NoData(x, y);
 			}
 			else
 			{
-				pResult->Set_NoData(x, y);
+				pResult->Set_Value(x, y, pResults[x]);
 			}
 		}
 	}
 
+	SG_Free(Columns);
+
 	//-----------------------------------------------------
 	return( true );
 }
@@ -442,7 +495,7 @@ bool CGrid_Calculator::On_Execute(void)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-bool CGrid_Calculator::Get_Values(int x, int y, CSG_Vector &Values)
+bool CGrid_Calculator::Get_Values(int x, int y, double **Values)
 {
 	TSG_Point	p	= Get_System().Get_Grid_to_World(x, y);
 
@@ -450,7 +503,7 @@ bool CGrid_Calculator::Get_Values(int x, int y, CSG_Vector &Values)
 	{
 		for(int i=0, j=m_pGrids->Get_Grid_Count(); i<m_pXGrids->Get_Grid_Count(); i++, j++)
 		{
-			if( !m_pXGrids->Get_Grid(i)->Get_Value(p, Values[j], m_Resampling, m_bUseNoData) )
+			if( !m_pXGrids->Get_Grid(i)->Get_Value(p, Values[j][x], m_Resampling, m_bUseNoData) )
 			{
 				return( false );
 			}
@@ -464,17 +517,17 @@ bool CGrid_Calculator::Get_Values(int x, int y, CSG_Vector &Values)
 			return( false );
 		}
 
-		Values[i]	= m_pGrids->Get_Grid(i)->asDouble(x, y);
+		Values[i][x]	= m_pGrids->Get_Grid(i)->asDouble(x, y);
 	}
 
 	int	n	= m_pGrids->Get_Grid_Count() + m_pXGrids->Get_Grid_Count();
 
-	if( m_bPosition[0] ) Values[n++] =      x  ;	// col()
-	if( m_bPosition[1] ) Values[n++] =      y  ;	// row()
-	if( m_bPosition[2] ) Values[n++] =    p.x  ;	// xpos()
-	if( m_bPosition[3] ) Values[n++] =    p.y  ;	// ypos()
-	if( m_bPosition[4] ) Values[n++] = Get_NX();	// ncols()
-	if( m_bPosition[5] ) Values[n++] = Get_NY();	// nrows()
+	if( m_bPosition[0] ) Values[n++][x] =      x  ;	// col()
+	if( m_bPosition[1] ) Values[n++][x] =      y  ;	// row()
+	if( m_bPosition[2] ) Values[n++][x] =    p.x  ;	// xpos()
+	if( m_bPosition[3] ) Values[n++][x] =    p.y  ;	// ypos()
+	if( m_bPosition[4] ) Values[n++][x] = Get_NX();	// ncols()
+	if( m_bPosition[5] ) Values[n++][x] = Get_NY();	// nrows()
 
 	return( true );
 }
@@ -586,27 +639,42 @@ bool CGrids_Calculator::On_Execute(void)
 	m_NoData_Value	= pResult->Get_NoData_Value();
 
 	//-----------------------------------------------------
+	CSG_Array	Values(sizeof(double)), Results(sizeof(double), Get_NX()), NoData(sizeof(BYTE), Get_NX());
+
+	double	**Columns	= Get_Columns(Values, Get_NX());
+
+	double	*pResults	= (double *)Results.Get_Array();
+	BYTE	*pNoData	= (BYTE   *)NoData .Get_Array();
+
 	for(int y=0; y<Get_NY() && Set_Progress(y); y++)
 	{
-		#pragma omp parallel for
-		for(int x=0; x<Get_NX(); x++)
+		for(int z=0; z<pResult->Get_NZ(); z++)
 		{
-			double	Result;	CSG_Vector	Values(m_nValues);
+			#pragma omp parallel for
+			for(int x=0; x<Get_NX(); x++)
+			{
+				pNoData[x]	= Get_Values(x, y, z, Columns) ? 0 : 1;
+			}
+
+			Get_Results(Columns, pResults, pNoData, Get_NX());
 
-			for(int z=0; z<pResult->Get_NZ(); z++)
+			#pragma omp parallel for
+			for(int x=0; x<Get_NX(); x++)
 			{
-				if( Get_Values(x, y, z, Values) && Get_Result(Values, Result) )
+				if( pNoData[x] )
 				{
-					pResult->Set_Value(x, y, z, Result);
+					pResult->Set_NoData(x, y, z);
 				}
 				else
 				{
-					pResult->Set_NoData(x, y, z);
+					pResult->Set_Value(x, y, z, pResults[x]);
 				}
 			}
 		}
 	}
 
+	SG_Free(Columns);
+
 	//-----------------------------------------------------
 	return( true );
 }
@@ -617,7 +685,7 @@ bool CGrids_Calculator::On_Execute(void)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-bool CGrids_Calculator::Get_Values(int x, int y, int z, CSG_Vector &Values)
+bool CGrids_Calculator::Get_Values(int x, int y, int z, double **Values)
 {
 	TSG_Point	p	= Get_System().Get_Grid_to_World(x, y);
 
@@ -629,7 +697,7 @@ bool CGrids_Calculator::Get_Values(int x, int y, int z, CSG_Vector &Values)
 
 		for(int i=0, j=m_pGrids->Get_Item_Count(); i<m_pXGrids->Get_Item_Count(); i++, j++)
 		{
-			if( !m_pXGrids->Get_Grids(i)->Get_Value(p.x, p.y, pz, Values[j], m_Resampling) )
+			if( !m_pXGrids->Get_Grids(i)->Get_Value(p.x, p.y, pz, Values[j][x], m_Resampling) )
 			{
 				return( false );
 			}
@@ -643,17 +711,17 @@ bool CGrids_Calculator::Get_Values(int x, int y, int z, CSG_Vector &Values)
 			return( false );
 		}
 
-		Values[i]	= m_pGrids->Get_Grids(i)->asDouble(x, y, z);
+		Values[i][x]	= m_pGrids->Get_Grids(i)->asDouble(x, y, z);
 	}
 
 	int	n	= m_pGrids->Get_Item_Count() + m_pXGrids->Get_Item_Count();
 
-	if( m_bPosition[0] ) Values[n++] =      x  ;	// col()
-	if( m_bPosition[1] ) Values[n++] =      y  ;	// row()
-	if( m_bPosition[2] ) Values[n++] =    p.x  ;	// xpos()
-	if( m_bPosition[3] ) Values[n++] =    p.y  ;	// ypos()
-	if( m_bPosition[4] ) Values[n++] = Get_NX();	// ncols()
-	if( m_bPosition[5] ) Values[n++] = Get_NY();	// nrows()
+	if( m_bPosition[0] ) Values[n++][x] =      x  ;	// col()
+	if( m_bPosition[1] ) Values[n++][x] =      y  ;	// row()
+	if( m_bPosition[2] ) Values[n++][x] =    p.x  ;	// xpos()
+	if( m_bPosition[3] ) Values[n++][x] =    p.y  ;	// ypos()
+	if( m_bPosition[4] ) Values[n++][x] = Get_NX();	// ncols()
+	if( m_bPosition[5] ) Values[n++][x] = Get_NY();	// nrows()
 
 	return( true );
 }
@@ -95,7 +95,9 @@ protected:
 
 	TSG_Data_Type				Get_Result_Type			(void);
 
-	bool						Get_Result				(const CSG_Vector &Values, double &Result);
+	double **					Get_Columns				(CSG_Array &Values, int nValues);
+
+	bool						Get_Results				(double **Columns, double *Results, BYTE *NoData, int nValues);
 
 	static double				Get_NoData_Value		(void)	{	return( m_NoData_Value );	}
 
@@ -126,7 +128,7 @@ private:
 	CSG_Parameter_Grid_List		*m_pGrids, *m_pXGrids;
 
 
-	bool						Get_Values				(int x, int y, CSG_Vector &Values);
+	bool						Get_Values				(int x, int y, double **Values);
 
 };
 
@@ -154,7 +156,7 @@ private:
 	CSG_Parameter_Grids_List	*m_pGrids, *m_pXGrids;
 
 
-	bool						Get_Values				(int x, int y, int z, CSG_Vector &Values);
+	bool						Get_Values				(int x, int y, int z, double **Values);
 
 };
 
@@ -138,34 +138,38 @@ bool CFilter_Gauss::On_Execute(void)
 	}
 
 	//-----------------------------------------------------
-	for(int y=0; y<Get_NY() && Set_Progress(y); y++)
+	// the grid is processed in tiles, which hold their cells
+	// plus a halo of kernel size, so that the kernel loops
+	// run on plain arrays and tiles can be filtered in parallel
+
+	CSG_Grid_Focal_Tiles	Tiles(pInput, Kernel.Get_Size());
+
+	CSG_Vector	Weights;	bool	bSeparable	= Kernel.Get_Separable(Weights);	// square kernel, two one-dimensional passes
+
+	#pragma omp parallel
 	{
-		#pragma omp parallel for
-		for(int x=0; x<Get_NX(); x++)
-		{
-			CSG_Simple_Statistics	s;
+		CSG_Grid_Focal_Tile	Tile;	CSG_Vector	Sum, Wgt;
 
-			if( !pInput->is_NoData(x, y) )
+		#pragma omp for schedule(dynamic)
+		for(int iTile=0; iTile<Tiles.Get_Count(); iTile++)
+		{
+			if( SG_OMP_Get_Thread_Num() == 0 )
 			{
-				for(int i=0; i<Kernel.Get_Count(); i++)
-				{
-					int	ix	= Kernel.Get_X(i, x);
-					int	iy	= Kernel.Get_Y(i, y);
+				Set_Progress(iTile * SG_OMP_Get_Max_Num_Threads(), Tiles.Get_Count());
+			}
 
-					if( pInput->is_InGrid(ix, iy) )
-					{
-						s.Add_Value(pInput->asDouble(ix, iy), Kernel.Get_Weight(i));
-					}
-				}
+			if( !Process_Get_Okay() || !Tiles.Get_Tile(iTile, Tile) )
+			{
+				continue;
 			}
 
-			if( s.Get_Weights() > 0.0 )
+			if( bSeparable )
 			{
-				pResult->Set_Value(x, y, s.Get_Mean());
+				_Filter_Separable(Tile, Weights, Sum, Wgt, pResult);
 			}
 			else
 			{
-				pResult->Set_NoData(x, y);
+				_Filter_Kernel(Tile, Kernel, pResult);
 			}
 		}
 	}
@@ -180,6 +184,115 @@ bool CFilter_Gauss::On_Execute(void)
 }
 
 
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+void CFilter_Gauss::_Filter_Separable(const CSG_Grid_Focal_Tile &Tile, const CSG_Vector &Weights, CSG_Vector &Sum, CSG_Vector &Wgt, CSG_Grid *pResult)
+{
+	int	Size	= Tile.Get_Halo(), NX = Tile.Get_NX(), nRows = Tile.Get_NY() + 2 * Size;
+
+	Sum.Create((size_t)NX * nRows);
+	Wgt.Create((size_t)NX * nRows);
+
+	const double	*w	= Weights.Get_Data() + Size;
+
+	//-----------------------------------------------------
+	// horizontal pass over the tile's columns, including the halo rows
+
+	for(int iy=0, y=Tile.Get_yMin()-Size; iy<nRows; iy++, y++)
+	{
+		const double	*Row	= Tile.Get_Row(y);
+
+		double	*s	= Sum.Get_Data() + (sLong)iy * NX;
+		double	*n	= Wgt.Get_Data() + (sLong)iy * NX;
+
+		for(int ix=0, x=Tile.Get_xMin(); ix<NX; ix++, x++)
+		{
+			s[ix]	= n[ix]	= 0.;
+
+			for(int i=-Size; i<=Size; i++)
+			{
+				if( !CSG_Grid_Focal_Tile::is_NoData(Row[x + i]) )
+				{
+					s[ix]	+= w[i] * Row[x + i];
+					n[ix]	+= w[i];
+				}
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	// vertical pass
+
+	for(int iy=Size, y=Tile.Get_yMin(); y<=Tile.Get_yMax(); iy++, y++)
+	{
+		const double	*Row	= Tile.Get_Row(y);
+
+		for(int ix=0, x=Tile.Get_xMin(); ix<NX; ix++, x++)
+		{
+			double	s	= 0., n	= 0.;
+
+			if( !CSG_Grid_Focal_Tile::is_NoData(Row[x]) )
+			{
+				for(int i=-Size; i<=Size; i++)
+				{
+					s	+= w[i] * Sum.Get_Data()[(sLong)(iy + i) * NX + ix];
+					n	+= w[i] * Wgt.Get_Data()[(sLong)(iy + i) * NX + ix];
+				}
+			}
+
+			if( n > 0. )
+			{
+				pResult->Set_Value(x, y, s / n);
+			}
+			else
+			{
+				pResult->Set_NoData(x, y);
+			}
+		}
+	}
+}
+
+//---------------------------------------------------------
+void CFilter_Gauss::_Filter_Kernel(const CSG_Grid_Focal_Tile &Tile, const CSG_Grid_Cell_Addressor &Kernel, CSG_Grid *pResult)
+{
+	const int *kx = Kernel.Get_X(), *ky = Kernel.Get_Y();	const double *kw = Kernel.Get_Weight();
+
+	for(int y=Tile.Get_yMin(); y<=Tile.Get_yMax(); y++)
+	{
+		for(int x=Tile.Get_xMin(); x<=Tile.Get_xMax(); x++)
+		{
+			double	s	= 0., w	= 0.;
+
+			if( !CSG_Grid_Focal_Tile::is_NoData(Tile.Get_Value(x, y)) )
+			{
+				for(int i=0; i<Kernel.Get_Count(); i++)
+				{
+					double	z	= Tile.Get_Value(x + kx[i], y + ky[i]);
+
+					if( !CSG_Grid_Focal_Tile::is_NoData(z) )
+					{
+						s	+= kw[i] * z;
+						w	+= kw[i];
+					}
+				}
+			}
+
+			if( w > 0. )
+			{
+				pResult->Set_Value(x, y, s / w);
+			}
+			else
+			{
+				pResult->Set_NoData(x, y);
+			}
+		}
+	}
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
@@ -79,6 +79,12 @@ protected:
 
 	virtual bool			On_Execute			(void);
 
+
+private:
+
+	void					_Filter_Separable	(const CSG_Grid_Focal_Tile &Tile, const CSG_Vector &Weights, CSG_Vector &Sum, CSG_Vector &Wgt, CSG_Grid *pResult);
+	void					_Filter_Kernel		(const CSG_Grid_Focal_Tile &Tile, const CSG_Grid_Cell_Addressor &Kernel, CSG_Grid *pResult);
+
 };
 
 
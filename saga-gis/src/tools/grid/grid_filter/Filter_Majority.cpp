@@ -135,7 +135,7 @@ bool CFilter_Majority::On_Execute(void)
 
 	if( m_Type == 1 )
 	{
-		d	= 1.0 - m_Threshold;
+		d	= 1.0 - d;
 	}
 
 	m_Threshold	= (int)(0.5 + d * m_Kernel.Get_Count());
@@ -161,22 +161,34 @@ bool CFilter_Majority::On_Execute(void)
 	}
 
 	//-----------------------------------------------------
-	for(int y=0; y<Get_NY() && Set_Progress(y); y++)
+	// tiles are processed in parallel, along each row a value
+	// histogram slides with the kernel, so that only the cells
+	// entering and leaving the kernel need to be updated
+
+	CSG_Array_Int	Out, In;	m_Kernel.Get_Sliding(Out, In);
+
+	CSG_Grid_Focal_Tiles	Tiles(m_pInput, m_Kernel.Get_Size());
+
+	#pragma omp parallel
 	{
-		#pragma omp parallel for
-		for(int x=0; x<Get_NX(); x++)
+		CSG_Grid_Focal_Tile	Tile;	CSG_Grid_Focal_Histogram	Histogram;
+
+		#pragma omp for schedule(dynamic)
+		for(int iTile=0; iTile<Tiles.Get_Count(); iTile++)
 		{
-			if( m_pInput->is_InGrid(x, y) )
+			if( SG_OMP_Get_Thread_Num() == 0 )
 			{
-				pResult->Set_Value(x, y, Get_Majority(x, y));
+				Set_Progress(iTile * SG_OMP_Get_Max_Num_Threads(), Tiles.Get_Count());
 			}
-			else
+
+			if( Process_Get_Okay() && Tiles.Get_Tile(iTile, Tile, true) )
 			{
-				pResult->Set_NoData(x, y);
+				Set_Tile(Tile, Out, In, Histogram, pResult);
 			}
 		}
 	}
 
+
 	//-------------------------------------------------
 	if( pResult == &Result )
 	{
@@ -201,36 +213,68 @@ bool CFilter_Majority::On_Execute(void)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-double CFilter_Majority::Get_Majority(int x, int y)
+void CFilter_Majority::Set_Tile(const CSG_Grid_Focal_Tile &Tile, const CSG_Array_Int &Out, const CSG_Array_Int &In, CSG_Grid_Focal_Histogram &Histogram, CSG_Grid *pResult)
 {
-	CSG_Unique_Number_Statistics	s;
+	Histogram.Create(Tile.Get_Rank_Count());
 
-	for(int i=0; i<m_Kernel.Get_Count(); i++)
-	{
-		int	ix	= m_Kernel.Get_X(i, x);
-		int	iy	= m_Kernel.Get_Y(i, y);
+	const int *kx = m_Kernel.Get_X(), *ky = m_Kernel.Get_Y(), *kOut = Out.Get_Array(), *kIn = In.Get_Array();
 
-		if( m_pInput->is_InGrid(ix, iy) )
+	#define GET_RANK(i, x, y)	Tile.Get_Rank_Row(y + ky[i])[x + kx[i]]
+
+	for(int y=Tile.Get_yMin(); y<=Tile.Get_yMax(); y++)
+	{
+		for(int x=Tile.Get_xMin(); x<=Tile.Get_xMax(); x++)
 		{
-			s.Add_Value(m_pInput->asDouble(ix, iy));
-		}
-	}
+			if( x == Tile.Get_xMin() )
+			{
+				for(int i=0; i<m_Kernel.Get_Count(); i++)	{	Histogram.Add(GET_RANK(i, x, y));	}
+			}
+			else
+			{
+				for(int i=0; i<(int)Out.Get_Size(); i++)	{	Histogram.Del(GET_RANK(kOut[i], x - 1, y));	}
+				for(int i=0; i<(int)In .Get_Size(); i++)	{	Histogram.Add(GET_RANK(kIn [i], x    , y));	}
+			}
 
-	int		Count;
-	double	Value;
+			double	Value	= Tile.Get_Value(x, y);
 
-	if( m_Type == 0 )
-	{
-		s.Get_Majority(Value, Count);
+			if( CSG_Grid_Focal_Tile::is_NoData(Value) )
+			{
+				pResult->Set_NoData(x, y);
 
-		return( Count > m_Threshold ? Value : m_pInput->asDouble(x, y) );
-	}
-	else
-	{
-		s.Get_Minority(Value, Count);
+				continue;
+			}
 
-		return( Count < m_Threshold ? Value : m_pInput->asDouble(x, y) );
+			//---------------------------------------------
+			// as with CSG_Unique_Number_Statistics, ties go to
+			// the value found first in kernel order
+
+			int	Count	= m_Type == 0 ? Histogram.Get_Count_Max() : Histogram.Get_Count_Min();
+
+			if( Count > 0 )
+			{
+				for(int i=0; i<m_Kernel.Get_Count(); i++)
+				{
+					int	Rank	= GET_RANK(i, x, y);
+
+					if( Rank >= 0 && Histogram.Get_Count(Rank) == Count )
+					{
+						if( m_Type == 0 ? Count > m_Threshold : Count < m_Threshold )
+						{
+							Value	= Tile.Get_Rank_Value(Rank);
+						}
+
+						break;
+					}
+				}
+			}
+
+			pResult->Set_Value(x, y, Value);
+		}
+
+		for(int i=0; i<m_Kernel.Get_Count(); i++)	{	Histogram.Del(GET_RANK(i, Tile.Get_xMax(), y));	}
 	}
+
+	#undef GET_RANK
 }
 
 
@@ -101,7 +101,7 @@ private:
 	CSG_Grid				*m_pInput;
 
 
-	double					Get_Majority		(int x, int y);
+	void					Set_Tile			(const CSG_Grid_Focal_Tile &Tile, const CSG_Array_Int &Out, const CSG_Array_Int &In, CSG_Grid_Focal_Histogram &Histogram, CSG_Grid *pResult);
 
 };
 
@@ -46,6 +46,8 @@
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
+#include <limits>
+
 #include "Filter_Morphology.h"
 
 
@@ -197,54 +199,172 @@ bool CFilter_Morphology::Get_Extreme(bool bMinimum, CSG_Grid *pInput, CSG_Grid *
 		pResult->Create(Get_System());
 	}
 
-	for(int y=0; y<Get_NY() && Set_Progress(y); y++)
+	//-----------------------------------------------------
+	// minimum and maximum of a square kernel are found in two
+	// one-dimensional running passes at constant costs per
+	// cell, other kernels slide a rank histogram along the rows
+
+	bool	bSquare	= m_Kernel.is_Square();
+
+	CSG_Array_Int	Out, In;
+
+	if( !bSquare )
+	{
+		m_Kernel.Get_Sliding(Out, In);
+	}
+
+	CSG_Grid_Focal_Tiles	Tiles(pInput, m_Kernel.Get_Size());
+
+	#pragma omp parallel
 	{
-		#pragma omp parallel for
-		for(int x=0; x<Get_NX(); x++)
+		CSG_Grid_Focal_Tile	Tile;	CSG_Grid_Focal_Histogram	Histogram;	CSG_Vector	Rows, Buffer;
+
+		#pragma omp for schedule(dynamic)
+		for(int iTile=0; iTile<Tiles.Get_Count(); iTile++)
 		{
-			double	Value;
+			if( SG_OMP_Get_Thread_Num() == 0 )
+			{
+				Set_Progress(iTile * SG_OMP_Get_Max_Num_Threads(), Tiles.Get_Count());
+			}
+
+			if( !Process_Get_Okay() || !Tiles.Get_Tile(iTile, Tile, !bSquare) )
+			{
+				continue;
+			}
 
-			if( Get_Extreme(bMinimum, pInput, x, y, Value) )
+			if( bSquare )
 			{
-				pResult->Set_Value(x, y, Value);
+				_Get_Extreme_Square (bMinimum, Tile, Rows, Buffer, pResult);
 			}
 			else
 			{
-				pResult->Set_NoData(x, y);
+				_Get_Extreme_Sliding(bMinimum, Tile, Out, In, Histogram, pResult);
 			}
 		}
 	}
 
-	return( true );
+	return( Process_Get_Okay() );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// van Herk/Gil-Werman: r[j] is the extreme of a[j] to a[j +
+// 2 * Size], computed from running extremes within blocks of
+// the window's length, which are stored in g and h.
+
+inline double	Get_Extreme_of	(bool bMinimum, double a, double b)	{	return( bMinimum ? (a < b ? a : b) : (a > b ? a : b) );	}
+
+static void	Get_Extreme_Run	(bool bMinimum, const double *a, int n, int Size, double *g, double *h, double *r)
+{
+	int	w	= 2 * Size + 1;
+
+	for(int i=0; i<n; i++)
+	{
+		g[i]	= i % w == 0 ? a[i] : Get_Extreme_of(bMinimum, g[i - 1], a[i]);
+	}
+
+	for(int i=n-1; i>=0; i--)
+	{
+		h[i]	= i == n - 1 || (i + 1) % w == 0 ? a[i] : Get_Extreme_of(bMinimum, h[i + 1], a[i]);
+	}
+
+	for(int j=0; j<=n-w; j++)
+	{
+		r[j]	= Get_Extreme_of(bMinimum, h[j], g[j + w - 1]);
+	}
 }
 
 //---------------------------------------------------------
-bool CFilter_Morphology::Get_Extreme(bool bMinimum, CSG_Grid *pInput, int x, int y, double &Value)
+void CFilter_Morphology::_Get_Extreme_Square(bool bMinimum, const CSG_Grid_Focal_Tile &Tile, CSG_Vector &Rows, CSG_Vector &Buffer, CSG_Grid *pResult)
 {
-	if( pInput->is_InGrid(x, y) )
+	int	Size	= Tile.Get_Halo(), NX = Tile.Get_NX(), NY = Tile.Get_NY(), nRows = NY + 2 * Size, n = M_GET_MAX(NX, NY) + 2 * Size;
+
+	Rows  .Create((size_t)NX * nRows);
+	Buffer.Create((size_t)n * 4);
+
+	double	*a = Buffer.Get_Data(), *g = a + n, *h = g + n, *r = h + n;
+
+	// no-data never wins, an infinite extreme means no data at all
+	const double	NoData	= bMinimum ? std::numeric_limits<double>::infinity() : -std::numeric_limits<double>::infinity();
+
+	//-----------------------------------------------------
+	for(int iy=0, y=Tile.Get_yMin()-Size; iy<nRows; iy++, y++)
 	{
-		CSG_Simple_Statistics	s;
+		const double	*Row	= Tile.Get_Row(y) + Tile.Get_xMin() - Size;
 
-		for(int i=0; i<m_Kernel.Get_Count(); i++)
+		for(int i=0; i<NX+2*Size; i++)
 		{
-			int	ix	= m_Kernel.Get_X(i, x);
-			int	iy	= m_Kernel.Get_Y(i, y);
+			a[i]	= CSG_Grid_Focal_Tile::is_NoData(Row[i]) ? NoData : Row[i];
+		}
 
-			if( pInput->is_InGrid(ix, iy) )
+		Get_Extreme_Run(bMinimum, a, NX + 2 * Size, Size, g, h, Rows.Get_Data() + (sLong)iy * NX);
+	}
+
+	//-----------------------------------------------------
+	for(int ix=0, x=Tile.Get_xMin(); ix<NX; ix++, x++)
+	{
+		for(int iy=0; iy<nRows; iy++)
+		{
+			a[iy]	= Rows.Get_Data()[(sLong)iy * NX + ix];
+		}
+
+		Get_Extreme_Run(bMinimum, a, nRows, Size, g, h, r);
+
+		for(int iy=0, y=Tile.Get_yMin(); iy<NY; iy++, y++)
+		{
+			if( CSG_Grid_Focal_Tile::is_NoData(Tile.Get_Value(x, y)) || r[iy] == NoData )
 			{
-				s	+= pInput->asDouble(ix, iy);
+				pResult->Set_NoData(x, y);
+			}
+			else
+			{
+				pResult->Set_Value(x, y, r[iy]);
 			}
 		}
+	}
+}
+
+//---------------------------------------------------------
+void CFilter_Morphology::_Get_Extreme_Sliding(bool bMinimum, const CSG_Grid_Focal_Tile &Tile, const CSG_Array_Int &Out, const CSG_Array_Int &In, CSG_Grid_Focal_Histogram &Histogram, CSG_Grid *pResult)
+{
+	Histogram.Create(Tile.Get_Rank_Count());
+
+	const int *kx = m_Kernel.Get_X(), *ky = m_Kernel.Get_Y(), *kOut = Out.Get_Array(), *kIn = In.Get_Array();
 
-		if( s.Get_Count() > 0 )
+	#define GET_RANK(i, x, y)	Tile.Get_Rank_Row(y + ky[i])[x + kx[i]]
+
+	for(int y=Tile.Get_yMin(); y<=Tile.Get_yMax(); y++)
+	{
+		for(int x=Tile.Get_xMin(); x<=Tile.Get_xMax(); x++)
 		{
-			Value	= bMinimum ? s.Get_Minimum() : s.Get_Maximum();
+			if( x == Tile.Get_xMin() )
+			{
+				for(int i=0; i<m_Kernel.Get_Count(); i++)	{	Histogram.Add(GET_RANK(i, x, y));	}
+			}
+			else
+			{
+				for(int i=0; i<(int)Out.Get_Size(); i++)	{	Histogram.Del(GET_RANK(kOut[i], x - 1, y));	}
+				for(int i=0; i<(int)In .Get_Size(); i++)	{	Histogram.Add(GET_RANK(kIn [i], x    , y));	}
+			}
 
-			return( true );
+			if( CSG_Grid_Focal_Tile::is_NoData(Tile.Get_Value(x, y)) || Histogram.Get_Count() < 1 )
+			{
+				pResult->Set_NoData(x, y);
+			}
+			else
+			{
+				pResult->Set_Value(x, y, Tile.Get_Rank_Value(Histogram.Get_Rank(bMinimum ? 0 : Histogram.Get_Count() - 1)));
+			}
 		}
+
+		for(int i=0; i<m_Kernel.Get_Count(); i++)	{	Histogram.Del(GET_RANK(i, Tile.Get_xMax(), y));	}
 	}
 
-	return( false );
+	#undef GET_RANK
 }
 
 
@@ -98,7 +98,8 @@ private:
 
 
 	bool					Get_Extreme		(bool bMinimum, CSG_Grid *pInput, CSG_Grid *pResult);
-	bool					Get_Extreme		(bool bMinimum, CSG_Grid *pInput, int x, int y, double &Value);
+	void					_Get_Extreme_Square	(bool bMinimum, const CSG_Grid_Focal_Tile &Tile, CSG_Vector &Rows, CSG_Vector &Buffer, CSG_Grid *pResult);
+	void					_Get_Extreme_Sliding	(bool bMinimum, const CSG_Grid_Focal_Tile &Tile, const CSG_Array_Int &Out, const CSG_Array_Int &In, CSG_Grid_Focal_Histogram &Histogram, CSG_Grid *pResult);
 
 };
 
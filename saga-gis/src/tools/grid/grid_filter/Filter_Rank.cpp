@@ -144,20 +144,29 @@ bool CFilter_Rank::On_Execute(void)
 	}
 
 	//-----------------------------------------------------
-	for(int y=0; y<Get_NY() && Set_Progress(y); y++)
+	// tiles are processed in parallel, along each row a rank
+	// histogram slides with the kernel, so that only the cells
+	// entering and leaving the kernel need to be updated
+
+	CSG_Array_Int	Out, In;	m_Kernel.Get_Sliding(Out, In);
+
+	CSG_Grid_Focal_Tiles	Tiles(m_pInput, m_Kernel.Get_Size());
+
+	#pragma omp parallel
 	{
-		#pragma omp parallel for
-		for(int x=0; x<Get_NX(); x++)
-		{
-			double	Value;
+		CSG_Grid_Focal_Tile	Tile;	CSG_Grid_Focal_Histogram	Histogram;
 
-			if( Get_Value(x, y, Rank, Value) )
+		#pragma omp for schedule(dynamic)
+		for(int iTile=0; iTile<Tiles.Get_Count(); iTile++)
+		{
+			if( SG_OMP_Get_Thread_Num() == 0 )
 			{
-				pResult->Set_Value(x, y, Value);
+				Set_Progress(iTile * SG_OMP_Get_Max_Num_Threads(), Tiles.Get_Count());
 			}
-			else
+
+			if( Process_Get_Okay() && Tiles.Get_Tile(iTile, Tile, true) )
 			{
-				pResult->Set_NoData(x, y);
+				Set_Tile(Tile, Rank, Out, In, Histogram, pResult);
 			}
 		}
 	}
@@ -187,59 +196,65 @@ bool CFilter_Rank::On_Execute(void)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-bool CFilter_Rank::Get_Value(int x, int y, double Rank, double &Value)
+void CFilter_Rank::Set_Tile(const CSG_Grid_Focal_Tile &Tile, double Rank, const CSG_Array_Int &Out, const CSG_Array_Int &In, CSG_Grid_Focal_Histogram &Histogram, CSG_Grid *pResult)
 {
-	if( m_pInput->is_InGrid(x, y) )
-	{
-		CSG_Table	Values;
+	Histogram.Create(Tile.Get_Rank_Count());
 
-		Values.Add_Field("Z", SG_DATATYPE_Double);
+	const int *kx = m_Kernel.Get_X(), *ky = m_Kernel.Get_Y(), *kOut = Out.Get_Array(), *kIn = In.Get_Array();
 
-		for(int i=0; i<m_Kernel.Get_Count(); i++)
-		{
-			int	ix	= m_Kernel.Get_X(i, x);
-			int	iy	= m_Kernel.Get_Y(i, y);
+	#define GET_RANK(i, x, y)	Tile.Get_Rank_Row(y + ky[i])[x + kx[i]]
+	#define GET_VALUE(k)		Tile.Get_Rank_Value(Histogram.Get_Rank(k))
 
-			if( m_pInput->is_InGrid(ix, iy) )
+	for(int y=Tile.Get_yMin(); y<=Tile.Get_yMax(); y++)
+	{
+		for(int x=Tile.Get_xMin(); x<=Tile.Get_xMax(); x++)
+		{
+			if( x == Tile.Get_xMin() )
 			{
-				Values.Add_Record()->Set_Value(0, m_pInput->asDouble(ix, iy));
+				for(int i=0; i<m_Kernel.Get_Count(); i++)	{	Histogram.Add(GET_RANK(i, x, y));	}
+			}
+			else
+			{
+				for(int i=0; i<(int)Out.Get_Size(); i++)	{	Histogram.Del(GET_RANK(kOut[i], x - 1, y));	}
+				for(int i=0; i<(int)In .Get_Size(); i++)	{	Histogram.Add(GET_RANK(kIn [i], x    , y));	}
 			}
-		}
-
-		switch( Values.Get_Count() )
-		{
-		case 0:
-			return( false );
-
-		case 1:
-			Value	= Values[0].asDouble(0);
-			return( true );
 
-		case 2:
-			Value	= (Values[0].asDouble(0) + Values[1].asDouble(0)) / 2.0;
-			return( true );
+			int	n	= Histogram.Get_Count();
 
-		default:
+			if( CSG_Grid_Focal_Tile::is_NoData(Tile.Get_Value(x, y)) || n < 1 )
 			{
-				Values.Set_Index(0, TABLE_INDEX_Ascending);
-
-				Rank	= Rank * (Values.Get_Count() - 1.0);
+				pResult->Set_NoData(x, y);
+			}
+			else if( n == 1 )
+			{
+				pResult->Set_Value(x, y, GET_VALUE(0));
+			}
+			else if( n == 2 )
+			{
+				pResult->Set_Value(x, y, (GET_VALUE(0) + GET_VALUE(1)) / 2.0);
+			}
+			else
+			{
+				double	r	= Rank * (n - 1.0);
 
-				int	i	= (int)Rank;
+				int	i	= (int)r;
 
-				Value	= Values.Get_Record_byIndex(i)->asDouble(0);
+				double	Value	= GET_VALUE(i);
 
-				if( Rank - i > 0.0 && i < Values.Get_Count() - 1 )
+				if( r - i > 0.0 && i < n - 1 )
 				{
-					Value	= (Value + Values.Get_Record_byIndex(i + 1)->asDouble(0)) / 2.0;
+					Value	= (Value + GET_VALUE(i + 1)) / 2.0;
 				}
-			}
 
-			return( true );
+				pResult->Set_Value(x, y, Value);
+			}
 		}
+
+		for(int i=0; i<m_Kernel.Get_Count(); i++)	{	Histogram.Del(GET_RANK(i, Tile.Get_xMax(), y));	}
 	}
 
-	return( false );
+	#undef GET_RANK
+	#undef GET_VALUE
 }
 
 
@@ -87,7 +87,7 @@ private:
 	CSG_Grid				*m_pInput;
 
 
-	bool					Get_Value			(int x, int y, double Rank, double &Value);
+	void					Set_Tile			(const CSG_Grid_Focal_Tile &Tile, double Rank, const CSG_Array_Int &Out, const CSG_Array_Int &In, CSG_Grid_Focal_Histogram &Histogram, CSG_Grid *pResult);
 
 };
 
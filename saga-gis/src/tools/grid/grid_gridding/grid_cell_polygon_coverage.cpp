@@ -237,37 +237,26 @@ bool CGrid_Cell_Polygon_Coverage::On_Execute(void)
 //---------------------------------------------------------
 bool CGrid_Cell_Polygon_Coverage::Get_Area(CSG_Shape_Polygon *pPolygon, CSG_Grid *pArea)
 {
-	CSG_Grid_System	s(pArea->Get_System());
+	CSG_Grid_Polygon_Coverage	Coverage(pArea->Get_System(), pPolygon);
 
-	int	xMin = s.Get_xWorld_to_Grid(pPolygon->Get_Extent().Get_XMin()); if( xMin <  0          ) xMin = 0;
-	int	xMax = s.Get_xWorld_to_Grid(pPolygon->Get_Extent().Get_XMax()); if( xMax >= s.Get_NX() ) xMax = s.Get_NX() - 1;
-	int	yMin = s.Get_yWorld_to_Grid(pPolygon->Get_Extent().Get_YMin()); if( yMin <  0          ) yMin = 0;
-	int	yMax = s.Get_yWorld_to_Grid(pPolygon->Get_Extent().Get_YMax()); if( yMax >= s.Get_NY() ) yMax = s.Get_NY() - 1;
-
-	double	d	= 0.5 * s.Get_Cellsize();
+	if( !Coverage.is_Valid() )
+	{
+		return( false );
+	}
 
 	#pragma omp parallel for
-	for(int y=yMin; y<=yMax; y++)
+	for(int y=Coverage.Get_yMin(); y<=Coverage.Get_yMax(); y++)
 	{
-		CSG_Shapes Cell(SHAPE_TYPE_Polygon); CSG_Shape_Polygon *pCell = (CSG_Shape_Polygon *)Cell.Add_Shape();
+		CSG_Vector	Row(Coverage.Get_NX());
 
-		TSG_Point	p;	p.y	= s.Get_YMin() + s.Get_Cellsize() * y;
+		Coverage.Get_Row(y, Row.Get_Data());
 
-		p.x	= s.Get_XMin() + s.Get_Cellsize() * xMin;
-
-		for(int x=xMin; x<=xMax; x++, p.x+=s.Get_Cellsize())
+		for(int x=Coverage.Get_xMin(), i=0; x<=Coverage.Get_xMax(); x++, i++)
 		{
-			pCell->Add_Point(p.x - d, p.y - d);
-			pCell->Add_Point(p.x - d, p.y + d);
-			pCell->Add_Point(p.x + d, p.y + d);
-			pCell->Add_Point(p.x + d, p.y - d);
-
-			if( SG_Polygon_Intersection(pCell, pPolygon) && pCell->Get_Area() > 0.0 )
+			if( Row[i] > 0. )
 			{
-				pArea->Add_Value(x, y, pCell->Get_Area());
+				pArea->Add_Value(x, y, Row[i] * pArea->Get_Cellarea());
 			}
-
-			pCell->Del_Parts();
 		}
 	}
 
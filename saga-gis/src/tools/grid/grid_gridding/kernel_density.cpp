@@ -75,6 +75,12 @@ CKernel_Density::CKernel_Density(void)
 
 	Set_Description	(_TW(
 		"Kernel density estimation. If any point is currently in selection only selected points are taken into account. "
+		"\n\n"
+		"The 'exact' method adds the kernel of each point to the target grid cells. "
+		"The 'binned' method first distributes the points to the target grid cells (linear binning) "
+		"and then convolves the binned grid with the kernel, using a Fast Fourier Transformation "
+		"for large kernel radii. This is much faster for large numbers of points and large radii, "
+		"but approximates the point positions by the grid resolution. "
 	));
 
 	Add_Reference("Fotheringham, A.S., Brunsdon, C., Charlton, M.", "2000",
@@ -115,6 +121,15 @@ CKernel_Density::CKernel_Density(void)
 		), 0
 	);
 
+	Parameters.Add_Choice("",
+		"METHOD"	, _TL("Method"),
+		_TL(""),
+		CSG_String::Format("%s|%s",
+			_TL("exact"),
+			_TL("binned")
+		), 0
+	);
+
 	//-----------------------------------------------------
 	m_Grid_Target.Create(&Parameters, true, "", "TARGET_");
 }
@@ -188,6 +203,12 @@ bool CKernel_Density::On_Execute(void)
 	m_dRadius	= Radius / m_pGrid->Get_Cellsize();
 	m_iRadius	= 1 + (int)m_dRadius;
 
+	//-----------------------------------------------------
+	if( Parameters("METHOD")->asInt() == 1 )
+	{
+		return( Set_Binned(pPoints, Population) );
+	}
+
 	//-----------------------------------------------------
 	if( pPoints->Get_Selection_Count() > 0 )
 	{
@@ -271,6 +292,298 @@ inline double CKernel_Density::Get_Kernel(double dx, double dy)
 }
 
 
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#define FFT_MIN_RADIUS	10	// minimum kernel radius (in cells) for which binned densities are convolved with fft
+
+//---------------------------------------------------------
+bool CKernel_Density::Set_Binned(CSG_Shapes *pPoints, int Population)
+{
+	int	Margin	= m_iRadius + 1;	// bins are extended by kernel radius to catch points outside the target extent
+
+	int	nx	= m_pGrid->Get_NX() + 2 * Margin;
+	int	ny	= m_pGrid->Get_NY() + 2 * Margin;
+
+	CSG_Vector	Bins;
+
+	if( !Bins.Create((size_t)nx * ny) )
+	{
+		Error_Set(_TL("failed to allocate memory"));
+
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	Process_Set_Text(_TL("binning"));
+
+	bool	bSelection	= pPoints->Get_Selection_Count() > 0;
+
+	int		nPoints		= bSelection ? (int)pPoints->Get_Selection_Count() : pPoints->Get_Count();
+
+	double	*pBins		= Bins.Get_Data();
+
+	#pragma omp parallel for
+	for(int iPoint=0; iPoint<nPoints; iPoint++)
+	{
+		CSG_Shape	*pPoint	= bSelection ? pPoints->Get_Selection(iPoint) : pPoints->Get_Shape(iPoint);
+
+		double	w	= Population < 0 ? 1. : pPoint->asDouble(Population);
+
+		TSG_Point	p	= pPoint->Get_Point(0);
+
+		double	x	= Margin + X_WORLD_TO_GRID(p.x); int ix = (int)floor(x); x -= ix;
+		double	y	= Margin + Y_WORLD_TO_GRID(p.y); int iy = (int)floor(y); y -= iy;
+
+		if( ix >= 0 && ix < nx - 1 && iy >= 0 && iy < ny - 1 )
+		{
+			sLong	i	= (sLong)iy * nx + ix;
+
+			#pragma omp atomic
+			pBins[i         ]	+= w * (1. - x) * (1. - y);
+			#pragma omp atomic
+			pBins[i      + 1]	+= w * (     x) * (1. - y);
+			#pragma omp atomic
+			pBins[i + nx    ]	+= w * (1. - x) * (     y);
+			#pragma omp atomic
+			pBins[i + nx + 1]	+= w * (     x) * (     y);
+		}
+	}
+
+	//-----------------------------------------------------
+	Process_Set_Text(_TL("convolution"));
+
+	if( m_iRadius < FFT_MIN_RADIUS )
+	{
+		return( Set_Binned_Direct(Bins, nx) );
+	}
+
+	return( Set_Binned_FFT(Bins, nx) );
+}
+
+//---------------------------------------------------------
+bool CKernel_Density::Set_Binned_Direct(const CSG_Vector &Bins, int nx)
+{
+	int	Margin	= m_iRadius + 1;
+
+	CSG_Array_Int	Offset;	CSG_Vector	Weight;
+
+	for(int dy=-m_iRadius; dy<=m_iRadius; dy++)
+	{
+		for(int dx=-m_iRadius; dx<=m_iRadius; dx++)
+		{
+			double	w	= Get_Kernel(dx, dy);
+
+			if( w > 0. )
+			{
+				Offset.Add(dy * nx + dx); Weight.Add_Row(w);
+			}
+		}
+	}
+
+	const double	*pBins	= Bins.Get_Data();
+
+	//-----------------------------------------------------
+	for(int y=0; y<m_pGrid->Get_NY() && Set_Progress(y, m_pGrid->Get_NY()); y++)
+	{
+		#pragma omp parallel for
+		for(int x=0; x<m_pGrid->Get_NX(); x++)
+		{
+			const double	*pBin	= pBins + (sLong)(y + Margin) * nx + x + Margin;
+
+			double	z	= 0.;
+
+			for(int i=0; i<Weight.Get_N(); i++)
+			{
+				z	+= Weight[i] * pBin[Offset[i]];
+			}
+
+			m_pGrid->Set_Value(x, y, z);
+		}
+	}
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// In-place radix-2 fft, n must be a power of two.
+//---------------------------------------------------------
+static void FFT_1D(double *Re, double *Im, int n, bool bInverse)
+{
+	for(int i=1, j=0; i<n; i++)	// bit reversed order
+	{
+		int	Bit	= n >> 1;
+
+		for( ; j & Bit; Bit>>=1)
+		{
+			j	^= Bit;
+		}
+
+		j	^= Bit;
+
+		if( i < j )
+		{
+			double	d;
+
+			d	= Re[i]; Re[i] = Re[j]; Re[j] = d;
+			d	= Im[i]; Im[i] = Im[j]; Im[j] = d;
+		}
+	}
+
+	//-----------------------------------------------------
+	for(int Length=2; Length<=n; Length<<=1)
+	{
+		int		Half	= Length / 2;
+
+		double	a		= (bInverse ? 2. : -2.) * M_PI / Length;
+
+		for(int j=0; j<Half; j++)
+		{
+			double	wRe	= cos(a * j), wIm = sin(a * j);
+
+			for(int i=j; i<n; i+=Length)
+			{
+				double	tRe	= Re[i + Half] * wRe - Im[i + Half] * wIm;
+				double	tIm	= Re[i + Half] * wIm + Im[i + Half] * wRe;
+
+				Re[i + Half]	= Re[i] - tRe;
+				Im[i + Half]	= Im[i] - tIm;
+				Re[i       ]	+= tRe;
+				Im[i       ]	+= tIm;
+			}
+		}
+	}
+}
+
+//---------------------------------------------------------
+static void FFT_2D(double *Re, double *Im, int n, bool bInverse, double *tRe, double *tIm)
+{
+	for(int y=0; y<n; y++)
+	{
+		FFT_1D(Re + (sLong)y * n, Im + (sLong)y * n, n, bInverse);
+	}
+
+	for(int x=0; x<n; x++)
+	{
+		for(int y=0; y<n; y++) { tRe[y] = Re[(sLong)y * n + x]; tIm[y] = Im[(sLong)y * n + x]; }
+
+		FFT_1D(tRe, tIm, n, bInverse);
+
+		for(int y=0; y<n; y++) { Re[(sLong)y * n + x] = tRe[y]; Im[(sLong)y * n + x] = tIm[y]; }
+	}
+}
+
+//---------------------------------------------------------
+// Overlap-save convolution: each tile of the target grid is
+// loaded with the bins of its kernel radius surrounding,
+// transformed, multiplied with the kernel spectrum and
+// transformed back. Tiles are independent and processed in
+// parallel.
+//---------------------------------------------------------
+bool CKernel_Density::Set_Binned_FFT(const CSG_Vector &Bins, int nx)
+{
+	int	Margin	= m_iRadius + 1, Radius = m_iRadius, ny = m_pGrid->Get_NY() + 2 * Margin;
+
+	// the transformation size is the next power of two that
+	// takes the kernel diameter plus a minimum tile size, so
+	// that it stays below 4 * Radius + 128 (two n x n buffers
+	// per thread) and the tile gets whatever is left
+
+	int	nTile	= M_GET_MIN(64, M_GET_MAX(m_pGrid->Get_NX(), m_pGrid->Get_NY()));
+
+	int	n		= 2; while( n < nTile + 2 * Radius ) { n *= 2; }
+
+	nTile	= n - 2 * Radius;
+
+	//-----------------------------------------------------
+	// the kernel is symmetric, its spectrum is real
+
+	CSG_Vector	Kernel((size_t)n * n), Im((size_t)n * n), tRe(n), tIm(n);
+
+	for(int dy=-Radius; dy<=Radius; dy++)
+	{
+		for(int dx=-Radius; dx<=Radius; dx++)
+		{
+			Kernel[(size_t)((dy + n) % n) * n + (dx + n) % n]	= Get_Kernel(dx, dy);
+		}
+	}
+
+	FFT_2D(Kernel.Get_Data(), Im.Get_Data(), n, false, tRe.Get_Data(), tIm.Get_Data());
+
+	Kernel	*= 1. / ((double)n * n);	// normalization of the inverse transformation
+
+	double	Epsilon	= 1e-10 * Get_Kernel(0., 0.);	// suppress round-off noise
+
+	Im.Destroy();
+
+	//-----------------------------------------------------
+	int	nxTiles	= 1 + (m_pGrid->Get_NX() - 1) / nTile;
+	int	nyTiles	= 1 + (m_pGrid->Get_NY() - 1) / nTile;
+	int	nTiles	= nxTiles * nyTiles, nThreads = SG_OMP_Get_Max_Num_Threads();
+
+	const double	*pBins	= Bins.Get_Data(), *pKernel = Kernel.Get_Data();
+
+	for(int iTile=0; iTile<nTiles && Set_Progress(iTile, nTiles); iTile+=nThreads)
+	{
+		int	jTile	= M_GET_MIN(iTile + nThreads, nTiles);
+
+		#pragma omp parallel for
+		for(int i=iTile; i<jTile; i++)
+		{
+			int	x0	= (i % nxTiles) * nTile;
+			int	y0	= (i / nxTiles) * nTile;
+
+			CSG_Vector	Re((size_t)n * n), Im((size_t)n * n), tRe(n), tIm(n);
+
+			for(int y=0, by=y0+Margin-Radius; y<nTile+2*Radius; y++, by++)
+			{
+				if( by >= 0 && by < ny )
+				{
+					for(int x=0, bx=x0+Margin-Radius; x<nTile+2*Radius && bx<nx; x++, bx++)
+					{
+						Re[(size_t)y * n + x]	= pBins[(sLong)by * nx + bx];	// bx >= 1, since Margin > Radius
+					}
+				}
+			}
+
+			FFT_2D(Re.Get_Data(), Im.Get_Data(), n, false, tRe.Get_Data(), tIm.Get_Data());
+
+			double	*pRe	= Re.Get_Data(), *pIm = Im.Get_Data();
+
+			for(sLong j=0; j<(sLong)n * n; j++)
+			{
+				pRe[j]	*= pKernel[j];
+				pIm[j]	*= pKernel[j];
+			}
+
+			FFT_2D(Re.Get_Data(), Im.Get_Data(), n, true , tRe.Get_Data(), tIm.Get_Data());
+
+			//---------------------------------------------
+			for(int y=0; y<nTile && y0+y<m_pGrid->Get_NY(); y++)
+			{
+				for(int x=0; x<nTile && x0+x<m_pGrid->Get_NX(); x++)
+				{
+					double	z	= Re[(size_t)(y + Radius) * n + x + Radius];
+
+					m_pGrid->Set_Value(x0 + x, y0 + y, fabs(z) < Epsilon ? 0. : z);
+				}
+			}
+		}
+	}
+
+	return( true );
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
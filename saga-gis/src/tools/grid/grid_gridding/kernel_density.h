@@ -94,6 +94,10 @@ private:
 
 	void						Set_Kernel				(const TSG_Point &Point, double Population);
 
+	bool						Set_Binned				(CSG_Shapes *pPoints, int Population);
+	bool						Set_Binned_Direct		(const CSG_Vector &Bins, int nx);
+	bool						Set_Binned_FFT			(const CSG_Vector &Bins, int nx);
+
 	double						Get_Kernel				(double dx, double dy);
 
 };
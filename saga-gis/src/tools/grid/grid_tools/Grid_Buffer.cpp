@@ -29,6 +29,8 @@
 //---------------------------------------------------------
 #include "Grid_Buffer.h"
 
+#include "Grid_Distance_Transform.h"
+
 //---------------------------------------------------------
 enum
 {
@@ -119,9 +121,46 @@ bool CGrid_Buffer::On_Execute(void)
 	pBuffer->Assign_NoData();
 	pBuffer->Fmt_Name("%s [%s]", pFeatures->Get_Name(), _TL("Buffer"));
 
-	bool	bFixed	= Parameters("TYPE")->asInt() == 0;
+	//-----------------------------------------------------
+	if( Parameters("TYPE")->asInt() == 0 )	// a fixed distance can be derived from the distance transform
+	{
+		int	Distance	= (int)(0.5 + Parameters("DISTANCE")->asDouble() / Get_Cellsize());
+
+		CGrid_Distance_Transform	Transform;
+
+		if( !Transform.Create(pFeatures, true) )
+		{
+			return( false );
+		}
 
-	int	Distance	= (int)(0.5 + Parameters("DISTANCE")->asDouble() / Get_Cellsize());
+		#pragma omp parallel for
+		for(int y=0; y<Get_NY(); y++)
+		{
+			if( SG_OMP_Get_Thread_Num() == 0 )
+			{
+				Set_Progress(y * SG_OMP_Get_Max_Num_Threads(), Get_NY());
+			}
+
+			if( !Process_Get_Okay() )
+			{
+				continue;
+			}
+
+			CSG_Array_Int	xNearest(Get_NX()), yNearest(Get_NX());
+
+			Transform.Get_Nearest(y, xNearest.Get_Array(), yNearest.Get_Array());
+
+			for(int x=0; x<Get_NX(); x++)
+			{
+				if( xNearest[x] >= 0 && SG_Get_Distance(x, y, xNearest[x], yNearest[x]) <= Distance )
+				{
+					pBuffer->Set_Value(x, y, Transform.is_Feature(x, y) ? FEATURE : BUFFER);
+				}
+			}
+		}
+
+		return( true );
+	}
 
 	//-----------------------------------------------------
 	for(int y=0; y<Get_NY() && Set_Progress(y); y++)
@@ -130,10 +169,7 @@ bool CGrid_Buffer::On_Execute(void)
 		{
 			if( !pFeatures->is_NoData(x, y) && pFeatures->asDouble(x, y) > 0.0 )
 			{
-				if( !bFixed )
-				{
-					Distance	= (int)(0.5 + pFeatures->asDouble(x, y) / Get_Cellsize());
-				}
+				int	Distance	= (int)(0.5 + pFeatures->asDouble(x, y) / Get_Cellsize());
 
 				for(int iy=y-Distance; iy<=y+Distance; iy++)
 				{
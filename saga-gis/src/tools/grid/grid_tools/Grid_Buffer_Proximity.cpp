@@ -58,6 +58,8 @@
 
 #include "Grid_Buffer_Proximity.h"
 
+#include "Grid_Distance_Transform.h"
+
 ///////////////////////////////////////////////////////////
 //														 //
 //				Construction/Destruction				 //
@@ -73,12 +75,12 @@ CGrid_Proximity_Buffer::CGrid_Proximity_Buffer(void){
 		"valid neighbour in a source grid. Additionally, the source cells define the zones that will be used in the "
 		"euclidean allocation calculations. Cell values in the source grid are treated as IDs (integer) and "
 		"used in the allocation grid to identify the grid value of the closest source cell. If a cell is at an equal "
-		"distance to two or more sources, the cell is assigned to the source that is first encountered in the tools scanning "
-		"process. The buffer grid is a "
+		"distance to two or more sources, the cell is assigned to one of them arbitrarily. The buffer grid is a "
 		"reclassification of the distance grid using a user specified equidistance to create a set of discrete distance "
 		"buffers from source features. The buffer zones are coded with the maximum distance value of the corresponding buffer interval. " 
 		"The output value type for the distance grid is floating-point. The output values for the allocation and buffer "
-		"grid are of type integer. The duration of tool execution is dependent on the number of source cells and the buffer distance."));
+		"grid are of type integer. Distances are derived with an exact euclidean distance transform, so that the duration of tool "
+		"execution depends only on the grid size."));
 
 	Parameters.Add_Grid(NULL, 
 						"SOURCE",
@@ -142,8 +144,8 @@ CGrid_Proximity_Buffer::~CGrid_Proximity_Buffer(void)
 bool CGrid_Proximity_Buffer::On_Execute(void){
 	
 	CSG_Grid	*pSource, *pDistance, *pAlloc, *pBuffer;
-	double 		dBufDist, dDist, cellSize;
-	int 		x, y, i, j, imin, imax, jmin, jmax, iBufDist, alloc, ival;
+	double 		dBufDist, cellSize;
+	int 		ival;
 
 	pSource 	= Parameters("SOURCE")->asGrid();
 	pDistance 	= Parameters("DISTANCE")->asGrid();
@@ -159,62 +161,50 @@ bool CGrid_Proximity_Buffer::On_Execute(void){
 		return (false);
 	}
 
-	dBufDist = dBufDist / cellSize;
-	iBufDist = (int) (dBufDist + 2.0);
-	dBufDist = pow(dBufDist, 2);
-
 	pDistance->Assign_NoData();
 	pAlloc->Assign_NoData();
 	pBuffer->Assign_NoData();
 
-    for(y=0; y<Get_NY() && Set_Progress(y); y++)
-	{		
-		for(x=0; x<Get_NX(); x++)
-		{			
- 			if( !pSource->is_NoData(x, y) )
-			{
-				alloc = pSource->asInt(x, y);
-
-				pAlloc->Set_Value(x, y, alloc);
-				pDistance->Set_Value(x, y, 0.0);
-
-				imin = M_GET_MAX(0, x-iBufDist);
-				imax = M_GET_MIN(x+iBufDist, Get_NX());
-				jmin = M_GET_MAX(0, y-iBufDist);
-				jmax = M_GET_MIN(y+iBufDist, Get_NY());
-
-				for(i=imin; i<imax; i++)
-				{
-					for(j=jmin; j<jmax; j++)
-					{
-						if( pSource->is_NoData(i, j) )
-						{
-							dDist= (x-i)*(x-i)+(y-j)*(y-j);		
-						
-							if( dDist <= dBufDist && (pDistance->is_NoData(i, j) || pDistance->asDouble(i, j) > dDist) )
-							{
-								pDistance->Set_Value(i, j, dDist);
-								pAlloc->Set_Value(i, j, alloc);
-							}
-						}
-					}//for
-				}//for
-			}//if
-		}//for
-	}//for						
-
-
-	for(y=0; y<Get_NY() && Set_Progress(y); y++)
-	{		
-		for(x=0; x<Get_NX(); x++)
+	CGrid_Distance_Transform	Transform;
+
+	if( !Transform.Create(pSource) )
+	{
+		return( false );
+	}
+
+	if( Transform.Get_Feature_Count() <= 0 )	// no source cells, all results stay no-data
+	{
+		return( true );
+	}
+
+	#pragma omp parallel for
+	for(int y=0; y<Get_NY(); y++)
+	{
+		if( SG_OMP_Get_Thread_Num() == 0 )
+		{
+			Set_Progress(y * SG_OMP_Get_Max_Num_Threads(), Get_NY());
+		}
+
+		if( !Process_Get_Okay() )
+		{
+			continue;
+		}
+
+		CSG_Array_Int	xNearest(Get_NX()), yNearest(Get_NX());
+
+		Transform.Get_Nearest(y, xNearest.Get_Array(), yNearest.Get_Array());
+
+		for(int x=0; x<Get_NX(); x++)
 		{
-			if( !pDistance->is_NoData(x, y) )
+			double	dDist	= SG_Get_Distance(x, y, xNearest[x], yNearest[x]) * cellSize;
+
+			if( dDist <= dBufDist )
 			{
-				dDist = sqrt(pDistance->asDouble(x, y)) * cellSize;
 				pDistance->Set_Value(x, y, dDist);
+				pAlloc->Set_Value(x, y, pSource->asInt(xNearest[x], yNearest[x]));
 
-				i = 0;
-				while( i< dDist )
+				int	i = 0;
+				while( i < dDist )
 					i += ival;
 				pBuffer->Set_Value(x, y, i);
 			}
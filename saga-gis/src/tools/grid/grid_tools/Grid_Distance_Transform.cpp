@@ -0,0 +1,261 @@
+/**********************************************************
+ * Version $Id$
+ *********************************************************/
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//                     Tool Library                      //
+//                     Grid_Tools                        //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//              Grid_Distance_Transform.cpp              //
+//                                                       //
+//                 Copyright (C) 2026 by                 //
+//                      Olaf Conrad                      //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'. SAGA is free software; you   //
+// can redistribute it and/or modify it under the terms  //
+// of the GNU General Public License as published by the //
+// Free Software Foundation, either version 2 of the     //
+// License, or (at your option) any later version.       //
+//                                                       //
+// SAGA is distributed in the hope that it will be       //
+// useful, but WITHOUT ANY WARRANTY; without even the    //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU General Public        //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU General    //
+// Public License along with this program; if not, see   //
+// <http://www.gnu.org/licenses/>.                       //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     oconrad@saga-gis.org                   //
+//                                                       //
+//    contact:    Olaf Conrad                            //
+//                Institute of Geography                 //
+//                University of Goettingen               //
+//                Goldschmidtstr. 5                      //
+//                37077 Goettingen                       //
+//                Germany                                //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include "Grid_Distance_Transform.h"
+
+#include <float.h>
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CGrid_Distance_Transform::CGrid_Distance_Transform(void)
+{
+	m_pFeatures	= NULL;
+	m_bPositive	= false;
+	m_nFeatures	= 0;
+}
+
+//---------------------------------------------------------
+bool CGrid_Distance_Transform::Destroy(void)
+{
+	m_Column.Destroy();
+
+	m_pFeatures	= NULL;
+	m_nFeatures	= 0;
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/** Column pass. Stores for each cell the row of the nearest
+  * feature cell in the same column or -1 if the column has no
+  * features at all. The columns are processed in strips, so
+  * that each thread scans the rows of its own strip forward
+  * and backward, keeping memory access in row order.
+*/
+//---------------------------------------------------------
+bool CGrid_Distance_Transform::Create(CSG_Grid *pFeatures, bool bPositive)
+{
+	Destroy();
+
+	if( !pFeatures || !pFeatures->is_Valid() || !m_Column.Create(pFeatures->Get_System(), SG_DATATYPE_Int) )
+	{
+		return( false );
+	}
+
+	m_pFeatures	= pFeatures;
+	m_bPositive	= bPositive;
+
+	int	NX	= pFeatures->Get_NX(), NY = pFeatures->Get_NY(), Strip = 64;
+
+	sLong	nFeatures	= 0;
+
+	#pragma omp parallel for reduction(+:nFeatures)
+	for(int x0=0; x0<NX; x0+=Strip)
+	{
+		if( !SG_UI_Process_Get_Okay() )
+		{
+			continue;
+		}
+
+		int	x1	= M_GET_MIN(NX, x0 + Strip);
+
+		CSG_Array_Int	Last(x1 - x0);
+
+		for(int x=x0; x<x1; x++)
+		{
+			Last[x - x0]	= -1;
+		}
+
+		for(int y=0; y<NY; y++)	// forward: last feature row below
+		{
+			for(int x=x0; x<x1; x++)
+			{
+				if( is_Feature(x, y) )
+				{
+					Last[x - x0]	= y; nFeatures++;
+				}
+
+				m_Column.Set_Value(x, y, Last[x - x0]);
+			}
+		}
+
+		for(int x=x0; x<x1; x++)
+		{
+			Last[x - x0]	= -1;
+		}
+
+		for(int y=NY-1; y>=0; y--)	// backward: compare with next feature row above
+		{
+			for(int x=x0; x<x1; x++)
+			{
+				int	yBelow	= m_Column.asInt(x, y);
+
+				if( yBelow == y )
+				{
+					Last[x - x0]	= y;
+				}
+				else if( Last[x - x0] >= 0 && (yBelow < 0 || Last[x - x0] - y < y - yBelow) )
+				{
+					m_Column.Set_Value(x, y, Last[x - x0]);
+				}
+			}
+		}
+	}
+
+	if( !SG_UI_Process_Get_Okay() )	// cancelled during the column pass
+	{
+		Destroy();
+
+		return( false );
+	}
+
+	m_nFeatures	= nFeatures;
+
+	return( true );
+}
+
+//---------------------------------------------------------
+/** Row pass. Builds the lower envelope of the parabolas
+  * (x - q)^2 + dy(q)^2 of all columns q with a feature and
+  * assigns each cell of the row to the parabola being lowest
+  * at its position. Cells of a grid without any feature get
+  * a nearest position of -1.
+*/
+//---------------------------------------------------------
+bool CGrid_Distance_Transform::Get_Nearest(int y, int *xNearest, int *yNearest)	const
+{
+	if( !m_pFeatures || y < 0 || y >= m_Column.Get_NY() )
+	{
+		return( false );
+	}
+
+	int	NX	= m_Column.Get_NX();
+
+	CSG_Array_Int	v(NX);	CSG_Vector	z(NX + 1);	CSG_Vector	f(NX);
+
+	int	k	= -1;
+
+	for(int q=0; q<NX; q++)
+	{
+		int	yq	= m_Column.asInt(q, y);
+
+		if( yq < 0 )
+		{
+			continue;
+		}
+
+		f[q]	= (double)(yq - y) * (yq - y);
+
+		double	s	= 0.;
+
+		while( k >= 0 && (s = ((f[q] + (double)q * q) - (f[v[k]] + (double)v[k] * v[k])) / (2. * (q - v[k]))) <= z[k] )
+		{
+			k--;
+		}
+
+		k++; v[k] = q; z[k] = k > 0 ? s : -DBL_MAX; z[k + 1] = DBL_MAX;
+	}
+
+	//-----------------------------------------------------
+	if( k < 0 )
+	{
+		for(int x=0; x<NX; x++)
+		{
+			xNearest[x]	= yNearest[x]	= -1;
+		}
+
+		return( true );
+	}
+
+	for(int x=0, i=0; x<NX; x++)
+	{
+		while( z[i + 1] < x )
+		{
+			i++;
+		}
+
+		xNearest[x]	= v[i];
+		yNearest[x]	= m_Column.asInt(v[i], y);
+	}
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
@@ -0,0 +1,122 @@
+/**********************************************************
+ * Version $Id$
+ *********************************************************/
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//                     Tool Library                      //
+//                     Grid_Tools                        //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//               Grid_Distance_Transform.h               //
+//                                                       //
+//                 Copyright (C) 2026 by                 //
+//                      Olaf Conrad                      //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'. SAGA is free software; you   //
+// can redistribute it and/or modify it under the terms  //
+// of the GNU General Public License as published by the //
+// Free Software Foundation, either version 2 of the     //
+// License, or (at your option) any later version.       //
+//                                                       //
+// SAGA is distributed in the hope that it will be       //
+// useful, but WITHOUT ANY WARRANTY; without even the    //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU General Public        //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU General    //
+// Public License along with this program; if not, see   //
+// <http://www.gnu.org/licenses/>.                       //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     oconrad@saga-gis.org                   //
+//                                                       //
+//    contact:    Olaf Conrad                            //
+//                Institute of Geography                 //
+//                University of Goettingen               //
+//                Goldschmidtstr. 5                      //
+//                37077 Goettingen                       //
+//                Germany                                //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#ifndef HEADER_INCLUDED__Grid_Distance_Transform_H
+#define HEADER_INCLUDED__Grid_Distance_Transform_H
+
+//---------------------------------------------------------
+#include "MLB_Interface.h"
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/** Exact euclidean distance transform after Felzenszwalb &
+  * Huttenlocher (2012). Create() runs the column pass, which
+  * finds for each cell the nearest feature cell within its
+  * column. Get_Nearest() then runs the row pass for a single
+  * row, returning the position of the nearest feature cell for
+  * each cell of that row. Get_Nearest() can be called for
+  * different rows in parallel.
+*/
+//---------------------------------------------------------
+class CGrid_Distance_Transform
+{
+public:
+	CGrid_Distance_Transform(void);
+
+	bool						Create					(CSG_Grid *pFeatures, bool bPositive = false);
+	bool						Destroy					(void);
+
+	bool						is_Feature				(int x, int y)	const
+	{
+		return( !m_pFeatures->is_NoData(x, y) && (!m_bPositive || m_pFeatures->asDouble(x, y) > 0.0) );
+	}
+
+	sLong						Get_Feature_Count		(void)	const	{	return( m_nFeatures );	}
+
+	bool						Get_Nearest				(int y, int *xNearest, int *yNearest)	const;
+
+
+private:
+
+	bool						m_bPositive;
+
+	sLong						m_nFeatures;
+
+	CSG_Grid					*m_pFeatures, m_Column;
+
+};
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#endif // #ifndef HEADER_INCLUDED__Grid_Distance_Transform_H
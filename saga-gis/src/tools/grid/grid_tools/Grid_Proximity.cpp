@@ -60,6 +60,8 @@
 //---------------------------------------------------------
 #include "Grid_Proximity.h"
 
+#include "Grid_Distance_Transform.h"
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -78,9 +80,15 @@ CGrid_Proximity::CGrid_Proximity(void)
 	Set_Author		(SG_T("O.Conrad (c) 2010"));
 
 	Set_Description	(_TW(
-		"Calculates a grid with euclidean distance to feature cells (not no-data cells)."
+		"Calculates a grid with euclidean distance to feature cells (not no-data cells). "
+		"Distances are derived with an exact euclidean distance transform."
 	));
 
+	Add_Reference("Felzenszwalb, P.F. & Huttenlocher, D.P.", "2012",
+		"Distance Transforms of Sampled Functions",
+		"Theory of Computing 8: 415-428."
+	);
+
 
 	//-----------------------------------------------------
 	// 2. Standard in- and output...
@@ -120,68 +128,22 @@ CGrid_Proximity::CGrid_Proximity(void)
 //---------------------------------------------------------
 bool CGrid_Proximity::On_Execute(void)
 {
-	int				x, y;
-	double			z, d;
-	TSG_Point		p;
-	CSG_Grid		*pFeatures, *pDistance, *pDirection, *pAllocation;
-	CSG_PRQuadTree	Search;
-
-	//-----------------------------------------------------
-	pFeatures	= Parameters("FEATURES")	->asGrid();
-	pDistance	= Parameters("DISTANCE")	->asGrid();
-	pDirection	= Parameters("DIRECTION")	->asGrid();
-	pAllocation	= Parameters("ALLOCATION")	->asGrid();
+	CSG_Grid	*pFeatures		= Parameters("FEATURES"  )->asGrid();
+	CSG_Grid	*pDistance		= Parameters("DISTANCE"  )->asGrid();
+	CSG_Grid	*pDirection		= Parameters("DIRECTION" )->asGrid();
+	CSG_Grid	*pAllocation	= Parameters("ALLOCATION")->asGrid();
 
 	//-----------------------------------------------------
 	Process_Set_Text(_TL("preparing distance calculation..."));
 
-	Search.Create(CSG_Rect(-1, -1, Get_NX(), Get_NY()));
+	CGrid_Distance_Transform	Transform;
 
-	for(y=0; y<Get_NY() && Set_Progress(y); y++)
+	if( !Transform.Create(pFeatures) )	// invalid input or cancelled
 	{
-		for(x=0; x<Get_NX(); x++)
-		{
-			if( pFeatures->is_NoData(x, y) )
-			{
-				pDistance->Set_Value(x, y, -1.0);
-			}
-			else
-			{
-				pDistance->Set_Value(x, y,  0.0);
-
-				if( pDirection )
-				{
-					pDirection->Set_NoData(x, y);
-				}
-
-				if( pAllocation )
-				{
-					pAllocation->Set_Value(x, y, pFeatures->asDouble(x, y));
-				}
-
-				//-----------------------------------------
-				bool	bBorder	= false;
-
-				for(int i=0; i<8 && !bBorder; i++)
-				{
-					int	ix	= Get_xTo(i, x);
-					int	iy	= Get_yTo(i, y);
-
-					if( is_InGrid(ix, iy) && pFeatures->is_NoData(ix, iy) )
-					{
-						bBorder	= true;
-					}
-				}
-
-				if( bBorder )
-				{
-					Search.Add_Point(x, y, pFeatures->asDouble(x, y));
-				}
-			}
-		}
+		return( false );
 	}
 
-	if( !Search.is_Okay() || Search.Get_Point_Count() <= 0 || Search.Get_Point_Count() >= Get_NCells() )
+	if( Transform.Get_Feature_Count() <= 0 || Transform.Get_Feature_Count() >= Get_NCells() )
 	{
 		Message_Add(_TL("no features to buffer."));
 
@@ -191,31 +153,47 @@ bool CGrid_Proximity::On_Execute(void)
 	//-----------------------------------------------------
 	Process_Set_Text(_TL("performing distance calculation..."));
 
-	for(y=0; y<Get_NY() && Set_Progress(y); y++)
+	#pragma omp parallel for
+	for(int y=0; y<Get_NY(); y++)
 	{
-		for(x=0; x<Get_NX(); x++)
+		if( SG_OMP_Get_Thread_Num() == 0 )
 		{
-			if( pDistance->asDouble(x, y) < 0.0 && Search.Get_Nearest_Point(x, y, p, z, d) )
-			{
-				pDistance->Set_Value(x, y, d * Get_Cellsize());
+			Set_Progress(y * SG_OMP_Get_Max_Num_Threads(), Get_NY());
+		}
+
+		if( !Process_Get_Okay() )
+		{
+			continue;
+		}
+
+		CSG_Array_Int	xNearest(Get_NX()), yNearest(Get_NX());
 
-				if( pDirection )
+		Transform.Get_Nearest(y, xNearest.Get_Array(), yNearest.Get_Array());
+
+		for(int x=0; x<Get_NX(); x++)
+		{
+			int	ix	= xNearest[x], iy = yNearest[x];
+
+			double	d	= SG_Get_Distance(x, y, ix, iy);
+
+			pDistance->Set_Value(x, y, d * Get_Cellsize());
+
+			if( pDirection )
+			{
+				if( d > 0.0 )
 				{
-					if( d > 0.0 )
-					{
-						pDirection->Set_Value(x, y, SG_Get_Angle_Of_Direction(x, y, p.x, p.y) * M_RAD_TO_DEG);
-					}
-					else
-					{
-						pDirection->Set_NoData(x, y);
-					}
+					pDirection->Set_Value(x, y, SG_Get_Angle_Of_Direction(x, y, ix, iy) * M_RAD_TO_DEG);
 				}
-
-				if( pAllocation )
+				else
 				{
-					pAllocation->Set_Value(x, y, z);
+					pDirection->Set_NoData(x, y);
 				}
 			}
+
+			if( pAllocation )
+			{
+				pAllocation->Set_Value(x, y, pFeatures->asDouble(ix, iy));
+			}
 		}
 	}
 
@@ -79,8 +79,14 @@ CGrid_Cluster_Analysis::CGrid_Cluster_Analysis(void)
 
 	Set_Description	(_TW(		
 		"This tool implements the K-Means cluster analysis for grids "
-		"in two variants, iterative minimum distance (Forgy 1965) "
-		"and hill climbing (Rubin 1967). "
+		"in three variants, iterative minimum distance (Forgy 1965), "
+		"hill climbing (Rubin 1967) and mini-batch k-means (Sculley 2010). "
+		"The minimum distance assignment skips distance calculations "
+		"using the bounds proposed by Hamerly (2010). Mini-batch k-means "
+		"updates the centroids from small random samples and suits very "
+		"large data sets. For mini-batch k-means the maximum number of "
+		"iterations refers to the number of batches. The start partition "
+		"can be created with k-means++ seeding (Arthur & Vassilvitskii 2007). "
 	));
 	
 	Add_Reference("Forgy, E.", "1965",
@@ -93,6 +99,21 @@ CGrid_Cluster_Analysis::CGrid_Cluster_Analysis(void)
 		"J. Theoretical Biology, 15:103-144."
 	);
 
+	Add_Reference("Arthur, D., Vassilvitskii, S.", "2007",
+		"k-means++: the advantages of careful seeding",
+		"Proceedings of the 18th Annual ACM-SIAM Symposium on Discrete Algorithms, 1027-1035."
+	);
+
+	Add_Reference("Hamerly, G.", "2010",
+		"Making k-means even faster",
+		"Proceedings of the 2010 SIAM International Conference on Data Mining, 130-140."
+	);
+
+	Add_Reference("Sculley, D.", "2010",
+		"Web-scale k-means clustering",
+		"Proceedings of the 19th International Conference on World Wide Web, 1177-1178."
+	);
+
 	//-----------------------------------------------------
 	Parameters.Add_Grid_List("",
 		"GRIDS"		, _TL("Grids"),
@@ -115,13 +136,20 @@ CGrid_Cluster_Analysis::CGrid_Cluster_Analysis(void)
 	Parameters.Add_Choice("",
 		"METHOD"		, _TL("Method"),
 		_TL(""),
-		CSG_String::Format("%s|%s|%s",
+		CSG_String::Format("%s|%s|%s|%s",
 			_TL("Iterative Minimum Distance (Forgy 1965)"),
 			_TL("Hill-Climbing (Rubin 1967)"),
-			_TL("Combined Minimum Distance / Hillclimbing") 
+			_TL("Combined Minimum Distance / Hillclimbing"),
+			_TL("Mini-Batch K-Means (Sculley 2010)")
 		), 1
 	);
 
+	Parameters.Add_Int("METHOD",
+		"BATCH_SIZE"	, _TL("Batch Size"),
+		_TL("Number of randomly drawn cells per mini-batch."),
+		1024, 1, true
+	);
+
 	Parameters.Add_Int("",
 		"NCLUSTER"		, _TL("Clusters"),
 		_TL("Number of clusters"),
@@ -140,6 +168,12 @@ CGrid_Cluster_Analysis::CGrid_Cluster_Analysis(void)
 		false
 	);
 
+	Parameters.Add_Bool("",
+		"SINGLE"		, _TL("Single Precision"),
+		_TL("Stores the features with single precision, which halves the memory needed, but might slightly change the resulting clusters."),
+		false
+	);
+
 	Parameters.Add_Bool("",
 		"RGB_COLORS"	, _TL("Update Colors from Features"),
 		_TL("Use the first three features in list to obtain blue, green, red components for class colour in look-up table."),
@@ -149,10 +183,11 @@ CGrid_Cluster_Analysis::CGrid_Cluster_Analysis(void)
 	Parameters.Add_Choice("",
 		"INITIALIZE"	, _TL("Start Partition"),
 		_TL(""),
-		CSG_String::Format("%s|%s|%s",
+		CSG_String::Format("%s|%s|%s|%s",
 			_TL("random"),
 			_TL("periodical"),
-			_TL("keep values") 
+			_TL("keep values"),
+			_TL("k-means++")
 		), 0
 	);
 
@@ -172,7 +207,9 @@ int CGrid_Cluster_Analysis::On_Parameters_Enable(CSG_Parameters *pParameters, CS
 	if( pParameter->Cmp_Identifier("OLDVERSION") )
 	{
 		pParameters->Set_Enabled("INITIALIZE", pParameter->asBool() == false);
+		pParameters->Set_Enabled("SINGLE"    , pParameter->asBool() == false);
 		pParameters->Set_Enabled("UPDATEVIEW", pParameter->asBool() == true );
+		pParameters->Set_Enabled("BATCH_SIZE", pParameter->asBool() == false && (*pParameters)("METHOD")->asInt() == 3);
 	}
 
 	if( pParameter->Cmp_Identifier("GRIDS") )
@@ -180,6 +217,11 @@ int CGrid_Cluster_Analysis::On_Parameters_Enable(CSG_Parameters *pParameters, CS
 		pParameters->Set_Enabled("RGB_COLORS", pParameter->asGridList()->Get_Grid_Count() >= 3);
 	}
 
+	if( pParameter->Cmp_Identifier("METHOD") )
+	{
+		pParameters->Set_Enabled("BATCH_SIZE", pParameter->asInt() == 3 && (*pParameters)("OLDVERSION")->asBool() == false);
+	}
+
 	return( CSG_Tool_Grid::On_Parameters_Enable(pParameters, pParameter) );
 }
 
@@ -203,7 +245,7 @@ bool CGrid_Cluster_Analysis::On_Execute(void)
 	//-----------------------------------------------------
 	CSG_Cluster_Analysis	Analysis;
 
-	if( !Analysis.Create(pGrids->Get_Grid_Count()) )
+	if( !Analysis.Create(pGrids->Get_Grid_Count(), Parameters("SINGLE")->asBool() ? SG_DATATYPE_Float : SG_DATATYPE_Double) )
 	{
 		return( false );
 	}
@@ -261,7 +303,8 @@ bool CGrid_Cluster_Analysis::On_Execute(void)
 		Parameters("METHOD"    )->asInt(),
 		Parameters("NCLUSTER"  )->asInt(),
 		Parameters("MAXITER"   )->asInt(),
-		Parameters("INITIALIZE")->asInt()
+		Parameters("INITIALIZE")->asInt(),
+		Parameters("BATCH_SIZE")->asInt()
 	);
 
 	for(iElement=0, nElements=0; iElement<Get_NCells(); iElement++)
@@ -433,6 +476,13 @@ bool CGrid_Cluster_Analysis::_On_Execute(void)
 		return( false );
 	}
 
+	if( Parameters("METHOD")->asInt() == 3 )
+	{
+		Error_Set(_TL("Mini-Batch K-Means is not supported by the old version."));
+
+		return( false );
+	}
+
 	//-----------------------------------------------------
 	Grids		= (CSG_Grid **)SG_Malloc(pGrids->Get_Grid_Count() * sizeof(CSG_Grid *));
 
@@ -468,7 +518,7 @@ bool CGrid_Cluster_Analysis::_On_Execute(void)
 	//-------------------------------------------------
 	switch( Parameters("METHOD")->asInt() )
 	{
-	case 0:		SP	= _MinimumDistance	(Grids, pGrids->Get_Grid_Count(), pCluster, nCluster, nMembers, Variances, Centroids, nElements = Get_NCells());	break;
+	default:	SP	= _MinimumDistance	(Grids, pGrids->Get_Grid_Count(), pCluster, nCluster, nMembers, Variances, Centroids, nElements = Get_NCells());	break;
 	case 1:		SP	= _HillClimbing		(Grids, pGrids->Get_Grid_Count(), pCluster, nCluster, nMembers, Variances, Centroids, nElements = Get_NCells());	break;
 	case 2:		SP	= _MinimumDistance	(Grids, pGrids->Get_Grid_Count(), pCluster, nCluster, nMembers, Variances, Centroids, nElements = Get_NCells());
 				SP	= _HillClimbing		(Grids, pGrids->Get_Grid_Count(), pCluster, nCluster, nMembers, Variances, Centroids, nElements = Get_NCells());	break;
@@ -240,6 +240,82 @@ TSG_Data_Type CSG_GDAL_Drivers::Get_SAGA_Type(int Type)
 //														 //
 ///////////////////////////////////////////////////////////
 
+//---------------------------------------------------------
+// Drivers supporting it (e.g. GTiff) decode or encode the
+// blocks touched by one raster request on several threads,
+// as long as the user did not configure it otherwise.
+//---------------------------------------------------------
+static bool	SG_GDAL_Set_Num_Threads(bool bOn)
+{
+	static const char	*Key	= "GDAL_NUM_THREADS";
+
+	if( bOn )
+	{
+		if( CPLGetConfigOption(Key, NULL) == NULL )
+		{
+			CPLSetThreadLocalConfigOption(Key, "ALL_CPUS");
+
+			return( true );
+		}
+	}
+	else
+	{
+		CPLSetThreadLocalConfigOption(Key, NULL);
+	}
+
+	return( false );
+}
+
+//---------------------------------------------------------
+// Grid types that have an identical GDAL data type, so that
+// values can be copied without conversion.
+//---------------------------------------------------------
+static bool	SG_GDAL_is_Native_Type(TSG_Data_Type Type)
+{
+	switch( Type )
+	{
+	case SG_DATATYPE_Byte  :
+	case SG_DATATYPE_Word  :
+	case SG_DATATYPE_Short :
+	case SG_DATATYPE_DWord :
+	case SG_DATATYPE_Int   :
+	case SG_DATATYPE_Float :
+	case SG_DATATYPE_Double:
+		return( true );
+
+	default:
+		return( false );
+	}
+}
+
+//---------------------------------------------------------
+// Number of rows transferred with one request. Rows are read
+// and written in multiples of the band's block height, so
+// that tiles and strips are decompressed only once.
+//---------------------------------------------------------
+static int	SG_GDAL_Get_Block_Rows(GDALRasterBandH pBand, int nLineBytes, int NY)
+{
+	int	nx, ny;
+
+	GDALGetBlockSize(pBand, &nx, &ny);
+
+	if( ny < 1 )
+	{
+		ny	= 1;
+	}
+
+	int	n	= (int)(16. * N_MEGABYTE_BYTES / ((double)ny * nLineBytes));	// at least 16 MB per request for small blocks
+
+	n	= ny * (n > 1 ? n : 1);
+
+	return( n < NY ? n : NY );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
 //---------------------------------------------------------
 CSG_GDAL_DataSet::CSG_GDAL_DataSet(void)
 {
@@ -276,6 +352,8 @@ bool CSG_GDAL_DataSet::Open_Read(const CSG_String &File_Name, const char *Driver
 {
 	Close();
 
+	bool	bThreads	= SG_GDAL_Set_Num_Threads(true);
+
 	#ifdef GDAL_V2_0_OR_NEWER
 	if( Drivers )
 	{
@@ -285,7 +363,17 @@ bool CSG_GDAL_DataSet::Open_Read(const CSG_String &File_Name, const char *Driver
 		m_pDataSet	= NULL;
 	#endif
 
-	if( !m_pDataSet && (m_pDataSet = GDALOpen(File_Name, GA_ReadOnly)) == NULL )
+	if( !m_pDataSet )
+	{
+		m_pDataSet	= GDALOpen(File_Name, GA_ReadOnly);
+	}
+
+	if( bThreads )
+	{
+		SG_GDAL_Set_Num_Threads(false);
+	}
+
+	if( !m_pDataSet )
 	{
 		return( false );
 	}
@@ -302,7 +390,16 @@ bool CSG_GDAL_DataSet::Open_Read(const CSG_String &File_Name, const CSG_Grid_Sys
 {
 	Close();
 
-	if( (m_pVrtSource = GDALOpen(File_Name, GA_ReadOnly)) == NULL )
+	bool	bThreads	= SG_GDAL_Set_Num_Threads(true);
+
+	m_pVrtSource	= GDALOpen(File_Name, GA_ReadOnly);
+
+	if( bThreads )
+	{
+		SG_GDAL_Set_Num_Threads(false);
+	}
+
+	if( m_pVrtSource == NULL )
 	{
 		return( false );
 	}
@@ -540,7 +637,16 @@ bool CSG_GDAL_DataSet::Open_Write(const CSG_String &File_Name, const CSG_String
 		return( false );
 	}
 
-	if( (m_pDataSet = GDALCreate(pDriver, File_Name, System.Get_NX(), System.Get_NY(), NBands, (GDALDataType)gSG_GDAL_Drivers.Get_GDAL_Type(Type), pOptions)) == NULL )
+	bool	bThreads	= SG_GDAL_Set_Num_Threads(true);
+
+	m_pDataSet	= GDALCreate(pDriver, File_Name, System.Get_NX(), System.Get_NY(), NBands, (GDALDataType)gSG_GDAL_Drivers.Get_GDAL_Type(Type), pOptions);
+
+	if( bThreads )
+	{
+		SG_GDAL_Set_Num_Threads(false);
+	}
+
+	if( m_pDataSet == NULL )
 	{
 		SG_UI_Msg_Add_Error(_TL("Could not create dataset."));
 
@@ -1029,7 +1135,40 @@ CSG_Grid * CSG_GDAL_DataSet::Read(int i)
 	}
 
 	//-----------------------------------------------------
-	void *zLine; GDALDataType zType;
+	GDALDataType	zType	= (GDALDataType)gSG_GDAL_Drivers.Get_GDAL_Type(Type);
+
+	char	*Rows	= NULL;	int	nRows	= 0;
+
+	if( SG_GDAL_is_Native_Type(Type) && zType == GDALGetRasterDataType(pBand) )	// copy blocks of rows straight into the grid's memory
+	{
+		nRows	= SG_GDAL_Get_Block_Rows(pBand, pGrid->Get_nLineBytes(), Get_NY());
+
+		Rows	= (char *)SG_Malloc((size_t)nRows * pGrid->Get_nLineBytes());
+	}
+
+	if( Rows )
+	{
+		for(int y=0; y<Get_NY() && SG_UI_Process_Set_Progress(y, Get_NY()); y+=nRows)
+		{
+			int	n	= y + nRows < Get_NY() ? nRows : Get_NY() - y;
+
+			if( GDALRasterIO(pBand, GF_Read, 0, y, Get_NX(), n, Rows, Get_NX(), n, zType, 0, pGrid->Get_nLineBytes()) == CE_None )
+			{
+				#pragma omp parallel for if( !pGrid->is_Cached() )
+				for(int j=0; j<n; j++)
+				{
+					pGrid->Set_Line(m_bTransform ? y + j : Get_NY() - 1 - (y + j), Rows + (size_t)j * pGrid->Get_nLineBytes());
+				}
+			}
+		}
+
+		SG_Free(Rows);
+
+		return( pGrid );
+	}
+
+	//-----------------------------------------------------
+	void *zLine;
 
 	switch( Type )
 	{
@@ -1074,19 +1213,75 @@ bool CSG_GDAL_DataSet::Write(int i, CSG_Grid *pGrid, double noDataValue)
 	//-----------------------------------------------------
 	CPLErr	Error	= CE_None;
 
-	double	*zLine	= (double *)SG_Malloc(Get_NX() * sizeof(double));
+	TSG_Data_Type	Type	= pGrid->Get_Type();
+
+	double	zNoData	= noDataValue; SG_Data_Type_Range_Check(Type, zNoData);
+
+	char	*Rows	= NULL;	int	nRows	= 0;
+
+	if( SG_GDAL_is_Native_Type(Type) && !pGrid->is_Scaled() && zNoData == noDataValue
+	&&  (Type == SG_DATATYPE_Float || Type == SG_DATATYPE_Double || zNoData == floor(zNoData)) )	// no-data value can be stored with the grid's type
+	{
+		nRows	= SG_GDAL_Get_Block_Rows(pBand, pGrid->Get_nLineBytes(), Get_NY());
+
+		Rows	= (char *)SG_Malloc((size_t)nRows * pGrid->Get_nLineBytes());
+	}
 
-	for(int y=0, yy=Get_NY()-1; Error==CE_None && y<Get_NY() && SG_UI_Process_Set_Progress(y, Get_NY()); y++, yy--)
+	if( Rows )	// write blocks of rows in the grid's own data type
 	{
-		for(int x=0; x<Get_NX(); x++)
+		bool	bNoData	= Type == SG_DATATYPE_Float || Type == SG_DATATYPE_Double	// no-data cells need to be replaced?
+			|| pGrid->Get_NoData_Value() != noDataValue || pGrid->Get_NoData_Value(true) != noDataValue;
+
+		for(int y=0; Error==CE_None && y<Get_NY() && SG_UI_Process_Set_Progress(y, Get_NY()); y+=nRows)
 		{
-			zLine[x]	= pGrid->is_NoData(x, yy) ? noDataValue : pGrid->asDouble(x, yy);
+			int	n	= y + nRows < Get_NY() ? nRows : Get_NY() - y;
+
+			#pragma omp parallel for if( !pGrid->is_Cached() )
+			for(int j=0; j<n; j++)
+			{
+				int	yy	= Get_NY() - 1 - (y + j);
+
+				char	*pLine	= Rows + (size_t)j * pGrid->Get_nLineBytes();
+
+				pGrid->Get_Line(yy, pLine);
+
+				for(int x=0; bNoData && x<Get_NX(); x++)
+				{
+					if( pGrid->is_NoData(x, yy) ) switch( Type )
+					{
+					default                : break;
+					case SG_DATATYPE_Byte  : ((BYTE   *)pLine)[x] = (BYTE  )noDataValue; break;
+					case SG_DATATYPE_Word  : ((WORD   *)pLine)[x] = (WORD  )noDataValue; break;
+					case SG_DATATYPE_Short : ((short  *)pLine)[x] = (short )noDataValue; break;
+					case SG_DATATYPE_DWord : ((DWORD  *)pLine)[x] = (DWORD )noDataValue; break;
+					case SG_DATATYPE_Int   : ((int    *)pLine)[x] = (int   )noDataValue; break;
+					case SG_DATATYPE_Float : ((float  *)pLine)[x] = (float )noDataValue; break;
+					case SG_DATATYPE_Double: ((double *)pLine)[x] = (double)noDataValue; break;
+					}
+				}
+			}
+
+			Error	= GDALRasterIO(pBand, GF_Write, 0, y, Get_NX(), n, Rows, Get_NX(), n, (GDALDataType)gSG_GDAL_Drivers.Get_GDAL_Type(Type), 0, pGrid->Get_nLineBytes());
 		}
 
-		Error	= GDALRasterIO(pBand, GF_Write, 0, y, Get_NX(), 1, zLine, Get_NX(), 1, GDT_Float64, 0, 0);
+		SG_Free(Rows);
 	}
+	else	// scaled values or no-data value not matching the grid's type
+	{
+		double	*zLine	= (double *)SG_Malloc(Get_NX() * sizeof(double));
 
-	SG_Free(zLine);
+		for(int y=0, yy=Get_NY()-1; Error==CE_None && y<Get_NY() && SG_UI_Process_Set_Progress(y, Get_NY()); y++, yy--)
+		{
+			for(int x=0; x<Get_NX(); x++)
+			{
+				zLine[x]	= pGrid->is_NoData(x, yy) ? noDataValue : pGrid->asDouble(x, yy);
+			}
+
+			Error	= GDALRasterIO(pBand, GF_Write, 0, y, Get_NX(), 1, zLine, Get_NX(), 1, GDT_Float64, 0, 0);
+		}
+
+		SG_Free(zLine);
+	}
 
 	//-----------------------------------------------------
 	if( Error != CE_None )
@@ -211,32 +211,33 @@ bool CGrid_Class_Statistics_For_Polygons::On_Execute(void)
 		{
 			CSG_Shape_Polygon	*pPolygon	= (CSG_Shape_Polygon *)pPolygons->Get_Shape(i);
 
-			int	xCells[2], yCells[2];
+			CSG_Grid_Polygon_Coverage	Coverage(Get_System(), pPolygon);
 
-			if( !Get_Cells(pPolygon->Get_Extent(), xCells, yCells) )
+			if( !Coverage.is_Valid() )
 			{
 				continue;
 			}
 
-			for(int y=yCells[0]; y<=yCells[1]; y++)
+			CSG_Vector	Row(Coverage.Get_NX()), Area(pPolygons->Get_Field_Count() - fStart);
+
+			for(int y=Coverage.Get_yMin(); y<=Coverage.Get_yMax(); y++)
 			{
-				double	yWorld	= Get_YMin() + y * Get_Cellsize();
+				Coverage.Get_Row(y, Row.Get_Data(), bCenter);
 
-				for(int x=xCells[0]; x<=xCells[1]; x++)
+				for(int x=Coverage.Get_xMin(), j=0; x<=Coverage.Get_xMax(); x++, j++)
 				{
-					if( m_Classes.asInt(x, y) < 0 )
+					if( Row[j] > 0. && m_Classes.asInt(x, y) >= 0 )
 					{
-						continue;
+						Area[m_Classes.asInt(x, y)]	+= Row[j] * Get_Cellarea();
 					}
+				}
+			}
 
-					double	xWorld	= Get_XMin() + x * Get_Cellsize();
-
-					double	Area	= Get_Intersection(pPolygon, xWorld, yWorld, bCenter);
-
-					if( Area > 0. )
-					{
-						pPolygon->Add_Value(fStart + m_Classes.asInt(x, y), Area);
-					}
+			for(int j=0; j<Area.Get_N(); j++)
+			{
+				if( Area[j] > 0. )
+				{
+					pPolygon->Add_Value(fStart + j, Area[j]);
 				}
 			}
 		}
@@ -301,18 +302,6 @@ bool CGrid_Class_Statistics_For_Polygons::On_Execute(void)
 //														 //
 ///////////////////////////////////////////////////////////
 
-//---------------------------------------------------------
-inline bool CGrid_Class_Statistics_For_Polygons::Get_Cells(const CSG_Rect &Extent, int xCells[2], int yCells[2])
-{
-	xCells[0] = (int)floor((Extent.Get_XMin() - Get_XMin()) / Get_Cellsize()); if( xCells[0] <         0 ) xCells[0] =            0;
-	xCells[1] = (int)ceil ((Extent.Get_XMax() - Get_XMin()) / Get_Cellsize()); if( xCells[1] >= Get_NX() ) xCells[1] = Get_NX() - 1;
-
-	yCells[0] = (int)floor((Extent.Get_YMin() - Get_YMin()) / Get_Cellsize()); if( yCells[0] <         0 ) yCells[0] =            0;
-	yCells[1] = (int)ceil ((Extent.Get_YMax() - Get_YMin()) / Get_Cellsize()); if( yCells[1] >= Get_NY() ) yCells[1] = Get_NY() - 1;
-
-	return( xCells[0] <= xCells[1] && yCells[0] <= yCells[1] );
-}
-
 //---------------------------------------------------------
 inline double CGrid_Class_Statistics_For_Polygons::Get_Intersection(CSG_Shape_Polygon *pPolygon, double x, double y, bool bCenter)
 {
@@ -87,7 +87,6 @@ private:
 	CSG_Grid				m_Classes;
 
 
-	bool					Get_Cells				(const CSG_Rect &Extent, int xCells[2], int yCells[2]);
 	double					Get_Intersection		(CSG_Shape_Polygon *pPolygon, double x, double y, bool bCenter);
 
 	bool					Get_Classes				(CSG_Grid *pGrid, CSG_Shapes *pPolygons);
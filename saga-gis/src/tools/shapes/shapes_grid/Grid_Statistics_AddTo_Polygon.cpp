@@ -254,15 +254,24 @@ bool CGrid_Statistics_AddTo_Polygon::On_Execute(void)
 		pPolygons	->Fmt_Name("%s [%s]", Parameters("POLYGONS")->asShapes()->Get_Name(), _TL("Grid Statistics"));
 	}
 
-	CSG_Simple_Statistics	*Statistics	= new CSG_Simple_Statistics[pPolygons->Get_Count()];
+	//-----------------------------------------------------
+	// the precise methods collect the statistics for all grids in a single pass
+
+	CSG_Simple_Statistics	*Statistics	= new CSG_Simple_Statistics[pPolygons->Get_Count() * (Method == 0 ? 1 : pGrids->Get_Grid_Count())];
+
+	if( Method != 0 )
+	{
+		Get_Precise(pGrids, pPolygons, Statistics, Percentiles.Get_N() > 0 || fGINI > 0, bParallelized);
+	}
 
 	//-----------------------------------------------------
 	for(int iGrid=0; iGrid<pGrids->Get_Grid_Count() && Process_Get_Okay(); iGrid++)
 	{
 		Process_Set_Text("[%d/%d] %s", 1 + iGrid, pGrids->Get_Grid_Count(), pGrids->Get_Grid(iGrid)->Get_Name());
 
-		if( (Method == 0 && Get_Simple (pGrids->Get_Grid(iGrid), pPolygons, Statistics, Percentiles.Get_N() > 0 || fGINI > 0, Index        ))
-		||  (Method != 0 && Get_Precise(pGrids->Get_Grid(iGrid), pPolygons, Statistics, Percentiles.Get_N() > 0 || fGINI > 0, bParallelized)) )
+		CSG_Simple_Statistics	*pStatistics	= Method == 0 ? Statistics : Statistics + iGrid * pPolygons->Get_Count();
+
+		if( Method != 0 || Get_Simple(pGrids->Get_Grid(iGrid), pPolygons, Statistics, Percentiles.Get_N() > 0 || fGINI > 0, Index) )
 		{
 			nFields	= pPolygons->Get_Field_Count();
 
@@ -288,7 +297,7 @@ bool CGrid_Statistics_AddTo_Polygon::On_Execute(void)
 			{
 				CSG_Shape	*pPolygon	= pPolygons->Get_Shape(i);
 
-				if( Statistics[i].Get_Count() == 0 )
+				if( pStatistics[i].Get_Count() == 0 )
 				{
 					if( fCOUNT    >= 0 )	pPolygon->Set_NoData(nFields + fCOUNT );
 					if( fMIN      >= 0 )	pPolygon->Set_NoData(nFields + fMIN   );
@@ -309,20 +318,20 @@ bool CGrid_Statistics_AddTo_Polygon::On_Execute(void)
 				}
 				else
 				{
-					if( fCOUNT    >= 0 )	pPolygon->Set_Value(nFields + fCOUNT , Statistics[i].Get_Count   ());
-					if( fMIN      >= 0 )	pPolygon->Set_Value(nFields + fMIN   , Statistics[i].Get_Minimum ());
-					if( fMAX      >= 0 )	pPolygon->Set_Value(nFields + fMAX   , Statistics[i].Get_Maximum ());
-					if( fRANGE    >= 0 )	pPolygon->Set_Value(nFields + fRANGE , Statistics[i].Get_Range   ());
-					if( fSUM      >= 0 )	pPolygon->Set_Value(nFields + fSUM   , Statistics[i].Get_Sum     ());
-					if( fMEAN     >= 0 )	pPolygon->Set_Value(nFields + fMEAN  , Statistics[i].Get_Mean    ());
-					if( fVAR      >= 0 )	pPolygon->Set_Value(nFields + fVAR   , Statistics[i].Get_Variance());
-					if( fSTDDEV   >= 0 )	pPolygon->Set_Value(nFields + fSTDDEV, Statistics[i].Get_StdDev  ());
-					if( fGINI     >= 0 )	pPolygon->Set_Value(nFields + fGINI  , Statistics[i].Get_Gini    ());
+					if( fCOUNT    >= 0 )	pPolygon->Set_Value(nFields + fCOUNT , pStatistics[i].Get_Count   ());
+					if( fMIN      >= 0 )	pPolygon->Set_Value(nFields + fMIN   , pStatistics[i].Get_Minimum ());
+					if( fMAX      >= 0 )	pPolygon->Set_Value(nFields + fMAX   , pStatistics[i].Get_Maximum ());
+					if( fRANGE    >= 0 )	pPolygon->Set_Value(nFields + fRANGE , pStatistics[i].Get_Range   ());
+					if( fSUM      >= 0 )	pPolygon->Set_Value(nFields + fSUM   , pStatistics[i].Get_Sum     ());
+					if( fMEAN     >= 0 )	pPolygon->Set_Value(nFields + fMEAN  , pStatistics[i].Get_Mean    ());
+					if( fVAR      >= 0 )	pPolygon->Set_Value(nFields + fVAR   , pStatistics[i].Get_Variance());
+					if( fSTDDEV   >= 0 )	pPolygon->Set_Value(nFields + fSTDDEV, pStatistics[i].Get_StdDev  ());
+					if( fGINI     >= 0 )	pPolygon->Set_Value(nFields + fGINI  , pStatistics[i].Get_Gini    ());
 					if( fQUANTILE >= 0 )
 					{
 						for(int iPercentile=0, iField=nFields + fQUANTILE; iPercentile<Percentiles.Get_N(); iPercentile++, iField++)
 						{
-							pPolygon->Set_Value(iField, Statistics[i].Get_Percentile(Percentiles[iPercentile]));
+							pPolygon->Set_Value(iField, pStatistics[i].Get_Percentile(Percentiles[iPercentile]));
 						}
 					}
 				}
@@ -344,23 +353,23 @@ bool CGrid_Statistics_AddTo_Polygon::On_Execute(void)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-bool CGrid_Statistics_AddTo_Polygon::Get_Precise(CSG_Grid *pGrid, CSG_Shapes *pPolygons, CSG_Simple_Statistics *Statistics, bool bHoldValues, bool bParallelized)
+bool CGrid_Statistics_AddTo_Polygon::Get_Precise(CSG_Parameter_Grid_List *pGrids, CSG_Shapes *pPolygons, CSG_Simple_Statistics *Statistics, bool bHoldValues, bool bParallelized)
 {
 	int	Method	= Parameters("METHOD")->asInt();
 
 	if( bParallelized )
 	{
-		#pragma omp parallel for
+		#pragma omp parallel for schedule(dynamic)
 		for(int i=0; i<pPolygons->Get_Count(); i++)
 		{
-			Get_Precise(pGrid, (CSG_Shape_Polygon *)pPolygons->Get_Shape(i), Statistics[i], bHoldValues, Method);
+			Get_Precise(pGrids, (CSG_Shape_Polygon *)pPolygons->Get_Shape(i), Statistics + i, pPolygons->Get_Count(), bHoldValues, Method);
 		}
 	}
 	else
 	{
 		for(int i=0; i<pPolygons->Get_Count() && Set_Progress(i, pPolygons->Get_Count()); i++)
 		{
-			Get_Precise(pGrid, (CSG_Shape_Polygon *)pPolygons->Get_Shape(i), Statistics[i], bHoldValues, Method);
+			Get_Precise(pGrids, (CSG_Shape_Polygon *)pPolygons->Get_Shape(i), Statistics + i, pPolygons->Get_Count(), bHoldValues, Method);
 		}
 	}
 
@@ -368,84 +377,54 @@ bool CGrid_Statistics_AddTo_Polygon::Get_Precise(CSG_Grid *pGrid, CSG_Shapes *pP
 }
 
 //---------------------------------------------------------
-bool CGrid_Statistics_AddTo_Polygon::Get_Precise(CSG_Grid *pGrid, CSG_Shape_Polygon *pPolygon, CSG_Simple_Statistics &Statistics, bool bHoldValues, int Method)
+// Statistics points to the polygon's statistics for the
+// first grid, those for the following grids are found at
+// multiples of nPolygons.
+//---------------------------------------------------------
+bool CGrid_Statistics_AddTo_Polygon::Get_Precise(CSG_Parameter_Grid_List *pGrids, CSG_Shape_Polygon *pPolygon, CSG_Simple_Statistics *Statistics, int nPolygons, bool bHoldValues, int Method)
 {
-	//-----------------------------------------------------
-	CSG_Shapes	Intersect(SHAPE_TYPE_Polygon);
+	for(int iGrid=0; iGrid<pGrids->Get_Grid_Count(); iGrid++)
+	{
+		Statistics[iGrid * nPolygons].Create(bHoldValues);
+	}
 
-	CSG_Shape_Polygon	*pCell, *pArea;
+	CSG_Grid_Polygon_Coverage	Coverage(Get_System(), pPolygon);
 
-	if( Method == 3 )	// polygon wise (cell area weighted)
+	if( !Coverage.is_Valid() )
 	{
-		pCell	= (CSG_Shape_Polygon *)Intersect.Add_Shape();
-		pArea	= (CSG_Shape_Polygon *)Intersect.Add_Shape();
+		return( false );
 	}
 
 	//-----------------------------------------------------
-	Statistics.Create(bHoldValues);
-
-	int	ax	= Get_System().Get_xWorld_to_Grid(pPolygon->Get_Extent().Get_XMin()) - 1;	if( ax < 0         )	ax	= 0;
-	int	bx	= Get_System().Get_xWorld_to_Grid(pPolygon->Get_Extent().Get_XMax()) + 1;	if( bx >= Get_NX() )	bx	= Get_NX() - 1;
-	int	ay	= Get_System().Get_yWorld_to_Grid(pPolygon->Get_Extent().Get_YMin()) - 1;	if( ay < 0         )	ay	= 0;
-	int	by	= Get_System().Get_yWorld_to_Grid(pPolygon->Get_Extent().Get_YMax()) + 1;	if( by >= Get_NY() )	by	= Get_NY() - 1;
+	CSG_Vector	Row(Coverage.Get_NX());
 
-	TSG_Point	Center;
-	TSG_Rect	Cell;
-
-	//-----------------------------------------------------
-	Center.y	= Get_System().Get_yGrid_to_World(ay);
-	Cell.yMin	= Center.y - 0.5 * Get_Cellsize();
-	Cell.yMax	= Cell.yMin + Get_Cellsize();
-		
-	for(int y=ay; y<=by; y++, Center.y+=Get_Cellsize(), Cell.yMin+=Get_Cellsize(), Cell.yMax+=Get_Cellsize())
+	for(int y=Coverage.Get_yMin(); y<=Coverage.Get_yMax(); y++)
 	{
-		Center.x	= Get_System().Get_xGrid_to_World(ax);
-		Cell.xMin	= Center.x - 0.5 * Get_Cellsize();
-		Cell.xMax	= Cell.xMin + Get_Cellsize();
+		Coverage.Get_Row(y, Row.Get_Data(), Method == 1);
 
-		for(int x=ax; x<=bx; x++, Center.x+=Get_Cellsize(), Cell.xMin+=Get_Cellsize(), Cell.xMax+=Get_Cellsize())
+		for(int x=Coverage.Get_xMin(), i=0; x<=Coverage.Get_xMax(); x++, i++)
 		{
-			if( !pGrid->is_NoData(x, y) )
+			if( Row[i] <= 0. )
 			{
-				switch( Method )
-				{
-				//-----------------------------------------
-				default:	// polygon wise (cell centers)
-					if( pPolygon->Contains(Center) )
-					{
-						Statistics	+= pGrid->asDouble(x, y);
-					}
-					break;
+				continue;
+			}
 
-				//-----------------------------------------
-				case  2:	// polygon wise (cell area)
-					if( pPolygon->Intersects(Cell) )
-					{
-						Statistics	+= pGrid->asDouble(x, y);
-					}
-					break;
+			for(int iGrid=0; iGrid<pGrids->Get_Grid_Count(); iGrid++)
+			{
+				CSG_Grid	*pGrid	= pGrids->Get_Grid(iGrid);
 
-				//-----------------------------------------
-				case  3:	// polygon wise (cell area weighted)
-					switch( pPolygon->Intersects(Cell) )
+				if( !pGrid->is_NoData(x, y) )
+				{
+					switch( Method )
 					{
-					case INTERSECTION_None     :	break;
-					case INTERSECTION_Identical:
-					case INTERSECTION_Contains :	Statistics.Add_Value(pGrid->asDouble(x, y),       Get_Cellarea());	break;
-					case INTERSECTION_Contained:	Statistics.Add_Value(pGrid->asDouble(x, y), pPolygon->Get_Area());	break;
-					case INTERSECTION_Overlaps :
-						pCell->Del_Parts();
-
-						pCell->Add_Point(Cell.xMin, Cell.yMin);	pCell->Add_Point(Cell.xMin, Cell.yMax);
-						pCell->Add_Point(Cell.xMax, Cell.yMax);	pCell->Add_Point(Cell.xMax, Cell.yMin);
+					default:	// polygon wise (cell centers), polygon wise (cell area)
+						Statistics[iGrid * nPolygons]	+= pGrid->asDouble(x, y);
+						break;
 
-						if( SG_Polygon_Intersection(pPolygon, pCell, pArea) )
-						{
-							Statistics.Add_Value(pGrid->asDouble(x, y), pArea->Get_Area());
-						}
+					case  3:	// polygon wise (cell area weighted)
+						Statistics[iGrid * nPolygons].Add_Value(pGrid->asDouble(x, y), Row[i] * Get_Cellarea());
 						break;
 					}
-					break;
 				}
 			}
 		}
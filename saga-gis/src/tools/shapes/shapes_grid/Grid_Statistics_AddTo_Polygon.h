@@ -89,8 +89,8 @@ private:
 	bool					Get_Simple				(CSG_Grid *pGrid, CSG_Shapes *pPolygons, CSG_Simple_Statistics *Statistics, bool bQuantiles, CSG_Grid &Index);
 	bool					Get_Simple_Index		(CSG_Shapes *pPolygons, CSG_Grid &Index);
 
-	bool					Get_Precise				(CSG_Grid *pGrid, CSG_Shapes *pPolygons, CSG_Simple_Statistics *Statistics, bool bQuantiles, bool bParallelized);
-	bool					Get_Precise				(CSG_Grid *pGrid, CSG_Shape_Polygon *pPolygon, CSG_Simple_Statistics &Statistics, bool bQuantiles, int Method);
+	bool					Get_Precise				(CSG_Parameter_Grid_List *pGrids, CSG_Shapes *pPolygons, CSG_Simple_Statistics *Statistics, bool bQuantiles, bool bParallelized);
+	bool					Get_Precise				(CSG_Parameter_Grid_List *pGrids, CSG_Shape_Polygon *pPolygon, CSG_Simple_Statistics *Statistics, int nPolygons, bool bQuantiles, int Method);
 
 };
 
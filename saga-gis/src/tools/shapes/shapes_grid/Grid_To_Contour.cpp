@@ -50,6 +50,8 @@
 //---------------------------------------------------------
 #include "Grid_To_Contour.h"
 
+#include <algorithm>
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -213,40 +215,75 @@ bool CGrid_To_Contour::On_Execute(void)
 	}
 
 	//-----------------------------------------------------
-	m_Edge.Create(SG_DATATYPE_Char, m_pGrid->Get_NX() + 1, m_pGrid->Get_NY() + 1, m_pGrid->Get_Cellsize(), m_pGrid->Get_XMin(), m_pGrid->Get_YMin());
+	m_Levels.Destroy();
 
-	for(double z=zMin; z<=zMax && Set_Progress(z - zMin, zMax - zMin); z+=zStep)
+	for(double z=zMin; z<=zMax; z+=zStep)
 	{
 		if( z >= m_pGrid->Get_Min() && z <= m_pGrid->Get_Max() )
 		{
-			Process_Set_Text("%s: %s", _TL("Contour"), SG_Get_String(z, -2).c_str());
-
-			Get_Contour(z);
+			m_Levels.Add_Row(z);
 		}
 	}
 
+	if( m_Levels.Get_N() < 1 || m_pGrid->Get_NX() < 2 || m_pGrid->Get_NY() < 2 )
+	{
+		return( false );
+	}
+
 	//-----------------------------------------------------
-	if( m_pPolygons && m_pContours->Get_Count() > 0 && Set_Progress(0))
+	// one pass over the grid for all contour levels, tiles of
+	// rows are traced in parallel and joined afterwards
+
+	int nRows = m_pGrid->Get_NY() - 1, nThreads = SG_OMP_Get_Max_Num_Threads();
+
+	int Tile_Size = M_GET_MAX(16, 1 + nRows / (8 * nThreads)), nTiles = 1 + (nRows - 1) / Tile_Size;
+
+	std::vector<std::vector<TChain > > Tiles  (nTiles);
+	std::vector<std::vector<TBorder> > Borders(nTiles);
+
+	Process_Set_Text(_TL("tracing contours"));
+
+	for(int iTile=0; iTile<nTiles && Set_Progress(iTile, nTiles); iTile+=nThreads)
 	{
-		Get_Polygons(NULL, (CSG_Shape_Line *)m_pContours->Get_Shape(0));
+		int jTile = M_GET_MIN(iTile + nThreads, nTiles);
 
-		for(int i=1; i<m_pContours->Get_Count() && Set_Progress(i, m_pContours->Get_Count()); i++)
+		#pragma omp parallel for
+		for(int i=iTile; i<jTile; i++)
 		{
-			Get_Polygons((CSG_Shape_Line *)m_pContours->Get_Shape(i - 1), (CSG_Shape_Line *)m_pContours->Get_Shape(i));
+			Get_Tile(i * Tile_Size, M_GET_MIN((i + 1) * Tile_Size, nRows), Tiles[i], Borders[i]);
 		}
+	}
+
+	if( !Process_Get_Okay() )
+	{
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	std::vector<TChain> Chains;
 
-		if( Set_Progress(100) )
+	Get_Chains(Tiles, Chains);
+
+	Set_Contours(Chains);
+
+	if( m_pPolygons )
+	{
+		Process_Set_Text(_TL("polygons"));
+
+		for(int i=1; i<nTiles; i++)
 		{
-			Get_Polygons((CSG_Shape_Line *)m_pContours->Get_Shape(m_pContours->Get_Count() - 1), NULL);
+			Borders[0].insert(Borders[0].end(), Borders[i].begin(), Borders[i].end()); std::vector<TBorder>().swap(Borders[i]);
 		}
 
+		Set_Polygons(Chains, Borders[0]);
+
 		if( Parameters("POLY_PARTS")->asBool() )
 		{
 			Split_Polygon_Parts(m_pPolygons);
 		}
 	}
 
-	m_Edge.Destroy();
+	m_Levels.Destroy();
 
 	//-----------------------------------------------------
 	return( m_pContours->Get_Count() > 0 );
@@ -258,109 +295,83 @@ bool CGrid_To_Contour::On_Execute(void)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-#define EDGE_ROW	0x01
-#define EDGE_COL	0x02
+// Contour lines are traced with marching squares on the dual
+// cells of the grid, i.e. cells spanned by four neighbouring
+// grid nodes. A crossing is identified by the edge it lies on
+// (two edges per node, 2 * n for the edge to the right, 2 * n + 1
+// for the edge above) and by the contour level. Segments are
+// oriented with higher values on the left side, so that each
+// crossing is the end of exactly one and the start of exactly
+// one other segment, which lets us join segments just by
+// matching their start and end keys.
+//
+// Filled contours are built from the same segments. The polygon
+// for the band between two levels is bounded by the lower level
+// contour (higher values on the left), by the reversed upper
+// level contour, and by pieces of the data border. Border pieces
+// are keyed in the band's own key space: 4 * edge + 2 * (0 for
+// the lower, 1 for the upper level crossing) or 2 * node + 1.
 
 //---------------------------------------------------------
-inline bool CGrid_To_Contour::is_Edge(int x, int y)
-{
-	return(  m_pGrid->is_InGrid(x    , y    )
-		&& (!m_pGrid->is_InGrid(x - 1, y - 1)
-		||  !m_pGrid->is_InGrid(x    , y - 1)
-		||  !m_pGrid->is_InGrid(x + 1, y - 1)
-		||  !m_pGrid->is_InGrid(x + 1, y    )
-		||  !m_pGrid->is_InGrid(x + 1, y + 1)
-		||  !m_pGrid->is_InGrid(x    , y + 1)
-		||  !m_pGrid->is_InGrid(x - 1, y + 1)
-		||  !m_pGrid->is_InGrid(x - 1, y    ) )
-	);
-}
+#define BAND_NODATA	(-2)
 
 //---------------------------------------------------------
-inline void CGrid_To_Contour::Set_Row(int x, int y, bool bOn)
+inline int CGrid_To_Contour::Get_Band(double z)	const
 {
-	int	Edge	= m_Edge.asInt(x, y);
+	int a = 0, b = m_Levels.Get_N();	// a: number of levels <= z
 
-	m_Edge.Set_Value(x, y, bOn ? (Edge | EDGE_ROW) : (Edge & EDGE_COL));
-}
+	while( a < b )
+	{
+		int i = (a + b) / 2;
 
-inline bool CGrid_To_Contour::Get_Row(int x, int y)
-{
-	return( (m_Edge.asInt(x, y) & EDGE_ROW) != 0 );
+		if( m_Levels(i) <= z ) { a = i + 1; } else { b = i; }
+	}
+
+	return( a - 1 );
 }
 
 //---------------------------------------------------------
-inline void CGrid_To_Contour::Set_Col(int x, int y, bool bOn)
+inline TSG_Point_Z CGrid_To_Contour::Get_Crossing(sLong Edge, int Level)	const
 {
-	int	Edge	= m_Edge.asInt(x, y);
+	sLong n = Edge / 2; int x = (int)(n % m_pGrid->Get_NX()), y = (int)(n / m_pGrid->Get_NX());
 
-	m_Edge.Set_Value(x, y, bOn ? (Edge | EDGE_COL) : (Edge & EDGE_ROW));
-}
+	int zx = Edge % 2 ? x : x + 1;
+	int zy = Edge % 2 ? y + 1 : y;
 
-inline bool CGrid_To_Contour::Get_Col(int x, int y)
-{
-	return( (m_Edge.asInt(x, y) & EDGE_COL) != 0 );
-}
+	double z = m_Levels(Level), d = m_pGrid->asDouble(x, y); d = (d - z) / (d - m_pGrid->asDouble(zx, zy));
 
+	TSG_Point_Z	p;
 
-///////////////////////////////////////////////////////////
-//														 //
-///////////////////////////////////////////////////////////
+	p.x = m_pGrid->Get_XMin() + m_pGrid->Get_Cellsize() * (x + d * (zx - x));
+	p.y = m_pGrid->Get_YMin() + m_pGrid->Get_Cellsize() * (y + d * (zy - y));
+	p.z = z;
+
+	return( p );
+}
 
 //---------------------------------------------------------
-bool CGrid_To_Contour::Get_Contour(double z)
+inline TSG_Point_Z CGrid_To_Contour::Get_Node(sLong Node)	const
 {
-	#pragma omp parallel for
-	for(int y=0; y<m_pGrid->Get_NY(); y++)	// Find Border Cells
-	{
-		for(int x=0; x<m_pGrid->Get_NX(); x++)
-		{
-			if( !m_pGrid->is_NoData(x, y) )
-			{
-				if( m_pGrid->asDouble(x, y) >= z )
-				{
-					if( m_pGrid->is_InGrid(x + 1, y    ) && m_pGrid->asDouble(x + 1, y    ) <  z ) Set_Row(x, y, true);
-					if( m_pGrid->is_InGrid(x    , y + 1) && m_pGrid->asDouble(x    , y + 1) <  z ) Set_Col(x, y, true);
-				}
-				else // if( m_pGrid->asDouble(x, y) < z )
-				{
-					if( m_pGrid->is_InGrid(x + 1, y    ) && m_pGrid->asDouble(x + 1, y    ) >= z ) Set_Row(x, y, true);
-					if( m_pGrid->is_InGrid(x    , y + 1) && m_pGrid->asDouble(x    , y + 1) >= z ) Set_Col(x, y, true);
-				}
-			}
-		}
- 	}
+	int x = (int)(Node % m_pGrid->Get_NX()), y = (int)(Node / m_pGrid->Get_NX());
 
-	//-----------------------------------------------------
-	if( m_bParts == false )
-	{
-		CSG_Shape *pContour = m_pContours->Add_Shape();
+	TSG_Point_Z	p;
 
-		pContour->Set_Value(0, m_pContours->Get_Count());
-		pContour->Set_Value(1, z);
-	}
+	p.x = m_pGrid->Get_XMin() + m_pGrid->Get_Cellsize() * x;
+	p.y = m_pGrid->Get_YMin() + m_pGrid->Get_Cellsize() * y;
+	p.z = m_pGrid->asDouble(x, y);
 
-	for(int y=0; y<m_pGrid->Get_NY(); y++)	// find unclosed contours first so that these start/end at edges and not somewhere else
-	{
-		for(int x=0; x<m_pGrid->Get_NX(); x++)
-		{
-			if( m_Edge.asInt(x, y) && is_Edge(x, y) )
-			{
-				Get_Contour(z, x, y);
-			}
-		}
-	}
+	return( p );
+}
 
-	for(int y=0; y<m_pGrid->Get_NY(); y++)
+//---------------------------------------------------------
+inline void CGrid_To_Contour::Add_Point(CSG_Shape *pShape, int iPart, const TSG_Point_Z &Point)
+{
+	int n = pShape->Get_Point_Count(iPart);
+
+	if( n < 1 || !CSG_Point(pShape->Get_Point(n - 1, iPart)).is_Equal(Point.x, Point.y) )
 	{
-		for(int x=0; x<m_pGrid->Get_NX(); x++)
-		{
-			while( Get_Contour(z, x, y) );
-		}
+		pShape->Add_Point(Point, iPart);
 	}
-
-	//-----------------------------------------------------
-	return( true );
 }
 
 
@@ -369,117 +380,95 @@ bool CGrid_To_Contour::Get_Contour(double z)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-bool CGrid_To_Contour::Get_Contour(double z, int x, int y)
+class CContour_Key_Compare
 {
-	bool	bRow;
+public:
+	CContour_Key_Compare(const std::vector<sLong> &Keys) : m_Keys(Keys) {}
 
-	if( Get_Row(x, y) )
+	bool			operator ()		(int a, int b)	const
 	{
-		bRow	= true;
-	}
-	else if( Get_Col(x, y) )
-	{
-		bRow	= false;
-	}
-	else
-	{
-		return( false );
+		return( m_Keys[a] < m_Keys[b] || (m_Keys[a] == m_Keys[b] && a < b) );
 	}
 
-	//-----------------------------------------------------
-	CSG_Shape *pContour;
 
-	if( m_bParts )
-	{
-		pContour = m_pContours->Add_Shape();
+private:
 
-		pContour->Set_Value(0, m_pContours->Get_Count());
-		pContour->Set_Value(1, z);
-	}
-	else
-	{
-		pContour = m_pContours->Get_Shape(m_pContours->Get_Count() - 1);
-	}
+	const std::vector<sLong>	&m_Keys;
 
-	int iPart = m_bParts ? 0 : pContour->Get_Part_Count();
+};
 
-	//-----------------------------------------------------
-	for(int Dir=0, x0=x, y0=y, bRow0=bRow?1:0; Dir>=0; )
+//---------------------------------------------------------
+inline int Get_Key_Position(const std::vector<int> &Index, const std::vector<sLong> &Keys, sLong Key)
+{
+	int a = 0, b = (int)Index.size();
+
+	while( a < b )
 	{
-		int zx = bRow ? x + 1 : x;
-		int zy = bRow ? y : y + 1;
+		int i = (a + b) / 2;
 
-		double d = m_pGrid->asDouble(x, y); d = (d - z) / (d - m_pGrid->asDouble(zx, zy));
+		if( Keys[Index[i]] < Key ) { a = i + 1; } else { b = i; }
+	}
 
-		pContour->Add_Point(
-			m_pGrid->Get_XMin() + m_pGrid->Get_Cellsize() * (x + d * (zx - x)),
-			m_pGrid->Get_YMin() + m_pGrid->Get_Cellsize() * (y + d * (zy - y)), iPart
-		);
+	return( a );
+}
 
-		if( pContour->Get_Vertex_Type() != SG_VERTEX_TYPE_XY )
-		{
-			pContour->Set_Z(z, pContour->Get_Point_Count(iPart) - 1, iPart);
-		}
+//---------------------------------------------------------
+// Links pieces with matching last and first keys to chains.
+// Order receives the piece indices chain by chain, Start the
+// offset of each chain in Order (plus a final end offset).
+// Open chains come first, closed rings follow.
+//---------------------------------------------------------
+void CGrid_To_Contour::Get_Links(const std::vector<sLong> &First, const std::vector<sLong> &Last, std::vector<int> &Order, std::vector<int> &Start)
+{
+	int n = (int)First.size();
 
-		if( Get_Contour_Cell(Dir, x, y, bRow) || Get_Contour_Cell(Dir, x, y, bRow) )
-		{
-			if( bRow  )	{ Set_Row(x , y , false); } else { Set_Col(x , y , false); }
-		}
-		else
-		{
-			if( bRow0 )	{ Set_Row(x0, y0, false); } else { Set_Col(x0, y0, false); }
+	std::vector<int> Index(n); for(int i=0; i<n; i++) { Index[i] = i; }
 
-			Dir	= -1;
-		}
-	}
+	std::sort(Index.begin(), Index.end(), CContour_Key_Compare(First));
 
 	//-----------------------------------------------------
-	return( pContour->Get_Point_Count(iPart) > 1 );
-}
+	std::vector<bool> bPrevious(n, false), bDone(n, false);
 
-//---------------------------------------------------------
-inline bool CGrid_To_Contour::Get_Contour_Cell(int &Dir, int &x, int &y, bool &bRow)
-{
-	if( bRow )
+	for(int i=0; i<n; i++)
 	{
-		switch( Dir )
+		for(int j=Get_Key_Position(Index, First, Last[i]); j<n && First[Index[j]] == Last[i]; j++)
 		{
-		case  0: if( Get_Row(x    , y + 1) ) { Dir = 5;                    y++; return( true ); }	// Norden
-		case  1: if( Get_Col(x + 1, y    ) ) { Dir = 6; bRow = false; x++;      return( true ); }	// Nord-Ost
-		case  2:	// Osten ist nicht...
-		case  3: if( y - 1 >= 0
-				 &&  Get_Col(x + 1, y - 1) ) { Dir = 0; bRow = false; x++; y--; return( true ); }	// Sued-Ost
-		case  4: if( y - 1 >= 0
-				 &&  Get_Row(x    , y - 1) ) { Dir = 1;                    y--; return( true ); }	// Sueden
-		case  5: if( y - 1 >= 0
-				 &&  Get_Col(x    , y - 1) ) { Dir = 2; bRow = false;      y--; return( true ); }	// Sued-West
-		case  6:	// Westen ist nicht...
-		case  7: if( Get_Col(x    , y    ) ) { Dir = 4; bRow = false;           return( true ); }	// Nord-West
-		default:
-			Dir = 0;
+			bPrevious[Index[j]] = true;
 		}
 	}
-	else
+
+	//-----------------------------------------------------
+	Order.clear(); Order.reserve(n); Start.clear();
+
+	for(int Pass=0; Pass<2; Pass++)	// first open chains, then rings
 	{
-		switch( Dir )
+		for(int i=0; i<n; i++)
 		{
-		case  0:	// Norden ist nicht...
-		case  1: if( Get_Row(x    , y + 1) ) { Dir = 6; bRow =  true;      y++; return( true ); }	// Nord-Ost
-		case  2: if( Get_Col(x + 1, y    ) ) { Dir = 7;               x++;      return( true ); }	// Osten
-		case  3: if( Get_Row(x    , y    ) ) { Dir = 0; bRow =  true;           return( true ); }	// Sued-Ost
-		case  4:	// Sueden ist nicht...
-		case  5: if( x - 1 >= 0
-				 &&  Get_Row(x - 1, y    ) ) { Dir = 2; bRow =  true; x--;      return( true ); }	// Sued-West
-		case  6: if( x - 1 >= 0
-				 &&  Get_Col(x - 1, y    ) ) { Dir = 3;               x--;      return( true ); }	// Westen
-		case  7: if( x - 1 >= 0
-				 &&  Get_Row(x - 1, y + 1) ) { Dir = 5; bRow =  true; x--; y++; return( true ); }	// Nord-West
-		default:
-			Dir = 0;
+			if( !bDone[i] && (Pass == 1 || !bPrevious[i]) )
+			{
+				Start.push_back((int)Order.size());
+
+				for(int j=i; j>=0; )
+				{
+					bDone[j] = true; Order.push_back(j);
+
+					int Next = -1;
+
+					for(int k=Get_Key_Position(Index, First, Last[j]); Next<0 && k<n && First[Index[k]] == Last[j]; k++)
+					{
+						if( !bDone[Index[k]] )
+						{
+							Next = Index[k];
+						}
+					}
+
+					j = Next;
+				}
+			}
 		}
 	}
 
-	return( false );
+	Start.push_back((int)Order.size());
 }
 
 
@@ -488,275 +477,426 @@ inline bool CGrid_To_Contour::Get_Contour_Cell(int &Dir, int &x, int &y, bool &b
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-#define EDGE_LINE		1
-#define EDGE_NODE_ONE	2
-#define EDGE_NODE_TWO	3
+void CGrid_To_Contour::Add_Border(std::vector<TBorder> &Borders, sLong Edge, sLong Node_A, int Band_A, sLong Node_B, int Band_B)
+{
+	TBorder Border; Border.Band = Band_A; Border.First = 2 * Node_A + 1;
+
+	for( ; Border.Band<Band_B; Border.Band++)	// ascending, leave band at upper level crossing
+	{
+		Border.Last  = 4 * Edge + 2; Borders.push_back(Border);
+		Border.First = 4 * Edge    ;
+	}
+
+	for( ; Border.Band>Band_B; Border.Band--)	// descending, leave band at lower level crossing
+	{
+		Border.Last  = 4 * Edge    ; Borders.push_back(Border);
+		Border.First = 4 * Edge + 2;
+	}
+
+	Border.Last = 2 * Node_B + 1; Borders.push_back(Border);
+}
 
 //---------------------------------------------------------
-bool CGrid_To_Contour::Get_Polygons(CSG_Shape_Line *pContour_Lo, CSG_Shape_Line *pContour_Hi)
+bool CGrid_To_Contour::Get_Tile(int yMin, int yMax, std::vector<TChain> &Chains, std::vector<TBorder> &Borders)
 {
-	double zMin = pContour_Lo ? pContour_Lo->asDouble(1) : m_pGrid->Get_Min();
-	double zMax = pContour_Hi ? pContour_Hi->asDouble(1) : m_pGrid->Get_Max();
+	static const int	dx[4] = { 0, 1, 1, 0 }, nx_Side[4] = { 0, 1, 0, -1 };
+	static const int	dy[4] = { 0, 0, 1, 1 }, ny_Side[4] = { -1, 0, 1, 0 };
 
-	#pragma omp parallel for
-	for(int y=0; y<m_pGrid->Get_NY(); y++)
+	int nx = m_pGrid->Get_NX(), ny = m_pGrid->Get_NY(), nLevels = m_Levels.Get_N();
+
+	//-----------------------------------------------------
+	// level bands of the tile's nodes, including the rows needed to check neighbouring cells
+
+	int yA = yMin > 0 ? yMin - 1 : 0, yB = yMax + 1 < ny ? yMax + 1 : ny - 1;
+
+	CSG_Array_Int Band((sLong)(yB - yA + 1) * nx); int *pBand = Band.Get_Array();
+
+	for(int y=yA; y<=yB; y++)
 	{
-		for(int x=0; x<m_pGrid->Get_NX(); x++)
+		for(int x=0; x<nx; x++, pBand++)
 		{
-			m_Edge.Set_Value(x, y, is_Edge(x, y) && zMin <= m_pGrid->asDouble(x, y) && m_pGrid->asDouble(x, y) <= zMax ? EDGE_LINE : 0);
+			*pBand = m_pGrid->is_NoData(x, y) ? BAND_NODATA : Get_Band(m_pGrid->asDouble(x, y));
 		}
 	}
 
-	//-----------------------------------------------------
-	CSG_Shape_Polygon *pPolygon = (CSG_Shape_Polygon *)m_pPolygons->Add_Shape();
+	pBand = Band.Get_Array();
 
-	pPolygon->Set_Value(0, m_pPolygons->Get_Count());
-	pPolygon->Set_Value(1, zMin);
-	pPolygon->Set_Value(2, zMax);
-	pPolygon->Set_Value(3, SG_Get_String(zMin) + " - " + SG_Get_String(zMax));
+	#define GET_BAND(x, y)	pBand[(sLong)((y) - yA) * nx + (x)]
 
-	//-----------------------------------------------------
-	CSG_Shapes	Segments(SHAPE_TYPE_Line);
-
-	Segments.Add_Field("x0", SG_DATATYPE_Int);
-	Segments.Add_Field("y0", SG_DATATYPE_Int);
-	Segments.Add_Field("x1", SG_DATATYPE_Int);
-	Segments.Add_Field("y1", SG_DATATYPE_Int);
-	
-	if( pContour_Lo ) { Add_Contour(Segments, pPolygon, pContour_Lo); }
-	if( pContour_Hi ) { Add_Contour(Segments, pPolygon, pContour_Hi); }
+	#define IS_CELL(x, y)	((x) >= 0 && (x) < nx - 1 && (y) >= 0 && (y) < ny - 1\
+		&& GET_BAND((x), (y)    ) != BAND_NODATA && GET_BAND((x) + 1, (y)    ) != BAND_NODATA\
+		&& GET_BAND((x), (y) + 1) != BAND_NODATA && GET_BAND((x) + 1, (y) + 1) != BAND_NODATA)
 
 	//-----------------------------------------------------
-	if( Segments.Get_Count() == 0 )	// no edge crossing line
+	std::vector<sLong> First, Last;
+
+	for(int y=yMin; y<yMax; y++)
 	{
-		for(int y=0; y<m_pGrid->Get_NY(); y++)
+		for(int x=0; x<nx-1; x++)
 		{
-			for(int x=0; x<m_pGrid->Get_NX(); x++)
+			if( !IS_CELL(x, y) )
 			{
-				if( m_Edge.asInt(x, y) == EDGE_LINE )	// add outer ring
+				continue;
+			}
+
+			int b[4]; sLong n[4], e[4];	// corners counter-clockwise from lower left, sides bottom, right, top, left
+
+			for(int k=0; k<4; k++)
+			{
+				b[k] = GET_BAND(x + dx[k], y + dy[k]); n[k] = (sLong)(y + dy[k]) * nx + x + dx[k];
+			}
+
+			e[0] = 2 * n[0]; e[1] = 2 * n[1] + 1; e[2] = 2 * n[3]; e[3] = 2 * n[0] + 1;
+
+			//---------------------------------------------
+			int bMin = M_GET_MIN(M_GET_MIN(b[0], b[1]), M_GET_MIN(b[2], b[3]));
+			int bMax = M_GET_MAX(M_GET_MAX(b[0], b[1]), M_GET_MAX(b[2], b[3]));
+
+			for(int Level=bMin+1, bCenter=BAND_NODATA; Level<=bMax; Level++)
+			{
+				int nCrossings = 0, Side[4]; bool bExit[4];
+
+				for(int k=0; k<4; k++)
 				{
-					Add_Edge(Segments, x, y);
+					bool bAbove = b[k] >= Level;
 
-					if( Segments.Get_Count() )
+					if( bAbove != (b[(k + 1) % 4] >= Level) )
 					{
-						pPolygon->Add_Part(((CSG_Shape_Polygon *)Segments.Get_Shape(0))->Get_Part(0));
+						Side[nCrossings] = k; bExit[nCrossings++] = bAbove;
+					}
+				}
+
+				if( nCrossings == 2 )
+				{
+					int i = bExit[0] ? 0 : 1;
 
-						Segments.Del_Shapes();
+					First.push_back(e[Side[i    ]] * nLevels + Level);
+					Last .push_back(e[Side[1 - i]] * nLevels + Level);
+				}
+				else // saddle, decide by cell center value
+				{
+					if( bCenter == BAND_NODATA )
+					{
+						bCenter = Get_Band(0.25 * (
+							m_pGrid->asDouble(x, y    ) + m_pGrid->asDouble(x + 1, y    ) +
+							m_pGrid->asDouble(x, y + 1) + m_pGrid->asDouble(x + 1, y + 1)
+						));
+					}
+
+					int Step = bCenter >= Level ? 1 : 3;
+
+					for(int i=0; i<4; i++)
+					{
+						if( bExit[i] )
+						{
+							First.push_back(e[Side[i           ]] * nLevels + Level);
+							Last .push_back(e[Side[(i + Step) % 4]] * nLevels + Level);
+						}
 					}
 				}
 			}
-		}
-
-		return( true );
-	}
 
-	//-----------------------------------------------------
-//	{	CSG_Grid *pGrid	= SG_Create_Grid(m_Edge); pGrid->Set_NoData_Value(0); DataObject_Add(pGrid);	}
-	for(int y=0; y<m_pGrid->Get_NY(); y++)
-	{
-		for(int x=0; x<m_pGrid->Get_NX(); x++)
-		{
-			if( m_Edge.asInt(x, y) == EDGE_NODE_ONE )
+			//---------------------------------------------
+			if( m_pPolygons )
 			{
-				Add_Edge(Segments, x, y);
+				for(int k=0; k<4; k++)
+				{
+					if( !IS_CELL(x + nx_Side[k], y + ny_Side[k]) )
+					{
+						Add_Border(Borders, e[k], n[k], b[k], n[(k + 1) % 4], b[(k + 1) % 4]);
+					}
+				}
 			}
 		}
 	}
-//	DataObject_Add(SG_Create_Shapes(Segments));
+
+	#undef GET_BAND
+	#undef IS_CELL
 
 	//-----------------------------------------------------
-	while( Segments.Get_Count() > 0 )
-	{
-		int iPart = pPolygon->Get_Part_Count();
+	std::vector<int> Order, Start;
 
-		CSG_Shape *pSegment = Segments.Get_Shape(0);
+	Get_Links(First, Last, Order, Start);
 
-		int x = pSegment->asInt(2);
-		int y = pSegment->asInt(3);
+	Chains.resize(Start.size() - 1);
 
-		bool bAscending = true;
+	for(size_t i=0; i<Chains.size(); i++)
+	{
+		Chains[i].reserve(1 + Start[i + 1] - Start[i]);
 
-		do
-		{
-			Add_Segment(pPolygon, iPart, pSegment, bAscending);
-		}
-		while( (pSegment = Get_Segment(Segments, x, y, bAscending)) != NULL );
+		Chains[i].push_back(First[Order[Start[i]]]);
 
-		if( pPolygon->Get_Point_Count(iPart) < 3 )
+		for(int j=Start[i]; j<Start[i + 1]; j++)
 		{
-			pPolygon->Del_Part(iPart);
+			Chains[i].push_back(Last[Order[j]]);
 		}
 	}
 
-	//-----------------------------------------------------
 	return( true );
 }
 
 //---------------------------------------------------------
-bool CGrid_To_Contour::Add_Contour(CSG_Shapes &Segments, CSG_Shape_Polygon *pPolygon, CSG_Shape_Line *pContour)
+bool CGrid_To_Contour::Get_Chains(std::vector<std::vector<TChain> > &Tiles, std::vector<TChain> &Chains)
 {
-	for(int iPart=0, x, y; iPart<pContour->Get_Part_Count(); iPart++)
-	{
-		CSG_Shape_Part *pPart = pContour->Get_Part(iPart);
+	std::vector<TChain *> Pieces; std::vector<sLong> First, Last;
 
-		if( !CSG_Point(pPart->Get_Point(0, true)).is_Equal(pPart->Get_Point(0, false)) )	// island
+	for(size_t iTile=0; iTile<Tiles.size(); iTile++)
+	{
+		for(size_t i=0; i<Tiles[iTile].size(); i++)
 		{
-			CSG_Shape *pSegment = Segments.Add_Shape();	pSegment->Add_Part(pPart);
+			TChain &Piece = Tiles[iTile][i];
 
-			m_Edge.Get_System().Get_World_to_Grid(x, y, pPart->Get_Point(0,  true));
-			m_Edge.Set_Value(x, y, m_Edge.asInt(x, y) == EDGE_NODE_ONE ? EDGE_NODE_TWO : EDGE_NODE_ONE);
-			pSegment->Set_Value(0, x);
-			pSegment->Set_Value(1, y);
-
-			m_Edge.Get_System().Get_World_to_Grid(x, y, pPart->Get_Point(0, false));
-			m_Edge.Set_Value(x, y, m_Edge.asInt(x, y) == EDGE_NODE_ONE ? EDGE_NODE_TWO : EDGE_NODE_ONE);
-			pSegment->Set_Value(2, x);
-			pSegment->Set_Value(3, y);
+			Pieces.push_back(&Piece); First.push_back(Piece.front()); Last.push_back(Piece.back());
 		}
-		else if( pPart->Get_Count() >= 3 )
+	}
+
+	//-----------------------------------------------------
+	std::vector<int> Order, Start;
+
+	Get_Links(First, Last, Order, Start);
+
+	Chains.resize(Start.size() - 1);
+
+	for(size_t i=0; i<Chains.size(); i++)
+	{
+		for(int j=Start[i]; j<Start[i + 1]; j++)
 		{
-			pPolygon->Add_Part(pPart);
+			TChain &Piece = *Pieces[Order[j]];
+
+			Chains[i].insert(Chains[i].end(), Piece.begin() + (j > Start[i] ? 1 : 0), Piece.end());
+
+			TChain().swap(Piece);
 		}
 	}
 
-	//-----------------------------------------------------
 	return( true );
 }
 
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
 //---------------------------------------------------------
-bool CGrid_To_Contour::Add_Edge(CSG_Shapes &Segments, int x, int y)
+bool CGrid_To_Contour::Get_Level_Chains(const std::vector<TChain> &Chains, std::vector<int> &Index, std::vector<int> &Start)
 {
-	CSG_Shape *pSegment = NULL;
+	int nLevels = m_Levels.Get_N();
 
-	for(int i=0; i<8 && !pSegment; i+=2)
+	Start.assign(nLevels + 1, 0);
+
+	for(size_t i=0; i<Chains.size(); i++)
 	{
-		int ix = CSG_Grid_System::Get_xTo(i, x);
-		int iy = CSG_Grid_System::Get_yTo(i, y);
+		Start[1 + (int)(Chains[i].front() % nLevels)]++;
+	}
 
-		if( m_Edge.is_InGrid(ix, iy) && m_Edge.asInt(ix, iy) == EDGE_LINE )
-		{
-			pSegment = Segments.Add_Shape();
+	for(int i=0; i<nLevels; i++)
+	{
+		Start[i + 1] += Start[i];
+	}
 
-			pSegment->Set_Value(0, x);
-			pSegment->Set_Value(1, y);
+	Index.resize(Chains.size()); std::vector<int> n(Start.begin(), Start.end() - 1);
 
-			x = ix; y = iy;
-		}
+	for(size_t i=0; i<Chains.size(); i++)	// keeps the order, i.e. open contours first
+	{
+		Index[n[Chains[i].front() % nLevels]++] = (int)i;
 	}
 
-	if( !pSegment )
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CGrid_To_Contour::Set_Contours(const std::vector<TChain> &Chains)
+{
+	int nLevels = m_Levels.Get_N();
+
+	std::vector<int> Index, Start;
+
+	Get_Level_Chains(Chains, Index, Start);
+
+	//-----------------------------------------------------
+	for(int Level=0; Level<nLevels; Level++)
 	{
-		for(int i=0; i<8 && !pSegment; i+=2)
+		CSG_Shape *pContour = NULL;
+
+		for(int i=Start[Level]; i<Start[Level + 1] || (!m_bParts && !pContour); i++)
 		{
-			int ix = CSG_Grid_System::Get_xTo(i, x);
-			int iy = CSG_Grid_System::Get_yTo(i, y);
+			if( m_bParts || !pContour )
+			{
+				pContour = m_pContours->Add_Shape();
 
-			if( m_Edge.is_InGrid(ix, iy) && m_Edge.asInt(ix, iy) == EDGE_NODE_ONE )
+				pContour->Set_Value(0, m_pContours->Get_Count());
+				pContour->Set_Value(1, m_Levels(Level));
+			}
+
+			if( i >= Start[Level + 1] )	// level without any contour line
 			{
-				pSegment = Segments.Add_Shape();
+				break;
+			}
+
+			//---------------------------------------------
+			const TChain &Chain = Chains[Index[i]]; int iPart = m_bParts ? 0 : pContour->Get_Part_Count();
 
-				pSegment->Set_Value(0,  x);
-				pSegment->Set_Value(1,  y);
-				pSegment->Set_Value(2, ix);
-				pSegment->Set_Value(3, iy);
+			for(size_t j=0; j<Chain.size(); j++)
+			{
+				Add_Point(pContour, iPart, Get_Crossing(Chain[j] / nLevels, Level));
 			}
-		}
 
-		return( pSegment != NULL );
+			if( pContour->Get_Point_Count(iPart) < 2 )
+			{
+				if( m_bParts )
+				{
+					m_pContours->Del_Shape(pContour);
+				}
+				else
+				{
+					pContour->Del_Part(iPart);
+				}
+			}
+		}
 	}
 
 	//-----------------------------------------------------
-	int iLast = -1;
+	return( true );
+}
 
-	for(bool bNext=true; bNext; )
-	{
-		bNext = false;
+//---------------------------------------------------------
+bool CGrid_To_Contour::Set_Polygons(const std::vector<TChain> &Chains, const std::vector<TBorder> &Borders)
+{
+	int nLevels = m_Levels.Get_N();
 
-		m_Edge.Set_Value(x, y, 0);
+	std::vector<int> Index, Start;
 
-		for(int i=0; i<8 && !bNext; i+=2)
-		{
-			int ix = CSG_Grid_System::Get_xTo(i, x);
-			int iy = CSG_Grid_System::Get_yTo(i, y);
+	Get_Level_Chains(Chains, Index, Start);
 
-			if( m_Edge.is_InGrid(ix, iy) && m_Edge.asInt(ix, iy) == EDGE_LINE )
-			{
-				bNext = true;
+	//-----------------------------------------------------
+	std::vector<int> Border_Index(Borders.size()), Border_Start(nLevels + 2, 0);
 
-				if( i != iLast )
-				{
-					iLast = i;
+	for(size_t i=0; i<Borders.size(); i++)
+	{
+		Border_Start[2 + Borders[i].Band]++;
+	}
 
-					pSegment->Add_Point(m_Edge.Get_System().Get_Grid_to_World(x, y));
-				}
+	for(int i=0; i<=nLevels; i++)
+	{
+		Border_Start[i + 1] += Border_Start[i];
+	}
 
-				x = ix; y = iy;
-			}
+	{
+		std::vector<int> n(Border_Start.begin(), Border_Start.end() - 1);
+
+		for(size_t i=0; i<Borders.size(); i++)
+		{
+			Border_Index[n[1 + Borders[i].Band]++] = (int)i;
 		}
 	}
 
 	//-----------------------------------------------------
-	pSegment->Add_Point(m_Edge.Get_System().Get_Grid_to_World(x, y));
-
-	for(int i=0; i<8; i+=2)
+	for(int Band=-1; Band<nLevels && Set_Progress(Band + 1, nLevels + 1); Band++)
 	{
-		int ix = CSG_Grid_System::Get_xTo(i, x);
-		int iy = CSG_Grid_System::Get_yTo(i, y);
+		double zMin = Band     >= 0       ? m_Levels(Band    ) : m_pGrid->Get_Min();
+		double zMax = Band + 1 <  nLevels ? m_Levels(Band + 1) : m_pGrid->Get_Max();
+
+		CSG_Shape_Polygon *pPolygon = (CSG_Shape_Polygon *)m_pPolygons->Add_Shape();
+
+		pPolygon->Set_Value(0, m_pPolygons->Get_Count());
+		pPolygon->Set_Value(1, zMin);
+		pPolygon->Set_Value(2, zMax);
+		pPolygon->Set_Value(3, SG_Get_String(zMin) + " - " + SG_Get_String(zMax));
+
+		//-------------------------------------------------
+		// pieces: lower contour (as is), upper contour (reversed), border
 
-		if( m_Edge.is_InGrid(ix, iy) && m_Edge.asInt(ix, iy) != 0 )
+		std::vector<int> Piece; std::vector<sLong> First, Last;
+
+		if( Band >= 0 )
 		{
-			pSegment->Set_Value(2, ix);
-			pSegment->Set_Value(3, iy);
+			for(int i=Start[Band]; i<Start[Band + 1]; i++)
+			{
+				const TChain &Chain = Chains[Index[i]];
 
-			return( true );
+				Piece.push_back(i); First.push_back(4 * (Chain.front() / nLevels)); Last.push_back(4 * (Chain.back() / nLevels));
+			}
 		}
-	}
 
-	pSegment->Set_Value(2, x);
-	pSegment->Set_Value(3, y);
+		int nLower = (int)Piece.size();
 
-	return( false );
-}
-
-//---------------------------------------------------------
-CSG_Shape * CGrid_To_Contour::Get_Segment(const CSG_Shapes &Segments, int &x, int &y, bool &bAscending)
-{
-	for(int i=0; i<Segments.Get_Count(); i++)
-	{
-		if( Segments[i].asInt(0) == x && Segments[i].asInt(1) == y )
+		if( Band + 1 < nLevels )
 		{
-			bAscending	= true;
+			for(int i=Start[Band + 1]; i<Start[Band + 2]; i++)
+			{
+				const TChain &Chain = Chains[Index[i]];
+
+				Piece.push_back(i); First.push_back(4 * (Chain.back() / nLevels) + 2); Last.push_back(4 * (Chain.front() / nLevels) + 2);
+			}
+		}
 
-			x	= Segments[i].asInt(2);
-			y	= Segments[i].asInt(3);
+		int nContours = (int)Piece.size();
 
-			return( Segments.Get_Shape(i) );
+		for(int i=Border_Start[1 + Band]; i<Border_Start[2 + Band]; i++)
+		{
+			const TBorder &Border = Borders[Border_Index[i]];
+
+			Piece.push_back(i); First.push_back(Border.First); Last.push_back(Border.Last);
 		}
 
-		if( Segments[i].asInt(2) == x && Segments[i].asInt(3) == y )
+		//-------------------------------------------------
+		std::vector<int> Order, Ring;
+
+		Get_Links(First, Last, Order, Ring);
+
+		for(size_t iRing=0; iRing+1<Ring.size(); iRing++)
 		{
-			bAscending	= false;
+			int iPart = pPolygon->Get_Part_Count();
 
-			x	= Segments[i].asInt(0);
-			y	= Segments[i].asInt(1);
+			for(int j=Ring[iRing]; j<Ring[iRing + 1]; j++)
+			{
+				int iPiece = Order[j];
 
-			return( Segments.Get_Shape(i) );
-		}
-	}
+				if( iPiece < nContours )
+				{
+					const TChain &Chain = Chains[Index[Piece[iPiece]]];
 
-	return( NULL );
-}
+					int Level = iPiece < nLower ? Band : Band + 1;
 
-//---------------------------------------------------------
-bool CGrid_To_Contour::Add_Segment(CSG_Shape *pPolygon, int iPart, CSG_Shape *pSegment, bool bAscending)
-{
-	for(int i=0; i<pSegment->Get_Point_Count(0); i++)
-	{
-		pPolygon->Add_Point(pSegment->Get_Point(i, 0, bAscending), iPart);
-	}
+					for(size_t k=0; k<Chain.size(); k++)
+					{
+						Add_Point(pPolygon, iPart, Get_Crossing(Chain[iPiece < nLower ? k : Chain.size() - 1 - k] / nLevels, Level));
+					}
+				}
+				else
+				{
+					const TBorder &Border = Borders[Border_Index[Piece[iPiece]]];
 
-	((CSG_Shapes *)pSegment->Get_Table())->Del_Shape(pSegment);
+					for(int k=0; k<2; k++)
+					{
+						sLong Key = k == 0 ? Border.First : Border.Last;
 
+						Add_Point(pPolygon, iPart, Key % 2 ? Get_Node(Key / 2) : Get_Crossing(Key / 4, Band + (int)((Key / 2) % 2)));
+					}
+				}
+			}
+
+			//---------------------------------------------
+			int n = pPolygon->Get_Point_Count(iPart);
+
+			if( n > 1 && CSG_Point(pPolygon->Get_Point(0, iPart)).is_Equal(pPolygon->Get_Point(n - 1, iPart)) )
+			{
+				pPolygon->Del_Point(n - 1, iPart);
+			}
+
+			if( pPolygon->Get_Point_Count(iPart) < 3 )
+			{
+				pPolygon->Del_Part(iPart);
+			}
+		}
+
+		if( pPolygon->Get_Part_Count() < 1 )	// band is not covered by the grid
+		{
+			m_pPolygons->Del_Shape(pPolygon);
+		}
+	}
+
+	//-----------------------------------------------------
 	return( true );
 }
 
@@ -62,6 +62,8 @@
 //---------------------------------------------------------
 #include <saga_api/saga_api.h>
 
+#include <vector>
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -88,29 +90,41 @@ protected:
 
 private:
 
+	typedef struct
+	{
+		int						Band;
+
+		sLong					First, Last;
+	}
+	TBorder;
+
+	typedef std::vector<sLong>	TChain;
+
+
 	bool					m_bParts;
 
-	CSG_Grid				*m_pGrid, m_Edge;
+	CSG_Vector				m_Levels;
+
+	CSG_Grid				*m_pGrid;
 
 	CSG_Shapes				*m_pContours, *m_pPolygons;
 
 
-	bool					is_Edge					(int x, int y);
+	int						Get_Band				(double z)	const;
+
+	bool					Get_Tile				(int yMin, int yMax, std::vector<TChain> &Chains, std::vector<TBorder> &Borders);
+	bool					Get_Chains				(std::vector<std::vector<TChain> > &Tiles, std::vector<TChain> &Chains);
 
-	void					Set_Row					(int x, int y, bool bOn);
-	bool					Get_Row					(int x, int y);
-	void					Set_Col					(int x, int y, bool bOn);
-	bool					Get_Col					(int x, int y);
+	static void				Get_Links				(const std::vector<sLong> &First, const std::vector<sLong> &Last, std::vector<int> &Order, std::vector<int> &Start);
+	static void				Add_Border				(std::vector<TBorder> &Borders, sLong Edge, sLong Node_A, int Band_A, sLong Node_B, int Band_B);
 
-	bool					Get_Contour				(double z);
-	bool					Get_Contour				(double z, int x, int y);
-	bool					Get_Contour_Cell		(int &Dir, int &x, int &y, bool &bRow);
+	TSG_Point_Z				Get_Crossing			(sLong Edge, int Level)	const;
+	TSG_Point_Z				Get_Node				(sLong Node           )	const;
+	void					Add_Point				(CSG_Shape *pShape, int iPart, const TSG_Point_Z &Point);
 
-	bool					Get_Polygons			(CSG_Shape_Line *pContour_Lo, CSG_Shape_Line *pContour_Hi);
-	bool					Add_Contour				(CSG_Shapes &Segments, CSG_Shape_Polygon *pPolygon, CSG_Shape_Line *pContour);
-	bool					Add_Edge				(CSG_Shapes &Segments, int x, int y);
-	bool					Add_Segment				(CSG_Shape *pPolygon, int iPart, CSG_Shape *pContour, bool bAscending);
-	CSG_Shape *				Get_Segment				(const CSG_Shapes &Segments, int &x, int &y, bool &bAscending);
+	bool					Get_Level_Chains		(const std::vector<TChain> &Chains, std::vector<int> &Index, std::vector<int> &Start);
+	bool					Set_Contours			(const std::vector<TChain> &Chains);
+	bool					Set_Polygons			(const std::vector<TChain> &Chains, const std::vector<TBorder> &Borders);
 
 	bool					Split_Polygon_Parts		(CSG_Shapes *pPolygons);
 
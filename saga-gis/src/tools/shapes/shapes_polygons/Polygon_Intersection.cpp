@@ -148,6 +148,16 @@ bool CPolygon_Overlay::Initialize(CSG_Shapes **ppA, CSG_Shapes **ppB, bool bBoth
 //														 //
 ///////////////////////////////////////////////////////////
 
+//---------------------------------------------------------
+// Layer A is processed in blocks of features. Within a block
+// the clipping of each A feature against its candidates from
+// layer B (those whose extents touch, found with the R-tree)
+// runs in parallel and is collected per feature. The results
+// are then added in the order of layer A and B, so the output
+// does not depend on the number of threads.
+//---------------------------------------------------------
+#define OVERLAY_BLOCK_SIZE	64
+
 //---------------------------------------------------------
 bool CPolygon_Overlay::Get_Intersection(CSG_Shapes *pA, CSG_Shapes *pB)
 {
@@ -156,22 +166,66 @@ bool CPolygon_Overlay::Get_Intersection(CSG_Shapes *pA, CSG_Shapes *pB)
 	m_pA	= pA;
 	m_pB	= pB;
 
-	CSG_Shapes	Result(SHAPE_TYPE_Polygon);
+	_Prepare(m_pA);
+	_Prepare(m_pB);
 
-	CSG_Shape_Polygon	*pResult	= (CSG_Shape_Polygon *)Result.Add_Shape();
+	if( !m_Index.Create(m_pB) )
+	{
+		return( false );
+	}
 
 	//-----------------------------------------------------
-	for(int id_A=0; id_A<m_pA->Get_Count() && Set_Progress(id_A, m_pA->Get_Count()); id_A++)
+	int	nBlock	= OVERLAY_BLOCK_SIZE * SG_OMP_Get_Max_Num_Threads();
+
+	CSG_Shapes	*Results	= new CSG_Shapes[nBlock];
+
+	for(int i=0; i<nBlock; i++)
 	{
-		for(int id_B=0; id_B<m_pB->Get_Count(); id_B++)
+		Results[i].Create(SHAPE_TYPE_Polygon);
+		Results[i].Add_Field("ID_B", SG_DATATYPE_Int);
+	}
+
+	for(int iBlock=0; iBlock<m_pA->Get_Count() && Set_Progress(iBlock, m_pA->Get_Count()); iBlock+=nBlock)
+	{
+		int	n	= M_GET_MIN(nBlock, m_pA->Get_Count() - iBlock);
+
+		#pragma omp parallel for schedule(dynamic)
+		for(int i=0; i<n; i++)
 		{
-			if( SG_Polygon_Intersection(m_pA->Get_Shape(id_A), m_pB->Get_Shape(id_B), pResult) )
+			CSG_Shapes	&Result	= Results[i];	Result.Del_Shapes();
+
+			CSG_Shape	*pShape_A	= m_pA->Get_Shape(iBlock + i);
+
+			CSG_Array_Int	Candidates;
+
+			for(int j=0, nCandidates=m_Index.Get_Shapes(pShape_A->Get_Extent(), Candidates); j<nCandidates; j++)
 			{
-				_Add_Polygon(pResult, id_A, id_B);
+				CSG_Shape	*pResult	= Result.Add_Shape();
+
+				if( SG_Polygon_Intersection(pShape_A, m_pB->Get_Shape(Candidates[j]), pResult) )
+				{
+					pResult->Set_Value(0, Candidates[j]);
+				}
+				else
+				{
+					Result.Del_Shape(Result.Get_Count() - 1);
+				}
+			}
+		}
+
+		for(int i=0; i<n; i++)
+		{
+			for(int j=0; j<Results[i].Get_Count(); j++)
+			{
+				_Add_Polygon((CSG_Shape_Polygon *)Results[i].Get_Shape(j), iBlock + i, Results[i].Get_Shape(j)->asInt(0));
 			}
 		}
 	}
 
+	delete[](Results);
+
+	m_Index.Destroy();
+
 	return( true );
 }
 
@@ -188,44 +242,103 @@ bool CPolygon_Overlay::Get_Difference(CSG_Shapes *pA, CSG_Shapes *pB, bool bInve
 	m_pA	= pA;
 	m_pB	= pB;
 
-	CSG_Shapes	Result(SHAPE_TYPE_Polygon);
+	_Prepare(m_pA);
+	_Prepare(m_pB);
 
-	CSG_Shape_Polygon	*pResult	= (CSG_Shape_Polygon *)Result.Add_Shape();
+	if( !m_Index.Create(m_pB) )
+	{
+		return( false );
+	}
 
 	//-----------------------------------------------------
-	for(int id_A=0; id_A<m_pA->Get_Count() && Set_Progress(id_A, m_pA->Get_Count()); id_A++)
+	int	nBlock	= OVERLAY_BLOCK_SIZE * SG_OMP_Get_Max_Num_Threads();
+
+	CSG_Shapes	Results(SHAPE_TYPE_Polygon);
+
+	for(int i=0; i<nBlock; i++)
+	{
+		Results.Add_Shape();
+	}
+
+	for(int iBlock=0; iBlock<m_pA->Get_Count() && Set_Progress(iBlock, m_pA->Get_Count()); iBlock+=nBlock)
 	{
-		pResult->Assign(m_pA->Get_Shape(id_A), false);
+		int	n	= M_GET_MIN(nBlock, m_pA->Get_Count() - iBlock);
 
-		for(int id_B=0; id_B<m_pB->Get_Count() && pResult->is_Valid(); id_B++)
+		#pragma omp parallel for schedule(dynamic)
+		for(int i=0; i<n; i++)
 		{
-			switch( pResult->Intersects(m_pB->Get_Shape(id_B)) )
+			CSG_Shape_Polygon	*pResult	= (CSG_Shape_Polygon *)Results.Get_Shape(i);
+
+			pResult->Assign(m_pA->Get_Shape(iBlock + i), false);
+
+			CSG_Array_Int	Candidates;
+
+			for(int j=0, nCandidates=m_Index.Get_Shapes(pResult->Get_Extent(), Candidates); j<nCandidates && pResult->is_Valid(); j++)
 			{
-			case INTERSECTION_None:
-				break;
-
-			case INTERSECTION_Identical:
-			case INTERSECTION_Contained:
-				pResult->Del_Parts();
-				break;
-
-			case INTERSECTION_Contains:
-			case INTERSECTION_Overlaps:
-				SG_Polygon_Difference(pResult, m_pB->Get_Shape(id_B));
-				break;
+				CSG_Shape	*pShape_B	= m_pB->Get_Shape(Candidates[j]);
+
+				switch( pResult->Intersects(pShape_B) )
+				{
+				case INTERSECTION_None:
+					break;
+
+				case INTERSECTION_Identical:
+				case INTERSECTION_Contained:
+					pResult->Del_Parts();
+					break;
+
+				case INTERSECTION_Contains:
+				case INTERSECTION_Overlaps:
+					SG_Polygon_Difference(pResult, pShape_B);
+					break;
+				}
 			}
 		}
 
-		if( pResult->is_Valid() )
+		for(int i=0; i<n; i++)
 		{
-			_Add_Polygon(pResult, id_A);
+			CSG_Shape_Polygon	*pResult	= (CSG_Shape_Polygon *)Results.Get_Shape(i);
+
+			if( pResult->is_Valid() )
+			{
+				_Add_Polygon(pResult, iBlock + i);
+			}
 		}
 	}
 
+	m_Index.Destroy();
+
 	return( true );
 }
 
 
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Polygons calculate some of their properties (extent,
+// area, orientation, lakes) on demand. Doing this once in
+// advance keeps the shapes read-only while they are shared
+// by several threads.
+//---------------------------------------------------------
+void CPolygon_Overlay::_Prepare(CSG_Shapes *pShapes)
+{
+	for(int i=0; i<pShapes->Get_Count(); i++)
+	{
+		CSG_Shape_Polygon	*pPolygon	= (CSG_Shape_Polygon *)pShapes->Get_Shape(i);
+
+		pPolygon->Get_Extent();
+
+		for(int iPart=0; iPart<pPolygon->Get_Part_Count(); iPart++)
+		{
+			pPolygon->is_Lake(iPart);
+			pPolygon->Get_Area(iPart);
+		}
+	}
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 ///////////////////////////////////////////////////////////
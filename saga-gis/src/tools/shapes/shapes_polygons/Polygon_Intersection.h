@@ -94,6 +94,10 @@ private:
 
 	CSG_Shapes				*m_pA, *m_pB, *m_pAB;
 
+	CSG_Shapes_RTree		m_Index;
+
+
+	void					_Prepare			(CSG_Shapes *pShapes);
 
 	CSG_Shape_Polygon *		_Add_Polygon		(int id_A, int id_B);
 	bool					_Add_Polygon		(CSG_Shape_Polygon *pPolygon, int id_A, int id_B = -1);
@@ -265,7 +265,7 @@ bool CPolygon_Dissolve::On_Execute(void)
 	double	minArea		= Parameters("MIN_AREA")->asDouble();
 
 	//-----------------------------------------------------
-	CSG_String	Value;	CSG_Shape	*pDissolve	= NULL;
+	CSG_String	Value;	CSG_Shape	*pDissolve	= NULL;	CSG_Shapes	Members(SHAPE_TYPE_Polygon);
 
 	for(int i=0; i<pPolygons->Get_Count() && Set_Progress(i, pPolygons->Get_Count()); i++)
 	{
@@ -273,7 +273,7 @@ bool CPolygon_Dissolve::On_Execute(void)
 
 		if( !pDissolve || (Dissolve.Get_Count() && Value.Cmp(Dissolve[i].asString(1))) )
 		{
-			Get_Dissolved(pDissolve, bDissolve, minArea);
+			Get_Dissolved(pDissolve, Members, bDissolve, minArea);
 
 			if( Dissolve.Get_Count() )
 			{
@@ -291,16 +291,24 @@ bool CPolygon_Dissolve::On_Execute(void)
 		}
 		else
 		{
-			for(int iPart=0; iPart<pPolygon->Get_Part_Count(); iPart++)
+			if( !bDissolve )
 			{
-				pDissolve->Add_Part(((CSG_Shape_Polygon *)pPolygon)->Get_Part(iPart));
+				for(int iPart=0; iPart<pPolygon->Get_Part_Count(); iPart++)
+				{
+					pDissolve->Add_Part(((CSG_Shape_Polygon *)pPolygon)->Get_Part(iPart));
+				}
 			}
 
 			Statistics_Add(pDissolve, pPolygon, false);
 		}
+
+		if( bDissolve )	// collect the members, these are merged with a cascaded union
+		{
+			Members.Add_Shape(pPolygon, SHAPE_COPY_GEOM);
+		}
 	}
 
-	Get_Dissolved(pDissolve, bDissolve, minArea);
+	Get_Dissolved(pDissolve, Members, bDissolve, minArea);
 
 	//-----------------------------------------------------
 	if( m_Statistics )
@@ -319,7 +327,7 @@ bool CPolygon_Dissolve::On_Execute(void)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-bool CPolygon_Dissolve::Get_Dissolved(CSG_Shape *pDissolve, bool bDissolve, double minArea)
+bool CPolygon_Dissolve::Get_Dissolved(CSG_Shape *pDissolve, CSG_Shapes &Members, bool bDissolve, double minArea)
 {
 	if( !pDissolve )
 	{
@@ -328,7 +336,9 @@ bool CPolygon_Dissolve::Get_Dissolved(CSG_Shape *pDissolve, bool bDissolve, doub
 
 	if( bDissolve )
 	{
-		SG_Polygon_Dissolve(pDissolve);
+		SG_Polygon_Dissolve(&Members, pDissolve);
+
+		Members.Del_Shapes();
 
 		if( minArea > 0.0 )
 		{
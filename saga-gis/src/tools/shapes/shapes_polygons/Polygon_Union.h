@@ -108,7 +108,7 @@ private:
 	CSG_Simple_Statistics		*m_Statistics;
 
 
-	bool						Get_Dissolved			(CSG_Shape *pDissolve, bool bDissolve, double nimArea);
+	bool						Get_Dissolved			(CSG_Shape *pDissolve, CSG_Shapes &Members, bool bDissolve, double minArea);
 
 	bool						Statistics_Initialize	(CSG_Shapes *pDissolved, CSG_Shapes *pPolygons);
 	CSG_String					Statistics_Get_Name		(const CSG_String &Type, const CSG_String &Name);
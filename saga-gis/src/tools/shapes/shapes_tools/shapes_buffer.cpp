@@ -228,8 +228,8 @@ bool CShapes_Buffer::On_Execute(void)
 bool CShapes_Buffer::Get_Buffers(CSG_Shapes *pShapes, int Field, CSG_Shapes *pBuffers, double Scale, bool bDissolve)
 {
 	double		Distance;
-	CSG_Shapes	Part(SHAPE_TYPE_Polygon);
-	CSG_Shape	*pPart	= Part.Add_Shape(), *pBuffer;
+	CSG_Shapes	Parts(SHAPE_TYPE_Polygon);	// single buffers to become dissolved
+	CSG_Shape	*pBuffer;
 
 	Distance	= Parameters("DIST_FIELD")->asDouble() * Scale;
 	Scale		= Parameters("DIST_SCALE")->asDouble() * Scale;
@@ -255,23 +255,36 @@ bool CShapes_Buffer::Get_Buffers(CSG_Shapes *pShapes, int Field, CSG_Shapes *pBu
 			if( !bDissolve )
 			{
 				pBuffer	= pBuffers->Add_Shape(pShape, SHAPE_COPY_ATTR);
-			}
 
-			if( pBuffer->Get_Part_Count() == 0 )
-			{
 				Get_Buffer(pShape, pBuffer, Distance);
 			}
 			else
 			{
-				Get_Buffer(pShape, pPart  , Distance);
-
-				SG_Polygon_Union(pBuffer, pPart);
+				CSG_Shape	*pPart	= Parts.Add_Shape();
 
-				pPart->Del_Parts();
+				if( !Get_Buffer(pShape, pPart, Distance) || !pPart->is_Valid() )
+				{
+					Parts.Del_Shape(Parts.Get_Count() - 1);
+				}
 			}
 		}
 	}
 
+	//-----------------------------------------------------
+	if( bDissolve && Parts.Get_Count() > 0 )
+	{
+		Process_Set_Text(_TL("dissolving buffers"));
+
+		if( Parts.Get_Count() == 1 )
+		{
+			pBuffer->Assign(Parts.Get_Shape(0), false);
+		}
+		else
+		{
+			SG_Polygon_Dissolve(&Parts, pBuffer);
+		}
+	}
+
 	//-----------------------------------------------------
 	return( pBuffers->is_Valid() );
 }
@@ -307,29 +320,22 @@ bool CShapes_Buffer::Get_Buffer_Point(CSG_Shape *pPoint, CSG_Shape *pBuffer, dou
 //---------------------------------------------------------
 bool CShapes_Buffer::Get_Buffer_Points(CSG_Shape *pPoints, CSG_Shape *pBuffer, double Distance)
 {
-	CSG_Shapes	Part(SHAPE_TYPE_Polygon);
-	CSG_Shape	*pPart	= Part.Add_Shape();
+	CSG_Shapes	Circles(SHAPE_TYPE_Polygon);
 
 	for(int iPart=0; iPart<pPoints->Get_Part_Count(); iPart++)
 	{
 		for(int iPoint=0; iPoint<pPoints->Get_Point_Count(iPart); iPoint++)
 		{
-			if( pBuffer->Get_Part_Count() == 0 )
-			{
-				Add_Arc(pBuffer, pPoints->Get_Point(iPoint), Distance, 0.0, M_PI_360);
-			}
-			else
-			{
-				Add_Arc(pPart  , pPoints->Get_Point(iPoint), Distance, 0.0, M_PI_360);
-
-				SG_Polygon_Union(pBuffer, pPart);
-
-				pPart->Del_Parts();
-			}
+			Add_Arc(Circles.Add_Shape(), pPoints->Get_Point(iPoint), Distance, 0.0, M_PI_360);
 		}
 	}
 
-	return( true );
+	if( Circles.Get_Count() == 1 )
+	{
+		return( pBuffer->Assign(Circles.Get_Shape(0), false) );
+	}
+
+	return( SG_Polygon_Dissolve(&Circles, pBuffer) );
 }
 
 //---------------------------------------------------------
@@ -70,6 +70,7 @@ CKinWav_D8::CKinWav_D8(void)
 		"It is not designed for operational usage. Rather it should give an idea about "
 		"some principles of dynamic simulation techniques and thus it might become a "
 		"starting point for more sophisticated and applicable simulation tools. "
+		"Rows without runoff in their neighbourhood are skipped. "
 	));
 
 	Add_Reference("Johnson, D.L., Miller, A.C.", "1997",
@@ -359,6 +360,7 @@ bool CKinWav_D8::Initialize(void)
 	m_Flow.Create(Get_System(), SG_DATATYPE_Float);
 	m_dx  .Create(Get_System(), SG_DATATYPE_Float);
 	m_Q   .Create(Get_System(), SG_DATATYPE_Float);
+	m_dF  .Create(Get_System(), SG_DATATYPE_Float);
 
 	switch( m_Routing )
 	{
@@ -391,9 +393,22 @@ bool CKinWav_D8::Initialize(void)
 	//-----------------------------------------------------
 	m_Flow_Sum = m_Flow_Out = 0.0;
 
-	for(int y=0; y<Get_NY(); y++) for(int x=0; x<Get_NX(); x++)
+	m_Row_Wet   .Create(Get_NY());
+	m_Row_Active.Create(Get_NY());
+
+	for(int y=0; y<Get_NY(); y++)
 	{
-		m_Flow_Sum	+= m_pFlow->asDouble(x, y);
+		m_Row_Wet[y] = 0; m_Row_Active[y] = 1;	// first time step processes all rows
+
+		for(int x=0; x<Get_NX(); x++)
+		{
+			m_Flow_Sum	+= m_pFlow->asDouble(x, y);
+
+			if( !m_pDEM->is_NoData(x, y) && m_pFlow->asDouble(x, y) > 0. )
+			{
+				m_Row_Wet[y] = 1;
+			}
+		}
 	}
 
 	//-----------------------------------------------------
@@ -413,6 +428,10 @@ bool CKinWav_D8::Finalize(void)
 	m_Flow.Destroy();
 	m_dx  .Destroy();
 	m_Q   .Destroy();
+	m_dF  .Destroy();
+
+	m_Row_Wet   .Destroy();
+	m_Row_Active.Destroy();
 
 	//-----------------------------------------------------
 	double	Flow_Sum	= 0.0;
@@ -527,16 +546,33 @@ void CKinWav_D8::Set_MFD(int x, int y)
 //														 //
 ///////////////////////////////////////////////////////////
 
+//---------------------------------------------------------
+// Runoff is not scattered to the receiving cells but
+// gathered from the donor cells in a separate pass, so that
+// no two threads write to the same cell. Only rows with
+// runoff in their neighbourhood need to be processed. Rows
+// that have been active in the previous time step are
+// processed once more to reset their temporary values.
 //---------------------------------------------------------
 void CKinWav_D8::Set_Flow(void)
 {
-	int	y;
+	CSG_Array_Int	Active(Get_NY()), Process(Get_NY());
 
-	#pragma omp parallel for private(y)
-	for(y=0; y<Get_NY(); y++) for(int x=0; x<Get_NX(); x++) if( !m_pDEM->is_NoData(x, y) )
+	for(int y=0; y<Get_NY(); y++)
+	{
+		Active [y] = (y > 0 && m_Row_Wet[y - 1]) || m_Row_Wet[y] || (y < Get_NY() - 1 && m_Row_Wet[y + 1]) ? 1 : 0;
+		Process[y] = Active[y] || m_Row_Active[y] ? 1 : 0;
+
+		m_Row_Active[y] = Active[y];
+	}
+
+	//-----------------------------------------------------
+	#pragma omp parallel for
+	for(int y=0; y<Get_NY(); y++) if( Process[y] ) for(int x=0; x<Get_NX(); x++) if( !m_pDEM->is_NoData(x, y) )
 	{
 		m_Flow  .Set_Value(x, y, m_pFlow->asDouble(x, y));
 		m_pFlow->Set_Value(x, y, 0.0);
+		m_dF    .Set_Value(x, y, 0.0);
 
 		m_Q     .Set_Value(x, y, Get_Q(x, y));
 
@@ -550,10 +586,45 @@ void CKinWav_D8::Set_Flow(void)
 		}
 	}
 
-	#pragma omp parallel for private(y)
-	for(y=0; y<Get_NY(); y++) for(int x=0; x<Get_NX(); x++) if( !m_pDEM->is_NoData(x, y) )
+	//-----------------------------------------------------
+	CSG_Vector	Flow_Out(Get_NY());	// row sums, no need for atomic updates
+
+	#pragma omp parallel for
+	for(int y=0; y<Get_NY(); y++) if( m_Row_Wet[y] ) for(int x=0; x<Get_NX(); x++) if( !m_pDEM->is_NoData(x, y) )
 	{
-		Set_Runoff(x, y);
+		Flow_Out[y]	+= Set_Runoff(x, y);
+	}
+
+	//-----------------------------------------------------
+	#pragma omp parallel for
+	for(int y=0; y<Get_NY(); y++)
+	{
+		m_Row_Wet[y] = 0;
+
+		if( Active[y] ) for(int x=0; x<Get_NX(); x++)
+		{
+			if( m_pDEM->is_NoData(x, y) )
+			{
+				continue;	// flow towards no-data has already been booked as outflow
+			}
+
+			double	dF	= Get_Runoff_In(x, y);
+
+			if( dF > 0.0 )
+			{
+				m_pFlow->Add_Value(x, y, dF);
+			}
+
+			if( m_pFlow->asDouble(x, y) > 0.0 )
+			{
+				m_Row_Wet[y] = 1;
+			}
+		}
+	}
+
+	for(int y=0; y<Get_NY(); y++)
+	{
+		m_Flow_Out	+= Flow_Out[y];
 	}
 }
 
@@ -667,7 +738,11 @@ void CKinWav_D8::Get_Upslope(int x, int y, double &F, double &Q)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-void CKinWav_D8::Set_Runoff(int x, int y)
+// Keeps the remaining runoff of the cell and stores the
+// runoff it passes to its neighbours in m_dF. Returns the
+// runoff that leaves the grid.
+//---------------------------------------------------------
+double CKinWav_D8::Set_Runoff(int x, int y)
 {
 	const double	m	= 5./3.;
 
@@ -677,7 +752,7 @@ void CKinWav_D8::Set_Runoff(int x, int y)
 
 	if( F <= 0.0 )
 	{
-		return;
+		return( 0.0 );
 	}
 
 	double	dx	= m_dx.asDouble(x, y);
@@ -686,7 +761,7 @@ void CKinWav_D8::Set_Runoff(int x, int y)
 	{
 		m_pFlow->Add_Value(x, y, F);
 
-		return;
+		return( 0.0 );
 	}
 
 	Get_Upslope(x, y, Fup, Qup);
@@ -722,45 +797,39 @@ void CKinWav_D8::Set_Runoff(int x, int y)
 	if( q <= 0.0 )
 	{
 		m_pFlow->Add_Value(x, y, F);
+
+		return( 0.0 );
+	}
+
+	double	dF	= q * dtdx;
+
+	if( F > dF )
+	{
+		m_pFlow->Add_Value(x, y, F - dF);
 	}
 	else
 	{
-		double	dF	= q * dtdx;
+		dF	= F;
+	}
 
-		if( F > dF )
-		{
-			m_pFlow->Add_Value(x, y, F - dF);
-		}
-		else
-		{
-			dF	= F;
-		}
+	m_dF.Set_Value(x, y, dF);
 
-		Set_Runoff(x, y, dF);
-	}
+	return( Get_Runoff_Out(x, y, dF) );
 }
 
 //---------------------------------------------------------
-void CKinWav_D8::Set_Runoff(int x, int y, double dF)
+double CKinWav_D8::Get_Runoff_Out(int x, int y, double dF)
 {
+	double	Out	= 0.0;
+
 	switch( m_Routing )
 	{
 	default: {
 		int	i	= m_dFlow->asInt(x, y);
 
-		if( i >= 0 )
+		if( i >= 0 && !m_pDEM->is_InGrid(Get_xTo(i, x), Get_yTo(i, y)) )
 		{
-			int	ix	= Get_xTo(i, x);
-			int	iy	= Get_yTo(i, y);
-
-			if( m_pDEM->is_InGrid(ix, iy) )
-			{
-				m_pFlow->Add_Value(Get_xTo(i, x), Get_yTo(i, y), dF);
-			}
-			else
-			{
-				m_Flow_Out	+= dF;
-			}
+			Out	= dF;
 		}
 	}	break;
 
@@ -769,23 +838,48 @@ void CKinWav_D8::Set_Runoff(int x, int y, double dF)
 		{
 			double	d	= m_dFlow[i].asDouble(x, y);
 
-			if( d > 0.0 )
+			if( d > 0.0 && !m_pDEM->is_InGrid(Get_xTo(i, x), Get_yTo(i, y)) )
 			{
-				int	ix	= Get_xTo(i, x);
-				int	iy	= Get_yTo(i, y);
+				Out	+= d * dF;
+			}
+		}
+	}	break;
+	}
 
-				if( m_pDEM->is_InGrid(ix, iy) )
-				{
-					m_pFlow->Add_Value(Get_xTo(i, x), Get_yTo(i, y), d * dF);
-				}
-				else
+	return( Out );
+}
+
+//---------------------------------------------------------
+double CKinWav_D8::Get_Runoff_In(int x, int y)
+{
+	double	In	= 0.0;
+
+	for(int i=0; i<8; i++)
+	{
+		int	ix	= Get_xTo(i, x);
+		int	iy	= Get_yTo(i, y);
+
+		double	dF;
+
+		if( m_pDEM->is_InGrid(ix, iy) && (dF = m_dF.asDouble(ix, iy)) > 0.0 )
+		{
+			switch( m_Routing )
+			{
+			default:
+				if( m_dFlow->asInt(ix, iy) == (i + 4) % 8 )
 				{
-					m_Flow_Out	+= d * dF;
+					In	+= dF;
 				}
+				break;
+
+			case  1:
+				In	+= dF * m_dFlow[(i + 4) % 8].asDouble(ix, iy);
+				break;
 			}
 		}
-	}	break;
 	}
+
+	return( In );
 }
 
 
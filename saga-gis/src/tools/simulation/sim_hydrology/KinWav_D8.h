@@ -91,7 +91,9 @@ private:
 
 	double				m_dt, m_Epsilon, m_Manning, m_Flow_Out, m_Flow_Sum;
 
-	CSG_Grid			*m_pDEM, *m_pManning, *m_pFlow, m_Flow, m_dFlow[8], m_dx, m_Q;
+	CSG_Array_Int		m_Row_Wet, m_Row_Active;
+
+	CSG_Grid			*m_pDEM, *m_pManning, *m_pFlow, m_Flow, m_dFlow[8], m_dx, m_Q, m_dF;
 
 	CSG_Table			*m_pGauges_Flow;
 
@@ -116,8 +118,9 @@ private:
 
 	void				Get_Upslope				(int x, int y, double &F, double &Q);
 
-	void				Set_Runoff				(int x, int y);
-	void				Set_Runoff				(int x, int y, double dF);
+	double				Set_Runoff				(int x, int y);
+	double				Get_Runoff_Out			(int x, int y, double dF);
+	double				Get_Runoff_In			(int x, int y);
 
 	bool				Gauges_Initialise		(void);
 	bool				Gauges_Set_Flow			(double Time);
@@ -63,7 +63,12 @@ COverland_Flow::COverland_Flow(void)
 	Set_Author		("O.Conrad (c) 2020");
 
 	Set_Description	(_TW(
-		"A simple overland flow simulation."
+		"A simple overland flow simulation. "
+		"Lateral flow is only calculated in the neighbourhood of wet cells. "
+		"With more than one time step level, cells are updated with a time step "
+		"that is doubled for each level their velocity is below the maximum velocity "
+		"(local time stepping), which reduces the calculation time for "
+		"simulations with a few fast flowing cells."
 	));
 
 	//-----------------------------------------------------
@@ -173,6 +178,12 @@ COverland_Flow::COverland_Flow(void)
 		0.5, 0.01, true, 1., true
 	);
 
+	Parameters.Add_Int("",
+		"TIME_LEVELS", _TL("Time Step Levels"),
+		_TL("Number of local time step levels. Each level doubles the time step for cells flowing accordingly slower. Set to one to apply the global time step to all cells."),
+		1, 1, true, 6, true
+	);
+
 //	Parameters.Add_Double("",
 //		"V_MIN"		, _TL("Minimum Velocity [m/h]"),
 //		_TL(""),
@@ -357,6 +368,13 @@ bool COverland_Flow::Initialize(void)
 	m_bFlow_Out      = Parameters("FLOW_OUT" )->asBool  ();
 	m_Flow_Out		 = 0.;
 
+	m_nLevels        = Parameters("TIME_LEVELS")->asInt ();
+
+	//-----------------------------------------------------
+	// resample weather grids once instead of each time step
+	Set_Weather(m_pPrecipitation, m_Weather[0], m_Precipitation);
+	Set_Weather(m_pETpot        , m_Weather[1], m_ETpot        );
+
 	//-----------------------------------------------------
 	if( Parameters("RESET")->asBool() )
 	{
@@ -402,6 +420,59 @@ bool COverland_Flow::Initialize(void)
 	m_Flow.Create(Get_System()       , SG_DATATYPE_Float);
 	m_v   .Create(Get_System(), 9, 0., SG_DATATYPE_Float);
 
+	if( m_nLevels > 1 )
+	{
+		m_Level.Create(Get_System(), SG_DATATYPE_Byte);
+	}
+
+	//-----------------------------------------------------
+	m_Wet_xMin    .Create(Get_NY()); m_Wet_xMax    .Create(Get_NY());
+	m_Lateral_xMin.Create(Get_NY()); m_Lateral_xMax.Create(Get_NY());
+
+	#pragma omp parallel for
+	for(int y=0; y<Get_NY(); y++)
+	{
+		int	xMin = Get_NX(), xMax = -1;
+
+		for(int x=0; x<Get_NX(); x++)
+		{
+			if( !m_pDEM->is_NoData(x, y) && m_pFlow->asDouble(x, y) > 0. )
+			{
+				if( xMin > x ) { xMin = x; } xMax = x;
+			}
+		}
+
+		m_Wet_xMin[y] = xMin; m_Wet_xMax[y] = xMax;
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool COverland_Flow::Set_Weather(CSG_Grid *&pGrid, CSG_Grid &Weather, double Default)
+{
+	if( !pGrid )
+	{
+		return( false );
+	}
+
+	Weather.Create(Get_System(), SG_DATATYPE_Float);
+
+	#pragma omp parallel for
+	for(int y=0; y<Get_NY(); y++) for(int x=0; x<Get_NX(); x++)
+	{
+		double	v;
+
+		if( !pGrid->Get_Value(Get_System().Get_Grid_to_World(x, y), v) )
+		{
+			v	= Default;
+		}
+
+		Weather.Set_Value(x, y, v);
+	}
+
+	pGrid	= &Weather;
+
 	return( true );
 }
 
@@ -411,6 +482,13 @@ bool COverland_Flow::Finalize(void)
 	m_Flow.Destroy();
 	m_v   .Destroy();
 
+	m_Level     .Destroy();
+	m_Weather[0].Destroy();
+	m_Weather[1].Destroy();
+
+	m_Wet_xMin    .Destroy(); m_Wet_xMax    .Destroy();
+	m_Lateral_xMin.Destroy(); m_Lateral_xMax.Destroy();
+
 	if( !Process_Get_Okay() )
 	{
 		SG_UI_Process_Set_Okay();
@@ -527,48 +605,231 @@ bool COverland_Flow::Set_Time_Stamp(double Time)
 //---------------------------------------------------------
 bool COverland_Flow::Do_Time_Step(void)
 {
-	m_vMax	= 0.;
-
-	#pragma omp parallel for
-	for(int y=0; y<Get_NY(); y++) for(int x=0; x<Get_NX(); x++)
-	{
-		Get_Velocity(x, y);
-	}
+	m_vMax	= Get_Velocities(-1);
 
 	//-----------------------------------------------------
 	if( m_vMax > 0. )
 	{
-		m_dTime	= Parameters("TIME_STEP")->asDouble() * Get_Cellsize() / m_vMax;	// CourantFriedrichsLewy (CFL) condition
+		int	nSteps	= 1 << (m_nLevels - 1);
 
-		#pragma omp parallel for
-		for(int y=0; y<Get_NY(); y++) for(int x=0; x<Get_NX(); x++)
+		m_dTime	= Parameters("TIME_STEP")->asDouble() * Get_Cellsize() / m_vMax;	// Courant-Friedrichs-Lewy (CFL) condition, fastest cells
+
+		if( nSteps > 1 )
 		{
-			Set_Flow_Lateral(x, y);
+			Set_Time_Levels();
 		}
+
+		for(int Step=0; Step<nSteps; Step++)
+		{
+			if( Step > 0 )
+			{
+				Get_Velocities(Step);
+			}
+
+			Set_Lateral_Range();
+
+			CSG_Vector	Flow_Out(Get_NY());	// row sums, no need for atomic updates
+
+			#pragma omp parallel for
+			for(int y=0; y<Get_NY(); y++) for(int x=m_Lateral_xMin[y]; x<=m_Lateral_xMax[y]; x++)
+			{
+				Flow_Out[y]	+= Set_Flow_Lateral(x, y, Step);
+			}
+
+			if( m_bFlow_Out )
+			{
+				for(int y=0; y<Get_NY(); y++)
+				{
+					m_Flow_Out	+= Flow_Out[y];
+				}
+			}
+
+			//---------------------------------------------
+			if( Step < nSteps - 1 )	// commit sub step, the last one is committed by the vertical balance
+			{
+				#pragma omp parallel for
+				for(int y=0; y<Get_NY(); y++)
+				{
+					int	xMin = Get_NX(), xMax = -1;
+
+					for(int x=m_Lateral_xMin[y]; x<=m_Lateral_xMax[y]; x++)
+					{
+						if( !m_pDEM->is_NoData(x, y) )
+						{
+							double	Flow	= m_Flow.asDouble(x, y);
+
+							if( Flow > 0. && m_pFlow->asDouble(x, y) <= 0. )	// newly wetted, its level has not been checked against its velocity
+							{
+								m_Level.Set_Value(x, y, 0);
+							}
+
+							m_pFlow->Set_Value(x, y, Flow);
+
+							if( Flow > 0. )
+							{
+								if( xMin > x ) { xMin = x; } xMax = x;
+							}
+						}
+					}
+
+					m_Wet_xMin[y] = xMin; m_Wet_xMax[y] = xMax;
+				}
+			}
+		}
+
+		m_dTime	*= nSteps;
 	}
 	else
 	{
 		m_dTime	= 1. / 60.;	// 1 min
+
+		for(int y=0; y<Get_NY(); y++)
+		{
+			m_Lateral_xMin[y] = Get_NX(); m_Lateral_xMax[y] = -1;
+		}
 	}
 
 	//-----------------------------------------------------
 	#pragma omp parallel for
-	for(int y=0; y<Get_NY(); y++) for(int x=0; x<Get_NX(); x++)
+	for(int y=0; y<Get_NY(); y++)
 	{
-		Set_Flow_Vertical(x, y);
+		int	xMin = Get_NX(), xMax = -1;
+
+		for(int x=0; x<Get_NX(); x++)
+		{
+			if( Set_Flow_Vertical(x, y) && m_pFlow->asDouble(x, y) > 0. )
+			{
+				if( xMin > x ) { xMin = x; } xMax = x;
+			}
+		}
+
+		m_Wet_xMin[y] = xMin; m_Wet_xMax[y] = xMax;
 	}
 
 	//-----------------------------------------------------
 	return( true );
 }
 
+//---------------------------------------------------------
+/**
+  * Returns the column range of row y that is covered by the
+  * wet cells of the rows within the given margin, expanded
+  * by the margin. The range is empty (xMin > xMax) if there
+  * are no wet cells within the margin.
+*/
+//---------------------------------------------------------
+void COverland_Flow::Get_Range(int y, int Margin, int &xMin, int &xMax)
+{
+	xMin = Get_NX(); xMax = -1;
+
+	for(int iy=y-Margin; iy<=y+Margin; iy++)
+	{
+		if( iy >= 0 && iy < Get_NY() && m_Wet_xMin[iy] <= m_Wet_xMax[iy] )
+		{
+			if( xMin > m_Wet_xMin[iy] - Margin ) { xMin = m_Wet_xMin[iy] - Margin; }
+			if( xMax < m_Wet_xMax[iy] + Margin ) { xMax = m_Wet_xMax[iy] + Margin; }
+		}
+	}
+
+	if( xMin < 0          ) { xMin = 0;            }
+	if( xMax >= Get_NX()  ) { xMax = Get_NX() - 1; }
+}
+
+//---------------------------------------------------------
+void COverland_Flow::Set_Lateral_Range(void)
+{
+	#pragma omp parallel for
+	for(int y=0; y<Get_NY(); y++)
+	{
+		int	xMin, xMax; Get_Range(y, 1, xMin, xMax);
+
+		m_Lateral_xMin[y] = xMin; m_Lateral_xMax[y] = xMax;
+	}
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// A cell's time step level is the number of times its
+// velocity can be doubled before reaching the maximum
+// velocity. Dry cells get the highest level, but a cell's
+// level never exceeds the level of a neighbour by more
+// than one, so water arriving from fast cells is passed on
+// in time. Cells that become wet during a time step fall
+// back to level 0 for the remaining sub steps (see
+// Do_Time_Step), so that they never move water with a
+// multiple of the time step, whose CFL condition has not
+// been checked for their velocity.
+//---------------------------------------------------------
+inline int COverland_Flow::Get_Time_Level(int x, int y)
+{
+	double	vSum;
+
+	if( m_pFlow->asDouble(x, y) > 0. && (vSum = m_v[8].asDouble(x, y)) > 0. )
+	{
+		int	Level	= (int)floor(log(m_vMax / vSum) / log(2.));
+
+		return( Level < 0 ? 0 : Level < m_nLevels - 1 ? Level : m_nLevels - 1 );
+	}
+
+	return( m_nLevels - 1 );
+}
+
+//---------------------------------------------------------
+bool COverland_Flow::Set_Time_Levels(void)
+{
+	int	Margin	= 1 << (m_nLevels - 1);	// water will not move farther during one time step
+
+	#pragma omp parallel for
+	for(int y=0; y<Get_NY(); y++)
+	{
+		int	xMin, xMax; Get_Range(y, Margin, xMin, xMax);
+
+		for(int x=xMin; x<=xMax; x++)
+		{
+			if( !m_pDEM->is_NoData(x, y) )
+			{
+				int	Level	= Get_Time_Level(x, y);
+
+				for(int i=0; i<8 && Level>0; i++)
+				{
+					int	ix, iy;
+
+					if( Get_Neighbour(x, y, i, ix, iy) && !m_pDEM->is_NoData(ix, iy) )
+					{
+						int	iLevel	= 1 + Get_Time_Level(ix, iy);
+
+						if( Level > iLevel )
+						{
+							Level	= iLevel;
+						}
+					}
+				}
+
+				m_Level.Set_Value(x, y, Level);
+			}
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+inline bool COverland_Flow::is_Active(int x, int y, int Step)
+{
+	return( m_nLevels < 2 || Step % (1 << m_Level.asInt(x, y)) == 0 );
+}
+
 
 ///////////////////////////////////////////////////////////
 //														 //
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-#define GET_GRID_OR_CONST(g, c)	{ double v; if( !g || !g->Get_Value(Get_System().Get_Grid_to_World(x, y), v) ) { v = c; } return( v > 0. ? m_dTime * v : 0. ); }
+#define GET_GRID_OR_CONST(g, c)	{ double v = g ? g->asDouble(x, y) : c; return( v > 0. ? m_dTime * v : 0. ); }
 
 //---------------------------------------------------------
 inline double COverland_Flow::Get_Precipitation(int x, int y)
@@ -689,19 +950,17 @@ inline double COverland_Flow::Get_Velocity(double Flow, double Slope, double Rou
 }
 
 //---------------------------------------------------------
-bool COverland_Flow::Get_Velocity(int x, int y)
+double COverland_Flow::Get_Velocity(int x, int y)
 {
 	if( m_pDEM->is_NoData(x, y) )
 	{
-		return( false );
+		return( 0. );
 	}
 
-	double	Flow = m_pFlow->asDouble(x, y);
+	double	vMax = 0., vSum = 0., Flow = m_pFlow->asDouble(x, y);
 
 	if( Flow > 0. )
 	{
-		double	vMax = 0., vSum = 0.;
-
 		for(int i=0; i<8; i++)
 		{
 			double	Slope	= Get_Slope(x, y, i);
@@ -724,35 +983,54 @@ bool COverland_Flow::Get_Velocity(int x, int y)
 				m_v[i].Set_Value(x, y, 0.);
 			}
 		}
+	}
+
+	//-----------------------------------------------------
+	m_v[8].Set_Value(x, y, vSum);
+
+	if( m_pVelocity )
+	{
+		m_pVelocity->Set_Value(x, y, vMax);	// 1/3600 * [m/h] => [m/s]
+	}
+
+	return( vMax );
+}
 
-		if( m_vMax < vMax )
+//---------------------------------------------------------
+// Updates the velocities of the wet cells that are active
+// in the given sub step (all wet cells if Step < 0) and
+// returns the maximum velocity. Row maxima are reduced
+// afterwards, which avoids a critical section.
+//---------------------------------------------------------
+double COverland_Flow::Get_Velocities(int Step)
+{
+	CSG_Vector	vMax(Get_NY());
+
+	#pragma omp parallel for
+	for(int y=0; y<Get_NY(); y++) for(int x=m_Wet_xMin[y]; x<=m_Wet_xMax[y]; x++)
+	{
+		if( Step < 0 || is_Active(x, y, Step) )
 		{
-			#pragma omp critical
+			double	v	= Get_Velocity(x, y);
+
+			if( vMax[y] < v )
 			{
-				if( m_vMax < vMax )	// could have been changed by another thread after the comparison outside the critical section
-				{
-					m_vMax = vMax;
-				}
+				vMax[y]	= v;
 			}
 		}
+	}
 
-		//-------------------------------------------------
-		m_v[8].Set_Value(x, y, vSum);
+	double	v	= 0.;
 
-		if( m_pVelocity )
-		{
-			m_pVelocity->Set_Value(x, y, vMax);	// 1/3600 * [m/h] => [m/s]
-		}
-	}
-	else
+	for(int y=0; y<Get_NY(); y++)
 	{
-		if( m_pVelocity )
+		if( v < vMax[y] )
 		{
-			m_pVelocity->Set_Value(x, y, 0.);
+			v	= vMax[y];
 		}
 	}
 
-	return( true );
+	return( v );
 }
 
 
@@ -761,7 +1039,7 @@ bool COverland_Flow::Get_Velocity(int x, int y)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-inline double COverland_Flow::Get_Flow_Lateral(int x, int y, int i, bool bInverse)
+inline double COverland_Flow::Get_Flow_Lateral(int x, int y, int i, bool bInverse, int Step)
 {
 	if( bInverse )
 	{
@@ -775,34 +1053,40 @@ inline double COverland_Flow::Get_Flow_Lateral(int x, int y, int i, bool bInvers
 
 	double	Flow, v;
 
-	if( (Flow = m_pFlow->asDouble(x, y)) > 0. && (v = m_v[i].asDouble(x, y)) > 0. )
+	if( is_Active(x, y, Step) && (Flow = m_pFlow->asDouble(x, y)) > 0. && (v = m_v[i].asDouble(x, y)) > 0. )
 	{
-		Flow	= Flow * v / m_v[8].asDouble(x, y) * m_dTime * v / Get_Length(i);
-
-		if( m_bFlow_Out && !bInverse && !is_InGrid(Get_xTo(i, x), Get_yTo(i, y)) )
-		{
-			#pragma omp atomic
-				m_Flow_Out	+= Flow;
-		}
+		double	dTime	= m_nLevels < 2 ? m_dTime : m_dTime * (1 << m_Level.asInt(x, y));
 
-		return( Flow );
+		return( Flow * v / m_v[8].asDouble(x, y) * dTime * v / Get_Length(i) );
 	}
 
 	return( 0. );
 }
 
 //---------------------------------------------------------
-bool COverland_Flow::Set_Flow_Lateral(int x, int y)
+// Returns the amount of flow that left the grid.
+//---------------------------------------------------------
+double COverland_Flow::Set_Flow_Lateral(int x, int y, int Step)
 {
-	double	iFlow, Flow = m_pFlow->asDouble(x, y);
+	if( m_pDEM->is_NoData(x, y) )
+	{
+		return( 0. );
+	}
+
+	double	iFlow, Flow = m_pFlow->asDouble(x, y), Flow_Out = 0.;
 
 	for(int i=0; i<8; i++)
 	{
-		if     ( (iFlow = Get_Flow_Lateral(x, y, i, false)) > 0. )	// downslope flow leaving cell
+		if     ( (iFlow = Get_Flow_Lateral(x, y, i, false, Step)) > 0. )	// downslope flow leaving cell
 		{
 			Flow	-= iFlow;
+
+			if( !is_InGrid(Get_xTo(i, x), Get_yTo(i, y)) )
+			{
+				Flow_Out	+= iFlow;
+			}
 		}
-		else if( (iFlow = Get_Flow_Lateral(x, y, i,  true)) > 0. )	// upslope flow entering cell
+		else if( (iFlow = Get_Flow_Lateral(x, y, i,  true, Step)) > 0. )	// upslope flow entering cell
 		{
 			Flow	+= iFlow;
 		}
@@ -810,7 +1094,16 @@ bool COverland_Flow::Set_Flow_Lateral(int x, int y)
 
 	m_Flow.Set_Value(x, y, Flow > 0. ? Flow : 0.);
 
-	return( true );
+	return( Flow_Out );
+}
+
+//---------------------------------------------------------
+// Flow after the lateral balance, which has only been
+// calculated within the lateral range of each row.
+//---------------------------------------------------------
+inline double COverland_Flow::Get_Flow_Lateral(int x, int y)
+{
+	return( x >= m_Lateral_xMin[y] && x <= m_Lateral_xMax[y] ? m_Flow.asDouble(x, y) : m_pFlow->asDouble(x, y) );
 }
 
 
@@ -848,7 +1141,7 @@ bool COverland_Flow::Set_Flow_Vertical(int x, int y)
 		}
 	}
 
-	double	Q    = P + m_Flow.asDouble(x, y) + (m_pPonding ? m_pPonding->asDouble(x, y) : 0.);
+	double	Q    = P + Get_Flow_Lateral(x, y) + (m_pPonding ? m_pPonding->asDouble(x, y) : 0.);
 
 	//-----------------------------------------------------
 	if( Q > 0. )
@@ -922,6 +1215,11 @@ bool COverland_Flow::Set_Flow_Vertical(int x, int y)
 	//-----------------------------------------------------
 	m_pFlow->Set_Value(x, y, Q);
 
+	if( m_pVelocity && Q <= 0. )
+	{
+		m_pVelocity->Set_Value(x, y, 0.);
+	}
+
 	return( true );
 }
 
@@ -85,9 +85,13 @@ private:
 
 	bool					m_bStrickler, m_bFlow_Out;
 
+	int						m_nLevels;
+
 	double					m_dTime, m_vMax, m_vMin, m_Flow_Out;
 
-	CSG_Grid				*m_pDEM, m_Flow, *m_pFlow, *m_pVelocity, *m_pIntercept, *m_pPonding, *m_pInfiltrat;
+	CSG_Array_Int			m_Wet_xMin, m_Wet_xMax, m_Lateral_xMin, m_Lateral_xMax;
+
+	CSG_Grid				*m_pDEM, m_Flow, *m_pFlow, *m_pVelocity, *m_pIntercept, *m_pPonding, *m_pInfiltrat, m_Level, m_Weather[2];
 
 	double					  m_Roughness,   m_Precipitation,   m_ETpot,   m_Intercept_max,   m_Ponding_max,   m_Infiltrat_max;
 	CSG_Grid				*m_pRoughness, *m_pPrecipitation, *m_pETpot, *m_pIntercept_max, *m_pPonding_max, *m_pInfiltrat_max;
@@ -102,8 +106,16 @@ private:
 
 	bool					Set_Time_Stamp			(double Time);
 
+	bool					Set_Weather				(CSG_Grid *&pGrid, CSG_Grid &Weather, double Default);
+
 	bool					Do_Time_Step			(void);
 
+	void					Get_Range				(int y, int Margin, int &xMin, int &xMax);
+	void					Set_Lateral_Range		(void);
+	bool					Set_Time_Levels			(void);
+	int						Get_Time_Level			(int x, int y);
+	bool					is_Active				(int x, int y, int Step);
+
 	double					Get_Precipitation		(int x, int y);
 	double					Get_ETpot				(int x, int y);
 
@@ -117,10 +129,12 @@ private:
 	double					Get_Slope				(int x, int y, int i);
 
 	double					Get_Velocity			(double Flow, double Slope, double Roughness);
-	bool					Get_Velocity			(int x, int y);
+	double					Get_Velocity			(int x, int y);
+	double					Get_Velocities			(int Step);
 
-	double					Get_Flow_Lateral		(int x, int y, int i, bool bInverse);
-	bool					Set_Flow_Lateral		(int x, int y);
+	double					Get_Flow_Lateral		(int x, int y, int i, bool bInverse, int Step);
+	double					Set_Flow_Lateral		(int x, int y, int Step);
+	double					Get_Flow_Lateral		(int x, int y);
 
 	bool					Set_Flow_Vertical		(int x, int y);
 
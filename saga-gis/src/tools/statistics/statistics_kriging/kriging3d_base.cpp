@@ -49,6 +49,19 @@
 
 #include "kriging3d_base.h"
 
+#include <algorithm>
+#include <vector>
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#define BLOCK_SIZE	8	// cells per block side, local neighbourhoods are grouped within blocks
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -290,7 +303,9 @@ bool CKriging3D_Base::On_Execute(void)
 
 	m_Block		= Parameters("BLOCK")->asBool() ? Parameters("DBLOCK")->asDouble() / 2. : 0.;
 
-	bool	bLog	= Parameters("LOG")->asBool();
+	bool	bLog	= m_bLog = Parameters("LOG")->asBool();
+
+	m_Log_Offset	= pPoints->Get_Minimum(Field);
 
 	//-----------------------------------------------------
 	int	zField	= pPoints->Get_Vertex_Type() > SG_VERTEX_TYPE_XY ? -1
@@ -350,11 +365,33 @@ bool CKriging3D_Base::On_Execute(void)
 	//-----------------------------------------------------
 	if( bResult )
 	{
-		bool	bStdDev	= Parameters("TQUALITY")->asInt() == 0;
+		m_bStdDev	= Parameters("TQUALITY")->asInt() == 0;
+
+		m_zScale	= zScale;
 
 		Message_Fmt("\n%s: %s", _TL("Variogram Model"), m_Model.Get_Formula(SG_TREND_STRING_Formula_Parameters).c_str());
 
-		for(int y=0; y<m_pValue->Get_NY() && Set_Progress(y, m_pValue->Get_NY()); y++)
+		if( m_Search.is_Okay() )	// local, blocks of cells sharing the same neighbourhood use the same factorisation
+		{
+			int	nx	= 1 + (m_pValue->Get_NX() - 1) / BLOCK_SIZE;
+			int	ny	= 1 + (m_pValue->Get_NY() - 1) / BLOCK_SIZE;
+			int	nz	= 1 + (m_pValue->Get_NZ() - 1) / BLOCK_SIZE;
+
+			for(int y=0; y<ny && Set_Progress(y, ny); y++)
+			{
+				#ifndef _DEBUG
+				#pragma omp parallel for
+				#endif // !_DEBUG
+				for(int x=0; x<nx; x++)
+				{
+					for(int z=0; z<nz; z++)
+					{
+						_Set_Block(x * BLOCK_SIZE, y * BLOCK_SIZE, z * BLOCK_SIZE);
+					}
+				}
+			}
+		}
+		else for(int y=0; y<m_pValue->Get_NY() && Set_Progress(y, m_pValue->Get_NY()); y++)
 		{
 			double	py = m_pValue->Get_YMin() + y * m_pValue->Get_Cellsize();
 
@@ -369,24 +406,7 @@ bool CKriging3D_Base::On_Execute(void)
 				{
 					double	v, e, pz = m_pValue->Get_Z(z) * zScale;
 
-					if( Get_Value(px, py, pz, v, e) )
-					{
-						if( bLog )
-						{
-							v	= exp(v) - 1. + pPoints->Get_Minimum(Field);
-						}
-
-						if( bStdDev )
-						{
-							e	= sqrt(e);
-						}
-
-						Set_Value(x, y, z, v, e);
-					}
-					else
-					{
-						Set_NoData(x, y, z);
-					}
+					_Set_Value(x, y, z, Get_Value(px, py, pz, v, e), v, e);
 				}
 			}
 		}
@@ -397,7 +417,8 @@ bool CKriging3D_Base::On_Execute(void)
 	//-----------------------------------------------------
 	m_Model.Clr_Data();
 
-	m_Search.Destroy();
+	m_Search     .Destroy();
+	m_Permutation.Destroy();
 	m_W     .Destroy();
 	m_Points.Destroy();
 
@@ -465,7 +486,7 @@ bool CKriging3D_Base::_Init_Search(bool bUpdate)
 {
 	if( m_Search_Options.Do_Use_All(bUpdate) )	// global
 	{
-		return( Get_Weights(m_Points, m_W) );
+		return( Get_Factors(m_Points, m_W, m_Permutation) );
 	}
 
 	return( m_Search.Create(m_Points) );	// local
@@ -499,6 +520,197 @@ bool CKriging3D_Base::Get_Points(double x, double y, double z, CSG_Matrix &Point
 	return( false );
 }
 
+//---------------------------------------------------------
+// Returns the indices of the neighbourhood's points in
+// ascending order, so that neighbourhoods can be compared.
+//---------------------------------------------------------
+bool CKriging3D_Base::Get_Points(double x, double y, double z, CSG_Array_Int &Index)
+{
+	if( m_Search.is_Okay() )
+	{
+		CSG_Vector	Distance;
+
+		m_Search.Get_Nearest_Points(x, y, z, m_Search_Options.Get_Max_Points(), m_Search_Options.Get_Radius(), Index, Distance);
+
+		if( Index.Get_Size() >= m_Search_Options.Get_Min_Points() && Index.Get_Size() > 0 )
+		{
+			std::sort(Index.Get_Array(), Index.Get_Array() + Index.Get_Size());
+
+			return( true );
+		}
+	}
+
+	return( false );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// The kriging matrix is not positive definite, so it is
+// factorised with the pivoting LU decomposition, and the
+// factors are solved for each prediction location.
+//---------------------------------------------------------
+bool CKriging3D_Base::Get_Factors(const CSG_Matrix &Points, CSG_Matrix &W, CSG_Array_Int &Permutation)
+{
+	if( !Get_Weights(Points, W) )
+	{
+		return( false );
+	}
+
+	return( SG_Matrix_LU_Decomposition(W.Get_NRows(), Permutation.Create(W.Get_NRows()), W.Get_Data(), m_Search.is_Okay()) );
+}
+
+//---------------------------------------------------------
+bool CKriging3D_Base::Get_Value(double x, double y, double z, const CSG_Matrix &Points, const CSG_Matrix &W, const CSG_Array_Int &Permutation, double &v, double &e)
+{
+	CSG_Vector	G;
+
+	if( !Get_Weights(x, y, z, Points, G) )
+	{
+		return( false );
+	}
+
+	CSG_Vector	Lambda(G);
+
+	if( !SG_Matrix_LU_Solve(W.Get_NRows(), Permutation.Get_Array(), W, Lambda.Get_Data()) )
+	{
+		return( false );
+	}
+
+	v	= 0.;
+	e	= 0.;
+
+	for(int i=0; i<Points.Get_NRows(); i++)
+	{
+		v	+= Lambda[i] * Points[i][3];
+		e	+= Lambda[i] * G[i];
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CKriging3D_Base::Get_Value(double x, double y, double z, double &v, double &e)
+{
+	if( !m_Search.is_Okay() )	// global
+	{
+		return( Get_Value(x, y, z, m_Points, m_W, m_Permutation, v, e) );
+	}
+
+	CSG_Matrix	Points, W;	CSG_Array_Int	Permutation;	// local
+
+	return( Get_Points(x, y, z, Points) && Get_Factors(Points, W, Permutation) && Get_Value(x, y, z, Points, W, Permutation, v, e) );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+void CKriging3D_Base::_Set_Value(int x, int y, int z, bool bOkay, double v, double e)
+{
+	if( bOkay )
+	{
+		if( m_bLog )
+		{
+			v	= exp(v) - 1. + m_Log_Offset;
+		}
+
+		if( m_bStdDev )
+		{
+			e	= sqrt(e);
+		}
+
+		Set_Value(x, y, z, v, e);
+	}
+	else
+	{
+		Set_NoData(x, y, z);
+	}
+}
+
+//---------------------------------------------------------
+// Groups the cells of a block by their neighbourhood. The
+// kriging matrix of each group is factorised once and then
+// solved for all cells of the group.
+//---------------------------------------------------------
+void CKriging3D_Base::_Set_Block(int xMin, int yMin, int zMin)
+{
+	int	xMax	= M_GET_MIN(xMin + BLOCK_SIZE, m_pValue->Get_NX());
+	int	yMax	= M_GET_MIN(yMin + BLOCK_SIZE, m_pValue->Get_NY());
+	int	zMax	= M_GET_MIN(zMin + BLOCK_SIZE, m_pValue->Get_NZ());
+
+	int	nx = xMax - xMin, nxy = nx * (yMax - yMin), nCells = nxy * (zMax - zMin);
+
+	std::vector<CSG_Array_Int>	Groups;	CSG_Array_Int	Group(nCells), Index;
+
+	for(int i=0; i<nCells; i++)
+	{
+		double	px	= m_pValue->Get_XMin() + (xMin + i % nx       ) * m_pValue->Get_Cellsize();
+		double	py	= m_pValue->Get_YMin() + (yMin + (i % nxy) / nx) * m_pValue->Get_Cellsize();
+		double	pz	= m_pValue->Get_Z    (zMin + i / nxy) * m_zScale;
+
+		Group[i]	= -1;
+
+		if( Get_Points(px, py, pz, Index) )
+		{
+			for(size_t j=0; Group[i]<0 && j<Groups.size(); j++)
+			{
+				if( Groups[j].Get_Size() == Index.Get_Size() && !memcmp(Groups[j].Get_Array(), Index.Get_Array(), Index.Get_Size() * sizeof(int)) )
+				{
+					Group[i]	= (int)j;
+				}
+			}
+
+			if( Group[i] < 0 )
+			{
+				Group[i]	= (int)Groups.size();
+
+				Groups.push_back(Index);
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	for(size_t j=0; j<Groups.size(); j++)
+	{
+		CSG_Matrix	Points(4, (int)Groups[j].Get_Size()), W;	CSG_Array_Int	Permutation;
+
+		for(int k=0; k<Points.Get_NRows(); k++)
+		{
+			Points.Set_Row(k, m_Points[Groups[j][k]]);
+		}
+
+		bool	bOkay	= Get_Factors(Points, W, Permutation);
+
+		for(int i=0; i<nCells; i++)
+		{
+			if( Group[i] == (int)j )
+			{
+				int	x = xMin + i % nx, y = yMin + (i % nxy) / nx, z = zMin + i / nxy;
+
+				double	v, e, px = m_pValue->Get_XMin() + x * m_pValue->Get_Cellsize();
+				double	      py = m_pValue->Get_YMin() + y * m_pValue->Get_Cellsize();
+				double	      pz = m_pValue->Get_Z(z) * m_zScale;
+
+				_Set_Value(x, y, z, bOkay && Get_Value(px, py, pz, Points, W, Permutation, v, e), v, e);
+			}
+		}
+	}
+
+	for(int i=0; i<nCells; i++)
+	{
+		if( Group[i] < 0 )
+		{
+			Set_NoData(xMin + i % nx, yMin + (i % nxy) / nx, zMin + i / nxy);
+		}
+	}
+}
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -77,6 +77,8 @@ protected:
 
 	CSG_Matrix						m_Points, m_W;
 
+	CSG_Array_Int					m_Permutation;
+
 	CSG_KDTree_2D					m_Search;
 
 	CSG_Parameters_PointSearch		m_Search_Options;
@@ -89,12 +91,17 @@ protected:
 
 	virtual bool					Init_Points				(CSG_Shapes *pPoints, int Field, bool bLog);
 
-	bool							Get_Points				(double x, double y, CSG_Matrix &Points);
+	bool							Get_Points				(double x, double y, CSG_Matrix    &Points);
+	bool							Get_Points				(double x, double y, CSG_Array_Int &Index );
 
 	virtual bool					Get_Weights				(const CSG_Matrix &Points, CSG_Matrix &W)	= 0;
+	virtual bool					Get_Weights				(double x, double y, const CSG_Matrix &Points, CSG_Vector &G)	= 0;
+
+	bool							Get_Factors				(const CSG_Matrix &Points, CSG_Matrix &W, CSG_Array_Int &Permutation);
 
-	virtual bool					Get_Value				(double x, double y, double &v, double &e)	= 0;
-	virtual bool					Get_Value				(const double    *c, double &v, double &e)	{	return( Get_Value(c[0], c[1], v, e) );	}
+	bool							Get_Value				(double x, double y, const CSG_Matrix &Points, const CSG_Matrix &W, const CSG_Array_Int &Permutation, double &v, double &e);
+	bool							Get_Value				(double x, double y, double &v, double &e);
+	bool							Get_Value				(const double    *c, double &v, double &e)	{	return( Get_Value(c[0], c[1], v, e) );	}
 
 	double							Get_Weight				(double d)				{	d = m_Model.Get_Value(d); return( d > 0. ? d : 0. );	}
 	double							Get_Weight				(double dx, double dy)	{	return( Get_Weight(sqrt(dx*dx + dy*dy))           );	}
@@ -130,7 +137,9 @@ protected:
 
 private:
 
-	double							m_Block;
+	bool							m_bLog, m_bStdDev;
+
+	double							m_Block, m_Log_Offset;
 
 	CSG_Trend						m_Model;
 
@@ -145,6 +154,9 @@ private:
 
 	bool							_Init_Search			(bool bUpdate = false);
 
+	void							_Set_Value				(int x, int y, bool bOkay, double v, double e);
+	void							_Set_Block				(int xMin, int yMin);
+
 	bool							_Get_Cross_Validation	(void);
 
 };
@@ -94,7 +94,7 @@ bool CKriging_Simple::Get_Weights(const CSG_Matrix &Points, CSG_Matrix &W)
 		}
 	}
 
-	return( W.Set_Inverse(m_Search.is_Okay(), n) );
+	return( true );
 }
 
 
@@ -103,50 +103,20 @@ bool CKriging_Simple::Get_Weights(const CSG_Matrix &Points, CSG_Matrix &W)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-bool CKriging_Simple::Get_Value(double x, double y, double &v, double &e)
+bool CKriging_Simple::Get_Weights(double x, double y, const CSG_Matrix &Points, CSG_Vector &G)
 {
-	CSG_Matrix	__Points, __W;	double	**P, **W;	int	i, n = 0;
-
-	if( !m_Search.is_Okay() )	// global
-	{
-		n	= m_Points.Get_NRows();
-		P	= m_Points.Get_Data ();
-		W	= m_W     .Get_Data ();
-	}
-	else if( Get_Points(x, y, __Points) && Get_Weights(__Points, __W) )	// local
-	{
-		n	= __Points.Get_NRows();
-		P	= __Points.Get_Data ();
-		W	= __W     .Get_Data ();
-	}
+	int	n	= Points.Get_NRows();
 
-	if( n < 1 )
+	if( n < 1 || !G.Create(n) )
 	{
 		return( false );
 	}
 
-	//-----------------------------------------------------
-	CSG_Vector	G(n);
-
-	for(i=0; i<n; i++)
-	{
-		G[i]	= Get_Weight(x, y, P[i][0], P[i][1]);
-	}
-
-	for(i=0, v=0., e=0.; i<n; i++)
+	for(int i=0; i<n; i++)
 	{
-		double	Lambda	= 0.;
-
-		for(int j=0; j<n; j++)
-		{
-			Lambda	+= W[i][j] * G[j];
-		}
-
-		v	+= Lambda * P[i][2];
-		e	+= Lambda * G[i];
+		G[i]	= Get_Weight(x, y, Points[i][0], Points[i][1]);
 	}
 
-	//-----------------------------------------------------
 	return( true );
 }
 
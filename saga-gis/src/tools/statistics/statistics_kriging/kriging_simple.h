@@ -76,7 +76,7 @@ protected:
 
 	virtual bool			Get_Weights			(const CSG_Matrix &Points, CSG_Matrix &W);
 
-	virtual bool			Get_Value			(double x, double y, double &v, double &e);
+	virtual bool			Get_Weights			(double x, double y, const CSG_Matrix &Points, CSG_Vector &G);
 
 };
 
@@ -201,7 +201,7 @@ bool CKriging_Universal::Get_Weights(const CSG_Matrix &Points, CSG_Matrix &W)
 		}
 	}
 
-	return( W.Set_Inverse(m_Search.is_Okay(), n + 1 + nGrids + nCoords) );
+	return( true );
 }
 
 
@@ -210,37 +210,21 @@ bool CKriging_Universal::Get_Weights(const CSG_Matrix &Points, CSG_Matrix &W)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-bool CKriging_Universal::Get_Value(double x, double y, double &v, double &e)
+bool CKriging_Universal::Get_Weights(double x, double y, const CSG_Matrix &Points, CSG_Vector &G)
 {
-	CSG_Matrix	__Points, __W;	double	**P, **W;	int	i, j, n = 0;
+	int	i, j, n	= Points.Get_NRows();
 
-	if( !m_Search.is_Okay() )	// global
-	{
-		n	= m_Points.Get_NRows();
-		P	= m_Points.Get_Data ();
-		W	= m_W     .Get_Data ();
-	}
-	else if( Get_Points(x, y, __Points) && Get_Weights(__Points, __W) )	// local
-	{
-		n	= __Points.Get_NRows();
-		P	= __Points.Get_Data ();
-		W	= __W     .Get_Data ();
-	}
+	int	nCoords	= m_bCoords ? 2 : 0;
+	int	nGrids	= m_pPredictors->Get_Grid_Count();
 
-	if( n < 1 )
+	if( n < 1 || !G.Create(n + 1 + nGrids + nCoords) )
 	{
 		return( false );
 	}
 
-	//-----------------------------------------------------
-	int	nCoords	= m_bCoords ? 2 : 0;
-	int	nGrids	= m_pPredictors->Get_Grid_Count();
-
-	CSG_Vector	G(n + 1 + nGrids + nCoords);
-
 	for(i=0; i<n; i++)
 	{
-		G[i]	= Get_Weight(x, y, P[i][0], P[i][1]);
+		G[i]	= Get_Weight(x, y, Points[i][0], Points[i][1]);
 	}
 
 	G[n]	= 1.;
@@ -259,20 +243,6 @@ bool CKriging_Universal::Get_Value(double x, double y, double &v, double &e)
 		G[n + 2 + nGrids]	= y;
 	}
 
-	for(i=0, v=0., e=0.; i<n; i++)
-	{
-		double	Lambda	= 0.;
-
-		for(j=0; j<=n+nGrids+nCoords; j++)
-		{
-			Lambda	+= W[i][j] * G[j];
-		}
-
-		v	+= Lambda * P[i][2];
-		e	+= Lambda * G[i];
-	}
-
-	//-----------------------------------------------------
 	return( true );
 }
 
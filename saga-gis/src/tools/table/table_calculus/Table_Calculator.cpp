@@ -231,20 +231,7 @@ bool CTable_Calculator_Base::On_Execute(void)
 	g_NoData_loValue	= pTable->Get_NoData_Value(false);
 	g_NoData_hiValue	= pTable->Get_NoData_Value(true );
 
-	if( pTable->Get_Selection_Count() > 0 && Parameters("SELECTION")->asBool() )
-	{
-		for(size_t i=0; i<pTable->Get_Selection_Count() && Set_Progress(i, pTable->Get_Selection_Count()); i++)
-		{
-			Get_Value(pTable->Get_Selection(i));
-		}
-	}
-	else
-	{
-		for(int i=0; i<pTable->Get_Count() && Set_Progress(i, pTable->Get_Count()); i++)
-		{
-			Get_Value(pTable->Get_Record(i));
-		}
-	}
+	Get_Values(pTable, pTable->Get_Selection_Count() > 0 && Parameters("SELECTION")->asBool());
 
 	//-----------------------------------------------------
 	if( pTable == Parameters("TABLE")->asTable() )
@@ -261,32 +248,73 @@ bool CTable_Calculator_Base::On_Execute(void)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-bool CTable_Calculator_Base::Get_Value(CSG_Table_Record *pRecord)
+// Records are processed in blocks, so that the formula is
+// evaluated for many records with one call.
+//---------------------------------------------------------
+bool CTable_Calculator_Base::Get_Values(CSG_Table *pTable, bool bSelection)
 {
-	CSG_Vector	Values(m_Values.Get_Size());
+	const int	nBlock	= 4096;
+
+	int		nValues		= (int)m_Values.Get_Size();
+
+	sLong	nRecords	= bSelection ? (sLong)pTable->Get_Selection_Count() : (sLong)pTable->Get_Count();
 
-	bool	bNoData	= false;
+	CSG_Array	Values(sizeof(double), (size_t)nValues * nBlock), Results(sizeof(double), nBlock), NoData(sizeof(BYTE), nBlock);
 
-	for(int i=0; i<m_Values.Get_Size(); i++)
+	double	*pValues	= (double *)Values .Get_Array();
+	double	*pResults	= (double *)Results.Get_Array();
+	BYTE	*pNoData	= (BYTE   *)NoData .Get_Array();
+
+	const double	*Columns[26];
+
+	for(int i=0; i<nValues; i++)
 	{
-		Values[i]	= pRecord->asDouble(m_Values[i]);
+		Columns[i]	= pValues + (size_t)i * nBlock;
+	}
 
-		if( !m_bNoData && pRecord->is_NoData(m_Values[i]) )
+	//-----------------------------------------------------
+	for(sLong iOffset=0; iOffset<nRecords && Set_Progress(iOffset, nRecords); iOffset+=nBlock)
+	{
+		int	n	= (int)M_GET_MIN((sLong)nBlock, nRecords - iOffset);
+
+		for(int iRecord=0; iRecord<n; iRecord++)
 		{
-			bNoData	= true;
+			CSG_Table_Record	*pRecord	= bSelection ? pTable->Get_Selection((size_t)(iOffset + iRecord)) : pTable->Get_Record((int)(iOffset + iRecord));
+
+			pNoData[iRecord]	= 0;
+
+			for(int i=0; i<nValues; i++)
+			{
+				pValues[(size_t)i * nBlock + iRecord]	= pRecord->asDouble(m_Values[i]);
+
+				if( !m_bNoData && pRecord->is_NoData(m_Values[i]) )
+				{
+					pNoData[iRecord]	= 1;
+				}
+			}
 		}
-	}
 
-	if( bNoData == false )
-	{
-		pRecord->Set_Value(m_Result, m_Formula.Get_Value(Values));
+		if( !m_Formula.Get_Values(Columns, nValues, pResults, n) )
+		{
+			return( false );
+		}
 
-		return( true );
+		for(int iRecord=0; iRecord<n; iRecord++)
+		{
+			CSG_Table_Record	*pRecord	= bSelection ? pTable->Get_Selection((size_t)(iOffset + iRecord)) : pTable->Get_Record((int)(iOffset + iRecord));
+
+			if( pNoData[iRecord] )
+			{
+				pRecord->Set_NoData(m_Result);
+			}
+			else
+			{
+				pRecord->Set_Value(m_Result, pResults[iRecord]);
+			}
+		}
 	}
 
-	pRecord->Set_NoData(m_Result);
-
-	return( false );
+	return( true );
 }
 
 
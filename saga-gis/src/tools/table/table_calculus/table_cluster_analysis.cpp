@@ -74,6 +74,16 @@ CTable_Cluster_Analysis::CTable_Cluster_Analysis(bool bShapes)
 		"J. Theoretical Biology, 15:103-144."
 	);
 
+	Add_Reference("Arthur, D., Vassilvitskii, S.", "2007",
+		"k-means++: the advantages of careful seeding",
+		"Proceedings of the 18th Annual ACM-SIAM Symposium on Discrete Algorithms, 1027-1035."
+	);
+
+	Add_Reference("Sculley, D.", "2010",
+		"Web-scale k-means clustering",
+		"Proceedings of the 19th International Conference on World Wide Web, 1177-1178."
+	);
+
 	//-----------------------------------------------------
 	if( (m_bShapes = bShapes) == true )
 	{
@@ -110,24 +120,63 @@ CTable_Cluster_Analysis::CTable_Cluster_Analysis(bool bShapes)
 	Parameters.Add_Choice("",
 		"METHOD"		, _TL("Method"),
 		_TL(""),
-		CSG_String::Format("%s|%s|%s",
+		CSG_String::Format("%s|%s|%s|%s",
 			_TL("Iterative Minimum Distance (Forgy 1965)"),
 			_TL("Hill-Climbing (Rubin 1967)"),
-			_TL("Combined Minimum Distance / Hillclimbing") 
+			_TL("Combined Minimum Distance / Hillclimbing"),
+			_TL("Mini-Batch K-Means (Sculley 2010)")
 		), 1
 	);
 
+	Parameters.Add_Int("METHOD",
+		"BATCH_SIZE"	, _TL("Batch Size"),
+		_TL("Number of randomly drawn records per mini-batch."),
+		1024, 1, true
+	);
+
 	Parameters.Add_Int("",
 		"NCLUSTER"	, _TL("Number of Clusters"),
 		_TL(""),
 		10, 2, true
 	);
 
+	Parameters.Add_Int("",
+		"MAXITER"	, _TL("Maximum Iterations"),
+		_TL("maximum number of iterations, ignored if set to zero (default), for mini-batch k-means the number of batches"),
+		0, 0, true
+	);
+
 	Parameters.Add_Bool("",
 		"NORMALISE"	, _TL("Normalise"),
 		_TL(""),
 		false
 	);
+
+	Parameters.Add_Choice("",
+		"INITIALIZE", _TL("Start Partition"),
+		_TL(""),
+		CSG_String::Format("%s|%s|%s",
+			_TL("random"),
+			_TL("periodical"),
+			_TL("k-means++")
+		), 0
+	);
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+int CTable_Cluster_Analysis::On_Parameters_Enable(CSG_Parameters *pParameters, CSG_Parameter *pParameter)
+{
+	if( pParameter->Cmp_Identifier("METHOD") )
+	{
+		pParameters->Set_Enabled("BATCH_SIZE", pParameter->asInt() == 3);
+	}
+
+	return( CSG_Tool::On_Parameters_Enable(pParameters, pParameter) );
 }
 
 
@@ -233,7 +282,15 @@ bool CTable_Cluster_Analysis::On_Execute(void)
 	}
 
 	//-----------------------------------------------------
-	bool	bResult	= Analysis.Execute(Parameters("METHOD")->asInt(), Parameters("NCLUSTER")->asInt());
+	int	Initialize	= Parameters("INITIALIZE")->asInt();	// there are no cluster values to keep (2)
+
+	bool	bResult	= Analysis.Execute(
+		Parameters("METHOD"    )->asInt(),
+		Parameters("NCLUSTER"  )->asInt(),
+		Parameters("MAXITER"   )->asInt(),
+		Initialize == 2 ? 3 : Initialize,
+		Parameters("BATCH_SIZE")->asInt()
+	);
 
 	for(iElement=0, nElements=0; iElement<pTable->Get_Count(); iElement++)
 	{
@@ -77,6 +77,8 @@ public:
 
 protected:
 
+	virtual int				On_Parameters_Enable	(CSG_Parameters *pParameters, CSG_Parameter *pParameter);
+
 	virtual bool			On_Execute		(void);
 
 
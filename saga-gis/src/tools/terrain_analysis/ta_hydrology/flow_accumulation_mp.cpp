@@ -62,7 +62,10 @@ CFlow_Accumulation_MP::CFlow_Accumulation_MP(void)
 	Set_Author		("O.Conrad (c) 2018");
 
 	Set_Description	(_TW(
-		"A simple implementation of a parallelizable flow accumulation algorithn."
+		"A simple implementation of a parallelizable flow accumulation algorithm. "
+		"Cells are processed in topological order: a cell is accumulated as soon as all of its donor cells are finished, "
+		"and all cells becoming ready at the same time are processed in parallel. "
+		"Flow proportions are stored quantized with a resolution of 1/255."
 	));
 
 	Add_Reference("Freeman, G.T.", "1991",
@@ -140,6 +143,10 @@ int CFlow_Accumulation_MP::On_Parameters_Enable(CSG_Parameters *pParameters, CSG
 //														 //
 ///////////////////////////////////////////////////////////
 
+//---------------------------------------------------------
+#define DONORS_ACTIVE	0xFE	// cell is accumulated in the current level
+#define DONORS_DONE		0xFF	// cell's accumulation is final (or no-data)
+
 //---------------------------------------------------------
 bool CFlow_Accumulation_MP::On_Execute(void)
 {
@@ -153,39 +160,64 @@ bool CFlow_Accumulation_MP::On_Execute(void)
 	}
 
 	//-----------------------------------------------------
-	bool	bChanged;	int	nPasses	= 1;
+	// dependency counting (Kahn's algorithm), a cell is released
+	// for accumulation as soon as all of its donors are finished,
+	// cells released at the same time are processed in parallel
+
+	int	Update	= Parameters("UPDATE")->asInt(), nLevels = 0;
+
+	BYTE	*Donors	= (BYTE *)m_Donors.Get_Array();
+
+	std::vector<sLong>	Level;	std::vector<std::vector<sLong> >	Next(SG_OMP_Get_Max_Num_Threads());
 
-	int	Update	= Parameters("UPDATE")->asInt();
+	for(sLong n=0; n<Get_NCells(); n++)
+	{
+		if( Donors[n] == 0 )
+		{
+			Level.push_back(n);
+		}
+	}
 
-	do
+	for(sLong nDone=0; !Level.empty() && Set_Progress_NCells(nDone); nDone+=Level.size())
 	{
-		Process_Set_Text(CSG_String::Format("%s %d", _TL("pass"), nPasses++));
+		Process_Set_Text(CSG_String::Format("%s %d", _TL("level"), ++nLevels));
 
-		bChanged	= false;
+		sLong	nCells	= (sLong)Level.size();
 
-		#ifndef _DEBUG
 		#pragma omp parallel for
-		#endif
-		for(int y=0; y<Get_NY(); y++)
+		for(sLong i=0; i<nCells; i++)
 		{
-			for(int x=0; x<Get_NX(); x++)
-			{
-				if( Get_Flow(x, y) )
-				{
-					bChanged	= true;
-				}
-			}
+			Get_Flow(Level[i]);
+		}
+
+		#pragma omp parallel for
+		for(sLong i=0; i<nCells; i++)
+		{
+			Get_Next(Level[i], Next[SG_OMP_Get_Thread_Num()]);
 		}
 
-		if( Update > 0 && nPasses % Update == 0 )
+		#pragma omp parallel for
+		for(sLong i=0; i<nCells; i++)
+		{
+			Donors[Level[i]]	= DONORS_DONE;
+		}
+
+		//-------------------------------------------------
+		Level.clear();
+
+		for(size_t i=0; i<Next.size(); i++)
+		{
+			Level.insert(Level.end(), Next[i].begin(), Next[i].end()); Next[i].clear();
+		}
+
+		if( Update > 0 && nLevels % Update == 0 )
 		{
 			DataObject_Update(m_pFlow);
 		}
 	}
-	while( bChanged && Process_Get_Okay() );
 
 	//-----------------------------------------------------
-	Message_Fmt("\n%s: %d", _TL("number of passes"), nPasses);
+	Message_Fmt("\n%s: %d", _TL("number of levels"), nLevels);
 
 	DataObject_Set_Colors   (m_pFlow, 11, SG_COLORS_WHITE_BLUE);
 	DataObject_Set_Parameter(m_pFlow, "METRIC_SCALE_MODE",   1);	// increasing geometrical intervals
@@ -211,12 +243,11 @@ bool CFlow_Accumulation_MP::Initialize(void)
 	m_pFlow->Set_NoData_Value(0.0);
 
 	//-----------------------------------------------------
-	for(int i=0; i<8; i++)
+	// flow proportions are stored quantised to 8 bytes per cell, summing up to 255
+
+	if( !m_Flow.Create(8 * sizeof(BYTE), (size_t)Get_NCells()) || !m_Donors.Create(sizeof(BYTE), (size_t)Get_NCells()) )
 	{
-		if( !m_Flow[i].Create(Get_System()) )
-		{
-			return( false );
-		}
+		return( false );
 	}
 
 	//-----------------------------------------------------
@@ -231,13 +262,51 @@ bool CFlow_Accumulation_MP::Initialize(void)
 	{
 		for(int x=0; x<Get_NX(); x++)
 		{
+			double	Proportion[8]	= { 0., 0., 0., 0., 0., 0., 0., 0. };
+
 			if( !m_pDEM->is_NoData(x, y) )
 			{
 				switch( Method )
 				{
-				case  0: Set_D8  (x, y   ); break;
-				case  1: Set_Dinf(x, y   ); break;
-				default: Set_MFD (x, y, c); break;
+				case  0: Get_D8  (x, y, Proportion   ); break;
+				case  1: Get_Dinf(x, y, Proportion   ); break;
+				default: Get_MFD (x, y, Proportion, c); break;
+				}
+			}
+
+			Set_Proportions(Get_System().Get_IndexFromRowCol(x, y), Proportion);
+		}
+	}
+
+	//-----------------------------------------------------
+	BYTE	*Donors	= (BYTE *)m_Donors.Get_Array();
+
+	#ifndef _DEBUG
+	#pragma omp parallel for
+	#endif
+	for(int y=0; y<Get_NY(); y++)
+	{
+		for(int x=0; x<Get_NX(); x++)
+		{
+			sLong	n	= Get_System().Get_IndexFromRowCol(x, y);
+
+			if( m_pDEM->is_NoData(x, y) )
+			{
+				Donors[n]	= DONORS_DONE;
+			}
+			else
+			{
+				Donors[n]	= 0;
+
+				for(int i=0; i<8; i++)
+				{
+					int	ix	= Get_xFrom(i, x);
+					int	iy	= Get_yFrom(i, y);
+
+					if( is_InGrid(ix, iy) && Get_Proportions(Get_System().Get_IndexFromRowCol(ix, iy))[i] > 0 )
+					{
+						Donors[n]++;
+					}
 				}
 			}
 		}
@@ -250,10 +319,8 @@ bool CFlow_Accumulation_MP::Initialize(void)
 //---------------------------------------------------------
 bool CFlow_Accumulation_MP::Finalize(void)
 {
-	for(int i=0; i<8; i++)
-	{
-		m_Flow[i].Destroy();
-	}
+	m_Flow  .Destroy();
+	m_Donors.Destroy();
 
 	return( true );
 }
@@ -264,7 +331,54 @@ bool CFlow_Accumulation_MP::Finalize(void)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-bool CFlow_Accumulation_MP::Set_D8(int x, int y)
+void CFlow_Accumulation_MP::Set_Proportions(sLong n, double Proportion[8])
+{
+	BYTE	*Flow	= Get_Proportions(n);
+
+	double	Sum	= 0.;
+
+	for(int i=0; i<8; i++)
+	{
+		Sum	+= Proportion[i];
+	}
+
+	if( Sum <= 0. )
+	{
+		memset(Flow, 0, 8 * sizeof(BYTE));
+
+		return;
+	}
+
+	//-----------------------------------------------------
+	int	Total	= 0;	double	Rest[8];
+
+	for(int i=0; i<8; i++)
+	{
+		double	q	= 255. * Proportion[i] / Sum;
+
+		Total	+= Flow[i] = (BYTE)q;
+
+		Rest[i]	= Proportion[i] > 0. ? q - Flow[i] : -1.;
+	}
+
+	for( ; Total<255; Total++)	// largest remainders get the missing units
+	{
+		int	iMax	= 0;
+
+		for(int i=1; i<8; i++)
+		{
+			if( Rest[iMax] < Rest[i] )
+			{
+				iMax	= i;
+			}
+		}
+
+		Flow[iMax]++;	Rest[iMax]	= -1.;
+	}
+}
+
+//---------------------------------------------------------
+bool CFlow_Accumulation_MP::Get_D8(int x, int y, double Proportion[8])
 {
 	int	i	= m_pDEM->Get_Gradient_NeighborDir(x, y);
 
@@ -273,13 +387,13 @@ bool CFlow_Accumulation_MP::Set_D8(int x, int y)
 		return( false );
 	}
 
-	m_Flow[i].Set_Value(x, y, 1.);
+	Proportion[i]	= 1.;
 
 	return( true );
 }
 
 //---------------------------------------------------------
-bool CFlow_Accumulation_MP::Set_Dinf(int x, int y)
+bool CFlow_Accumulation_MP::Get_Dinf(int x, int y, double Proportion[8])
 {
 	double	s, a;
 
@@ -294,53 +408,32 @@ bool CFlow_Accumulation_MP::Set_Dinf(int x, int y)
 		{
 			double	d	= fmod(a, M_PI_045) / M_PI_045;
 
-			m_Flow[i[0] % 8].Set_Value(x, y, 1 - d);
-			m_Flow[i[1] % 8].Set_Value(x, y,     d);
+			Proportion[i[0] % 8]	= 1 - d;
+			Proportion[i[1] % 8]	=     d;
 
 			return( true );
 		}
 	}
 
-	return( Set_D8(x, y) );
+	return( Get_D8(x, y, Proportion) );
 }
 
 //---------------------------------------------------------
-bool CFlow_Accumulation_MP::Set_MFD(int x, int y, double Convergence)
+bool CFlow_Accumulation_MP::Get_MFD(int x, int y, double Proportion[8], double Convergence)
 {
-	//-----------------------------------------------------
-	int	i;	double	dz[8], dzSum = 0.0, z = m_pDEM->asDouble(x, y);
+	double	z	= m_pDEM->asDouble(x, y);
 
-	for(i=0; i<8; i++)
+	for(int i=0; i<8; i++)
 	{
 		int	ix	= Get_xTo(i, x);
 		int	iy	= Get_yTo(i, y);
 
-		if( m_pDEM->is_InGrid(ix, iy) && (dz[i] = m_pDEM->asDouble(ix, iy)) < z )
+		if( m_pDEM->is_InGrid(ix, iy) && m_pDEM->asDouble(ix, iy) < z )
 		{
-			dzSum	+= (dz[i] = pow((z - dz[i]) / Get_Length(i), Convergence));
-		}
-		else
-		{
-			dz[i]	= 0.0;
+			Proportion[i]	= pow((z - m_pDEM->asDouble(ix, iy)) / Get_Length(i), Convergence);
 		}
 	}
 
-	//-----------------------------------------------------
-	if( dzSum > 0.0 )
-	{
-		for(i=0; i<8; i++)
-		{
-			if( dz[i] > 0.0 )
-			{
-				int	ix	= Get_xTo(i, x);
-				int	iy	= Get_yTo(i, y);
-
-				m_Flow[i].Set_Value(x, y, dz[i] / dzSum);
-			}
-		}
-	}
-
-	//-----------------------------------------------------
 	return( true );
 }
 
@@ -350,12 +443,10 @@ bool CFlow_Accumulation_MP::Set_MFD(int x, int y, double Convergence)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-bool CFlow_Accumulation_MP::Get_Flow(int x, int y)
+void CFlow_Accumulation_MP::Get_Flow(sLong n)
 {
-	if( !m_pFlow->is_NoData(x, y) || m_pDEM->is_NoData(x, y) )
-	{
-		return( false );
-	}
+	int	x	= (int)(n % Get_NX());
+	int	y	= (int)(n / Get_NX());
 
 	//-----------------------------------------------------
 	double	Flow	= Get_Cellarea();
@@ -365,21 +456,76 @@ bool CFlow_Accumulation_MP::Get_Flow(int x, int y)
 		int	ix	= Get_xFrom(i, x);
 		int	iy	= Get_yFrom(i, y);
 
-		if( m_Flow[i].is_InGrid(ix, iy) && m_Flow[i].asDouble(ix, iy) > 0.0 )
+		if( is_InGrid(ix, iy) )
 		{
-			if( m_pFlow->is_NoData(ix, iy) )
+			BYTE	w	= Get_Proportions(Get_System().Get_IndexFromRowCol(ix, iy))[i];
+
+			if( w > 0 )
 			{
-				return( false );
+				Flow	+= w * m_pFlow->asDouble(ix, iy) / 255.;
 			}
-
-			Flow	+= m_Flow[i].asDouble(ix, iy) * m_pFlow->asDouble(ix, iy);
 		}
 	}
 
 	m_pFlow->Set_Value(x, y, Flow);
 
 	//-----------------------------------------------------
-	return( true );
+	BYTE	*Donors	= (BYTE *)m_Donors.Get_Array(), *Proportion = Get_Proportions(n);
+
+	Donors[n]	= DONORS_ACTIVE;
+
+	for(int i=0; i<8; i++)
+	{
+		if( Proportion[i] > 0 )
+		{
+			sLong	r	= Get_System().Get_IndexFromRowCol(Get_xTo(i, x), Get_yTo(i, y));
+
+			#pragma omp atomic
+			Donors[r]--;
+		}
+	}
+}
+
+//---------------------------------------------------------
+// A receiver, whose donors are all finished now, is released
+// by its first donor (in direction order) of the current level.
+//---------------------------------------------------------
+void CFlow_Accumulation_MP::Get_Next(sLong n, std::vector<sLong> &Next)
+{
+	int	x	= (int)(n % Get_NX());
+	int	y	= (int)(n / Get_NX());
+
+	BYTE	*Donors	= (BYTE *)m_Donors.Get_Array(), *Proportion = Get_Proportions(n);
+
+	for(int i=0; i<8; i++)
+	{
+		int	rx	= Get_xTo(i, x);
+		int	ry	= Get_yTo(i, y);
+
+		if( Proportion[i] > 0 && Donors[Get_System().Get_IndexFromRowCol(rx, ry)] == 0 )
+		{
+			for(int j=0; j<8; j++)
+			{
+				int	ix	= Get_xFrom(j, rx);
+				int	iy	= Get_yFrom(j, ry);
+
+				if( is_InGrid(ix, iy) )
+				{
+					sLong	d	= Get_System().Get_IndexFromRowCol(ix, iy);
+
+					if( Donors[d] == DONORS_ACTIVE && Get_Proportions(d)[j] > 0 )
+					{
+						if( d == n )
+						{
+							Next.push_back(Get_System().Get_IndexFromRowCol(rx, ry));
+						}
+
+						break;
+					}
+				}
+			}
+		}
+	}
 }
 
 
@@ -58,6 +58,8 @@
 //---------------------------------------------------------
 #include <saga_api/saga_api.h>
 
+#include <vector>
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -83,17 +85,23 @@ protected:
 
 private:
 
-	CSG_Grid				*m_pDEM, *m_pFlow, m_Flow[8];
+	CSG_Array				m_Flow, m_Donors;
+
+	CSG_Grid				*m_pDEM, *m_pFlow;
 
 
 	bool					Initialize				(void);
 	bool					Finalize				(void);
 
-	bool					Set_D8					(int x, int y);
-	bool					Set_Dinf				(int x, int y);
-	bool					Set_MFD					(int x, int y, double Convergence);
+	BYTE *					Get_Proportions			(sLong n)	{	return( (BYTE *)m_Flow.Get_Array() + 8 * n );	}
+	void					Set_Proportions			(sLong n, double Proportion[8]);
+
+	bool					Get_D8					(int x, int y, double Proportion[8]);
+	bool					Get_Dinf				(int x, int y, double Proportion[8]);
+	bool					Get_MFD					(int x, int y, double Proportion[8], double Convergence);
 
-	bool					Get_Flow				(int x, int y);
+	void					Get_Flow				(sLong n);
+	void					Get_Next				(sLong n, std::vector<sLong> &Next);
 
 };
 
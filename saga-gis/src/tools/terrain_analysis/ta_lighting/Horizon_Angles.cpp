@@ -0,0 +1,251 @@
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//                     Tool Library                      //
+//                      ta_lighting                      //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                   Horizon_Angles.cpp                  //
+//                                                       //
+//                 Copyright (C) 2026 by                 //
+//                      Olaf Conrad                      //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'. SAGA is free software; you   //
+// can redistribute it and/or modify it under the terms  //
+// of the GNU General Public License as published by the //
+// Free Software Foundation, either version 2 of the     //
+// License, or (at your option) any later version.       //
+//                                                       //
+// SAGA is distributed in the hope that it will be       //
+// useful, but WITHOUT ANY WARRANTY; without even the    //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU General Public        //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU General    //
+// Public License along with this program; if not, see   //
+// <http://www.gnu.org/licenses/>.                       //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     oconrad@saga-gis.org                   //
+//                                                       //
+//    contact:    Olaf Conrad                            //
+//                Institute of Geography                 //
+//                University of Goettingen               //
+//                Goldschmidtstr. 5                      //
+//                37077 Goettingen                       //
+//                Germany                                //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include "Horizon_Angles.h"
+
+#include <float.h>
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CHorizon_Angles::CHorizon_Angles(void)
+{
+	Set_Name		(_TL("Horizon Angles"));
+
+	Set_Author		("O.Conrad (c) 2026");
+
+	Set_Description	(_TW(
+		"Calculates for each cell the elevation angle of the horizon for a number "
+		"of azimuth sectors. The angles are stored as a compact, quantised grid "
+		"collection (2 bytes per cell and sector, about 0.003 degree resolution), "
+		"one level per sector starting with north and proceeding clockwise. "
+		"The result can be saved and reused e.g. by the 'Potential Incoming Solar Radiation' "
+		"tool, which then only needs a table look-up to decide if a cell is shaded."
+	));
+
+	Parameters.Add_Grid("",
+		"DEM"		, _TL("Elevation"),
+		_TL(""),
+		PARAMETER_INPUT
+	);
+
+	Parameters.Add_Grids("",
+		"HORIZON"	, _TL("Horizon Angles"),
+		_TL("Horizon angles [radians] for each azimuth sector."),
+		PARAMETER_OUTPUT, true, SG_DATATYPE_Word
+	);
+
+	Parameters.Add_Int("",
+		"NSECTORS"	, _TL("Number of Sectors"),
+		_TL(""),
+		36, 4, true
+	);
+
+	Parameters.Add_Double("",
+		"RADIUS"	, _TL("Maximum Search Radius"),
+		_TL("The maximum search radius [map units]. This value is ignored if set to zero."),
+		0.0, 0.0, true
+	);
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CHorizon_Angles::On_Execute(void)
+{
+	CSG_Grid	*pDEM		= Parameters("DEM"    )->asGrid ();
+	CSG_Grids	*pHorizon	= Parameters("HORIZON")->asGrids();
+
+	if( !Get_Horizon(pDEM, pHorizon, Parameters("NSECTORS")->asInt(), Parameters("RADIUS")->asDouble()) )
+	{
+		return( false );
+	}
+
+	pHorizon->Fmt_Name("%s [%s]", pDEM->Get_Name(), _TL("Horizon"));
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Horizon angles are quantised to 16 bit unsigned integers
+// covering the range from -90 to +90 degree, the maximum
+// value is reserved for no-data.
+//---------------------------------------------------------
+#define HORIZON_SCALE	(M_PI / 65534.)
+#define HORIZON_OFFSET	(-M_PI_090)
+
+//---------------------------------------------------------
+bool CHorizon_Angles::Get_Horizon(CSG_Grid *pDEM, CSG_Grids *pHorizon, int nSectors, double Radius)
+{
+	if( !pDEM || !pDEM->is_Valid() || !pHorizon || nSectors < 1
+	||  !pHorizon->Create(pDEM->Get_System(), nSectors, 0., SG_DATATYPE_Word) )
+	{
+		return( false );
+	}
+
+	pHorizon->Set_Scaling(HORIZON_SCALE, HORIZON_OFFSET);
+	pHorizon->Set_NoData_Value(65535);
+	pHorizon->Set_Unit(_TL("radians"));
+
+	//-----------------------------------------------------
+	CSG_Points_Z	Direction;
+
+	for(int i=0; i<nSectors; i++)
+	{
+		pHorizon->Set_Z(i, 360. * i / nSectors);
+
+		double	Azimuth	= (M_PI_360 * i) / nSectors, dx = sin(Azimuth), dy = cos(Azimuth), d = M_GET_MAX(fabs(dx), fabs(dy));
+
+		Direction.Add(dx / d, dy / d, pDEM->Get_Cellsize() * sqrt(dx*dx + dy*dy) / d);	// step with one cell along the major axis
+	}
+
+	if( Radius <= 0. )
+	{
+		Radius	= pDEM->Get_Cellsize() * M_GET_LENGTH(pDEM->Get_NX(), pDEM->Get_NY());
+	}
+
+	double	zMax	= pDEM->Get_Max();
+
+	//-----------------------------------------------------
+	for(int y=0; y<pDEM->Get_NY() && SG_UI_Process_Set_Progress(y, pDEM->Get_NY()); y++)
+	{
+		#pragma omp parallel for
+		for(int x=0; x<pDEM->Get_NX(); x++)
+		{
+			if( pDEM->is_NoData(x, y) )
+			{
+				for(int i=0; i<nSectors; i++)
+				{
+					pHorizon->Get_Grid_Ptr(i)->Set_NoData(x, y);
+				}
+
+				continue;
+			}
+
+			double	z	= pDEM->asDouble(x, y);
+
+			for(int i=0; i<nSectors; i++)
+			{
+				double	Tangent	= -DBL_MAX, dx = Direction[i].x, dy = Direction[i].y, dDistance = Direction[i].z;
+
+				double	ix	= x, iy = y;
+
+				for(double Distance=dDistance; Distance<=Radius; Distance+=dDistance)
+				{
+					int	jx	= (int)floor((ix += dx) + 0.5), jy = (int)floor((iy += dy) + 0.5);	// nearest cell, also for negative coordinates
+
+					if( !pDEM->is_InGrid(jx, jy, false) )
+					{
+						break;	// the sample left the grid
+					}
+
+					if( (zMax - z) / Distance <= Tangent )
+					{
+						break;	// nothing ahead can rise above the current horizon
+					}
+
+					if( !pDEM->is_NoData(jx, jy) )
+					{
+						double	t	= (pDEM->asDouble(jx, jy) - z) / Distance;
+
+						if( Tangent < t )
+						{
+							Tangent	= t;
+						}
+					}
+				}
+
+				pHorizon->Get_Grid_Ptr(i)->Set_Value(x, y, Tangent > -DBL_MAX ? atan(Tangent) : -M_PI_090);
+			}
+		}
+	}
+
+	SG_UI_Process_Set_Ready();
+
+	return( true );
+}
+
+//---------------------------------------------------------
+double CHorizon_Angles::Get_Horizon(const CSG_Grids &Horizon, int x, int y, double Azimuth)
+{
+	double	s	= fmod(Azimuth / M_PI_360, 1.); if( s < 0. ) s += 1.;
+
+	s	*= Horizon.Get_NZ();
+
+	int		i	= (int)s, j = (i + 1) % Horizon.Get_NZ();	i %= Horizon.Get_NZ();
+
+	double	d	= s - floor(s);
+
+	return( (1. - d) * Horizon.asDouble(x, y, i) + d * Horizon.asDouble(x, y, j) );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
@@ -61,6 +61,7 @@
 
 //---------------------------------------------------------
 #include "SolarRadiation.h"
+#include "Horizon_Angles.h"
 
 
 ///////////////////////////////////////////////////////////
@@ -149,14 +150,28 @@ CSolarRadiation::CSolarRadiation(void)
 
 	Parameters.Add_Choice("",
 		"SHADOW"		, _TL("Shadow"),
-		_TL("Choose 'slim' to trace grid node's shadow, 'fat' to trace the whole cell's shadow, or ignore shadowing effects. The first is slightly faster but might show some artifacts."),
-		CSG_String::Format("%s|%s|%s",
+		_TL("Choose 'slim' to trace grid node's shadow, 'fat' to trace the whole cell's shadow, or ignore shadowing effects. The first is slightly faster but might show some artifacts. "
+			"The 'horizon' option looks up precomputed horizon angles, which pays off for calculations with many time steps."),
+		CSG_String::Format("%s|%s|%s|%s",
 			_TL("slim"),
 			_TL("fat"),
-			_TL("none")
+			_TL("none"),
+			_TL("horizon")
 		), 0
 	);
 
+	Parameters.Add_Grids("SHADOW",
+		"GRD_HORIZON"	, _TL("Horizon Angles"),
+		_TL("Horizon angles as created by the 'Horizon Angles' tool. Calculated on the fly if not provided."),
+		PARAMETER_INPUT_OPTIONAL
+	);
+
+	Parameters.Add_Int("GRD_HORIZON",
+		"HORIZON_SECTORS", _TL("Number of Sectors"),
+		_TL("Number of azimuth sectors, if horizon angles are calculated on the fly."),
+		36, 4, true
+	);
+
 	//-----------------------------------------------------
 	Parameters.Add_Choice("",
 		"LOCATION"		, _TL("Location"),
@@ -320,6 +335,16 @@ int CSolarRadiation::On_Parameters_Enable(CSG_Parameters *pParameters, CSG_Param
 		pParameters->Set_Enabled("UPDATE_STRETCH", pParameter->asInt() == 2);
 	}
 
+	if(	pParameter->Cmp_Identifier("SHADOW") )
+	{
+		pParameters->Set_Enabled("GRD_HORIZON"   , pParameter->asInt() == 3);
+	}
+
+	if(	pParameter->Cmp_Identifier("GRD_HORIZON") )
+	{
+		pParameters->Set_Enabled("HORIZON_SECTORS", pParameter->asGrids() == NULL);
+	}
+
 	if(	pParameter->Cmp_Identifier("LOCATION") )
 	{
 		pParameters->Set_Enabled("LATITUDE"      , pParameter->asInt() == 0);
@@ -376,6 +401,7 @@ bool CSolarRadiation::On_Execute(void)
 	m_pDuration		= NULL;
 	m_pSunrise		= NULL;
 	m_pSunset		= NULL;
+	m_pHorizon		= NULL;
 
 	m_bLocalSVF		= Parameters("LOCALSVF"  )->asBool  ();
 
@@ -526,6 +552,7 @@ bool CSolarRadiation::Finalize(void)
 
 	//-----------------------------------------------------
 	m_Shade      .Destroy();
+	m_Horizon    .Destroy(); m_pHorizon = NULL;
 	m_Slope      .Destroy();
 	m_Aspect     .Destroy();
 	m_Lat        .Destroy();
@@ -1083,6 +1110,25 @@ bool CSolarRadiation::Get_Slope_Gradient(void)
 	m_Slope .Create(Get_System());
 	m_Aspect.Create(Get_System());
 
+	m_pHorizon	= NULL;
+
+	if( Parameters("SHADOW")->asInt() == 3 )	// horizon
+	{
+		if( (m_pHorizon = Parameters("GRD_HORIZON")->asGrids()) == NULL )
+		{
+			Process_Set_Text(_TL("Horizon Angles"));
+
+			if( !CHorizon_Angles::Get_Horizon(m_pDEM, &m_Horizon, Parameters("HORIZON_SECTORS")->asInt()) )
+			{
+				return( false );
+			}
+
+			m_pHorizon	= &m_Horizon;
+		}
+
+		Process_Set_Text(_TL("Slope Gradient"));
+	}
+
 	for(int y=0; y<Get_NY() && Set_Progress(y); y++)
 	{
 		#pragma omp parallel for
@@ -1170,6 +1216,11 @@ bool CSolarRadiation::Get_Shade(double Sun_Height, double Sun_Azimuth)
 		return( true );
 	}
 
+	if( m_pHorizon )
+	{
+		return( Get_Shade_Horizon(Sun_Height, Sun_Azimuth) );
+	}
+
 	int	Shadowing	= Parameters("SHADOW")->asInt();
 
 	double	dx, dy, dz;
@@ -1204,6 +1255,39 @@ bool CSolarRadiation::Get_Shade(double Sun_Height, double Sun_Azimuth)
 	return( true );
 }
 
+//---------------------------------------------------------
+// A cell is shaded, if its horizon in the direction of the
+// sun is higher than the sun. Sun positions varying with
+// location are supported without extra costs.
+//---------------------------------------------------------
+bool CSolarRadiation::Get_Shade_Horizon(double Sun_Height, double Sun_Azimuth)
+{
+	if( m_Location == 0 && Sun_Height <= 0.0 )
+	{
+		return( false );
+	}
+
+	#pragma omp parallel for
+	for(sLong i=0; i<Get_NCells(); i++)
+	{
+		int	x	= (int)(i % Get_NX()), y = (int)(i / Get_NX());
+
+		if( m_pDEM->is_NoData(x, y) || m_pHorizon->is_NoData(x, y, 0) )
+		{
+			m_Shade.Set_Value(x, y, 0);
+		}
+		else
+		{
+			double	Height	= m_Location ? m_Sun_Height .asDouble(x, y) : Sun_Height;
+			double	Azimuth	= m_Location ? m_Sun_Azimuth.asDouble(x, y) : Sun_Azimuth;
+
+			m_Shade.Set_Value(x, y, CHorizon_Angles::Get_Horizon(*m_pHorizon, x, y, Azimuth) > Height ? 1 : 0);
+		}
+	}
+
+	return( true );
+}
+
 //---------------------------------------------------------
 void CSolarRadiation::Set_Shade(double x, double y, double z, double dx, double dy, double dz, int Shadowing)
 {
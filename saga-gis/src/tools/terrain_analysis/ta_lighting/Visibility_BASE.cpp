@@ -62,6 +62,8 @@
 //---------------------------------------------------------
 #include "Visibility_BASE.h"
 
+#include <float.h>
+
 
 ///////////////////////////////////////////////////////////
 //                                                       //
@@ -99,6 +101,12 @@ void CVisibility_BASE::Initialize(CSG_Grid *pVisibility, int iMethod)
 		pVisibility->Set_Unit(_TL("radians"));
 		Colors.Set_Ramp(SG_GET_RGB(0, 95, 0), SG_GET_RGB(255, 255, 191));
 		break;
+
+	case 4:		// Cumulative
+		pVisibility->Assign(0.0);
+		pVisibility->Set_Unit(_TL("observers"));
+		Colors.Set_Ramp(SG_GET_RGB(0, 0, 0), SG_GET_RGB(255, 255, 255));
+		break;
 	}
 
 	SG_UI_DataObject_Colors_Set(pVisibility, &Colors);
@@ -107,7 +115,29 @@ void CVisibility_BASE::Initialize(CSG_Grid *pVisibility, int iMethod)
 }
 
 //---------------------------------------------------------
-void CVisibility_BASE::Set_Visibility(CSG_Grid *pDTM, CSG_Grid *pVisibility, int x_Pos, int y_Pos, double z_Pos, double dHeight, int iMethod)
+void CVisibility_BASE::Set_Visibility(CSG_Grid *pDTM, CSG_Grid *pVisibility, int x_Pos, int y_Pos, double z_Pos, double dHeight, int iMethod, int iAlgorithm)
+{
+	CSG_Array	Visible(sizeof(BYTE), (size_t)pDTM->Get_NCells());
+
+	if( Get_Viewshed(pDTM, x_Pos, y_Pos, z_Pos, pDTM->Get_Max(), iAlgorithm, (BYTE *)Visible.Get_Array()) )
+	{
+		#pragma omp parallel for
+		for(int y=0; y<pDTM->Get_NY(); y++)
+		{
+			Add_Visibility(pDTM, pVisibility, (BYTE *)Visible.Get_Array(), y, x_Pos, y_Pos, z_Pos, dHeight, iMethod);
+		}
+	}
+
+	return;
+}
+
+//---------------------------------------------------------
+// Merges the viewshed of one observer into row y of the
+// output. All methods are order independent (set, count,
+// minimum, maximum), so rows can be merged in parallel
+// and observers in any sequence.
+//---------------------------------------------------------
+void CVisibility_BASE::Add_Visibility(CSG_Grid *pDTM, CSG_Grid *pVisibility, const BYTE *Visible, int y, int x_Pos, int y_Pos, double z_Pos, double dHeight, int iMethod)
 {
 	double		Exaggeration	= 1.0;
 
@@ -115,72 +145,213 @@ void CVisibility_BASE::Set_Visibility(CSG_Grid *pDTM, CSG_Grid *pVisibility, int
 				aziSrc, decSrc,
 				d, dx, dy, dz;
 
-	for(int y=0; y<pDTM->Get_NY() && SG_UI_Process_Set_Progress(y, pDTM->Get_NY()); y++)
+	Visible	+= (sLong)y * pDTM->Get_NX();
+
+	for(int x=0; x<pDTM->Get_NX(); x++)
 	{
-		for(int x=0; x<pDTM->Get_NX(); x++)
+		if( pDTM->is_NoData(x, y) )
 		{
-			if( pDTM->is_NoData(x, y) )
-			{
-				pVisibility->Set_NoData(x, y);
-			}
-			else
+			pVisibility->Set_NoData(x, y);
+		}
+		else if( Visible[x] )
+		{
+			dx		= x_Pos - x;
+			dy		= y_Pos - y;
+			dz		= z_Pos - pDTM->asDouble(x, y);
+
+			switch( iMethod )
 			{
-				dx		= x_Pos - x;
-				dy		= y_Pos - y;
-				dz		= z_Pos - pDTM->asDouble(x, y);
+			case 0:		// Visibility
+				pVisibility->Set_Value(x, y, 1);
+				break;
 
-				//-----------------------------------------
-				if( Trace_Point(pDTM, x, y, dx, dy, dz) )
+			case 1:		// Shade
+				pDTM->Get_Gradient(x, y, decDTM, aziDTM);
+				decDTM	= M_PI_090 - atan(Exaggeration * tan(decDTM));
+
+				decSrc	= atan2(dz, sqrt(dx*dx + dy*dy));
+				aziSrc	= atan2(dx, dy);
+
+				d		= acos(sin(decDTM) * sin(decSrc) + cos(decDTM) * cos(decSrc) * cos(aziDTM - aziSrc));
+
+				if( d > M_PI_090 )
+					d = M_PI_090;
+
+				if( pVisibility->asDouble(x, y) > d )
+					pVisibility->Set_Value(x, y, d);
+				break;
+
+			case 2:		// Distance
+				d		= pDTM->Get_Cellsize() * sqrt(dx*dx + dy*dy);
+
+				if( pVisibility->is_NoData(x, y) || pVisibility->asDouble(x, y) > d )
+					pVisibility->Set_Value(x, y, d);
+				break;
+
+			case 3:		// Size
+				if( (d = pDTM->Get_Cellsize() * sqrt(dx*dx + dy*dy)) > 0.0 )
 				{
-					switch( iMethod )
-					{
-					case 0:		// Visibility
-						pVisibility->Set_Value(x, y, 1);
-						break;
+					d	= atan2(dHeight, d);
+					if( pVisibility->is_NoData(x, y) || pVisibility->asDouble(x, y) < d )
+						pVisibility->Set_Value(x, y, d);
+				}
+				break;
+
+			case 4:		// Cumulative
+				pVisibility->Add_Value(x, y, 1);
+				break;
+			}
+		}
+	}
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                                                       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Fills Visible (one byte per cell, row by row) with 1 for
+// cells that can be seen from the observer and 0 otherwise.
+// iAlgorithm: 0 = ray tracing per cell, 1 = XDraw sweep.
+// zMax is the DTM's maximum, which has to be requested by
+// the caller outside of any parallel section, because the
+// grid's statistics might get updated on request.
+//---------------------------------------------------------
+bool CVisibility_BASE::Get_Viewshed(CSG_Grid *pDTM, int x_Pos, int y_Pos, double z_Pos, double zMax, int iAlgorithm, BYTE *Visible, bool bParallel)
+{
+	if( !pDTM->is_InGrid(x_Pos, y_Pos) || !Visible )
+	{
+		return( false );
+	}
+
+	switch( iAlgorithm )
+	{
+	default:	return( _Get_Viewshed_Trace(pDTM, x_Pos, y_Pos, z_Pos, zMax, Visible, bParallel) );
+	case  1:	return( _Get_Viewshed_XDraw(pDTM, x_Pos, y_Pos, z_Pos, Visible) );
+	}
+}
+
+//---------------------------------------------------------
+// XDraw (Franklin & Ray 1994): the grid is swept in square
+// rings of growing Chebyshev distance around the observer.
+// The horizon (steepest slope seen so far along the line of
+// sight) of a ring cell is interpolated from the two cells
+// of the previous ring straddling the line to the observer.
+// Only the previous ring needs to be kept, so the sweep is
+// O(N) in time and O(sqrt N) in additional memory. Each ring
+// is stored as four sides indexed by the offset along the
+// side, the corners being held by both adjacent sides.
+//---------------------------------------------------------
+bool CVisibility_BASE::_Get_Viewshed_XDraw(CSG_Grid *pDTM, int x_Pos, int y_Pos, double z_Pos, BYTE *Visible)
+{
+	const int	nx	= pDTM->Get_NX(), ny = pDTM->Get_NY();
+
+	memset(Visible, 0, (size_t)nx * ny);
+
+	Visible[(sLong)y_Pos * nx + x_Pos]	= pDTM->is_NoData(x_Pos, y_Pos) ? 0 : 1;
+
+	int	nRings	= M_GET_MAX(M_GET_MAX(x_Pos, nx - 1 - x_Pos), M_GET_MAX(y_Pos, ny - 1 - y_Pos));
+
+	if( nRings < 1 )
+	{
+		return( true );
+	}
 
-					case 1:		// Shade
-						pDTM->Get_Gradient(x, y, decDTM, aziDTM);
-						decDTM	= M_PI_090 - atan(Exaggeration * tan(decDTM));
+	//-----------------------------------------------------
+	const int	nSide	= 2 * nRings + 1;
 
-						decSrc	= atan2(dz, sqrt(dx*dx + dy*dy));
-						aziSrc	= atan2(dx, dy);
+	CSG_Array	Horizon(sizeof(double), 2 * 4 * nSide);
 
-						d		= acos(sin(decDTM) * sin(decSrc) + cos(decDTM) * cos(decSrc) * cos(aziDTM - aziSrc));
+	double	*Last	= (double *)Horizon.Get_Array(), *Next = Last + 4 * nSide;
 
-						if( d > M_PI_090 )
-							d = M_PI_090;
+	for(int i=0; i<4*nSide; i++)
+	{
+		Last[i]	= -DBL_MAX;	// the observer's own cell does not obstruct
+	}
 
-						if( pVisibility->asDouble(x, y) > d )
-							pVisibility->Set_Value(x, y, d);
-						break;
+	//-----------------------------------------------------
+	for(int k=1; k<=nRings; k++)
+	{
+		double	f	= (k - 1) / (double)k;
 
-					case 2:		// Distance
-						d		= pDTM->Get_Cellsize() * sqrt(dx*dx + dy*dy);
+		for(int Side=0; Side<4; Side++)
+		{
+			double	*pLast	= Last + Side * nSide + nRings;
+			double	*pNext	= Next + Side * nSide + nRings;
 
-						if( pVisibility->is_NoData(x, y) || pVisibility->asDouble(x, y) > d )
-							pVisibility->Set_Value(x, y, d);
-						break;
+			for(int o=-k; o<=k; o++)
+			{
+				int	x, y;
+
+				switch( Side )
+				{
+				default:	x = x_Pos + k; y = y_Pos + o; break;
+				case  1:	x = x_Pos - k; y = y_Pos + o; break;
+				case  2:	x = x_Pos + o; y = y_Pos + k; break;
+				case  3:	x = x_Pos + o; y = y_Pos - k; break;
+				}
+
+				if( x < 0 || x >= nx || y < 0 || y >= ny )
+				{
+					continue;
+				}
 
-					case 3:		// Size
-						if( (d = pDTM->Get_Cellsize() * sqrt(dx*dx + dy*dy)) > 0.0 )
-						{
-							d	= atan2(dHeight, d);
-							if( pVisibility->is_NoData(x, y) || pVisibility->asDouble(x, y) < d )
-								pVisibility->Set_Value(x, y, d);
-						}
-						break;
+				//-----------------------------------------
+				double	t	= o * f, w = t - floor(t), h;
+				int		i	= (int)floor(t);
+
+				h	= w > 0.0 ? (1.0 - w) * pLast[i] + w * pLast[i + 1] : pLast[i];
+
+				if( pDTM->is_NoData(x, y) )
+				{
+					pNext[o]	= h;	// no-data cells are transparent
+				}
+				else
+				{
+					double	s	= (pDTM->asDouble(x, y) - z_Pos) / sqrt((double)(k*k + o*o));
+
+					if( s >= h )
+					{
+						Visible[(sLong)y * nx + x]	= 1;
+
+						h	= s;
 					}
+
+					pNext[o]	= h;
 				}
 			}
 		}
+
+		double	*p	= Last;	Last = Next; Next = p;
 	}
 
-	return;
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CVisibility_BASE::_Get_Viewshed_Trace(CSG_Grid *pDTM, int x_Pos, int y_Pos, double z_Pos, double zMax, BYTE *Visible, bool bParallel)
+{
+	#pragma omp parallel for if(bParallel)
+	for(int y=0; y<pDTM->Get_NY(); y++)
+	{
+		BYTE	*pVisible	= Visible + (sLong)y * pDTM->Get_NX();
+
+		for(int x=0; x<pDTM->Get_NX(); x++)
+		{
+			pVisible[x]	= !pDTM->is_NoData(x, y)
+				&& Trace_Point(pDTM, x, y, x_Pos - x, y_Pos - y, z_Pos - pDTM->asDouble(x, y), zMax) ? 1 : 0;
+		}
+	}
+
+	return( true );
 }
 
 
 //---------------------------------------------------------
-bool CVisibility_BASE::Trace_Point(CSG_Grid *pDTM, int x, int y, double dx, double dy, double dz)
+bool CVisibility_BASE::Trace_Point(CSG_Grid *pDTM, int x, int y, double dx, double dy, double dz, double zMax)
 {
 	double	ix, iy, iz, id, d, dist;
 
@@ -220,7 +391,7 @@ bool CVisibility_BASE::Trace_Point(CSG_Grid *pDTM, int x, int y, double dx, doub
 			{
 				return( false );
 			}
-			else if( iz > pDTM->Get_Max() )
+			else if( iz > zMax )
 			{
 				return( true );
 			}
@@ -250,6 +421,7 @@ void CVisibility_BASE::Finalize(CSG_Grid *pVisibility, int iMethod)
 
 	case 2:		// Distance
 	case 3:		// Size
+	case 4:		// Cumulative
 		SG_UI_DataObject_Show(pVisibility, true);
 		break;
 	}
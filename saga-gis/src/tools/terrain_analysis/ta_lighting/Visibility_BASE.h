@@ -91,12 +91,17 @@ public:
 protected:
 
 	void		Initialize		(CSG_Grid *pVisibility, int iMethod);
-	void		Set_Visibility	(CSG_Grid *pDTM, CSG_Grid *pVisibility, int x_Pos, int y_Pos, double z_Pos, double dHeight, int iMethod);
-	bool		Trace_Point		(CSG_Grid *pDTM, int x, int y, double dx, double dy, double dz);
+	void		Set_Visibility	(CSG_Grid *pDTM, CSG_Grid *pVisibility, int x_Pos, int y_Pos, double z_Pos, double dHeight, int iMethod, int iAlgorithm = 0);
+	void		Add_Visibility	(CSG_Grid *pDTM, CSG_Grid *pVisibility, const BYTE *Visible, int y, int x_Pos, int y_Pos, double z_Pos, double dHeight, int iMethod);
+	bool		Get_Viewshed	(CSG_Grid *pDTM, int x_Pos, int y_Pos, double z_Pos, double zMax, int iAlgorithm, BYTE *Visible, bool bParallel = true);
+	bool		Trace_Point		(CSG_Grid *pDTM, int x, int y, double dx, double dy, double dz, double zMax);
 	void		Finalize		(CSG_Grid *pVisibility, int iMethod);
 
 private:
 
+	bool		_Get_Viewshed_XDraw	(CSG_Grid *pDTM, int x_Pos, int y_Pos, double z_Pos, BYTE *Visible);
+	bool		_Get_Viewshed_Trace	(CSG_Grid *pDTM, int x_Pos, int y_Pos, double z_Pos, double zMax, BYTE *Visible, bool bParallel);
+
 
 };
 
@@ -102,14 +102,25 @@ CVisibility_Point::CVisibility_Point(void)
 		NULL	, "METHOD"		, _TL("Unit"),
 		_TL(""),
 
-		CSG_String::Format(SG_T("%s|%s|%s|%s|"),
+		CSG_String::Format(SG_T("%s|%s|%s|%s|%s|"),
 			_TL("Visibility"),
 			_TL("Shade"),
 			_TL("Distance"),
-			_TL("Size")
+			_TL("Size"),
+			_TL("Cumulative")
 		), 1
 	);
 
+	Parameters.Add_Choice(
+		NULL	, "ALGORITHM"	, _TL("Algorithm"),
+		_TL("Ray tracing follows the line of sight from each cell to the observer. XDraw sweeps the grid in rings around the observer and interpolates the horizon from the previous ring, which is fast but approximate."),
+
+		CSG_String::Format(SG_T("%s|%s|"),
+			_TL("Ray Tracing"),
+			_TL("XDraw")
+		), 0
+	);
+
 	Parameters.Add_Value(
 		NULL	, "MULTIPLE_OBS"	, _TL("Multiple Observer"),
 		_TL("Allow multiple observer positions."),
@@ -135,6 +146,7 @@ bool CVisibility_Point::On_Execute(void)
 	m_pVisibility	= Parameters("VISIBILITY")	->asGrid();
 	m_Height		= Parameters("HEIGHT")		->asDouble();
 	m_Method		= Parameters("METHOD")		->asInt();
+	m_Algorithm		= Parameters("ALGORITHM")	->asInt();
 	m_bMultiple		= Parameters("MULTIPLE_OBS")->asBool();
 	
 	if( m_bMultiple )
@@ -168,7 +180,7 @@ bool CVisibility_Point::On_Execute_Position(CSG_Point ptWorld, TSG_Tool_Interact
 		Initialize(m_pVisibility, m_Method);
 
 
-	Set_Visibility(m_pDTM, m_pVisibility, x_Pos, y_Pos, z_Pos, m_Height, m_Method);
+	Set_Visibility(m_pDTM, m_pVisibility, x_Pos, y_Pos, z_Pos, m_Height, m_Method, m_Algorithm);
 
 
 	//-----------------------------------------------------
@@ -97,7 +97,7 @@ protected:
 
 private:
 
-	int						m_Method;
+	int						m_Method, m_Algorithm;
 
 	double					m_Height;
 
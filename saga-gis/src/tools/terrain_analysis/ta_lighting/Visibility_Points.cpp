@@ -62,6 +62,16 @@
 #include "Visibility_Points.h"
 
 
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#define VIEWSHED_BATCH_MEMORY	((sLong)256 * 1024 * 1024)	// maximum bytes used for the viewshed masks of one observer batch
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
@@ -108,13 +118,24 @@ CVisibility_Points::CVisibility_Points(void)
 		NULL	, "METHOD"		, _TL("Unit"),
 		_TL(""),
 
-		CSG_String::Format(SG_T("%s|%s|%s|%s|"),
+		CSG_String::Format(SG_T("%s|%s|%s|%s|%s|"),
 			_TL("Visibility"),
 			_TL("Shade"),
 			_TL("Distance"),
-			_TL("Size")
+			_TL("Size"),
+			_TL("Cumulative")
 		), 1
 	);
+
+	Parameters.Add_Choice(
+		NULL	, "ALGORITHM"	, _TL("Algorithm"),
+		_TL("Ray tracing follows the line of sight from each cell to the observer. XDraw sweeps the grid in rings around the observer and interpolates the horizon from the previous ring, which is fast but approximate."),
+
+		CSG_String::Format(SG_T("%s|%s|"),
+			_TL("Ray Tracing"),
+			_TL("XDraw")
+		), 0
+	);
 }
 
 //---------------------------------------------------------
@@ -133,29 +154,76 @@ bool CVisibility_Points::On_Execute(void)
 {
 	CSG_Grid		*pDTM, *pVisibility;
 	CSG_Shapes		*pShapes;
-	int				iMethod, iField;
+	int				iMethod, iAlgorithm, iField;
 
 	pDTM			= Parameters("ELEVATION")	->asGrid();
 	pVisibility		= Parameters("VISIBILITY")	->asGrid();
 	pShapes			= Parameters("POINTS")		->asShapes();
 	iField			= Parameters("FIELD_HEIGHT")->asInt();
 	iMethod			= Parameters("METHOD")		->asInt();
+	iAlgorithm		= Parameters("ALGORITHM")	->asInt();
 
-	Initialize(pVisibility, iMethod);
+	//-----------------------------------------------------
+	CSG_Array_Int	X, Y;	CSG_Vector	Z, Height;
 
 	for(int iShape=0; iShape<pShapes->Get_Count(); iShape++)
 	{
-		Process_Set_Text("%s %d...", _TL("processing observer"), iShape + 1);
-
 		int	x	= Get_System().Get_xWorld_to_Grid(pShapes->Get_Shape(iShape)->Get_Point(0).x);
 		int	y	= Get_System().Get_yWorld_to_Grid(pShapes->Get_Shape(iShape)->Get_Point(0).y);
 
 		if( pDTM->is_InGrid(x, y, true) )
 		{
 			double	dHeight = pShapes->Get_Record(iShape)->asDouble(iField);
-			double	z		= pDTM->asDouble(x, y) + dHeight;
 
-			Set_Visibility(pDTM, pVisibility, x, y, z, dHeight, iMethod);
+			X.Add(x); Y.Add(y); Z.Add_Row(pDTM->asDouble(x, y) + dHeight); Height.Add_Row(dHeight);
+		}
+	}
+
+	Initialize(pVisibility, iMethod);
+
+	//-----------------------------------------------------
+	// observers are processed in batches of one per thread,
+	// each batch's viewsheds are merged row by row afterwards.
+	// every observer of a batch needs its own viewshed mask
+	// of one byte per cell, so the batch size is limited to
+	// keep the masks within VIEWSHED_BATCH_MEMORY bytes
+
+	int	nObservers	= (int)X.Get_Size(), nBatch = M_GET_MIN(nObservers, SG_OMP_Get_Max_Num_Threads());
+
+	nBatch	= (int)M_GET_MAX(1, M_GET_MIN((sLong)nBatch, VIEWSHED_BATCH_MEMORY / Get_NCells()));
+
+	double	zMax	= pDTM->Get_Max();	// request statistics before entering the parallel section
+
+	CSG_Array	Visible(sizeof(BYTE), (size_t)M_GET_MAX(1, nBatch) * Get_NCells());
+
+	if( nObservers > 0 && !Visible.Get_Array() )
+	{
+		Error_Set(_TL("failed to allocate memory"));
+
+		return( false );
+	}
+
+	for(int iBatch=0; iBatch<nObservers && Set_Progress(iBatch, nObservers); iBatch+=nBatch)
+	{
+		Process_Set_Text("%s %d...", _TL("processing observer"), iBatch + 1);
+
+		int	n	= M_GET_MIN(nBatch, nObservers - iBatch);
+
+		#pragma omp parallel for schedule(dynamic)
+		for(int i=0; i<n; i++)
+		{
+			int	j	= iBatch + i;
+
+			Get_Viewshed(pDTM, X[j], Y[j], Z[j], zMax, iAlgorithm, (BYTE *)Visible.Get_Array() + i * Get_NCells(), n < 2);
+		}
+
+		#pragma omp parallel for
+		for(int y=0; y<Get_NY(); y++)
+		{
+			for(int i=0, j=iBatch; i<n; i++, j++)
+			{
+				Add_Visibility(pDTM, pVisibility, (BYTE *)Visible.Get_Array() + i * Get_NCells(), y, X[j], Y[j], Z[j], Height[j], iMethod);
+			}
 		}
 	}
 
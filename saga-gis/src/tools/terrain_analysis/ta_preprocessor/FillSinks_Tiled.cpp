@@ -0,0 +1,637 @@
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//                    Tool Library                       //
+//                  ta_preprocessing                     //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                  FillSinks_Tiled.cpp                  //
+//                                                       //
+//                 Copyright (C) 2026 by                 //
+//                      Olaf Conrad                      //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'. SAGA is free software; you   //
+// can redistribute it and/or modify it under the terms  //
+// of the GNU General Public License as published by the //
+// Free Software Foundation, either version 3 of the     //
+// License, or (at your option) any later version.       //
+//                                                       //
+// SAGA is distributed in the hope that it will be       //
+// useful, but WITHOUT ANY WARRANTY; without even the    //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU General Public        //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU General    //
+// Public License along with this program; if not, see   //
+// <http://www.gnu.org/licenses/>.                       //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     oconrad@saga-gis.org                   //
+//                                                       //
+//    contact:    Olaf Conrad                            //
+//                Institute of Geography                 //
+//                University of Goettingen               //
+//                Goldschmidtstr. 5                      //
+//                37077 Goettingen                       //
+//                Germany                                //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include "FillSinks_Tiled.h"
+
+#include <queue>
+#include <map>
+#include <float.h>
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+typedef struct SCell
+{
+	int		x, y;	double	z;
+}
+TCell;
+
+//---------------------------------------------------------
+class CCell_Greater
+{
+public:
+	bool			operator ()		(const TCell &a, const TCell &b)	const
+	{
+		return( a.z > b.z );
+	}
+};
+
+//---------------------------------------------------------
+// Cells are taken from the plain queue first. It holds cells
+// that have been raised to the level of the cell they were
+// reached from, i.e. cells inside depressions and on flats,
+// which do not need to be sorted by the priority queue.
+//---------------------------------------------------------
+class CCell_Queue
+{
+public:
+
+	void			Push			(int x, int y, double z, bool bPit)
+	{
+		TCell	Cell; Cell.x = x; Cell.y = y; Cell.z = z;
+
+		if( bPit )
+		{
+			m_Pit     .push(Cell);
+		}
+		else
+		{
+			m_Priority.push(Cell);
+		}
+	}
+
+	bool			Pop				(TCell &Cell)
+	{
+		if( !m_Pit.empty() )
+		{
+			Cell	= m_Pit.front(); m_Pit.pop();
+
+			return( true );
+		}
+
+		if( !m_Priority.empty() )
+		{
+			Cell	= m_Priority.top(); m_Priority.pop();
+
+			return( true );
+		}
+
+		return( false );
+	}
+
+
+private:
+
+	std::queue<TCell>												m_Pit;
+
+	std::priority_queue<TCell, std::vector<TCell>, CCell_Greater>	m_Priority;
+
+};
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CFillSinks_Tiled::CFillSinks_Tiled(void)
+{
+	Set_Name		(_TL("Fill Sinks (Tiled Priority-Flood)"));
+
+	Set_Author		("O.Conrad (c) 2026");
+
+	Set_Description	(_TW(
+		"Fills the depressions of a digital elevation model up to their spill "
+		"elevation using a tiled and parallelized variant of the priority-flood "
+		"algorithm, which makes it suitable for very large elevation models.\n"
+		"The elevation model is divided into tiles, which are flooded independently "
+		"from their borders. Each border cell starts a separate watershed and the "
+		"lowest pass elevations between neighbouring watersheds are recorded. "
+		"The resulting graph of watersheds, which also connects the watersheds "
+		"across the tile borders, is solved for the elevation at which each "
+		"watershed spills to the outside of the elevation model. Finally each tile "
+		"is flooded a second time from its raised border cells. "
+		"Cells that are raised to the level of their predecessor are processed "
+		"with a plain queue instead of the priority queue.\n"
+		"In contrast to the Wang & Liu tools this tool does not preserve a minimum "
+		"slope, filled depressions become flat areas. "
+	));
+
+	Add_Reference("Barnes, R., Lehman, C., Mulla, D.", "2014",
+		"Priority-flood: An optimal depression-filling and watershed-labeling algorithm for digital elevation models",
+		"Computers & Geosciences 62: 117-127."
+	);
+
+	Add_Reference("Barnes, R.", "2016",
+		"Parallel priority-flood depression filling for trillion cell digital elevation models on desktops or clusters",
+		"Computers & Geosciences 96: 56-68."
+	);
+
+	//-----------------------------------------------------
+	Parameters.Add_Grid("",
+		"ELEV"		, _TL("DEM"),
+		_TL("Digital elevation model"),
+		PARAMETER_INPUT
+	);
+
+	Parameters.Add_Grid("",
+		"FILLED"	, _TL("Filled DEM"),
+		_TL("Depression-free digital elevation model"),
+		PARAMETER_OUTPUT
+	);
+
+	Parameters.Add_Int("",
+		"TILE_SIZE"	, _TL("Tile Size"),
+		_TL("Edge length of the tiles in number of cells."),
+		1024, 32, true
+	);
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CFillSinks_Tiled::On_Execute(void)
+{
+	m_pDEM		= Parameters("ELEV"     )->asGrid();
+	m_pFilled	= Parameters("FILLED"   )->asGrid();
+	m_Size		= Parameters("TILE_SIZE")->asInt ();
+
+	m_pFilled->Fmt_Name("%s [%s]", m_pDEM->Get_Name(), _TL("no sinks"));
+
+	m_pFilled->Assign_NoData();
+
+	m_nx	= 1 + (Get_NX() - 1) / m_Size;
+	m_ny	= 1 + (Get_NY() - 1) / m_Size;
+
+	int	nTiles	= m_nx * m_ny;
+
+	m_Labels	= new CSG_Array_Int[nTiles];
+
+	std::vector<std::vector<TEdge> >	Edges(nTiles);
+
+	CSG_Array_Int	Offset(nTiles);
+
+	//-----------------------------------------------------
+	// 1. flood each tile from its border and outlet cells and
+	// record the lowest passes between the watersheds...
+
+	Process_Set_Text(_TL("flooding tiles"));
+
+	#pragma omp parallel for schedule(dynamic)
+	for(int iTile=0; iTile<nTiles; iTile++)
+	{
+		if( SG_OMP_Get_Thread_Num() == 0 )
+		{
+			Set_Progress(iTile, nTiles);
+		}
+
+		Offset[iTile]	= Set_Labels(iTile, Edges[iTile]);
+	}
+
+	//-----------------------------------------------------
+	// 2. make labels unique over all tiles, label 0 drains to
+	// the outside of the elevation model...
+
+	int	nLabels	= 1;
+
+	for(int iTile=0; iTile<nTiles; iTile++)
+	{
+		int	n	= Offset[iTile]; Offset[iTile] = nLabels - 1; nLabels += n;
+	}
+
+	#pragma omp parallel for
+	for(int iTile=0; iTile<nTiles; iTile++)
+	{
+		int	*Labels	= m_Labels[iTile].Get_Array();
+
+		for(size_t i=0; i<m_Labels[iTile].Get_Size(); i++)
+		{
+			if( Labels[i] > 0 )
+			{
+				Labels[i]	+= Offset[iTile];
+			}
+		}
+
+		for(size_t i=0; i<Edges[iTile].size(); i++)
+		{
+			if( Edges[iTile][i].a > 0 ) { Edges[iTile][i].a += Offset[iTile]; }
+			if( Edges[iTile][i].b > 0 ) { Edges[iTile][i].b += Offset[iTile]; }
+		}
+	}
+
+	Process_Set_Text(_TL("connecting tiles"));
+
+	#pragma omp parallel for schedule(dynamic)
+	for(int iTile=0; iTile<nTiles; iTile++)
+	{
+		Set_Edges(iTile, Edges[iTile]);
+	}
+
+	//-----------------------------------------------------
+	// 3. find the spill elevation of each watershed, i.e. the
+	// lowest maximum pass elevation on the way to the outside...
+
+	Process_Set_Text(_TL("resolving spill elevations"));
+
+	std::vector<std::vector<std::pair<int, double> > >	Graph(nLabels);
+
+	for(int iTile=0; iTile<nTiles; iTile++)
+	{
+		for(size_t i=0; i<Edges[iTile].size(); i++)
+		{
+			const TEdge	&Edge	= Edges[iTile][i];
+
+			Graph[Edge.a].push_back(std::make_pair(Edge.b, Edge.z));
+			Graph[Edge.b].push_back(std::make_pair(Edge.a, Edge.z));
+		}
+
+		std::vector<TEdge>().swap(Edges[iTile]);
+	}
+
+	std::vector<double>	Spill(nLabels, DBL_MAX);
+
+	std::priority_queue<std::pair<double, int>, std::vector<std::pair<double, int> >, std::greater<std::pair<double, int> > >	Queue;
+
+	Queue.push(std::make_pair(Spill[0] = -DBL_MAX, 0));
+
+	while( !Queue.empty() && Process_Get_Okay() )
+	{
+		double	z	= Queue.top().first;
+		int		a	= Queue.top().second; Queue.pop();
+
+		if( z > Spill[a] )
+		{
+			continue;	// already resolved with a lower spill elevation
+		}
+
+		for(size_t i=0; i<Graph[a].size(); i++)
+		{
+			int		b	= Graph[a][i].first;
+			double	zb	= M_GET_MAX(z, Graph[a][i].second);
+
+			if( zb < Spill[b] )
+			{
+				Queue.push(std::make_pair(Spill[b] = zb, b));
+			}
+		}
+	}
+
+	std::vector<std::vector<std::pair<int, double> > >().swap(Graph);
+
+	if( !Process_Get_Okay() )
+	{
+		delete[](m_Labels);
+
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	// 4. flood each tile again from its raised border cells...
+
+	Process_Set_Text(_TL("filling tiles"));
+
+	#pragma omp parallel for schedule(dynamic)
+	for(int iTile=0; iTile<nTiles; iTile++)
+	{
+		if( SG_OMP_Get_Thread_Num() == 0 )
+		{
+			Set_Progress(iTile, nTiles);
+		}
+
+		Set_Filled(iTile, Spill);
+	}
+
+	//-----------------------------------------------------
+	delete[](m_Labels);
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+void CFillSinks_Tiled::Get_Tile(int iTile, int &x0, int &y0, int &nx, int &ny)
+{
+	x0	= (iTile % m_nx) * m_Size; nx = M_GET_MIN(m_Size, Get_NX() - x0);
+	y0	= (iTile / m_nx) * m_Size; ny = M_GET_MIN(m_Size, Get_NY() - y0);
+}
+
+//---------------------------------------------------------
+int CFillSinks_Tiled::Get_Perimeter_Count(int nx, int ny)
+{
+	return( ny < 2 ? nx : 2 * nx + (nx < 2 ? 1 : 2) * (ny - 2) );
+}
+
+//---------------------------------------------------------
+/** Index of a tile's border cell in the tile's label array:
+  * bottom row, top row, left and right column. Returns -1 for
+  * cells not located at the tile border.
+*/
+int CFillSinks_Tiled::Get_Perimeter(int x, int y, int nx, int ny)
+{
+	if( y == 0      ) { return( x ); }
+	if( y == ny - 1 ) { return( nx + x ); }
+	if( x == 0      ) { return( 2 * nx + y - 1 ); }
+	if( x == nx - 1 ) { return( 2 * nx + y - 1 + ny - 2 ); }
+
+	return( -1 );
+}
+
+//---------------------------------------------------------
+int CFillSinks_Tiled::Get_Label(int x, int y)
+{
+	int	x0, y0, nx, ny, iTile = (y / m_Size) * m_nx + x / m_Size;
+
+	Get_Tile(iTile, x0, y0, nx, ny);
+
+	return( m_Labels[iTile][Get_Perimeter(x - x0, y - y0, nx, ny)] );
+}
+
+//---------------------------------------------------------
+/** A cell drains to the outside of the elevation model, if it
+  * is located at the grid's border or next to a no-data cell.
+*/
+bool CFillSinks_Tiled::is_Outlet(int x, int y)
+{
+	for(int i=0; i<8; i++)
+	{
+		int	ix = Get_xTo(i, x), iy = Get_yTo(i, y);
+
+		if( !m_pDEM->is_InGrid(ix, iy) )
+		{
+			return( true );
+		}
+	}
+
+	return( false );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+int CFillSinks_Tiled::Set_Labels(int iTile, std::vector<TEdge> &Edges)
+{
+	int	x0, y0, nx, ny, nLabels = 0;
+
+	Get_Tile(iTile, x0, y0, nx, ny);
+
+	std::vector<int>	Label(nx * ny, -1);
+	std::vector<double>	Z    (nx * ny);
+
+	CCell_Queue	Queue;
+
+	m_Labels[iTile].Create(Get_Perimeter_Count(nx, ny));
+
+	//-----------------------------------------------------
+	for(int y=0; y<ny; y++) for(int x=0; x<nx; x++)
+	{
+		int	p	= Get_Perimeter(x, y, nx, ny);
+
+		if( !m_pDEM->is_NoData(x0 + x, y0 + y) && (p >= 0 || is_Outlet(x0 + x, y0 + y)) )
+		{
+			int	i	= y * nx + x;
+
+			Label[i]	= is_Outlet(x0 + x, y0 + y) ? 0 : ++nLabels;
+
+			Queue.Push(x, y, Z[i] = m_pDEM->asDouble(x0 + x, y0 + y), false);
+		}
+
+		if( p >= 0 )
+		{
+			m_Labels[iTile][p]	= Label[y * nx + x];
+		}
+	}
+
+	//-----------------------------------------------------
+	std::map<std::pair<int, int>, double>	Passes;
+
+	TCell	Cell;
+
+	while( Queue.Pop(Cell) )
+	{
+		int	Cell_Label	= Label[Cell.y * nx + Cell.x];
+
+		for(int i=0; i<8; i++)
+		{
+			int	ix = Get_xTo(i, Cell.x), iy = Get_yTo(i, Cell.y);
+
+			if( ix >= 0 && ix < nx && iy >= 0 && iy < ny && !m_pDEM->is_NoData(x0 + ix, y0 + iy) )
+			{
+				int	n	= iy * nx + ix;
+
+				if( Label[n] < 0 )
+				{
+					double	z	= m_pDEM->asDouble(x0 + ix, y0 + iy);
+
+					Label[n]	= Cell_Label;
+
+					Queue.Push(ix, iy, Z[n] = M_GET_MAX(z, Cell.z), z <= Cell.z);
+				}
+				else if( Label[n] != Cell_Label )
+				{
+					std::pair<int, int>	Key(M_GET_MIN(Label[n], Cell_Label), M_GET_MAX(Label[n], Cell_Label));
+
+					double	z	= M_GET_MAX(Z[n], Cell.z);
+
+					std::map<std::pair<int, int>, double>::iterator	Pass	= Passes.find(Key);
+
+					if( Pass == Passes.end() )
+					{
+						Passes[Key]	= z;
+					}
+					else if( Pass->second > z )
+					{
+						Pass->second	= z;
+					}
+				}
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	for(std::map<std::pair<int, int>, double>::iterator Pass=Passes.begin(); Pass!=Passes.end(); Pass++)
+	{
+		TEdge	Edge; Edge.a = Pass->first.first; Edge.b = Pass->first.second; Edge.z = Pass->second;
+
+		Edges.push_back(Edge);
+	}
+
+	return( nLabels );
+}
+
+//---------------------------------------------------------
+/** Connects the watersheds of this tile's border cells with
+  * those of the neighbouring tiles.
+*/
+bool CFillSinks_Tiled::Set_Edges(int iTile, std::vector<TEdge> &Edges)
+{
+	int	x0, y0, nx, ny;
+
+	Get_Tile(iTile, x0, y0, nx, ny);
+
+	for(int y=0; y<ny; y++) for(int x=0; x<nx; x++)
+	{
+		int	p	= Get_Perimeter(x, y, nx, ny);
+
+		if( p < 0 )	// skip the tile's inner cells
+		{
+			x	= nx - 2;
+
+			continue;
+		}
+
+		int	a	= m_Labels[iTile][p];
+
+		if( a < 0 )
+		{
+			continue;
+		}
+
+		double	z	= m_pDEM->asDouble(x0 + x, y0 + y);
+
+		for(int i=0; i<8; i++)
+		{
+			int	ix = Get_xTo(i, x0 + x), iy = Get_yTo(i, y0 + y);
+
+			if( (ix < x0 || ix >= x0 + nx || iy < y0 || iy >= y0 + ny) && m_pDEM->is_InGrid(ix, iy) )
+			{
+				int	b	= Get_Label(ix, iy);
+
+				if( b >= 0 && b != a )
+				{
+					TEdge	Edge; Edge.a = a; Edge.b = b; Edge.z = M_GET_MAX(z, m_pDEM->asDouble(ix, iy));
+
+					Edges.push_back(Edge);
+				}
+			}
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CFillSinks_Tiled::Set_Filled(int iTile, const std::vector<double> &Spill)
+{
+	int	x0, y0, nx, ny;
+
+	Get_Tile(iTile, x0, y0, nx, ny);
+
+	std::vector<bool>	bDone(nx * ny, false);
+
+	CCell_Queue	Queue;
+
+	//-----------------------------------------------------
+	for(int y=0; y<ny; y++) for(int x=0; x<nx; x++)
+	{
+		if( !m_pDEM->is_NoData(x0 + x, y0 + y) )
+		{
+			int	p	= Get_Perimeter(x, y, nx, ny);
+
+			if( p >= 0 )
+			{
+				double	z	= m_pDEM->asDouble(x0 + x, y0 + y), zSpill = Spill[m_Labels[iTile][p]];
+
+				Queue.Push(x, y, zSpill < DBL_MAX ? M_GET_MAX(z, zSpill) : z, false);
+
+				bDone[y * nx + x]	= true;
+			}
+			else if( is_Outlet(x0 + x, y0 + y) )
+			{
+				Queue.Push(x, y, m_pDEM->asDouble(x0 + x, y0 + y), false);
+
+				bDone[y * nx + x]	= true;
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	TCell	Cell;
+
+	while( Queue.Pop(Cell) )
+	{
+		m_pFilled->Set_Value(x0 + Cell.x, y0 + Cell.y, Cell.z);
+
+		for(int i=0; i<8; i++)
+		{
+			int	ix = Get_xTo(i, Cell.x), iy = Get_yTo(i, Cell.y);
+
+			if( ix >= 0 && ix < nx && iy >= 0 && iy < ny && !bDone[iy * nx + ix] && !m_pDEM->is_NoData(x0 + ix, y0 + iy) )
+			{
+				double	z	= m_pDEM->asDouble(x0 + ix, y0 + iy);
+
+				bDone[iy * nx + ix]	= true;
+
+				Queue.Push(ix, iy, M_GET_MAX(z, Cell.z), z <= Cell.z);
+			}
+		}
+	}
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
@@ -0,0 +1,121 @@
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//                    Tool Library                       //
+//                  ta_preprocessing                     //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                   FillSinks_Tiled.h                   //
+//                                                       //
+//                 Copyright (C) 2026 by                 //
+//                      Olaf Conrad                      //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'. SAGA is free software; you   //
+// can redistribute it and/or modify it under the terms  //
+// of the GNU General Public License as published by the //
+// Free Software Foundation, either version 3 of the     //
+// License, or (at your option) any later version.       //
+//                                                       //
+// SAGA is distributed in the hope that it will be       //
+// useful, but WITHOUT ANY WARRANTY; without even the    //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU General Public        //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU General    //
+// Public License along with this program; if not, see   //
+// <http://www.gnu.org/licenses/>.                       //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     oconrad@saga-gis.org                   //
+//                                                       //
+//    contact:    Olaf Conrad                            //
+//                Institute of Geography                 //
+//                University of Goettingen               //
+//                Goldschmidtstr. 5                      //
+//                37077 Goettingen                       //
+//                Germany                                //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#ifndef HEADER_INCLUDED__FillSinks_Tiled_H
+#define HEADER_INCLUDED__FillSinks_Tiled_H
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include <saga_api/saga_api.h>
+
+#include <vector>
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+class CFillSinks_Tiled : public CSG_Tool_Grid
+{
+public:
+	CFillSinks_Tiled(void);
+
+
+protected:
+
+	virtual bool		On_Execute				(void);
+
+
+private:
+
+	typedef struct SEdge
+	{
+		int		a, b;	double	z;
+	}
+	TEdge;
+
+	int					m_Size, m_nx, m_ny;
+
+	CSG_Grid			*m_pDEM, *m_pFilled;
+
+	CSG_Array_Int		*m_Labels;
+
+
+	void				Get_Tile				(int iTile, int &x0, int &y0, int &nx, int &ny);
+	int					Get_Perimeter_Count		(int nx, int ny);
+	int					Get_Perimeter			(int x, int y, int nx, int ny);
+	int					Get_Label				(int x, int y);
+
+	bool				is_Outlet				(int x, int y);
+
+	int					Set_Labels				(int iTile, std::vector<TEdge> &Edges);
+	bool				Set_Edges				(int iTile, std::vector<TEdge> &Edges);
+	bool				Set_Filled				(int iTile, const std::vector<double> &Spill);
+
+};
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#endif // #ifndef HEADER_INCLUDED__FillSinks_Tiled_H